@@ -492,7 +492,7 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::squared_distance(
       I(p) = Ip;
       C.row(p).head(DIM) = c;
     },
-    10000);
+    1000);
 }
 
 template <typename DerivedV, int DIM>
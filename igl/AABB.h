@@ -74,7 +74,9 @@ public:
         swap(*this,other);
         return *this;
       }
-      AABB(AABB&& other):
+      // noexcept so that growing a std::vector of trees moves them instead of
+      // copying them
+      AABB(AABB&& other) noexcept:
         // initialize via default constructor
         AABB() 
       {
@@ -0,0 +1,684 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "FastWindingNumber.h"
+#include "parallel_for.h"
+#include "solid_angle.h"
+#include "PI.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#if defined(__AVX__) || defined(__SSE2__)
+#  include <immintrin.h>
+
+namespace
+{
+  // Lanes of doubles, one query each (the double precision lanes of SSE
+  // need SSE2)
+#  ifdef __AVX__
+  typedef __m256d fwn_lanes;
+  const int fwn_num_lanes = 4;
+  inline fwn_lanes fwn_set1(const double a){ return _mm256_set1_pd(a); }
+  inline fwn_lanes fwn_load(const double * a){ return _mm256_loadu_pd(a); }
+  inline void fwn_store(double * a, const fwn_lanes x){ _mm256_storeu_pd(a,x); }
+  inline fwn_lanes fwn_add(const fwn_lanes a, const fwn_lanes b){ return _mm256_add_pd(a,b); }
+  inline fwn_lanes fwn_sub(const fwn_lanes a, const fwn_lanes b){ return _mm256_sub_pd(a,b); }
+  inline fwn_lanes fwn_mul(const fwn_lanes a, const fwn_lanes b){ return _mm256_mul_pd(a,b); }
+  inline fwn_lanes fwn_div(const fwn_lanes a, const fwn_lanes b){ return _mm256_div_pd(a,b); }
+  inline fwn_lanes fwn_sqrt(const fwn_lanes a){ return _mm256_sqrt_pd(a); }
+  // All bits set in the lanes whose bit is set in mask, zero in the others
+  inline fwn_lanes fwn_mask(const int mask)
+  {
+    return _mm256_castsi256_pd(_mm256_set_epi64x(
+      -((mask>>3)&1),-((mask>>2)&1),-((mask>>1)&1),-(mask&1)));
+  }
+  inline fwn_lanes fwn_and(const fwn_lanes a, const fwn_lanes b){ return _mm256_and_pd(a,b); }
+#  else
+  typedef __m128d fwn_lanes;
+  const int fwn_num_lanes = 2;
+  inline fwn_lanes fwn_set1(const double a){ return _mm_set1_pd(a); }
+  inline fwn_lanes fwn_load(const double * a){ return _mm_loadu_pd(a); }
+  inline void fwn_store(double * a, const fwn_lanes x){ _mm_storeu_pd(a,x); }
+  inline fwn_lanes fwn_add(const fwn_lanes a, const fwn_lanes b){ return _mm_add_pd(a,b); }
+  inline fwn_lanes fwn_sub(const fwn_lanes a, const fwn_lanes b){ return _mm_sub_pd(a,b); }
+  inline fwn_lanes fwn_mul(const fwn_lanes a, const fwn_lanes b){ return _mm_mul_pd(a,b); }
+  inline fwn_lanes fwn_div(const fwn_lanes a, const fwn_lanes b){ return _mm_div_pd(a,b); }
+  inline fwn_lanes fwn_sqrt(const fwn_lanes a){ return _mm_sqrt_pd(a); }
+  inline fwn_lanes fwn_mask(const int mask)
+  {
+    return _mm_castsi128_pd(_mm_set_epi64x(-((mask>>1)&1),-(mask&1)));
+  }
+  inline fwn_lanes fwn_and(const fwn_lanes a, const fwn_lanes b){ return _mm_and_pd(a,b); }
+#  endif
+}
+#endif
+
+IGL_INLINE igl::FastWindingNumber::FastWindingNumber(
+  const int _expansion_order,
+  const int _leaf_capacity):
+  expansion_order(std::min(std::max(_expansion_order,0),2)),
+  leaf_capacity(std::max(_leaf_capacity,1)),
+  triangles(false)
+{
+}
+
+IGL_INLINE void igl::FastWindingNumber::build(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F)
+{
+  triangles = true;
+  const int m = F.rows();
+  P.resize(m,3);
+  A.resize(m);
+  AN.resize(m,3);
+  T.resize(m,9);
+  for(int f = 0;f<m;f++)
+  {
+    const Eigen::RowVector3d a = V.row(F(f,0));
+    const Eigen::RowVector3d b = V.row(F(f,1));
+    const Eigen::RowVector3d c = V.row(F(f,2));
+    P.row(f) = (a+b+c)/3.;
+    AN.row(f) = 0.5*(b-a).cross(c-a);
+    A(f) = AN.row(f).norm();
+    T.row(f) << a,b,c;
+  }
+  build_tree();
+}
+
+IGL_INLINE void igl::FastWindingNumber::build(
+  const Eigen::MatrixXd & _P,
+  const Eigen::MatrixXd & N,
+  const Eigen::VectorXd & _A)
+{
+  triangles = false;
+  P = _P.leftCols(3);
+  A = _A;
+  AN = N.leftCols(3).array().colwise()*_A.array();
+  T.resize(0,9);
+  build_tree();
+}
+
+IGL_INLINE void igl::FastWindingNumber::build_tree()
+{
+  const int m = P.rows();
+  cells.clear();
+  if(m == 0)
+  {
+    CM.resize(0,3);
+    R.resize(0);
+    EC.resize(0,0);
+    return;
+  }
+  std::vector<int> order(m),buffer(m);
+  for(int e = 0;e<m;e++)
+  {
+    order[e] = e;
+  }
+  const Eigen::RowVector3d min_corner = P.colwise().minCoeff();
+  const Eigen::RowVector3d max_corner = P.colwise().maxCoeff();
+  Cell root;
+  root.begin = 0;
+  root.end = m;
+  cells.push_back(root);
+  build_cell(
+    0,0.5*(min_corner+max_corner),0.5*(max_corner-min_corner).maxCoeff(),
+    order,buffer);
+
+  // Elements in tree order, so that each cell's are contiguous
+  {
+    MatrixX3R sP(m,3),sAN(m,3);
+    Eigen::VectorXd sA(m);
+    MatrixXR sT(triangles ? m : 0,9);
+    for(int e = 0;e<m;e++)
+    {
+      sP.row(e) = P.row(order[e]);
+      sA(e) = A(order[e]);
+      sAN.row(e) = AN.row(order[e]);
+      if(triangles)
+      {
+        sT.row(e) = T.row(order[e]);
+      }
+    }
+    P.swap(sP);
+    A.swap(sA);
+    AN.swap(sAN);
+    T.swap(sT);
+  }
+
+  // Expansions [Barill et al. 2018], cell by cell
+  const int num_terms = expansion_order == 0 ? 3 : (expansion_order == 1 ? 12 : 39);
+  const int num_cells = cells.size();
+  CM.resize(num_cells,3);
+  R.resize(num_cells);
+  EC.setZero(num_cells,num_terms);
+  igl::parallel_for(num_cells,[&](const int c)
+  {
+    const Cell & cell = cells[c];
+    Eigen::RowVector3d masscenter(0,0,0);
+    double areatotal = 0;
+    for(int e = cell.begin;e<cell.end;e++)
+    {
+      areatotal += A(e);
+      masscenter += A(e)*P.row(e);
+    }
+    if(areatotal > 0)
+    {
+      masscenter /= areatotal;
+    }else
+    {
+      masscenter = P.middleRows(cell.begin,cell.end-cell.begin).colwise().mean();
+    }
+    CM.row(c) = masscenter;
+    double max_norm = 0;
+    for(int e = cell.begin;e<cell.end;e++)
+    {
+      const Eigen::RowVector3d point = P.row(e)-masscenter;
+      const Eigen::RowVector3d an = AN.row(e);
+      if(triangles)
+      {
+        // Bound the whole triangle, not just its centroid
+        for(int k = 0;k<3;k++)
+        {
+          max_norm = std::max(max_norm,
+            (T.row(e).segment<3>(3*k)-masscenter).norm());
+        }
+      }else
+      {
+        max_norm = std::max(max_norm,point.norm());
+      }
+      double * ec = EC.row(c).data();
+      for(int j = 0;j<3;j++)
+      {
+        ec[j] += an(j);
+      }
+      if(num_terms >= 12)
+      {
+        for(int j = 0;j<3;j++)
+        {
+          for(int i = 0;i<3;i++)
+          {
+            ec[3+i+3*j] += point(i)*an(j);
+          }
+        }
+      }
+      if(num_terms == 39)
+      {
+        // Second moment of the element about the center of mass: a
+        // triangle adds its own spread about its centroid, which is 1/12 of
+        // the sum of its corners' outer products
+        Eigen::Matrix3d moment = point.transpose()*point;
+        if(triangles)
+        {
+          for(int v = 0;v<3;v++)
+          {
+            const Eigen::RowVector3d d = T.row(e).segment<3>(3*v)-P.row(e);
+            moment += d.transpose()*d/12.0;
+          }
+        }
+        for(int k = 0;k<3;k++)
+        {
+          for(int j = 0;j<3;j++)
+          {
+            for(int i = 0;i<3;i++)
+            {
+              ec[12+9*k+i+3*j] += 0.5*moment(k,i)*an(j);
+            }
+          }
+        }
+      }
+    }
+    R(c) = max_norm;
+  },1000);
+}
+
+IGL_INLINE void igl::FastWindingNumber::build_cell(
+  const int c,
+  const Eigen::RowVector3d & center,
+  const double half_width,
+  std::vector<int> & order,
+  std::vector<int> & buffer)
+{
+  const int begin = cells[c].begin;
+  const int end = cells[c].end;
+  cells[c].first_child = -1;
+  cells[c].num_children = 0;
+  // Coincident elements can not be separated, stop before the cells become
+  // degenerate
+  if(end-begin <= leaf_capacity ||
+    !(half_width > 1e-12*std::max(1.0,center.cwiseAbs().maxCoeff())))
+  {
+    return;
+  }
+  // Counting sort by octant, numbered as in octree
+  const auto octant = [&](const int e)
+  {
+    return (P(e,0) >= center(0) ? 1 : 0) + (P(e,1) >= center(1) ? 2 : 0) +
+      (P(e,2) >= center(2) ? 4 : 0);
+  };
+  int offset[9] = {0,0,0,0,0,0,0,0,0};
+  for(int k = begin;k<end;k++)
+  {
+    offset[octant(order[k])+1]++;
+  }
+  for(int o = 0;o<8;o++)
+  {
+    offset[o+1] += offset[o];
+  }
+  int fill[8];
+  std::copy(offset,offset+8,fill);
+  for(int k = begin;k<end;k++)
+  {
+    buffer[begin+fill[octant(order[k])]++] = order[k];
+  }
+  std::copy(buffer.begin()+begin,buffer.begin()+end,order.begin()+begin);
+
+  // Children of the non-empty octants
+  const int first_child = cells.size();
+  Eigen::RowVector3d child_centers[8];
+  const double h = 0.5*half_width;
+  for(int o = 0;o<8;o++)
+  {
+    if(offset[o+1] == offset[o])
+    {
+      continue;
+    }
+    Cell child;
+    child.begin = begin+offset[o];
+    child.end = begin+offset[o+1];
+    child_centers[cells.size()-first_child] = center;
+    for(int d = 0;d<3;d++)
+    {
+      child_centers[cells.size()-first_child](d) += (o>>d)&1 ? h : -h;
+    }
+    cells.push_back(child);
+  }
+  const int num_children = cells.size()-first_child;
+  cells[c].first_child = first_child;
+  cells[c].num_children = num_children;
+  for(int k = 0;k<num_children;k++)
+  {
+    build_cell(first_child+k,child_centers[k],h,order,buffer);
+  }
+}
+
+IGL_INLINE double igl::FastWindingNumber::element_winding_number(
+  const int e,
+  const Eigen::RowVector3d & q) const
+{
+  if(triangles)
+  {
+    const Eigen::RowVector3d a = T.row(e).segment<3>(0);
+    const Eigen::RowVector3d b = T.row(e).segment<3>(3);
+    const Eigen::RowVector3d c = T.row(e).segment<3>(6);
+    return igl::solid_angle(a,b,c,q);
+  }
+  const Eigen::RowVector3d loc = P.row(e)-q;
+  const double wn = loc.dot(AN.row(e))/(4.0*igl::PI*std::pow(loc.norm(),3));
+  // As in fast_winding_number
+  return std::isnan(wn) ? 0.5 : wn;
+}
+
+IGL_INLINE double igl::FastWindingNumber::expansion_winding_number(
+  const std::vector<int> & far_cells,
+  const Eigen::RowVector3d & q) const
+{
+  // The expansions of fast_winding_number with the derivative tensors
+  // contracted by hand:
+  //   wn = k3 loc·C0
+  //      + k3 tr(C1) - 3 k5 locᵀ C1 loc
+  //      + Σ_i 15 k7 loc_i locᵀ C2_i loc
+  //        - 3 k5 (C2_i(i,:) loc + locᵀ C2_i(:,i) + loc_i tr(C2_i))
+  // with loc = CM - q and kn = 1/(4π |loc|^n)
+  const int num_terms = EC.cols();
+  double wn = 0;
+  for(const int c : far_cells)
+  {
+    const double * ec = EC.row(c).data();
+    const double l[3] = {CM(c,0)-q(0),CM(c,1)-q(1),CM(c,2)-q(2)};
+    const double r2 = l[0]*l[0]+l[1]*l[1]+l[2]*l[2];
+    const double k3 = 1.0/(4.0*igl::PI*r2*std::sqrt(r2));
+    double cell_wn = k3*(l[0]*ec[0]+l[1]*ec[1]+l[2]*ec[2]);
+    if(num_terms >= 12)
+    {
+      const double k5 = k3/r2;
+      const double * c1 = ec+3;
+      double lC1l = 0;
+      for(int j = 0;j<3;j++)
+      {
+        for(int i = 0;i<3;i++)
+        {
+          lC1l += l[i]*c1[i+3*j]*l[j];
+        }
+      }
+      cell_wn += k3*(c1[0]+c1[4]+c1[8]) - 3.0*k5*lC1l;
+      if(num_terms == 39)
+      {
+        const double k7 = k5/r2;
+        for(int k = 0;k<3;k++)
+        {
+          const double * c2 = ec+12+9*k;
+          double lC2l = 0;
+          double rows = 0;
+          double cols = 0;
+          for(int j = 0;j<3;j++)
+          {
+            for(int i = 0;i<3;i++)
+            {
+              lC2l += l[i]*c2[i+3*j]*l[j];
+            }
+            rows += c2[k+3*j]*l[j];
+            cols += l[j]*c2[j+3*k];
+          }
+          cell_wn += 15.0*k7*l[k]*lC2l -
+            3.0*k5*(rows+cols+l[k]*(c2[0]+c2[4]+c2[8]));
+        }
+      }
+    }
+    wn += cell_wn;
+  }
+  return wn;
+}
+
+IGL_INLINE double igl::FastWindingNumber::winding_number(
+  const Eigen::RowVector3d & q,
+  const double beta,
+  std::vector<int> & stack,
+  std::vector<int> & far_cells) const
+{
+  double wn = 0;
+  if(cells.empty())
+  {
+    return wn;
+  }
+  if(!(beta > 0))
+  {
+    for(int e = 0;e<P.rows();e++)
+    {
+      wn += element_winding_number(e,q);
+    }
+    return wn;
+  }
+  const double beta2 = beta*beta;
+  stack.clear();
+  far_cells.clear();
+  stack.push_back(0);
+  while(!stack.empty())
+  {
+    const int c = stack.back();
+    stack.pop_back();
+    const Cell & cell = cells[c];
+    if((CM.row(c)-q).squaredNorm() > beta2*R(c)*R(c))
+    {
+      far_cells.push_back(c);
+    }else if(cell.num_children == 0)
+    {
+      for(int e = cell.begin;e<cell.end;e++)
+      {
+        wn += element_winding_number(e,q);
+      }
+    }else
+    {
+      for(int k = 0;k<cell.num_children;k++)
+      {
+        stack.push_back(cell.first_child+k);
+      }
+    }
+  }
+  return wn + expansion_winding_number(far_cells,q);
+}
+
+#if defined(__AVX__) || defined(__SSE2__)
+IGL_INLINE void igl::FastWindingNumber::winding_number_lanes(
+  const Eigen::MatrixXd & Q,
+  const int * I,
+  const int n,
+  const double beta,
+  std::vector<int> & stack,
+  std::vector<int> & far_cells,
+  Eigen::VectorXd & W) const
+{
+  // Lanes past n repeat the last query and are dropped
+  Eigen::RowVector3d q[fwn_num_lanes];
+  double qc[3][fwn_num_lanes];
+  double wn[fwn_num_lanes];
+  for(int l = 0;l<fwn_num_lanes;l++)
+  {
+    q[l] = Q.row(I[std::min(l,n-1)]).head<3>();
+    for(int i = 0;i<3;i++)
+    {
+      qc[i][l] = q[l](i);
+    }
+    wn[l] = 0;
+  }
+
+  // Stack entries and far cells are c<<4 | the mask of the lanes they apply
+  // to. A lane leaves a subtree at its first far cell, so each lane visits
+  // the cells of its own walk, in the same order.
+  const double beta2 = beta*beta;
+  stack.clear();
+  far_cells.clear();
+  stack.push_back((1<<n)-1);
+  while(!stack.empty())
+  {
+    const int c = stack.back()>>4;
+    int mask = stack.back()&15;
+    stack.pop_back();
+    const Cell & cell = cells[c];
+    int far = 0;
+    for(int l = 0;l<n;l++)
+    {
+      if(((mask>>l)&1) && (CM.row(c)-q[l]).squaredNorm() > beta2*R(c)*R(c))
+      {
+        far |= 1<<l;
+      }
+    }
+    if(far)
+    {
+      far_cells.push_back(c<<4 | far);
+    }
+    mask &= ~far;
+    if(!mask)
+    {
+      continue;
+    }
+    if(cell.num_children == 0)
+    {
+      for(int l = 0;l<n;l++)
+      {
+        if((mask>>l)&1)
+        {
+          for(int e = cell.begin;e<cell.end;e++)
+          {
+            wn[l] += element_winding_number(e,q[l]);
+          }
+        }
+      }
+    }else
+    {
+      for(int k = 0;k<cell.num_children;k++)
+      {
+        stack.push_back((cell.first_child+k)<<4 | mask);
+      }
+    }
+  }
+
+  // expansion_winding_number in lanes, operation for operation, masked to
+  // the lanes each cell is far from
+  const int num_terms = EC.cols();
+  const fwn_lanes q_lanes[3] =
+    {fwn_load(qc[0]),fwn_load(qc[1]),fwn_load(qc[2])};
+  const fwn_lanes four_pi = fwn_set1(4.0*igl::PI);
+  const fwn_lanes one = fwn_set1(1.0);
+  const fwn_lanes three = fwn_set1(3.0);
+  const fwn_lanes fifteen = fwn_set1(15.0);
+  fwn_lanes sum = fwn_set1(0.0);
+  for(const int entry : far_cells)
+  {
+    const int c = entry>>4;
+    const double * ec = EC.row(c).data();
+    fwn_lanes l[3];
+    for(int i = 0;i<3;i++)
+    {
+      l[i] = fwn_sub(fwn_set1(CM(c,i)),q_lanes[i]);
+    }
+    const fwn_lanes r2 = fwn_add(fwn_add(
+      fwn_mul(l[0],l[0]),fwn_mul(l[1],l[1])),fwn_mul(l[2],l[2]));
+    const fwn_lanes k3 = fwn_div(one,
+      fwn_mul(fwn_mul(four_pi,r2),fwn_sqrt(r2)));
+    fwn_lanes cell_wn = fwn_mul(k3,fwn_add(fwn_add(
+      fwn_mul(l[0],fwn_set1(ec[0])),fwn_mul(l[1],fwn_set1(ec[1]))),
+      fwn_mul(l[2],fwn_set1(ec[2]))));
+    if(num_terms >= 12)
+    {
+      const fwn_lanes k5 = fwn_div(k3,r2);
+      const double * c1 = ec+3;
+      fwn_lanes lC1l = fwn_set1(0.0);
+      for(int j = 0;j<3;j++)
+      {
+        for(int i = 0;i<3;i++)
+        {
+          lC1l = fwn_add(lC1l,
+            fwn_mul(fwn_mul(l[i],fwn_set1(c1[i+3*j])),l[j]));
+        }
+      }
+      cell_wn = fwn_add(cell_wn,fwn_sub(
+        fwn_mul(k3,fwn_set1(c1[0]+c1[4]+c1[8])),
+        fwn_mul(fwn_mul(three,k5),lC1l)));
+      if(num_terms == 39)
+      {
+        const fwn_lanes k7 = fwn_div(k5,r2);
+        for(int k = 0;k<3;k++)
+        {
+          const double * c2 = ec+12+9*k;
+          fwn_lanes lC2l = fwn_set1(0.0);
+          fwn_lanes rows = fwn_set1(0.0);
+          fwn_lanes cols = fwn_set1(0.0);
+          for(int j = 0;j<3;j++)
+          {
+            for(int i = 0;i<3;i++)
+            {
+              lC2l = fwn_add(lC2l,
+                fwn_mul(fwn_mul(l[i],fwn_set1(c2[i+3*j])),l[j]));
+            }
+            rows = fwn_add(rows,fwn_mul(fwn_set1(c2[k+3*j]),l[j]));
+            cols = fwn_add(cols,fwn_mul(l[j],fwn_set1(c2[j+3*k])));
+          }
+          cell_wn = fwn_add(cell_wn,fwn_sub(
+            fwn_mul(fwn_mul(fwn_mul(fifteen,k7),l[k]),lC2l),
+            fwn_mul(fwn_mul(three,k5),fwn_add(fwn_add(rows,cols),
+              fwn_mul(l[k],fwn_set1(c2[0]+c2[4]+c2[8]))))));
+        }
+      }
+    }
+    sum = fwn_add(sum,fwn_and(fwn_mask(entry&15),cell_wn));
+  }
+  double expansion[fwn_num_lanes];
+  fwn_store(expansion,sum);
+  for(int l = 0;l<n;l++)
+  {
+    W(I[l]) = wn[l] + expansion[l];
+  }
+}
+#endif
+
+IGL_INLINE void igl::FastWindingNumber::winding_number(
+  const Eigen::MatrixXd & Q,
+  Eigen::VectorXd & W,
+  const double beta) const
+{
+  W.resize(Q.rows());
+  std::vector<std::vector<int> > stacks,far_cells;
+#if defined(__AVX__) || defined(__SSE2__)
+  // Batches of nearby queries share a walk of the tree, so that the
+  // expansions of their common far cells are evaluated in SIMD lanes.
+  // Queries are batched in Morton order on a 1024^3 grid over their
+  // bounding box.
+  if(beta > 0 && !cells.empty())
+  {
+    const int nq = Q.rows();
+    std::vector<std::pair<unsigned,int> > morton(nq);
+    if(nq > 0)
+    {
+      const Eigen::RowVector3d min_corner = Q.leftCols(3).colwise().minCoeff();
+      const Eigen::RowVector3d max_corner = Q.leftCols(3).colwise().maxCoeff();
+      const double extent = (max_corner-min_corner).maxCoeff();
+      const double scale = extent > 0 ? 1023.0/extent : 0;
+      // Spreads the 10 bits of x to every third bit
+      const auto spread = [](unsigned x)
+      {
+        x = (x | (x<<16)) & 0x030000FF;
+        x = (x | (x<<8)) & 0x0300F00F;
+        x = (x | (x<<4)) & 0x030C30C3;
+        x = (x | (x<<2)) & 0x09249249;
+        return x;
+      };
+      igl::parallel_for(nq,[&](const int i)
+      {
+        unsigned code = 0;
+        for(int d = 0;d<3;d++)
+        {
+          const double x = (Q(i,d)-min_corner(d))*scale;
+          // NaN queries go first
+          const unsigned cell = x > 0 ? unsigned(std::min(x,1023.0)) : 0;
+          code |= spread(cell)<<d;
+        }
+        morton[i] = std::make_pair(code,i);
+      },10000);
+      std::sort(morton.begin(),morton.end());
+    }
+    std::vector<int> I(nq);
+    for(int i = 0;i<nq;i++)
+    {
+      I[i] = morton[i].second;
+    }
+    const int num_batches = (nq+fwn_num_lanes-1)/fwn_num_lanes;
+    igl::parallel_for(
+      num_batches,
+      [&](const size_t nt)
+      {
+        stacks.resize(nt);
+        far_cells.resize(nt);
+      },
+      [&](const int b, const size_t t)
+      {
+        const int first = b*fwn_num_lanes;
+        winding_number_lanes(Q,I.data()+first,
+          std::min(fwn_num_lanes,nq-first),beta,stacks[t],far_cells[t],W);
+      },
+      [](const size_t){},
+      1000/fwn_num_lanes);
+    return;
+  }
+#endif
+  igl::parallel_for(
+    Q.rows(),
+    [&](const size_t nt)
+    {
+      stacks.resize(nt);
+      far_cells.resize(nt);
+    },
+    [&](const int i, const size_t t)
+    {
+      W(i) = winding_number(Q.row(i).head<3>(),beta,stacks[t],far_cells[t]);
+    },
+    [](const size_t){},
+    1000);
+}
+
+IGL_INLINE double igl::FastWindingNumber::winding_number(
+  const Eigen::RowVector3d & q,
+  const double beta) const
+{
+  std::vector<int> stack,far_cells;
+  return winding_number(q,beta,stack,far_cells);
+}
+
+IGL_INLINE int igl::FastWindingNumber::size() const
+{
+  return P.rows();
+}
@@ -0,0 +1,149 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_FASTWINDINGNUMBER_H
+#define IGL_FASTWINDINGNUMBER_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <vector>
+
+namespace igl
+{
+  // Precomputed hierarchy for evaluating the generalized winding number of a
+  // triangle mesh or an oriented point cloud at many query points
+  // [Barill et al. 2018] (see fast_winding_number). Built once per mesh and
+  // const afterwards, so one object can be shared by any number of threads.
+  //
+  // Elements (triangles or points) are sorted into the leaves of an octree
+  // and each cell stores the center of mass, radius and Taylor expansion
+  // coefficients of its dipoles in contiguous arrays. Each query collects
+  // the cells far enough away to be approximated by their expansion and
+  // evaluates them in one flat loop over those arrays; near leaves are
+  // summed exactly (triangle solid angles, or point dipoles).
+  //
+  // Example:
+  //   igl::FastWindingNumber fwn;
+  //   fwn.build(V,F);
+  //   Eigen::VectorXd W;
+  //   fwn.winding_number(Q,W);
+  class FastWindingNumber
+  {
+  public:
+    // Inputs:
+    //   expansion_order  order of the Taylor expansions, 0, 1 or 2
+    //   leaf_capacity  maximum number of elements of a leaf
+    IGL_INLINE FastWindingNumber(
+      const int expansion_order = 2,
+      const int leaf_capacity = 16);
+    // Build for a triangle mesh
+    //
+    // Inputs:
+    //   V  #V by 3 list of mesh vertex positions
+    //   F  #F by 3 list of triangle indices into V
+    IGL_INLINE void build(const Eigen::MatrixXd & V, const Eigen::MatrixXi & F);
+    // Build for an oriented point cloud
+    //
+    // Inputs:
+    //   P  #P by 3 list of point locations
+    //   N  #P by 3 list of point normals
+    //   A  #P list of point areas
+    IGL_INLINE void build(
+      const Eigen::MatrixXd & P,
+      const Eigen::MatrixXd & N,
+      const Eigen::VectorXd & A);
+    // Winding number at each query point, in parallel
+    //
+    // Inputs:
+    //   Q  #Q by 3 list of query points
+    //   beta  Barnes-Hut accuracy parameter, a cell is approximated by its
+    //     expansion when farther than beta times its radius. Larger is more
+    //     accurate and slower, <= 0 sums all elements directly.
+    // Outputs:
+    //   W  #Q list of winding numbers
+    IGL_INLINE void winding_number(
+      const Eigen::MatrixXd & Q,
+      Eigen::VectorXd & W,
+      const double beta = 2) const;
+    IGL_INLINE double winding_number(
+      const Eigen::RowVector3d & q,
+      const double beta = 2) const;
+    // Number of elements
+    IGL_INLINE int size() const;
+  private:
+    typedef Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> MatrixX3R;
+    typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor>
+      MatrixXR;
+    struct Cell
+    {
+      // Elements begin ... end-1 (in tree order)
+      int begin;
+      int end;
+      // Children are first_child ... first_child+num_children-1
+      int first_child;
+      int num_children;
+    };
+    // Sort elements begin ... end-1 into cell c and its descendants
+    IGL_INLINE void build_cell(
+      const int c,
+      const Eigen::RowVector3d & center,
+      const double half_width,
+      std::vector<int> & order,
+      std::vector<int> & buffer);
+    // Build the cells, sort the elements into tree order and compute the
+    // expansions
+    IGL_INLINE void build_tree();
+    // Winding number of element e at q, summed directly
+    IGL_INLINE double element_winding_number(
+      const int e,
+      const Eigen::RowVector3d & q) const;
+    // Sum of the expansions of the given cells at q
+    IGL_INLINE double expansion_winding_number(
+      const std::vector<int> & far_cells,
+      const Eigen::RowVector3d & q) const;
+    // Winding number at q using stack and far_cells as scratch space
+    IGL_INLINE double winding_number(
+      const Eigen::RowVector3d & q,
+      const double beta,
+      std::vector<int> & stack,
+      std::vector<int> & far_cells) const;
+#if defined(__AVX__) || defined(__SSE2__)
+    // Winding numbers W(I[0]) ... W(I[n-1]) at the same rows of Q, n at
+    // most the number of SIMD lanes (4 with AVX, 2 with SSE2). The tree is
+    // walked once for all of them and the expansion of each far cell is
+    // evaluated at all of them at once, with the same result as one
+    // winding_number per query.
+    IGL_INLINE void winding_number_lanes(
+      const Eigen::MatrixXd & Q,
+      const int * I,
+      const int n,
+      const double beta,
+      std::vector<int> & stack,
+      std::vector<int> & far_cells,
+      Eigen::VectorXd & W) const;
+#endif
+    int expansion_order;
+    int leaf_capacity;
+    bool triangles;
+    // Per element, in tree order: dipole position, area, area times normal
+    // and (triangles only) corner positions
+    MatrixX3R P;
+    Eigen::VectorXd A;
+    MatrixX3R AN;
+    MatrixXR T;
+    std::vector<Cell> cells;
+    // Per cell: center of mass, radius and expansion coefficients
+    MatrixX3R CM;
+    Eigen::VectorXd R;
+    MatrixXR EC;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "FastWindingNumber.cpp"
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 The libigl contributors
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "GeodesicService.h"
+#include "fast_marching.h"
+#include "parallel_for.h"
+#include "vertex_triangle_adjacency.h"
+
+IGL_INLINE void igl::GeodesicService::set_mesh(
+  const int id,
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F)
+{
+  meshes.erase(id);
+  Entry & entry = meshes[id];
+  entry.V = V;
+  entry.F = F;
+  igl::vertex_triangle_adjacency(F,V.rows(),entry.VF,entry.NI);
+}
+
+IGL_INLINE bool igl::GeodesicService::has_mesh(const int id) const
+{
+  return meshes.count(id) > 0;
+}
+
+IGL_INLINE void igl::GeodesicService::erase_mesh(const int id)
+{
+  meshes.erase(id);
+}
+
+IGL_INLINE void igl::GeodesicService::clear()
+{
+  meshes.clear();
+}
+
+IGL_INLINE bool igl::GeodesicService::precompute(const int id)
+{
+  auto it = meshes.find(id);
+  if(it == meshes.end())
+  {
+    return false;
+  }
+  Entry & entry = it->second;
+  if(!entry.heat_ready)
+  {
+    entry.heat_ready = 
+      igl::heat_geodesics_precompute(entry.V,entry.F,entry.heat);
+  }
+  return entry.heat_ready;
+}
+
+IGL_INLINE bool igl::GeodesicService::distances(
+  const int id,
+  const std::vector<Eigen::VectorXi> & gammas,
+  Eigen::MatrixXd & D,
+  const Method method)
+{
+  auto it = meshes.find(id);
+  if(it == meshes.end())
+  {
+    return false;
+  }
+  Entry & entry = it->second;
+  switch(method)
+  {
+    case GEODESIC_HEAT:
+    {
+      if(!precompute(id))
+      {
+        return false;
+      }
+      igl::heat_geodesics_solve(entry.heat,gammas,D);
+      return true;
+    }
+    case GEODESIC_FAST_MARCHING:
+    {
+      D.resize(entry.V.rows(),gammas.size());
+      // Source sets are independent
+      igl::parallel_for(gammas.size(),[&](const int s)
+      {
+        Eigen::VectorXd Ds;
+        igl::fast_marching(entry.V,entry.F,entry.VF,entry.NI,gammas[s],Ds);
+        D.col(s) = Ds;
+      },2);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
@@ -0,0 +1,88 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 The libigl contributors
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_GEODESIC_SERVICE_H
+#define IGL_GEODESIC_SERVICE_H
+#include "igl_inline.h"
+#include "heat_geodesics.h"
+#include <Eigen/Core>
+#include <map>
+#include <vector>
+
+namespace igl
+{
+  // Answers repeated geodesic distance queries on a set of meshes. Per mesh
+  // it keeps the heat method factorizations (built on the first heat query)
+  // and the vertex-triangle adjacency used by fast marching, so that later
+  // queries only pay for back substitutions / marching.
+  //
+  // Example:
+  //   igl::GeodesicService geodesics;
+  //   geodesics.set_mesh(terrain_id,V,F);
+  //   // every frame
+  //   geodesics.distances(terrain_id,{snake_sources,target_sources},D);
+  class GeodesicService
+  {
+  public:
+    enum Method
+    {
+      // Heat method [Crane et al. 2013], all source sets in one multi-column
+      // solve
+      GEODESIC_HEAT = 0,
+      // Fast marching, approximate but without factorization
+      GEODESIC_FAST_MARCHING = 1
+    };
+    // Add or replace the mesh with the given id, dropping cached
+    // factorizations of a previous mesh with that id
+    //
+    // Inputs:
+    //   id  caller chosen mesh identifier
+    //   V  #V by 3 list of mesh vertex positions
+    //   F  #F by 3 list of mesh face indices into V
+    IGL_INLINE void set_mesh(
+      const int id,
+      const Eigen::MatrixXd & V,
+      const Eigen::MatrixXi & F);
+    IGL_INLINE bool has_mesh(const int id) const;
+    IGL_INLINE void erase_mesh(const int id);
+    IGL_INLINE void clear();
+    // Factorize the heat method solvers of a mesh now rather than on its
+    // first heat query. Returns false on failure or unknown id.
+    IGL_INLINE bool precompute(const int id);
+    // Distances to several sets of source vertices
+    //
+    // Inputs:
+    //   id  mesh identifier
+    //   gammas  #sets list of lists of source vertex indices
+    //   method  see Method
+    // Outputs:
+    //   D  #V by #sets list of distances, column s to gammas[s]
+    // Returns false on failure or unknown id.
+    IGL_INLINE bool distances(
+      const int id,
+      const std::vector<Eigen::VectorXi> & gammas,
+      Eigen::MatrixXd & D,
+      const Method method = GEODESIC_HEAT);
+  private:
+    struct Entry
+    {
+      Eigen::MatrixXd V;
+      Eigen::MatrixXi F;
+      bool heat_ready = false;
+      HeatGeodesicsData<double> heat;
+      // Vertex-triangle adjacency (see vertex_triangle_adjacency)
+      Eigen::VectorXi VF,NI;
+    };
+    std::map<int,Entry> meshes;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "GeodesicService.cpp"
+#endif
+
+#endif
@@ -0,0 +1,522 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "PointIndex.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+
+namespace igl
+{
+  namespace point_index_detail
+  {
+    // Keeps the k smallest (squared distance, id) pairs offered to it in a
+    // max-heap, so the current k-th distance is always at the front
+    class BoundedQueue
+    {
+    public:
+      IGL_INLINE void reset(const int _k)
+      {
+        k = _k;
+        heap.clear();
+        heap.reserve(k);
+      }
+      IGL_INLINE double worst() const
+      {
+        return (int)heap.size() < k ?
+          std::numeric_limits<double>::infinity() : heap.front().first;
+      }
+      IGL_INLINE void offer(const double d, const int id)
+      {
+        if((int)heap.size() < k)
+        {
+          heap.emplace_back(d,id);
+          std::push_heap(heap.begin(),heap.end());
+        }else if(d < heap.front().first)
+        {
+          std::pop_heap(heap.begin(),heap.end());
+          heap.back() = std::make_pair(d,id);
+          std::push_heap(heap.begin(),heap.end());
+        }
+      }
+      // Sort nearest first, the queue is no longer a heap afterwards
+      IGL_INLINE const std::vector<std::pair<double,int> > & sorted()
+      {
+        std::sort_heap(heap.begin(),heap.end());
+        return heap;
+      }
+    private:
+      int k;
+      std::vector<std::pair<double,int> > heap;
+    };
+    // Per thread query buffers
+    struct QueryScratch
+    {
+      BoundedQueue queue;
+      // Cells left to visit with their squared distances
+      std::vector<std::pair<double,int> > stack;
+    };
+    IGL_INLINE int octant(const Eigen::Vector3d & p, const Eigen::Vector3d & c)
+    {
+      return (p(0) >= c(0) ? 1 : 0) + (p(1) >= c(1) ? 2 : 0) +
+        (p(2) >= c(2) ? 4 : 0);
+    }
+  }
+}
+
+IGL_INLINE igl::PointIndex::PointIndex(const int _leaf_capacity):
+  leaf_capacity(std::max(_leaf_capacity,1)),
+  root(-1),
+  num_points(0)
+{
+}
+
+IGL_INLINE void igl::PointIndex::build(const Eigen::MatrixXd & P)
+{
+  clear();
+  if(P.rows() == 0)
+  {
+    return;
+  }
+  assert(P.leftCols(3).allFinite() && "points must be finite");
+  const Eigen::Vector3d min_corner = P.leftCols(3).colwise().minCoeff();
+  const Eigen::Vector3d max_corner = P.leftCols(3).colwise().maxCoeff();
+  Cell cell;
+  cell.center = 0.5*(min_corner+max_corner);
+  cell.half_width = 0.5*(max_corner-min_corner).maxCoeff();
+  if(!(cell.half_width > 0))
+  {
+    cell.half_width = 1;
+  }
+  cell.parent = -1;
+  cell.first_child = -1;
+  cell.count = 0;
+  root = 0;
+  cells.push_back(cell);
+  points.resize(P.rows());
+  leaf.resize(P.rows());
+  for(int i = 0;i<P.rows();i++)
+  {
+    points[i] = P.row(i).head<3>().transpose();
+    place(i);
+  }
+  num_points = P.rows();
+}
+
+IGL_INLINE void igl::PointIndex::clear()
+{
+  root = -1;
+  num_points = 0;
+  cells.clear();
+  points.clear();
+  leaf.clear();
+  free_ids.clear();
+  free_blocks.clear();
+}
+
+IGL_INLINE int igl::PointIndex::insert(const Eigen::RowVector3d & p)
+{
+  if(!p.allFinite())
+  {
+    return -1;
+  }
+  int id;
+  if(free_ids.empty())
+  {
+    id = points.size();
+    points.push_back(p.transpose());
+    leaf.push_back(-1);
+  }else
+  {
+    id = free_ids.back();
+    free_ids.pop_back();
+    points[id] = p.transpose();
+  }
+  enclose(points[id]);
+  place(id);
+  num_points++;
+  return id;
+}
+
+IGL_INLINE bool igl::PointIndex::remove(const int id)
+{
+  if(!contains(id))
+  {
+    return false;
+  }
+  unplace(id);
+  leaf[id] = -1;
+  free_ids.push_back(id);
+  num_points--;
+  return true;
+}
+
+IGL_INLINE bool igl::PointIndex::update(
+  const int id,
+  const Eigen::RowVector3d & p)
+{
+  if(!contains(id) || !p.allFinite())
+  {
+    return false;
+  }
+  points[id] = p.transpose();
+  // Still inside its leaf: nothing to restructure
+  if(cell_contains(cells[leaf[id]],points[id]))
+  {
+    return true;
+  }
+  unplace(id);
+  enclose(points[id]);
+  place(id);
+  return true;
+}
+
+IGL_INLINE void igl::PointIndex::update(const Eigen::MatrixXd & P)
+{
+  for(int i = 0;i<P.rows();i++)
+  {
+    update(i,P.row(i).head<3>());
+  }
+}
+
+IGL_INLINE int igl::PointIndex::size() const
+{
+  return num_points;
+}
+
+IGL_INLINE bool igl::PointIndex::contains(const int id) const
+{
+  return id >= 0 && id < (int)leaf.size() && leaf[id] >= 0;
+}
+
+IGL_INLINE Eigen::RowVector3d igl::PointIndex::point(const int id) const
+{
+  return points[id].transpose();
+}
+
+IGL_INLINE void igl::PointIndex::knn(
+  const Eigen::MatrixXd & Q,
+  const int k,
+  Eigen::MatrixXi & I,
+  Eigen::MatrixXd & sqrD) const
+{
+  using namespace point_index_detail;
+  I.setConstant(Q.rows(),std::max(k,0),-1);
+  sqrD.setConstant(
+    Q.rows(),std::max(k,0),std::numeric_limits<double>::infinity());
+  if(k <= 0 || root < 0)
+  {
+    return;
+  }
+  std::vector<QueryScratch> scratch;
+  igl::parallel_for(
+    Q.rows(),
+    [&](const size_t nt){ scratch.resize(nt); },
+    [&](const int q, const size_t t)
+    {
+      const Eigen::Vector3d query = Q.row(q).head<3>().transpose();
+      BoundedQueue & queue = scratch[t].queue;
+      std::vector<std::pair<double,int> > & stack = scratch[t].stack;
+      queue.reset(k);
+      stack.clear();
+      stack.emplace_back(cell_squared_distance(query,cells[root]),root);
+      while(!stack.empty())
+      {
+        const std::pair<double,int> top = stack.back();
+        stack.pop_back();
+        const Cell & cell = cells[top.second];
+        if(cell.count == 0 || top.first >= queue.worst())
+        {
+          continue;
+        }
+        if(cell.first_child < 0)
+        {
+          for(const int id : cell.points)
+          {
+            queue.offer((points[id]-query).squaredNorm(),id);
+          }
+          continue;
+        }
+        // Push the far children first so the nearest is visited next
+        const size_t begin = stack.size();
+        for(int c = cell.first_child;c<cell.first_child+8;c++)
+        {
+          if(cells[c].count > 0)
+          {
+            stack.emplace_back(cell_squared_distance(query,cells[c]),c);
+          }
+        }
+        std::sort(
+          stack.begin()+begin,stack.end(),
+          [](const std::pair<double,int> & a, const std::pair<double,int> & b)
+          {
+            return a.first > b.first;
+          });
+      }
+      const std::vector<std::pair<double,int> > & found = queue.sorted();
+      for(int j = 0;j<(int)found.size();j++)
+      {
+        sqrD(q,j) = found[j].first;
+        I(q,j) = found[j].second;
+      }
+    },
+    [](const size_t){},
+    1000);
+}
+
+IGL_INLINE void igl::PointIndex::radius_search(
+  const Eigen::MatrixXd & Q,
+  const double radius,
+  std::vector<std::vector<int> > & I) const
+{
+  using namespace point_index_detail;
+  I.resize(Q.rows());
+  const double sqr_radius = radius*radius;
+  std::vector<QueryScratch> scratch;
+  igl::parallel_for(
+    Q.rows(),
+    [&](const size_t nt){ scratch.resize(nt); },
+    [&](const int q, const size_t t)
+    {
+      I[q].clear();
+      if(root < 0 || radius < 0)
+      {
+        return;
+      }
+      const Eigen::Vector3d query = Q.row(q).head<3>().transpose();
+      std::vector<std::pair<double,int> > & stack = scratch[t].stack;
+      stack.clear();
+      stack.emplace_back(0,root);
+      while(!stack.empty())
+      {
+        const Cell & cell = cells[stack.back().second];
+        stack.pop_back();
+        if(cell.count == 0 || cell_squared_distance(query,cell) > sqr_radius)
+        {
+          continue;
+        }
+        if(cell.first_child < 0)
+        {
+          for(const int id : cell.points)
+          {
+            if((points[id]-query).squaredNorm() <= sqr_radius)
+            {
+              I[q].push_back(id);
+            }
+          }
+          continue;
+        }
+        for(int c = cell.first_child;c<cell.first_child+8;c++)
+        {
+          stack.emplace_back(0,c);
+        }
+      }
+    },
+    [](const size_t){},
+    1000);
+}
+
+IGL_INLINE double igl::PointIndex::cell_squared_distance(
+  const Eigen::Vector3d & q,
+  const Cell & cell) const
+{
+  return ((q-cell.center).cwiseAbs().array()-cell.half_width).
+    cwiseMax(0).matrix().squaredNorm();
+}
+
+IGL_INLINE bool igl::PointIndex::cell_contains(
+  const Cell & cell,
+  const Eigen::Vector3d & p) const
+{
+  return (p-cell.center).cwiseAbs().maxCoeff() <= cell.half_width;
+}
+
+IGL_INLINE void igl::PointIndex::enclose(const Eigen::Vector3d & p)
+{
+  // No root contains a non-finite point, it would grow forever
+  assert(p.allFinite());
+  if(root < 0)
+  {
+    Cell cell;
+    cell.center = p;
+    cell.half_width = 1;
+    cell.parent = -1;
+    cell.first_child = -1;
+    cell.count = 0;
+    root = cells.size();
+    cells.push_back(cell);
+    return;
+  }
+  while(!cell_contains(cells[root],p))
+  {
+    // Double the root towards p. The old root becomes a child of the new
+    // one, which takes over its slot.
+    const Eigen::Vector3d old_center = cells[root].center;
+    const double h = cells[root].half_width;
+    Eigen::Vector3d center;
+    for(int d = 0;d<3;d++)
+    {
+      center(d) = old_center(d) + (p(d) >= old_center(d) ? h : -h);
+    }
+    const int first = allocate_block();
+    const int moved = first + point_index_detail::octant(old_center,center);
+    for(int c = 0;c<8;c++)
+    {
+      Cell & child = cells[first+c];
+      child.center = center;
+      for(int d = 0;d<3;d++)
+      {
+        child.center(d) += (c>>d)&1 ? h : -h;
+      }
+      child.half_width = h;
+      child.parent = root;
+      child.first_child = -1;
+      child.count = 0;
+      child.points.clear();
+    }
+    std::swap(cells[moved],cells[root]);
+    Cell & old_root = cells[moved];
+    old_root.parent = root;
+    if(old_root.first_child < 0)
+    {
+      for(const int id : old_root.points)
+      {
+        leaf[id] = moved;
+      }
+    }else
+    {
+      for(int c = old_root.first_child;c<old_root.first_child+8;c++)
+      {
+        cells[c].parent = moved;
+      }
+    }
+    Cell & new_root = cells[root];
+    new_root.center = center;
+    new_root.half_width = 2*h;
+    new_root.parent = -1;
+    new_root.first_child = first;
+    new_root.count = old_root.count;
+    new_root.points.clear();
+  }
+}
+
+IGL_INLINE void igl::PointIndex::place(const int id)
+{
+  const Eigen::Vector3d & p = points[id];
+  int c = root;
+  while(cells[c].first_child >= 0)
+  {
+    cells[c].count++;
+    c = cells[c].first_child + point_index_detail::octant(p,cells[c].center);
+  }
+  cells[c].count++;
+  cells[c].points.push_back(id);
+  leaf[id] = c;
+  if((int)cells[c].points.size() > leaf_capacity)
+  {
+    split(c);
+  }
+}
+
+IGL_INLINE void igl::PointIndex::unplace(const int id)
+{
+  std::vector<int> & bucket = cells[leaf[id]].points;
+  *std::find(bucket.begin(),bucket.end(),id) = bucket.back();
+  bucket.pop_back();
+  for(int c = leaf[id];c >= 0;c = cells[c].parent)
+  {
+    cells[c].count--;
+  }
+  // Merge sparse subtrees back into leaves, so cells do not pile up where
+  // points have passed through
+  for(int c = cells[leaf[id]].parent;c >= 0;c = cells[c].parent)
+  {
+    Cell & cell = cells[c];
+    if(cell.count > leaf_capacity/2)
+    {
+      break;
+    }
+    for(int child = cell.first_child;child<cell.first_child+8;child++)
+    {
+      if(cells[child].first_child >= 0)
+      {
+        return;
+      }
+    }
+    for(int child = cell.first_child;child<cell.first_child+8;child++)
+    {
+      for(const int j : cells[child].points)
+      {
+        cell.points.push_back(j);
+        leaf[j] = c;
+      }
+      cells[child].points.clear();
+    }
+    free_blocks.push_back(cell.first_child);
+    cell.first_child = -1;
+  }
+}
+
+IGL_INLINE void igl::PointIndex::split(const int c)
+{
+  // Coincident points can not be separated, stop before the cells become
+  // degenerate
+  if(!(cells[c].half_width >
+    1e-12*std::max(1.0,cells[c].center.cwiseAbs().maxCoeff())))
+  {
+    return;
+  }
+  const int first = allocate_block();
+  Cell & cell = cells[c];
+  const double h = 0.5*cell.half_width;
+  for(int o = 0;o<8;o++)
+  {
+    Cell & child = cells[first+o];
+    child.center = cell.center;
+    for(int d = 0;d<3;d++)
+    {
+      child.center(d) += (o>>d)&1 ? h : -h;
+    }
+    child.half_width = h;
+    child.parent = c;
+    child.first_child = -1;
+    child.count = 0;
+    child.points.clear();
+  }
+  cell.first_child = first;
+  std::vector<int> bucket;
+  bucket.swap(cell.points);
+  for(const int id : bucket)
+  {
+    const int o = first + point_index_detail::octant(points[id],cell.center);
+    cells[o].points.push_back(id);
+    cells[o].count++;
+    leaf[id] = o;
+  }
+  for(int o = first;o<first+8;o++)
+  {
+    if((int)cells[o].points.size() > leaf_capacity)
+    {
+      split(o);
+    }
+  }
+}
+
+IGL_INLINE int igl::PointIndex::allocate_block()
+{
+  if(!free_blocks.empty())
+  {
+    const int first = free_blocks.back();
+    free_blocks.pop_back();
+    return first;
+  }
+  const int first = cells.size();
+  cells.resize(cells.size()+8);
+  return first;
+}
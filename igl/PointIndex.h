@@ -0,0 +1,134 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_POINT_INDEX_H
+#define IGL_POINT_INDEX_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <vector>
+
+namespace igl
+{
+  // Persistent spatial index over a changing set of 3D points, for repeated
+  // k-nearest-neighbour and radius queries. Points live in the buckets of an
+  // octree (see octree) that is refined as buckets overflow and grown when
+  // points leave its root cell. Moving a point within its leaf cell only
+  // overwrites its position, so tracking slowly moving points does not
+  // restructure the tree.
+  //
+  // Queries are const and may run concurrently; batch queries are
+  // parallelized over the query points. Modifications must not run
+  // concurrently with anything else.
+  //
+  // Example:
+  //   igl::PointIndex index;
+  //   index.build(P);
+  //   // every frame
+  //   index.update(P);
+  //   index.knn(Q,8,I,sqrD);
+  class PointIndex
+  {
+  public:
+    // Inputs:
+    //   leaf_capacity  number of points a leaf holds before it is split
+    IGL_INLINE PointIndex(const int leaf_capacity = 16);
+    // Replace all points, point i of P gets id i
+    //
+    // Inputs:
+    //   P  #P by 3 list of finite point positions
+    IGL_INLINE void build(const Eigen::MatrixXd & P);
+    IGL_INLINE void clear();
+    // Add a point. Returns its id, ids of removed points are reused. Returns
+    // -1 and adds nothing if p is not finite.
+    IGL_INLINE int insert(const Eigen::RowVector3d & p);
+    // Returns false if id is not in the index
+    IGL_INLINE bool remove(const int id);
+    // Move a point. Returns false, leaving the point where it was, if id is
+    // not in the index or p is not finite
+    IGL_INLINE bool update(const int id, const Eigen::RowVector3d & p);
+    // Move the points with ids 0 to #P-1, which must all be in the index.
+    // Rows that are not finite are skipped.
+    //
+    // Inputs:
+    //   P  #P by 3 list of new point positions
+    IGL_INLINE void update(const Eigen::MatrixXd & P);
+    // Number of points in the index
+    IGL_INLINE int size() const;
+    IGL_INLINE bool contains(const int id) const;
+    IGL_INLINE Eigen::RowVector3d point(const int id) const;
+    // The k nearest points to each query point
+    //
+    // Inputs:
+    //   Q  #Q by 3 list of query points
+    //   k  number of neighbours
+    // Outputs:
+    //   I  #Q by k list of point ids, nearest first, -1 where fewer than k
+    //     points are in the index
+    //   sqrD  #Q by k list of squared distances (infinity where I is -1)
+    IGL_INLINE void knn(
+      const Eigen::MatrixXd & Q,
+      const int k,
+      Eigen::MatrixXi & I,
+      Eigen::MatrixXd & sqrD) const;
+    // All points within a distance of each query point
+    //
+    // Inputs:
+    //   Q  #Q by 3 list of query points
+    //   radius  search radius
+    // Outputs:
+    //   I  #Q list of lists of ids of the points within radius of each
+    //     query point, in no particular order
+    IGL_INLINE void radius_search(
+      const Eigen::MatrixXd & Q,
+      const double radius,
+      std::vector<std::vector<int> > & I) const;
+  private:
+    struct Cell
+    {
+      Eigen::Vector3d center;
+      double half_width;
+      int parent;
+      // Children are first_child ... first_child+7, numbered by octant as in
+      // octree, -1 for leaves
+      int first_child;
+      // Number of points in the subtree
+      int count;
+      // Ids of the points of a leaf
+      std::vector<int> points;
+    };
+    // Squared distance from q to the cell, 0 inside
+    IGL_INLINE double cell_squared_distance(
+      const Eigen::Vector3d & q,
+      const Cell & cell) const;
+    IGL_INLINE bool cell_contains(const Cell & cell, const Eigen::Vector3d & p) const;
+    // Grow the root until it contains p, which must be finite
+    IGL_INLINE void enclose(const Eigen::Vector3d & p);
+    // Add point id to the tree below the root
+    IGL_INLINE void place(const int id);
+    // Remove point id from its leaf and the counts of its ancestors, merging
+    // subtrees that became sparse
+    IGL_INLINE void unplace(const int id);
+    IGL_INLINE void split(const int c);
+    // Index of 8 consecutive cells, reusing those of merged subtrees
+    IGL_INLINE int allocate_block();
+    int leaf_capacity;
+    int root;
+    int num_points;
+    std::vector<Cell> cells;
+    std::vector<Eigen::Vector3d> points;
+    // Leaf holding each id, -1 for free ids
+    std::vector<int> leaf;
+    std::vector<int> free_ids;
+    std::vector<int> free_blocks;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "PointIndex.cpp"
+#endif
+
+#endif
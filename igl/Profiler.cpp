@@ -0,0 +1,225 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "Profiler.h"
+#include "get_seconds_hires.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace igl
+{
+  namespace profiler_detail
+  {
+    struct ThreadState
+    {
+      int depth;
+      int id;
+    };
+    // Nesting depth and id of the calling thread
+    IGL_INLINE ThreadState & thread_state()
+    {
+      static std::atomic<int> next_id(0);
+      static thread_local ThreadState state = {0, next_id++};
+      return state;
+    }
+    IGL_INLINE double percentile(std::vector<double> & X, const double p)
+    {
+      if(X.empty())
+      {
+        return 0;
+      }
+      // Nearest rank
+      const double r = std::ceil(std::min(std::max(p,0.0),100.0)/100.0*X.size());
+      const size_t k = std::max<size_t>(1,static_cast<size_t>(r))-1;
+      std::nth_element(X.begin(),X.begin()+k,X.end());
+      return X[k];
+    }
+  }
+}
+
+IGL_INLINE igl::Profiler::Scope::Scope(const char * _name):
+  profiler(igl::profiler()),
+  name(_name),
+  begin(profiler.now())
+{
+  profiler_detail::thread_state().depth++;
+}
+
+IGL_INLINE igl::Profiler::Scope::Scope(Profiler & _profiler, const char * _name):
+  profiler(_profiler),
+  name(_name),
+  begin(profiler.now())
+{
+  profiler_detail::thread_state().depth++;
+}
+
+IGL_INLINE igl::Profiler::Scope::~Scope()
+{
+  const int depth = --profiler_detail::thread_state().depth;
+  profiler.record(name,begin,profiler.now(),depth);
+}
+
+IGL_INLINE igl::Profiler::Profiler(
+  const size_t _capacity,
+  const size_t frame_window):
+  enabled(true),
+  capacity(std::max<size_t>(_capacity,1)),
+  slots(new Slot[std::max<size_t>(_capacity,1)]),
+  head(0),
+  origin(get_seconds_hires()),
+  frame_times(std::max<size_t>(frame_window,1),0),
+  frame_count(0),
+  frame_begin(0)
+{
+  for(size_t s = 0;s<capacity;s++)
+  {
+    slots[s].seq.store(0,std::memory_order_relaxed);
+    slots[s].name.store(nullptr,std::memory_order_relaxed);
+    slots[s].begin.store(0,std::memory_order_relaxed);
+    slots[s].end.store(0,std::memory_order_relaxed);
+    slots[s].depth.store(0,std::memory_order_relaxed);
+    slots[s].thread.store(0,std::memory_order_relaxed);
+  }
+}
+
+IGL_INLINE double igl::Profiler::now() const
+{
+  return get_seconds_hires() - origin;
+}
+
+IGL_INLINE void igl::Profiler::record(
+  const char * name,
+  const double begin,
+  const double end,
+  const int depth)
+{
+  if(!enabled)
+  {
+    return;
+  }
+  const std::uint64_t i = head.fetch_add(1,std::memory_order_relaxed);
+  Slot & slot = slots[i%capacity];
+  // Mark as being written so that readers skip it
+  slot.seq.store(0,std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name,std::memory_order_relaxed);
+  slot.begin.store(begin,std::memory_order_relaxed);
+  slot.end.store(end,std::memory_order_relaxed);
+  slot.depth.store(depth,std::memory_order_relaxed);
+  slot.thread.store(profiler_detail::thread_state().id,std::memory_order_relaxed);
+  slot.seq.store(i+1,std::memory_order_release);
+}
+
+IGL_INLINE void igl::Profiler::begin_frame()
+{
+  frame_begin = now();
+  profiler_detail::thread_state().depth++;
+}
+
+IGL_INLINE void igl::Profiler::end_frame()
+{
+  const double end = now();
+  const int depth = --profiler_detail::thread_state().depth;
+  frame_times[frame_count%frame_times.size()] = end-frame_begin;
+  frame_count++;
+  record("frame",frame_begin,end,depth);
+}
+
+IGL_INLINE void igl::Profiler::events(std::vector<Event> & E) const
+{
+  E.clear();
+  const std::uint64_t end = head.load(std::memory_order_acquire);
+  const std::uint64_t begin = end > capacity ? end-capacity : 0;
+  E.reserve(static_cast<size_t>(end-begin));
+  for(std::uint64_t i = begin;i<end;i++)
+  {
+    const Slot & slot = slots[i%capacity];
+    if(slot.seq.load(std::memory_order_acquire) != i+1)
+    {
+      continue;
+    }
+    const Event e = {
+      slot.name.load(std::memory_order_relaxed),
+      slot.begin.load(std::memory_order_relaxed),
+      slot.end.load(std::memory_order_relaxed),
+      slot.depth.load(std::memory_order_relaxed),
+      slot.thread.load(std::memory_order_relaxed)};
+    // Keep the loads above before the second check of seq
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(slot.seq.load(std::memory_order_relaxed) != i+1)
+    {
+      continue;
+    }
+    E.push_back(e);
+  }
+}
+
+IGL_INLINE double igl::Profiler::frame_percentile(const double p) const
+{
+  const size_t n = std::min(frame_count,frame_times.size());
+  std::vector<double> X(frame_times.begin(),frame_times.begin()+n);
+  return profiler_detail::percentile(X,p);
+}
+
+IGL_INLINE double igl::Profiler::scope_percentile(
+  const char * name,
+  const double p) const
+{
+  std::vector<Event> E;
+  events(E);
+  std::vector<double> X;
+  for(const auto & e : E)
+  {
+    if(e.name == name || std::strcmp(e.name,name) == 0)
+    {
+      X.push_back(e.end-e.begin);
+    }
+  }
+  return profiler_detail::percentile(X,p);
+}
+
+IGL_INLINE bool igl::Profiler::write_chrome_trace(
+  const std::string & filename) const
+{
+  std::ofstream out(filename);
+  if(!out)
+  {
+    return false;
+  }
+  std::vector<Event> E;
+  events(E);
+  out<<"{\"traceEvents\":[";
+  out.precision(3);
+  out<<std::fixed;
+  for(size_t e = 0;e<E.size();e++)
+  {
+    out<<(e == 0 ? "\n" : ",\n")<<"{\"name\":\"";
+    for(const char * c = E[e].name;*c;c++)
+    {
+      if(*c == '"' || *c == '\\')
+      {
+        out<<'\\';
+      }
+      out<<*c;
+    }
+    // Complete events, timestamps in microseconds
+    out<<"\",\"ph\":\"X\",\"pid\":0,\"tid\":"<<E[e].thread<<
+      ",\"ts\":"<<1e6*E[e].begin<<
+      ",\"dur\":"<<1e6*(E[e].end-E[e].begin)<<
+      ",\"args\":{\"depth\":"<<E[e].depth<<"}}";
+  }
+  out<<"\n],\"displayTimeUnit\":\"ms\"}\n";
+  return out.good();
+}
+
+IGL_INLINE igl::Profiler & igl::profiler()
+{
+  static Profiler p;
+  return p;
+}
@@ -0,0 +1,131 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PROFILER_H
+#define IGL_PROFILER_H
+#include "igl_inline.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace igl
+{
+  // Lightweight hierarchical profiler. Timed scopes are stored as complete
+  // events (name, begin, end, nesting depth, thread) in a fixed size
+  // lock-free ring buffer, so recording never allocates or blocks and the
+  // oldest events are overwritten once the buffer wraps. Frame durations are
+  // kept in a separate rolling window for percentile queries.
+  //
+  // Example:
+  //   igl::profiler().begin_frame();
+  //   {
+  //     igl::Profiler::Scope scope("IK");
+  //     ...
+  //   }
+  //   igl::profiler().end_frame();
+  //   double p99 = igl::profiler().frame_percentile(99);
+  //   igl::profiler().write_chrome_trace("trace.json");
+  class Profiler
+  {
+  public:
+    struct Event
+    {
+      // Scope name, must outlive the profiler (e.g. a string literal)
+      const char * name;
+      // Seconds since the profiler was constructed
+      double begin;
+      double end;
+      // Nesting depth on the recording thread (frames are at depth 0)
+      int depth;
+      // Small per-thread id, in order of first use
+      int thread;
+    };
+    // Times its own lifetime and records it on destruction
+    class Scope
+    {
+    public:
+      IGL_INLINE Scope(const char * name);
+      IGL_INLINE Scope(Profiler & profiler, const char * name);
+      IGL_INLINE ~Scope();
+    private:
+      Scope(const Scope &);
+      Scope & operator=(const Scope &);
+      Profiler & profiler;
+      const char * name;
+      double begin;
+    };
+
+    // Inputs:
+    //   capacity  number of events kept in the ring buffer
+    //   frame_window  number of most recent frames used for percentiles
+    IGL_INLINE Profiler(
+      const size_t capacity = 1<<16,
+      const size_t frame_window = 256);
+    // Current time in seconds since construction
+    IGL_INLINE double now() const;
+    // Record a finished scope. Safe to call from any thread.
+    IGL_INLINE void record(
+      const char * name,
+      const double begin,
+      const double end,
+      const int depth);
+    // Mark the start/end of a frame on the calling thread. Scopes recorded
+    // in between are nested below a "frame" event.
+    IGL_INLINE void begin_frame();
+    IGL_INLINE void end_frame();
+    // Copy the events currently held by the ring buffer, oldest first.
+    // Events being overwritten while copying are skipped.
+    IGL_INLINE void events(std::vector<Event> & E) const;
+    // Percentile p in [0,100] of the frame durations (seconds) in the
+    // rolling window, 0 if no frame was recorded yet.
+    IGL_INLINE double frame_percentile(const double p) const;
+    // Percentile p in [0,100] of the durations of the buffered events
+    // called name.
+    IGL_INLINE double scope_percentile(const char * name, const double p) const;
+    // Write the buffered events as Chrome trace JSON (chrome://tracing,
+    // https://ui.perfetto.dev).
+    IGL_INLINE bool write_chrome_trace(const std::string & filename) const;
+    // Recording is skipped while false
+    bool enabled;
+  private:
+    Profiler(const Profiler &);
+    Profiler & operator=(const Profiler &);
+    // Seqlock slot. The event fields are relaxed atomics so that a reader
+    // racing with a writer of the same slot reads stale or torn values,
+    // which it then discards by checking seq again, instead of racing on
+    // plain memory.
+    struct Slot
+    {
+      // index+1 of the event held by this slot, 0 while being written
+      std::atomic<std::uint64_t> seq;
+      std::atomic<const char *> name;
+      std::atomic<double> begin;
+      std::atomic<double> end;
+      std::atomic<int> depth;
+      std::atomic<int> thread;
+    };
+    size_t capacity;
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<std::uint64_t> head;
+    double origin;
+    // Rolling window of frame durations, only touched by the frame thread
+    std::vector<double> frame_times;
+    size_t frame_count;
+    double frame_begin;
+  };
+  // Process wide profiler used by Profiler::Scope(name)
+  IGL_INLINE Profiler & profiler();
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "Profiler.cpp"
+#endif
+
+#endif
@@ -0,0 +1,351 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "ProgressiveMeshReader.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+IGL_INLINE igl::ProgressiveMeshReader::ProgressiveMeshReader()
+{
+  clear();
+}
+
+IGL_INLINE void igl::ProgressiveMeshReader::clear()
+{
+  m_state = STATE_HEADER;
+  m_buffer.clear();
+  m_pos = 0;
+  m_dim = 0;
+  m_num_base_vertices = 0;
+  m_num_base_faces = 0;
+  m_num_splits = -1;
+  m_n = 0;
+  m_m = 0;
+  m_VF.clear();
+  m_U.resize(0,0);
+  m_G.resize(0,3);
+  m_splits.clear();
+}
+
+IGL_INLINE bool igl::ProgressiveMeshReader::push(
+  const char * data,
+  const size_t size)
+{
+  if(m_state == STATE_FAILED)
+  {
+    return false;
+  }
+  if(m_state == STATE_DONE)
+  {
+    return true;
+  }
+  m_buffer.insert(m_buffer.end(),data,data+size);
+  while(true)
+  {
+    bool decoded = false;
+    switch(m_state)
+    {
+      case STATE_HEADER:
+        decoded = decode_header();
+        break;
+      case STATE_BASE:
+        decoded = decode_base();
+        break;
+      case STATE_SPLITS:
+        decoded = decode_split();
+        break;
+      default:
+        break;
+    }
+    if(!decoded)
+    {
+      break;
+    }
+  }
+  if(m_state == STATE_FAILED || m_state == STATE_DONE)
+  {
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_pos = 0;
+    return m_state == STATE_DONE;
+  }
+  // Keep only the incomplete tail
+  m_buffer.erase(m_buffer.begin(),m_buffer.begin()+m_pos);
+  m_pos = 0;
+  return true;
+}
+
+IGL_INLINE bool igl::ProgressiveMeshReader::has_base() const
+{
+  return m_state == STATE_SPLITS || m_state == STATE_DONE;
+}
+
+IGL_INLINE bool igl::ProgressiveMeshReader::done() const
+{
+  return m_state == STATE_DONE;
+}
+
+IGL_INLINE bool igl::ProgressiveMeshReader::failed() const
+{
+  return m_state == STATE_FAILED;
+}
+
+IGL_INLINE int igl::ProgressiveMeshReader::num_splits() const
+{
+  return m_num_splits;
+}
+
+IGL_INLINE const Eigen::MatrixXd &
+  igl::ProgressiveMeshReader::base_vertices() const
+{
+  return m_U;
+}
+
+IGL_INLINE const Eigen::MatrixXi &
+  igl::ProgressiveMeshReader::base_faces() const
+{
+  return m_G;
+}
+
+IGL_INLINE const std::vector<igl::VertexSplit> &
+  igl::ProgressiveMeshReader::splits() const
+{
+  return m_splits;
+}
+
+IGL_INLINE bool igl::ProgressiveMeshReader::decode_header()
+{
+  const char magic[6] = {'I','G','L','P','M',1};
+  const size_t available = m_buffer.size()-m_pos;
+  if(std::memcmp(
+    m_buffer.data()+m_pos,magic,available < 6 ? available : 6) != 0)
+  {
+    m_state = STATE_FAILED;
+    return false;
+  }
+  size_t pos = m_pos+6;
+  std::uint64_t header[4];
+  for(int h = 0;h<4;h++)
+  {
+    if(!read_varint(pos,header[h]))
+    {
+      return false;
+    }
+  }
+  const std::uint64_t max_int = std::numeric_limits<int>::max();
+  if(
+    header[0] == 0 || header[0] > 16 ||
+    header[1] > max_int || header[2] > max_int || header[3] > max_int)
+  {
+    m_state = STATE_FAILED;
+    return false;
+  }
+  m_dim = header[0];
+  m_num_base_vertices = header[1];
+  m_num_base_faces = header[2];
+  m_num_splits = header[3];
+  m_pos = pos;
+  m_state = STATE_BASE;
+  return true;
+}
+
+IGL_INLINE bool igl::ProgressiveMeshReader::decode_base()
+{
+  // Positions have a fixed size
+  if(m_buffer.size()-m_pos < size_t(4)*m_dim*m_num_base_vertices)
+  {
+    return false;
+  }
+  size_t pos = m_pos;
+  Eigen::MatrixXd U(m_num_base_vertices,m_dim);
+  for(int u = 0;u<U.rows();u++)
+  {
+    for(int d = 0;d<m_dim;d++)
+    {
+      read_float(pos,U(u,d));
+    }
+  }
+  Eigen::MatrixXi G(m_num_base_faces,3);
+  for(int g = 0;g<G.rows();g++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      std::uint64_t x;
+      if(!read_varint(pos,x))
+      {
+        return false;
+      }
+      if(x >= (std::uint64_t)m_num_base_vertices)
+      {
+        m_state = STATE_FAILED;
+        return false;
+      }
+      G(g,c) = x;
+    }
+  }
+  m_VF.assign(m_num_base_vertices,std::vector<int>());
+  for(int g = 0;g<G.rows();g++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      m_VF[G(g,c)].push_back(g);
+    }
+  }
+  m_U.swap(U);
+  m_G.swap(G);
+  m_n = m_num_base_vertices;
+  m_m = m_num_base_faces;
+  m_splits.reserve(m_num_splits);
+  m_pos = pos;
+  m_state = m_num_splits == 0 ? STATE_DONE : STATE_SPLITS;
+  return true;
+}
+
+IGL_INLINE bool igl::ProgressiveMeshReader::decode_split()
+{
+  size_t pos = m_pos;
+  VertexSplit split;
+  const int t = m_n;
+  std::uint64_t x;
+  if(!read_varint(pos,x))
+  {
+    return false;
+  }
+  if(x >= (std::uint64_t)m_n)
+  {
+    m_state = STATE_FAILED;
+    return false;
+  }
+  split.s = x;
+  split.s_position.resize(m_dim);
+  split.t_position.resize(m_dim);
+  for(int d = 0;d<m_dim;d++)
+  {
+    if(!read_float(pos,split.s_position(d)))
+    {
+      return false;
+    }
+  }
+  for(int d = 0;d<m_dim;d++)
+  {
+    if(!read_float(pos,split.t_position(d)))
+    {
+      return false;
+    }
+  }
+  // One bit per face incident on s
+  const std::vector<int> & Ls = m_VF[split.s];
+  if(pos+(Ls.size()+7)/8 > m_buffer.size())
+  {
+    return false;
+  }
+  for(size_t i = 0;i<Ls.size();i++)
+  {
+    if(m_buffer[pos+i/8] & (1<<(i%8)))
+    {
+      split.faces.push_back(Ls[i]);
+    }
+  }
+  pos += (Ls.size()+7)/8;
+  std::uint64_t num_new_faces;
+  if(!read_varint(pos,num_new_faces))
+  {
+    return false;
+  }
+  if(num_new_faces > 2)
+  {
+    m_state = STATE_FAILED;
+    return false;
+  }
+  split.new_faces.resize(num_new_faces,3);
+  for(int i = 0;i<(int)num_new_faces;i++)
+  {
+    if(!read_varint(pos,x))
+    {
+      return false;
+    }
+    const std::uint64_t o = x/2;
+    if(o >= (std::uint64_t)m_n || o == (std::uint64_t)split.s)
+    {
+      m_state = STATE_FAILED;
+      return false;
+    }
+    split.new_faces(i,0) = split.s;
+    split.new_faces(i,1) = x%2 ? int(o) : t;
+    split.new_faces(i,2) = x%2 ? t : int(o);
+  }
+  split.t_birth = -1;
+  split.new_faces_birth.setConstant(num_new_faces,-1);
+  // Only now that the split is complete, update the incident faces
+  std::vector<int> rest;
+  rest.reserve(Ls.size()-split.faces.size());
+  std::set_difference(
+    Ls.begin(),Ls.end(),split.faces.begin(),split.faces.end(),
+    std::back_inserter(rest));
+  m_VF[split.s].swap(rest);
+  m_VF.push_back(split.faces);
+  for(int i = 0;i<split.new_faces.rows();i++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      m_VF[split.new_faces(i,c)].push_back(m_m+i);
+    }
+  }
+  m_splits.push_back(std::move(split));
+  m_n++;
+  m_m += num_new_faces;
+  m_pos = pos;
+  if((int)m_splits.size() == m_num_splits)
+  {
+    m_state = STATE_DONE;
+  }
+  return true;
+}
+
+IGL_INLINE bool igl::ProgressiveMeshReader::read_varint(
+  size_t & pos,
+  std::uint64_t & x) const
+{
+  x = 0;
+  for(int shift = 0;shift<64;shift+=7)
+  {
+    if(pos >= m_buffer.size())
+    {
+      return false;
+    }
+    const unsigned char b = m_buffer[pos++];
+    x |= std::uint64_t(b & 0x7f) << shift;
+    if(!(b & 0x80))
+    {
+      return true;
+    }
+  }
+  // Too long, treat as the largest value so that range checks fail
+  x = std::numeric_limits<std::uint64_t>::max();
+  return true;
+}
+
+IGL_INLINE bool igl::ProgressiveMeshReader::read_float(
+  size_t & pos,
+  double & x) const
+{
+  if(pos+4 > m_buffer.size())
+  {
+    return false;
+  }
+  std::uint32_t u = 0;
+  for(int b = 0;b<4;b++)
+  {
+    u |= std::uint32_t(m_buffer[pos++]) << (8*b);
+  }
+  float f;
+  std::memcpy(&f,&u,sizeof(f));
+  x = f;
+  return true;
+}
@@ -0,0 +1,108 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PROGRESSIVEMESHREADER_H
+#define IGL_PROGRESSIVEMESHREADER_H
+#include "igl_inline.h"
+#include "VertexSplit.h"
+#include <Eigen/Core>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace igl
+{
+  // Incremental decoder of the .pm files written by writePM. Bytes are fed
+  // in whatever chunks they arrive in, e.g. from a socket, and are decoded as
+  // soon as the base mesh or a vertex split is complete, so that a client can
+  // show the base mesh and refine it (see progressive_mesh_refine) while the
+  // rest of the file is still downloading.
+  //
+  // Example:
+  //   igl::ProgressiveMeshReader reader;
+  //   Eigen::MatrixXd V;
+  //   Eigen::MatrixXi F;
+  //   int k = 0;
+  //   while(receive(chunk))
+  //   {
+  //     reader.push(chunk.data(),chunk.size());
+  //     if(V.rows() == 0 && reader.has_base())
+  //     {
+  //       V = reader.base_vertices();
+  //       F = reader.base_faces();
+  //     }
+  //     igl::progressive_mesh_refine(reader.splits(),max_m,V,F,k);
+  //   }
+  class ProgressiveMeshReader
+  {
+  public:
+    IGL_INLINE ProgressiveMeshReader();
+    // Forget everything read so far, to read another file
+    IGL_INLINE void clear();
+    // Decode the next bytes of the file
+    //
+    // Inputs:
+    //   data  pointer to size bytes
+    //   size  number of bytes
+    // Returns false if the file is malformed, in which case all further
+    // bytes are ignored
+    IGL_INLINE bool push(const char * data, const size_t size);
+    // Whether the base mesh has been decoded
+    IGL_INLINE bool has_base() const;
+    // Whether the base mesh and all the splits have been decoded
+    IGL_INLINE bool done() const;
+    // Whether the file was found to be malformed
+    IGL_INLINE bool failed() const;
+    // Number of splits announced by the header, -1 before it is decoded
+    IGL_INLINE int num_splits() const;
+    // #U by dim list of base vertex positions
+    IGL_INLINE const Eigen::MatrixXd & base_vertices() const;
+    // #G by 3 list of base face indices
+    IGL_INLINE const Eigen::MatrixXi & base_faces() const;
+    // Splits decoded so far, in order. Only grows as bytes are pushed.
+    IGL_INLINE const std::vector<VertexSplit> & splits() const;
+  private:
+    enum State
+    {
+      STATE_HEADER,
+      STATE_BASE,
+      STATE_SPLITS,
+      STATE_DONE,
+      STATE_FAILED
+    };
+    // Try to decode the next header, base mesh or split from m_buffer
+    // starting at m_pos. Returns false if more bytes are needed.
+    IGL_INLINE bool decode_header();
+    IGL_INLINE bool decode_base();
+    IGL_INLINE bool decode_split();
+    IGL_INLINE bool read_varint(size_t & pos, std::uint64_t & x) const;
+    IGL_INLINE bool read_float(size_t & pos, double & x) const;
+    State m_state;
+    // Bytes received but not decoded yet start at m_pos
+    std::vector<unsigned char> m_buffer;
+    size_t m_pos;
+    int m_dim;
+    int m_num_base_vertices;
+    int m_num_base_faces;
+    int m_num_splits;
+    // Size of the mesh refined by all splits decoded so far, to validate the
+    // next split
+    int m_n;
+    int m_m;
+    // Faces incident on each vertex, sorted by index
+    std::vector<std::vector<int> > m_VF;
+    Eigen::MatrixXd m_U;
+    Eigen::MatrixXi m_G;
+    std::vector<VertexSplit> m_splits;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "ProgressiveMeshReader.cpp"
+#endif
+
+#endif
@@ -0,0 +1,364 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "SparseSignedDistance.h"
+#include "AABB.h"
+#include "FastWindingNumber.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  // Floor division, a/b rounded towards -infinity
+  inline int floor_div(const int a, const int b)
+  {
+    return a >= 0 ? a/b : -((-a+b-1)/b);
+  }
+}
+
+IGL_INLINE igl::SparseSignedDistance::SparseSignedDistance(
+  const int block_width):
+  m_block_width(std::max(block_width,2)),
+  m_h(0),
+  m_band(0)
+{
+}
+
+IGL_INLINE void igl::SparseSignedDistance::build(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const double h,
+  const double band)
+{
+  clear();
+  m_h = h;
+  m_band = std::max(band,2.*h);
+  if(V.rows() == 0 || F.rows() == 0)
+  {
+    return;
+  }
+  const int w = m_block_width;
+  const int w3 = w*w*w;
+
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  igl::FastWindingNumber fwn;
+  fwn.build(V,F);
+
+  // Every lattice cube containing a vertex has all its corners in the band
+  for(int v = 0;v<V.rows();v++)
+  {
+    Eigen::RowVector3i ijk;
+    for(int d = 0;d<3;d++)
+    {
+      ijk(d) = int(std::floor(V(v,d)/h));
+    }
+    touch_block(Eigen::RowVector3i(
+      floor_div(ijk(0),w),floor_div(ijk(1),w),floor_div(ijk(2),w)));
+  }
+
+  const double band_sqr = m_band*m_band;
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  // Lattice coordinates of the l-th value
+  const auto sample = [&](const size_t l)->Eigen::RowVector3i
+  {
+    const int x = l%w3;
+    return m_blocks[l/w3]*w + Eigen::RowVector3i(x%w,(x/w)%w,x/(w*w));
+  };
+  // Evaluate the blocks allocated in the last wave, then allocate the
+  // neighbours they reach, until no new blocks are found
+  int first = 0;
+  while(first < (int)m_blocks.size())
+  {
+    const int last = m_blocks.size();
+    m_values.resize(size_t(last)*w3);
+    // Unsigned distances first, bounded by the band so that samples away
+    // from the surface stop early
+    igl::parallel_for((last-first)*w3,[&](const int s)
+    {
+      const size_t bl = size_t(first)*w3 + s;
+      const Eigen::RowVector3d p = h*sample(bl).cast<double>();
+      int i = -1;
+      Eigen::RowVector3d c;
+      const double sqrd = tree.squared_distance(V,F,p,band_sqr,i,c);
+      m_values[bl] = i < 0 || sqrd >= band_sqr ? nan : float(std::sqrt(sqrd));
+    },1000);
+    // Then signs. Two neighbouring samples have the same sign if either is
+    // farther than h from the surface (the ball around it reaches the other
+    // without crossing the surface), so the samples of a block fall into a
+    // few components of equal sign and only one winding number per component
+    // is needed.
+    const float trusted = float(1.0001*h);
+    std::vector<int> component(size_t(last-first)*w3,-1);
+    std::vector<std::vector<int> > seeds(last-first);
+    igl::parallel_for(last-first,[&](const int bb)
+    {
+      const size_t offset = size_t(first+bb)*w3;
+      int * label = component.data() + size_t(bb)*w3;
+      std::vector<int> stack;
+      for(int l = 0;l<w3;l++)
+      {
+        if(label[l] >= 0 || std::isnan(m_values[offset+l]))
+        {
+          continue;
+        }
+        const int id = seeds[bb].size();
+        seeds[bb].push_back(l);
+        label[l] = id;
+        stack.push_back(l);
+        while(!stack.empty())
+        {
+          const int u = stack.back();
+          stack.pop_back();
+          const float du = m_values[offset+u];
+          const int x[3] = {u%w,(u/w)%w,u/(w*w)};
+          for(int d = 0;d<3;d++)
+          {
+            for(int e = -1;e<=1;e+=2)
+            {
+              if(x[d]+e < 0 || x[d]+e >= w)
+              {
+                continue;
+              }
+              const int v = u + e*(d==0?1:(d==1?w:w*w));
+              const float dv = m_values[offset+v];
+              if(label[v] >= 0 || std::isnan(dv) || std::max(du,dv) <= trusted)
+              {
+                continue;
+              }
+              label[v] = id;
+              stack.push_back(v);
+            }
+          }
+        }
+      }
+    },1);
+    std::vector<int> seed_offset(last-first+1,0);
+    for(int bb = 0;bb<last-first;bb++)
+    {
+      seed_offset[bb+1] = seed_offset[bb] + seeds[bb].size();
+    }
+    Eigen::MatrixXd Q(seed_offset.back(),3);
+    for(int bb = 0;bb<last-first;bb++)
+    {
+      for(int k = 0;k<(int)seeds[bb].size();k++)
+      {
+        Q.row(seed_offset[bb]+k) =
+          h*sample(size_t(first+bb)*w3+seeds[bb][k]).cast<double>();
+      }
+    }
+    Eigen::VectorXd W;
+    fwn.winding_number(Q,W);
+    for(size_t s = 0;s<component.size();s++)
+    {
+      if(component[s] >= 0 && W(seed_offset[s/w3]+component[s]) > 0.5)
+      {
+        m_values[size_t(first)*w3+s] = -m_values[size_t(first)*w3+s];
+      }
+    }
+    for(int b = first;b<last;b++)
+    {
+      const Eigen::RowVector3i block = m_blocks[b];
+      for(int l = 0;l<w3;l++)
+      {
+        if(std::isnan(m_values[size_t(b)*w3+l]))
+        {
+          continue;
+        }
+        const int x[3] = {l%w,(l/w)%w,l/(w*w)};
+        int lo[3],hi[3];
+        for(int d = 0;d<3;d++)
+        {
+          lo[d] = x[d] == 0 ? -1 : 0;
+          hi[d] = x[d] == w-1 ? 1 : 0;
+        }
+        for(int dz = lo[2];dz<=hi[2];dz++)
+        {
+          for(int dy = lo[1];dy<=hi[1];dy++)
+          {
+            for(int dx = lo[0];dx<=hi[0];dx++)
+            {
+              if(dx != 0 || dy != 0 || dz != 0)
+              {
+                touch_block(block+Eigen::RowVector3i(dx,dy,dz));
+              }
+            }
+          }
+        }
+      }
+    }
+    first = last;
+  }
+
+  // Drop the blocks that turned out to lie entirely outside the band
+  int kept = 0;
+  m_block_index.clear();
+  for(int b = 0;b<(int)m_blocks.size();b++)
+  {
+    const auto begin = m_values.begin()+size_t(b)*w3;
+    if(std::all_of(begin,begin+w3,[](const float s){ return std::isnan(s); }))
+    {
+      continue;
+    }
+    if(kept != b)
+    {
+      m_blocks[kept] = m_blocks[b];
+      std::copy(begin,begin+w3,m_values.begin()+size_t(kept)*w3);
+    }
+    m_block_index[block_key(m_blocks[kept])] = kept;
+    kept++;
+  }
+  m_blocks.resize(kept);
+  m_values.resize(size_t(kept)*w3);
+  m_blocks.shrink_to_fit();
+  m_values.shrink_to_fit();
+}
+
+IGL_INLINE void igl::SparseSignedDistance::clear()
+{
+  m_block_index.clear();
+  m_blocks.clear();
+  m_values.clear();
+}
+
+IGL_INLINE double igl::SparseSignedDistance::spacing() const
+{
+  return m_h;
+}
+
+IGL_INLINE double igl::SparseSignedDistance::band() const
+{
+  return m_band;
+}
+
+IGL_INLINE int igl::SparseSignedDistance::block_width() const
+{
+  return m_block_width;
+}
+
+IGL_INLINE int igl::SparseSignedDistance::num_blocks() const
+{
+  return m_blocks.size();
+}
+
+IGL_INLINE Eigen::RowVector3i igl::SparseSignedDistance::block_origin(
+  const int b) const
+{
+  return m_blocks[b]*m_block_width;
+}
+
+IGL_INLINE bool igl::SparseSignedDistance::value(
+  const Eigen::RowVector3i & ijk,
+  double & s) const
+{
+  const int w = m_block_width;
+  const int b = find_block(Eigen::RowVector3i(
+    floor_div(ijk(0),w),floor_div(ijk(1),w),floor_div(ijk(2),w)));
+  if(b < 0)
+  {
+    return false;
+  }
+  const Eigen::RowVector3i x = ijk - m_blocks[b]*w;
+  s = m_values[size_t(b)*w*w*w + x(0) + w*(x(1) + w*x(2))];
+  return !std::isnan(s);
+}
+
+IGL_INLINE void igl::SparseSignedDistance::block_cubes(
+  const int b,
+  Eigen::VectorXd & S,
+  Eigen::MatrixXd & GV,
+  Eigen::MatrixXi & GI) const
+{
+  const int w = m_block_width;
+  const int w3 = w*w*w;
+  const int n = w+1;
+  // This block and the 7 neighbours holding the far faces of its cubes
+  int neighbours[8];
+  for(int o = 0;o<8;o++)
+  {
+    neighbours[o] = find_block(
+      m_blocks[b]+Eigen::RowVector3i(o&1,(o>>1)&1,(o>>2)&1));
+  }
+  const Eigen::RowVector3i origin = m_blocks[b]*w;
+  S.resize(n*n*n);
+  GV.resize(n*n*n,3);
+  for(int z = 0;z<n;z++)
+  {
+    for(int y = 0;y<n;y++)
+    {
+      for(int x = 0;x<n;x++)
+      {
+        const int s = x + n*(y + n*z);
+        const int o = (x==w) | ((y==w)<<1) | ((z==w)<<2);
+        const int nb = neighbours[o];
+        S(s) = nb < 0 ?
+          std::numeric_limits<double>::quiet_NaN() :
+          double(m_values[size_t(nb)*w3 + x%w + w*(y%w + w*(z%w))]);
+        GV.row(s) = m_h*(origin+Eigen::RowVector3i(x,y,z)).cast<double>();
+      }
+    }
+  }
+  const int offsets[8] =
+    {0,1,1+n,n,n*n,1+n*n,1+n+n*n,n+n*n};
+  GI.resize(w3,8);
+  int num_cubes = 0;
+  for(int z = 0;z<w;z++)
+  {
+    for(int y = 0;y<w;y++)
+    {
+      for(int x = 0;x<w;x++)
+      {
+        const int s = x + n*(y + n*z);
+        bool in_band = true;
+        for(int c = 0;c<8 && in_band;c++)
+        {
+          in_band = !std::isnan(S(s+offsets[c]));
+        }
+        if(!in_band)
+        {
+          continue;
+        }
+        for(int c = 0;c<8;c++)
+        {
+          GI(num_cubes,c) = s+offsets[c];
+        }
+        num_cubes++;
+      }
+    }
+  }
+  GI.conservativeResize(num_cubes,8);
+}
+
+IGL_INLINE std::int64_t igl::SparseSignedDistance::block_key(
+  const Eigen::RowVector3i & c)
+{
+  // 21 bits per coordinate
+  const std::int64_t offset = std::int64_t(1)<<20;
+  const std::int64_t mask = (std::int64_t(1)<<21)-1;
+  return
+    ((c(0)+offset)&mask) |
+    (((c(1)+offset)&mask)<<21) |
+    (((c(2)+offset)&mask)<<42);
+}
+
+IGL_INLINE int igl::SparseSignedDistance::find_block(
+  const Eigen::RowVector3i & c) const
+{
+  const auto it = m_block_index.find(block_key(c));
+  return it == m_block_index.end() ? -1 : it->second;
+}
+
+IGL_INLINE void igl::SparseSignedDistance::touch_block(
+  const Eigen::RowVector3i & c)
+{
+  if(m_block_index.emplace(block_key(c),int(m_blocks.size())).second)
+  {
+    m_blocks.push_back(c);
+  }
+}
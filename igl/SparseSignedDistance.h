@@ -0,0 +1,107 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SPARSESIGNEDDISTANCE_H
+#define IGL_SPARSESIGNEDDISTANCE_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace igl
+{
+  // Signed distance to a triangle mesh sampled on a regular lattice, but only
+  // within a narrow band around the surface. The lattice is split into cubic
+  // blocks of block_width^3 samples which are allocated on demand and found
+  // through a hash map, so memory and time scale with the area of the surface
+  // rather than the volume of its bounding box.
+  //
+  // Like sparse_voxel_grid, the band is found by growing outwards from the
+  // surface: blocks are seeded at the mesh vertices and a block's neighbour
+  // is visited whenever a sample next to it lies in the band. Samples are
+  // evaluated in parallel, their distance with an AABB query bounded by the
+  // band and their sign with a FastWindingNumber, queried once per region of
+  // a block that provably has a single sign.
+  //
+  // Example:
+  //   igl::SparseSignedDistance sdf;
+  //   sdf.build(V,F,bbox_side/1024.,0.01*bbox_side);
+  //   // offset surface, see copyleft::marching_cubes
+  //   igl::copyleft::marching_cubes(sdf,0.005*bbox_side,SV,SF);
+  class SparseSignedDistance
+  {
+  public:
+    // Inputs:
+    //   block_width  number of samples along each side of a block
+    IGL_INLINE SparseSignedDistance(const int block_width = 8);
+    // Inputs:
+    //   V  #V by 3 list of mesh vertex positions
+    //   F  #F by 3 list of triangle indices into V, ideally watertight
+    //   h  lattice spacing, sample (i,j,k) is at h*(i,j,k)
+    //   band  half width of the band, at least 2*h. To extract the
+    //     isosurface at value iso the band should be at least |iso|+2*h.
+    IGL_INLINE void build(
+      const Eigen::MatrixXd & V,
+      const Eigen::MatrixXi & F,
+      const double h,
+      const double band);
+    IGL_INLINE void clear();
+    IGL_INLINE double spacing() const;
+    IGL_INLINE double band() const;
+    IGL_INLINE int block_width() const;
+    // Number of allocated blocks
+    IGL_INLINE int num_blocks() const;
+    // Lattice coordinates of the first sample of block b
+    IGL_INLINE Eigen::RowVector3i block_origin(const int b) const;
+    // Signed distance at a lattice sample
+    //
+    // Inputs:
+    //   ijk  lattice coordinates
+    // Outputs:
+    //   s  signed distance (negative inside)
+    // Returns false if the sample is outside the band
+    IGL_INLINE bool value(const Eigen::RowVector3i & ijk, double & s) const;
+    // The lattice cubes whose first corner lies in block b and whose 8 corners
+    // are in the band, in the form expected by the sparse overload of
+    // copyleft::marching_cubes. Every cube of the band belongs to exactly one
+    // block.
+    //
+    // Inputs:
+    //   b  block index
+    // Outputs:
+    //   S  (block_width+1)^3 list of sample values (NaN outside the band)
+    //   GV  (block_width+1)^3 by 3 list of sample positions
+    //   GI  #cubes by 8 list of indices into S, corners ordered as in
+    //     copyleft::marching_cubes
+    IGL_INLINE void block_cubes(
+      const int b,
+      Eigen::VectorXd & S,
+      Eigen::MatrixXd & GV,
+      Eigen::MatrixXi & GI) const;
+  private:
+    IGL_INLINE static std::int64_t block_key(const Eigen::RowVector3i & c);
+    // Index of the block with block coordinates c, -1 if not allocated
+    IGL_INLINE int find_block(const Eigen::RowVector3i & c) const;
+    // Allocate the block with block coordinates c if needed
+    IGL_INLINE void touch_block(const Eigen::RowVector3i & c);
+    int m_block_width;
+    double m_h;
+    double m_band;
+    std::unordered_map<std::int64_t,int> m_block_index;
+    // Block coordinates of each block
+    std::vector<Eigen::RowVector3i> m_blocks;
+    // block_width^3 values per block, x fastest, NaN outside the band
+    std::vector<float> m_values;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "SparseSignedDistance.cpp"
+#endif
+
+#endif
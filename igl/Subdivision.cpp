@@ -0,0 +1,103 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "Subdivision.h"
+#include "loop.h"
+#include "parallel_for.h"
+#include "upsample.h"
+#include <cassert>
+
+IGL_INLINE igl::Subdivision::Subdivision()
+{
+}
+
+IGL_INLINE void igl::Subdivision::precompute(
+  const int n_verts,
+  const Eigen::MatrixXi & F,
+  const int number_of_subdivs,
+  const Scheme scheme)
+{
+  Eigen::SparseMatrix<double> S(n_verts,n_verts);
+  S.setIdentity();
+  m_F = F;
+  for(int i = 0;i<number_of_subdivs;i++)
+  {
+    const Eigen::MatrixXi Fi = m_F;
+    Eigen::SparseMatrix<double> Si;
+    switch(scheme)
+    {
+      case SUBDIVISION_UPSAMPLE:
+        upsample(int(S.rows()),Fi,Si,m_F);
+        break;
+      case SUBDIVISION_LOOP:
+      default:
+        loop(int(S.rows()),Fi,Si,m_F);
+        break;
+    }
+    S = Si*S;
+  }
+  m_S = S;
+  m_S.makeCompressed();
+}
+
+IGL_INLINE int igl::Subdivision::rows() const
+{
+  return m_S.rows();
+}
+
+IGL_INLINE int igl::Subdivision::num_faces() const
+{
+  return m_F.rows();
+}
+
+IGL_INLINE const Eigen::SparseMatrix<double,Eigen::RowMajor> &
+  igl::Subdivision::S() const
+{
+  return m_S;
+}
+
+template <typename DerivedV, typename DerivedNV>
+IGL_INLINE void igl::Subdivision::apply(
+  const Eigen::MatrixBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedNV> & NV) const
+{
+  assert(V.rows() == m_S.cols() && "V should match precompute");
+  typedef typename DerivedNV::Scalar Scalar;
+  const int dim = V.cols();
+  NV.resize(m_S.rows(),dim);
+  const int * outer = m_S.outerIndexPtr();
+  const int * inner = m_S.innerIndexPtr();
+  const double * value = m_S.valuePtr();
+  // Each refined vertex only reads its own row of stencils
+  igl::parallel_for(m_S.rows(),[&](const int i)
+  {
+    for(int d = 0;d<dim;d++)
+    {
+      double x = 0;
+      for(int k = outer[i];k<outer[i+1];k++)
+      {
+        x += value[k]*double(V(inner[k],d));
+      }
+      NV(i,d) = Scalar(x);
+    }
+  },1000);
+}
+
+template <typename DerivedNF>
+IGL_INLINE void igl::Subdivision::faces(
+  Eigen::PlainObjectBase<DerivedNF> & NF) const
+{
+  NF = m_F.cast<typename DerivedNF::Scalar>();
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::Subdivision::apply<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
+template void igl::Subdivision::apply<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 1, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 1, -1, -1> >&) const;
+template void igl::Subdivision::faces<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&) const;
+template void igl::Subdivision::faces<Eigen::Matrix<unsigned int, -1, -1, 1, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<unsigned int, -1, -1, 1, -1, -1> >&) const;
+#endif
@@ -0,0 +1,91 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SUBDIVISION_H
+#define IGL_SUBDIVISION_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+
+namespace igl
+{
+  // Repeated subdivision of a mesh whose topology is fixed but whose vertices
+  // move, e.g. an animated cage. The stencils of all levels are multiplied
+  // into a single sparse matrix once per topology, so refining a new pose is
+  // one sparse matrix-matrix product, evaluated in parallel over the rows.
+  //
+  // Write the refined positions into ViewerData::V through set_vertices
+  // rather than into MeshGL::V_vbo: the viewer's bounds (culling), collision
+  // trees and serialization all read V. A caller that does fill the VBOs
+  // directly must refresh those itself.
+  //
+  // Example:
+  //   igl::Subdivision subdivision;
+  //   subdivision.precompute(C.rows(),CF,3);
+  //   Eigen::MatrixXd V;
+  //   Eigen::MatrixXi F;
+  //   subdivision.apply(C,V);
+  //   subdivision.faces(F);
+  //   data.set_mesh(std::move(V),std::move(F));
+  //   // every frame
+  //   subdivision.apply(C,V);
+  //   data.set_vertices(std::move(V));
+  class Subdivision
+  {
+  public:
+    enum Scheme
+    {
+      // Midpoint subdivision, see upsample
+      SUBDIVISION_UPSAMPLE = 0,
+      // Loop subdivision, see loop
+      SUBDIVISION_LOOP = 1
+    };
+    IGL_INLINE Subdivision();
+    // Build the stencil matrix of number_of_subdivs levels
+    //
+    // Inputs:
+    //   n_verts  number of coarse vertices
+    //   F  #F by 3 list of coarse triangle indices into the vertices
+    //   number_of_subdivs  number of levels
+    //   scheme  subdivision rule
+    IGL_INLINE void precompute(
+      const int n_verts,
+      const Eigen::MatrixXi & F,
+      const int number_of_subdivs,
+      const Scheme scheme = SUBDIVISION_LOOP);
+    // Number of refined vertices and faces
+    IGL_INLINE int rows() const;
+    IGL_INLINE int num_faces() const;
+    // #NV by #V composite subdivision matrix
+    IGL_INLINE const Eigen::SparseMatrix<double,Eigen::RowMajor> & S() const;
+    // Refined vertex positions
+    //
+    // Inputs:
+    //   V  #V by dim list of coarse vertex positions
+    // Outputs:
+    //   NV  #NV by dim list of refined vertex positions, S()*V
+    template <typename DerivedV, typename DerivedNV>
+    IGL_INLINE void apply(
+      const Eigen::MatrixBase<DerivedV> & V,
+      Eigen::PlainObjectBase<DerivedNV> & NV) const;
+    // Refined faces
+    //
+    // Outputs:
+    //   NF  #NF by 3 list of face indices into NV
+    template <typename DerivedNF>
+    IGL_INLINE void faces(Eigen::PlainObjectBase<DerivedNF> & NF) const;
+  private:
+    Eigen::SparseMatrix<double,Eigen::RowMajor> m_S;
+    Eigen::MatrixXi m_F;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "Subdivision.cpp"
+#endif
+
+#endif
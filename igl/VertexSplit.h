@@ -0,0 +1,41 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_VERTEXSPLIT_H
+#define IGL_VERTEXSPLIT_H
+#include <Eigen/Core>
+#include <vector>
+
+namespace igl
+{
+  // Inverse of one edge collapse of decimate: vertex s of a mesh (V,F) is
+  // split into s and a new vertex t = V.rows(), appended to V, and the faces
+  // lost by the collapse are appended to F. A coarse mesh followed by the
+  // vertex splits of its decimation, coarsest first, is a progressive mesh
+  // [Hoppe 1996].
+  //
+  // See also: decimate, progressive_mesh_refine, writePM, readPM
+  struct VertexSplit
+  {
+    // index into V of the vertex to split
+    int s;
+    // positions of s and of t after the split
+    Eigen::RowVectorXd s_position;
+    Eigen::RowVectorXd t_position;
+    // increasing list of indices into F of the faces in which s becomes t
+    std::vector<int> faces;
+    // #new_faces (at most 2) by 3 list of faces appended to F, indices into V
+    // with t appended
+    Eigen::MatrixXi new_faces;
+    // index of t and #new_faces list of indices of the new faces in the
+    // mesh given to decimate (see I and J of decimate), -1 when unknown
+    int t_birth;
+    Eigen::VectorXi new_faces_birth;
+  };
+}
+
+#endif
@@ -7,8 +7,8 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "arap.h"
 #include "colon.h"
-#include "cotmatrix.h"
-#include "massmatrix.h"
+#include "cotmatrix_cached.h"
+#include "massmatrix_cached.h"
 #include "group_sum_matrix.h"
 #include "covariance_scatter_matrix.h"
 #include "speye.h"
@@ -21,6 +21,7 @@
 #include "fit_rotations.h"
 #include <cassert>
 #include <iostream>
+#include <limits>
 
 template <
   typename DerivedV,
@@ -41,6 +42,17 @@ IGL_INLINE bool igl::arap_precomputation(
   data.n = n;
   assert((b.size() == 0 || b.maxCoeff() < n) && "b out of bounds");
   assert((b.size() == 0 || b.minCoeff() >=0) && "b out of bounds");
+  // With the connectivity, fixed vertices and dynamics of the previous
+  // precomputation the system matrix keeps its sparsity pattern: its values
+  // are refilled in place and only the numeric factorization is redone
+  const bool refactor =
+    data.L_F.rows() == F.rows() && data.L_F.cols() == F.cols() &&
+    F.rows() > 0 &&
+    (data.L_F.array() == F.template cast<int>().array()).all() &&
+    data.b.size() == b.size() &&
+    (data.b.array() == b.template cast<int>().array()).all() &&
+    data.L_with_dynamics == data.with_dynamics &&
+    data.solver_data.n == n;
   // remember b
   data.b = b;
   //assert(F.cols() == 3 && "For now only triangles");
@@ -66,8 +78,13 @@ IGL_INLINE bool igl::arap_precomputation(
   }
   const PlainObjectBase<DerivedV>& ref_V = (flat?plane_V:V);
   const PlainObjectBase<DerivedF>& ref_F = (flat?plane_F:F);
-  SparseMatrixS L;
-  cotmatrix(V,F,L);
+  if(refactor)
+  {
+    cotmatrix_cached(V,F,data.L_data,data.L);
+  }else
+  {
+    cotmatrix_cached_precompute(V,F,data.L_data,data.L);
+  }
 
   ARAPEnergyType eff_energy = data.energy;
   if(eff_energy == ARAP_ENERGY_TYPE_DEFAULT)
@@ -145,14 +162,19 @@ IGL_INLINE bool igl::arap_precomputation(
   }
   assert(data.K.rows() == data.n*data.dim);
 
-  SparseMatrix<double> Q = (-L).eval();
+  SparseMatrix<double> Q = (-data.L).eval();
 
   if(data.with_dynamics)
   {
     const double h = data.h;
     assert(h != 0);
-    SparseMatrix<double> M;
-    massmatrix(V,F,MASSMATRIX_TYPE_DEFAULT,data.M);
+    if(refactor)
+    {
+      massmatrix_cached(V,F,MASSMATRIX_TYPE_DEFAULT,data.M_data,data.M);
+    }else
+    {
+      massmatrix_cached_precompute(V,F,MASSMATRIX_TYPE_DEFAULT,data.M_data,data.M);
+    }
     const double dw = (1./data.ym)*(h*h);
     SparseMatrix<double> DQ = dw * 1./(h*h)*data.M;
     Q += DQ;
@@ -161,8 +183,21 @@ IGL_INLINE bool igl::arap_precomputation(
     data.vel = MatrixXd::Zero(n,data.dim);
   }
 
-  return min_quad_with_fixed_precompute(
-    Q,b,SparseMatrix<double>(),true,data.solver_data);
+  const bool success = refactor ?
+    min_quad_with_fixed_refactorize(
+      Q,SparseMatrix<double>(),data.solver_data) :
+    min_quad_with_fixed_precompute(
+      Q,b,SparseMatrix<double>(),true,data.solver_data);
+  // A failed factorization is redone from scratch next time
+  if(success)
+  {
+    data.L_F = F.template cast<int>();
+    data.L_with_dynamics = data.with_dynamics;
+  }else
+  {
+    data.L_F.resize(0,0);
+  }
+  return success;
 }
 
 template <
@@ -201,7 +236,11 @@ IGL_INLINE bool igl::arap_solve(
   {
     U0 = U_prev;
   }
-  while(iter < data.max_iter)
+  const int Rdim = data.dim;
+  // Reused across iterations
+  MatrixXd S,R(Rdim,data.CSM.rows()),eff_R,B;
+  double max_diff = std::numeric_limits<double>::infinity();
+  while(iter < data.max_iter && max_diff > data.tol)
   {
     U_prev = U;
     // enforce boundary conditions exactly
@@ -213,24 +252,19 @@ IGL_INLINE bool igl::arap_solve(
     const auto & Udim = U.replicate(data.dim,1);
     assert(U.cols() == data.dim);
     // As if U.col(2) was 0
-    MatrixXd S = data.CSM * Udim;
+    S = data.CSM * Udim;
     // THIS NORMALIZATION IS IMPORTANT TO GET SINGLE PRECISION SVD CODE TO WORK
     // CORRECTLY.
     S /= S.array().abs().maxCoeff();
 
-    const int Rdim = data.dim;
-    MatrixXd R(Rdim,data.CSM.rows());
+    // Local step, in parallel and vectorized when available (see
+    // fit_rotations)
     if(R.rows() == 2)
     {
       fit_rotations_planar(S,R);
     }else
     {
       fit_rotations(S,true,R);
-//#ifdef __SSE__ // fit_rotations_SSE will convert to float if necessary
-//      fit_rotations_SSE(S,R);
-//#else
-//      fit_rotations(S,true,R);
-//#endif
     }
     //for(int k = 0;k<(data.CSM.rows()/dim);k++)
     //{
@@ -241,7 +275,6 @@ IGL_INLINE bool igl::arap_solve(
     // Number of rotations: #vertices or #elements
     int num_rots = data.K.cols()/Rdim/Rdim;
     // distribute group rotations to vertices in each group
-    MatrixXd eff_R;
     if(data.G.size() == 0)
     {
       // copy...
@@ -276,25 +309,23 @@ IGL_INLINE bool igl::arap_solve(
     columnize(eff_R,num_rots,2,Rcol);
     VectorXd Bcol = -data.K * Rcol;
     assert(Bcol.size() == data.n*data.dim);
-    for(int c = 0;c<data.dim;c++)
+    // Global step, all coordinates in one solve
+    B = Map<const MatrixXd>(Bcol.data(),n,data.dim);
+    if(data.with_dynamics)
     {
-      VectorXd Uc,Bc,bcc,Beq;
-      Bc = Bcol.block(c*n,0,n,1);
-      if(data.with_dynamics)
-      {
-        Bc += Dl.col(c);
-      }
-      if(bc.size()>0)
-      {
-        bcc = bc.col(c);
-      }
-      min_quad_with_fixed_solve(
-        data.solver_data,
-        Bc,bcc,Beq,
-        Uc);
-      U.col(c) = Uc;
+      B += Dl;
+    }
+    MatrixXd Y = bc.template cast<double>();
+    if(bc.size() == 0)
+    {
+      Y.resize(0,data.dim);
     }
+    MatrixXd Beq;
+    MatrixXd Unew;
+    min_quad_with_fixed_solve(data.solver_data,B,Y,Beq,Unew);
+    U = Unew;
 
+    max_diff = (U-U_prev).array().abs().maxCoeff();
     iter++;
   }
   if(data.with_dynamics)
@@ -28,11 +28,22 @@ namespace igl
     // h  dynamics time step
     // ym  ~Young's modulus smaller is softer, larger is more rigid/stiff
     // max_iter  maximum inner iterations
+    // tol  stop iterating once no coordinate of U changes by more than tol in
+    //   an iteration. With the previous frame's solution as initial guess
+    //   (warm start) interactive deformation usually needs only a few
+    //   iterations per frame.
     // K  rhs pre-multiplier
     // M  mass matrix
     // solver_data  quadratic solver data
     // b  list of boundary indices into V
     // dim  dimension being used for solving
+    // L_data, M_data  positions of the element contributions among the
+    //   nonzeros of L and M (see cotmatrix_cached, massmatrix_cached)
+    // L  cotangent matrix of the rest pose
+    // L_F  connectivity L was built for. Calling arap_precomputation again
+    //   with the same F, b and with_dynamics (e.g. for a new rest pose) only
+    //   refills L and M and refactors solver_data.
+    // L_with_dynamics  with_dynamics when L was built
     int n;
     Eigen::VectorXi G;
     ARAPEnergyType energy;
@@ -41,11 +52,16 @@ namespace igl
     double h;
     double ym;
     int max_iter;
+    double tol;
     Eigen::SparseMatrix<double> K,M;
     Eigen::SparseMatrix<double> CSM;
     min_quad_with_fixed_data<double> solver_data;
     Eigen::VectorXi b;
     int dim;
+    Eigen::VectorXi L_data,M_data;
+    Eigen::SparseMatrix<double> L;
+    Eigen::MatrixXi L_F;
+    bool L_with_dynamics;
       ARAPData():
         n(0),
         G(),
@@ -55,11 +71,17 @@ namespace igl
         h(1),
         ym(1),
         max_iter(10),
+        tol(0),
         K(),
         CSM(),
         solver_data(),
         b(),
-        dim(-1) // force this to be set by _precomputation
+        dim(-1), // force this to be set by _precomputation
+        L_data(),
+        M_data(),
+        L(),
+        L_F(),
+        L_with_dynamics(false)
     {
     };
   };
@@ -87,7 +109,9 @@ namespace igl
   // Inputs:
   //   bc  #b by dim list of boundary conditions
   //   data  struct containing necessary precomputation and parameters
-  //   U  #V by dim initial guess
+  //   U  #V by dim initial guess, e.g. the solution of the previous frame
+  // Outputs:
+  //   U  #V by dim solution
   template <
     typename Derivedbc,
     typename DerivedU>
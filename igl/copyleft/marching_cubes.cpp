@@ -25,8 +25,11 @@
 
 #include "marching_cubes.h"
 #include "marching_cubes_tables.h"
+#include "../parallel_for.h"
 
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 
 extern const int edgeTable[256];
@@ -529,6 +532,160 @@ IGL_INLINE void igl::copyleft::marching_cubes(
   MarchingCubes<DerivedValues, DerivedPoints, DerivedVertices, DerivedIndices, DerivedFaces> mc(values, points, indices, 0.0 /*isovalue*/, vertices, faces);
 }
 
+// Lattice edge from sample ijk to its neighbour along axis
+struct MarchingCubesLatticeEdge
+{
+  int ijk[3];
+  int axis;
+  bool operator==(const MarchingCubesLatticeEdge & other) const
+  {
+    return ijk[0] == other.ijk[0] && ijk[1] == other.ijk[1] &&
+      ijk[2] == other.ijk[2] && axis == other.axis;
+  }
+};
+
+struct MarchingCubesLatticeEdgeHash
+{
+  std::size_t operator()(const MarchingCubesLatticeEdge & e) const
+  {
+    std::size_t seed = 0;
+    for(const int i : {e.ijk[0],e.ijk[1],e.ijk[2],e.axis})
+    {
+      seed ^= std::hash<int>()(i) + 0x9e3779b9 + (seed<<6) + (seed>>2); // Copied from boost::hash_combine
+    }
+    return seed;
+  }
+};
+
+// Mesh the blocks of sdf in bounded batches, see marching_cubes(sdf,...).
+// With edges, also passes the lattice edge each vertex lies on.
+IGL_INLINE void marching_cubes_sparse_signed_distance_blocks(
+  const igl::SparseSignedDistance & sdf,
+  const double isovalue,
+  const bool with_edges,
+  const std::function<void(
+    const Eigen::MatrixXd & vertices,
+    const Eigen::MatrixXi & faces,
+    const std::vector<MarchingCubesLatticeEdge> & edges)> & emit)
+{
+  typedef MarchingCubes<
+    Eigen::VectorXd, Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXi,
+    Eigen::MatrixXi> BlockMarchingCubes;
+  const int n = sdf.block_width()+1;
+  // Mesh a bounded batch of blocks at a time, so the extracted surface can be
+  // consumed while the rest is being meshed
+  const int batch = 256;
+  std::vector<Eigen::MatrixXd> BV(batch);
+  std::vector<Eigen::MatrixXi> BF(batch);
+  std::vector<std::vector<MarchingCubesLatticeEdge> > BE(batch);
+  for(int first = 0;first<sdf.num_blocks();first+=batch)
+  {
+    const int num = std::min(batch,sdf.num_blocks()-first);
+    igl::parallel_for(num,[&](const int b)
+    {
+      Eigen::VectorXd S;
+      Eigen::MatrixXd GV;
+      Eigen::MatrixXi GI;
+      sdf.block_cubes(first+b,S,GV,GI);
+      BV[b].resize(0,3);
+      BF[b].resize(0,3);
+      BE[b].clear();
+      if(GI.rows() == 0)
+      {
+        return;
+      }
+      BlockMarchingCubes mc(S,GV,GI,isovalue,BV[b],BF[b]);
+      if(!with_edges)
+      {
+        return;
+      }
+      // Vertices are created once per edge between two block samples, whose
+      // lattice coordinates follow from the block origin
+      const Eigen::RowVector3i origin = sdf.block_origin(first+b);
+      BE[b].resize(BV[b].rows());
+      for(const auto & edge_vertex : mc.edge2vertex)
+      {
+        const unsigned s = std::min(edge_vertex.first.i0_,edge_vertex.first.i1_);
+        const unsigned d = std::max(edge_vertex.first.i0_,edge_vertex.first.i1_)-s;
+        MarchingCubesLatticeEdge & e = BE[b][edge_vertex.second];
+        e.ijk[0] = origin(0)+int(s%n);
+        e.ijk[1] = origin(1)+int((s/n)%n);
+        e.ijk[2] = origin(2)+int(s/(n*n));
+        e.axis = d == 1 ? 0 : (int(d) == n ? 1 : 2);
+      }
+    },1);
+    for(int b = 0;b<num;b++)
+    {
+      if(BF[b].rows() > 0)
+      {
+        emit(BV[b],BF[b],BE[b]);
+      }
+    }
+  }
+}
+
+IGL_INLINE void igl::copyleft::marching_cubes(
+  const igl::SparseSignedDistance & sdf,
+  const double isovalue,
+  const std::function<void(
+    const Eigen::MatrixXd & vertices,
+    const Eigen::MatrixXi & faces)> & emit)
+{
+  marching_cubes_sparse_signed_distance_blocks(sdf,isovalue,false,
+    [&](
+      const Eigen::MatrixXd & BV,
+      const Eigen::MatrixXi & BF,
+      const std::vector<MarchingCubesLatticeEdge> &)
+    {
+      emit(BV,BF);
+    });
+}
+
+IGL_INLINE void igl::copyleft::marching_cubes(
+  const igl::SparseSignedDistance & sdf,
+  const double isovalue,
+  Eigen::MatrixXd & vertices,
+  Eigen::MatrixXi & faces)
+{
+  // Weld by lattice edge as the dense version does, not by position: where
+  // a sample equals the isovalue, vertices of different edges coincide
+  std::unordered_map<
+    MarchingCubesLatticeEdge,int,MarchingCubesLatticeEdgeHash> vertex_of;
+  std::vector<Eigen::RowVector3d> V;
+  std::vector<Eigen::RowVector3i> F;
+  marching_cubes_sparse_signed_distance_blocks(sdf,isovalue,true,
+    [&](
+      const Eigen::MatrixXd & BV,
+      const Eigen::MatrixXi & BF,
+      const std::vector<MarchingCubesLatticeEdge> & BE)
+    {
+      std::vector<int> J(BV.rows());
+      for(int v = 0;v<BV.rows();v++)
+      {
+        const auto it = vertex_of.emplace(BE[v],int(V.size()));
+        if(it.second)
+        {
+          V.push_back(BV.row(v));
+        }
+        J[v] = it.first->second;
+      }
+      for(int f = 0;f<BF.rows();f++)
+      {
+        F.emplace_back(J[BF(f,0)],J[BF(f,1)],J[BF(f,2)]);
+      }
+    });
+  vertices.resize(V.size(),3);
+  for(int v = 0;v<(int)V.size();v++)
+  {
+    vertices.row(v) = V[v];
+  }
+  faces.resize(F.size(),3);
+  for(int f = 0;f<(int)F.size();f++)
+  {
+    faces.row(f) = F[f];
+  }
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template void igl::copyleft::marching_cubes<Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, 3, 0, -1, 3>, Eigen::Matrix<float, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> > const&, unsigned int, unsigned int, unsigned int, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> >&);
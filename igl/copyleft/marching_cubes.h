@@ -8,8 +8,10 @@
 #ifndef IGL_COPYLEFT_MARCHINGCUBES_H
 #define IGL_COPYLEFT_MARCHINGCUBES_H
 #include "../igl_inline.h"
+#include "../SparseSignedDistance.h"
 
 #include <Eigen/Core>
+#include <functional>
 namespace igl
 {
   namespace copyleft
@@ -116,6 +118,37 @@ namespace igl
       Eigen::PlainObjectBase<DerivedVertices> &vertices,
       Eigen::PlainObjectBase<DerivedFaces> &faces);
 
+    // marching_cubes( sdf, isovalue, emit )
+    //
+    // Perform marching cubes reconstruction of a narrow band signed distance
+    // field one block at a time (see SparseSignedDistance::block_cubes), so
+    // the whole lattice is never held in memory. Blocks are meshed in
+    // parallel and passed to emit in order.
+    //
+    // Input:
+    //   sdf  narrow band signed distance field
+    //   isovalue  the isovalue of the surface to reconstruct, within the band
+    //   emit  called with the vertices and faces of each non-empty block.
+    //     Vertices on the boundary between blocks are repeated by each block.
+    IGL_INLINE void marching_cubes(
+      const igl::SparseSignedDistance & sdf,
+      const double isovalue,
+      const std::function<void(
+        const Eigen::MatrixXd & vertices,
+        const Eigen::MatrixXi & faces)> & emit);
+    // Overload of the above function collecting the blocks into one mesh,
+    // merging the copies of a vertex repeated between blocks by the lattice
+    // edge they lie on
+    //
+    // Output:
+    //   vertices  #V by 3 list of mesh vertex positions
+    //   faces  #F by 3 list of mesh triangle indices
+    IGL_INLINE void marching_cubes(
+      const igl::SparseSignedDistance & sdf,
+      const double isovalue,
+      Eigen::MatrixXd & vertices,
+      Eigen::MatrixXi & faces);
+
   }
 
 }
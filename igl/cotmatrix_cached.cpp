@@ -0,0 +1,99 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "cotmatrix_cached.h"
+#include "cotmatrix_entries.h"
+#include "sparse_cached.h"
+#include <vector>
+
+template <typename DerivedV, typename DerivedF, typename Scalar>
+IGL_INLINE void igl::cotmatrix_cached_precompute(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  Eigen::VectorXi & data,
+  Eigen::SparseMatrix<Scalar>& L)
+{
+  using namespace Eigen;
+  using namespace std;
+  Matrix<int,Dynamic,2> edges;
+  const int simplex_size = F.cols();
+  // 3 for triangles, 4 for tets
+  assert(simplex_size == 3 || simplex_size == 4);
+  if(simplex_size == 3)
+  {
+    edges.resize(3,2);
+    edges <<
+      1,2,
+      2,0,
+      0,1;
+  }else if(simplex_size == 4)
+  {
+    edges.resize(6,2);
+    edges <<
+      1,2,
+      2,0,
+      0,1,
+      3,0,
+      3,1,
+      3,2;
+  }else
+  {
+    return;
+  }
+  // Same entries in the same order as cotmatrix, cotmatrix_cached fills in
+  // the values
+  vector<Triplet<Scalar> > IJV;
+  IJV.reserve(F.rows()*edges.rows()*4);
+  for(int i = 0; i < F.rows(); i++)
+  {
+    for(int e = 0;e<edges.rows();e++)
+    {
+      const int source = F(i,edges(e,0));
+      const int dest = F(i,edges(e,1));
+      IJV.push_back(Triplet<Scalar>(source,dest,0));
+      IJV.push_back(Triplet<Scalar>(dest,source,0));
+      IJV.push_back(Triplet<Scalar>(source,source,0));
+      IJV.push_back(Triplet<Scalar>(dest,dest,0));
+    }
+  }
+  L.resize(V.rows(),V.rows());
+  sparse_cached_precompute(IJV,data,L);
+  cotmatrix_cached(V,F,data,L);
+}
+
+template <typename DerivedV, typename DerivedF, typename Scalar>
+IGL_INLINE void igl::cotmatrix_cached(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const Eigen::VectorXi & data,
+  Eigen::SparseMatrix<Scalar>& L)
+{
+  using namespace Eigen;
+  Matrix<Scalar,Dynamic,Dynamic> C;
+  cotmatrix_entries(V,F,C);
+  assert(data.size() == 4*C.size());
+  // Row major over elements to match the triplets of the precomputation
+  Matrix<Scalar,Dynamic,1> IJV(4*C.size());
+  for(int i = 0;i<C.rows();i++)
+  {
+    for(int e = 0;e<C.cols();e++)
+    {
+      const int t = 4*(i*C.cols()+e);
+      IJV(t+0) = C(i,e);
+      IJV(t+1) = C(i,e);
+      IJV(t+2) = -C(i,e);
+      IJV(t+3) = -C(i,e);
+    }
+  }
+  sparse_cached(IJV,data,L);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::cotmatrix_cached_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, 1, 0, -1, 1>&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::cotmatrix_cached<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<int, -1, 1, 0, -1, 1> const&, Eigen::SparseMatrix<double, 0, int>&);
+#endif
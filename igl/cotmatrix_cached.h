@@ -0,0 +1,56 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_COTMATRIX_CACHED_H
+#define IGL_COTMATRIX_CACHED_H
+#include "igl_inline.h"
+#define EIGEN_YES_I_KNOW_SPARSE_MODULE_IS_NOT_STABLE_YET
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+namespace igl
+{
+  // Constructs the cotangent matrix (see cotmatrix) in two phases, one fixing
+  // the sparsity pattern for a given connectivity F, and one writing the
+  // values for the current vertex positions V in place (see sparse_cached).
+  // The second phase does not allocate and keeps the positions of the
+  // nonzeros of L, so factorizations of matrices built from L can be updated
+  // with min_quad_with_fixed_refactorize.
+  //
+  // Inputs:
+  //   V  #V by dim list of mesh vertex positions
+  //   F  #F by simplex_size list of mesh elements (triangles or tetrahedra)
+  // Outputs:
+  //   data  positions of each element's contributions among the nonzeros of L
+  //   L  #V by #V cotangent matrix
+  //
+  // Example:
+  //   // once per connectivity
+  //   igl::cotmatrix_cached_precompute(V,F,L_data,L);
+  //   igl::min_quad_with_fixed_precompute((-L).eval(),b,Aeq,true,mqwf);
+  //   // every frame
+  //   igl::cotmatrix_cached(V,F,L_data,L);
+  //   igl::min_quad_with_fixed_refactorize((-L).eval(),Aeq,mqwf);
+  //   igl::min_quad_with_fixed_solve(mqwf,B,bc,Beq,Z);
+  template <typename DerivedV, typename DerivedF, typename Scalar>
+  IGL_INLINE void cotmatrix_cached_precompute(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    Eigen::VectorXi & data,
+    Eigen::SparseMatrix<Scalar>& L);
+  template <typename DerivedV, typename DerivedF, typename Scalar>
+  IGL_INLINE void cotmatrix_cached(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::VectorXi & data,
+    Eigen::SparseMatrix<Scalar>& L);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "cotmatrix_cached.cpp"
+#endif
+
+#endif
@@ -15,6 +15,9 @@
 #include "connect_boundary_to_infinity.h"
 #include "max_faces_stopping_condition.h"
 #include "shortest_edge_and_midpoint.h"
+#include "circulation.h"
+#include "slice_mask_vertex_splits.h"
+#include <algorithm>
 
 IGL_INLINE bool igl::decimate(
   const Eigen::MatrixXd & V,
@@ -71,6 +74,80 @@ IGL_INLINE bool igl::decimate(
   return igl::decimate(V,F,max_m,U,G,J,I);
 }
 
+IGL_INLINE bool igl::decimate(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const size_t max_m,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I,
+  std::vector<VertexSplit> & splits)
+{
+  // Original number of faces
+  const int orig_m = F.rows();
+  // Tracking number of faces
+  int m = F.rows();
+  Eigen::MatrixXd VO;
+  Eigen::MatrixXi FO;
+  igl::connect_boundary_to_infinity(V,F,VO,FO);
+  if(!is_edge_manifold(FO))
+  {
+    return false;
+  }
+  Eigen::VectorXi EMAP;
+  Eigen::MatrixXi E,EF,EI;
+  edge_flaps(FO,E,EMAP,EF,EI);
+  const auto always_try = [](
+    const Eigen::MatrixXd &                                         ,/*V*/
+    const Eigen::MatrixXi &                                         ,/*F*/
+    const Eigen::MatrixXi &                                         ,/*E*/
+    const Eigen::VectorXi &                                         ,/*EMAP*/
+    const Eigen::MatrixXi &                                         ,/*EF*/
+    const Eigen::MatrixXi &                                         ,/*EI*/
+    const std::set<std::pair<double,int> > &                        ,/*Q*/
+    const std::vector<std::set<std::pair<double,int> >::iterator > &,/*Qit*/
+    const Eigen::MatrixXd &                                         ,/*C*/
+    const int                                                        /*e*/
+    ) -> bool { return true;};
+  const auto never_care = [](
+    const Eigen::MatrixXd &                                         ,   /*V*/
+    const Eigen::MatrixXi &                                         ,   /*F*/
+    const Eigen::MatrixXi &                                         ,   /*E*/
+    const Eigen::VectorXi &                                         ,/*EMAP*/
+    const Eigen::MatrixXi &                                         ,  /*EF*/
+    const Eigen::MatrixXi &                                         ,  /*EI*/
+    const std::set<std::pair<double,int> > &                        ,   /*Q*/
+    const std::vector<std::set<std::pair<double,int> >::iterator > &, /*Qit*/
+    const Eigen::MatrixXd &                                         ,   /*C*/
+    const int                                                       ,   /*e*/
+    const int                                                       ,  /*e1*/
+    const int                                                       ,  /*e2*/
+    const int                                                       ,  /*f1*/
+    const int                                                       ,  /*f2*/
+    const bool                                                  /*collapsed*/
+    )-> void { };
+  bool ret = decimate(
+    VO,
+    FO,
+    shortest_edge_and_midpoint,
+    max_faces_stopping_condition(m,orig_m,max_m),
+    always_try,
+    never_care,
+    E,EMAP,EF,EI,
+    U,
+    G,
+    J,
+    I,
+    splits);
+  // Drop the faces to infinity, from the coarse mesh and from the splits
+  Eigen::Array<bool,Eigen::Dynamic,1> keep(FO.rows());
+  keep.head(orig_m).setConstant(true);
+  keep.tail(FO.rows()-orig_m).setConstant(false);
+  slice_mask_vertex_splits(keep,U,G,J,I,splits);
+  return ret;
+}
+
 IGL_INLINE bool igl::decimate(
   const Eigen::MatrixXd & OV,
   const Eigen::MatrixXi & OF,
@@ -364,3 +441,198 @@ IGL_INLINE bool igl::decimate(
   remove_unreferenced(V,F2,U,G,_1,I);
   return clean_finish;
 }
+
+IGL_INLINE bool igl::decimate(
+  const Eigen::MatrixXd & OV,
+  const Eigen::MatrixXi & OF,
+  const std::function<void(
+    const int,
+    const Eigen::MatrixXd &,
+    const Eigen::MatrixXi &,
+    const Eigen::MatrixXi &,
+    const Eigen::VectorXi &,
+    const Eigen::MatrixXi &,
+    const Eigen::MatrixXi &,
+    double &,
+    Eigen::RowVectorXd &)> & cost_and_placement,
+  const std::function<bool(
+      const Eigen::MatrixXd &,
+      const Eigen::MatrixXi &,
+      const Eigen::MatrixXi &,
+      const Eigen::VectorXi &,
+      const Eigen::MatrixXi &,
+      const Eigen::MatrixXi &,
+      const std::set<std::pair<double,int> > &,
+      const std::vector<std::set<std::pair<double,int> >::iterator > &,
+      const Eigen::MatrixXd &,
+      const int,
+      const int,
+      const int,
+      const int,
+      const int)> & stopping_condition,
+    const std::function<bool(
+      const Eigen::MatrixXd &                                         ,/*V*/
+      const Eigen::MatrixXi &                                         ,/*F*/
+      const Eigen::MatrixXi &                                         ,/*E*/
+      const Eigen::VectorXi &                                         ,/*EMAP*/
+      const Eigen::MatrixXi &                                         ,/*EF*/
+      const Eigen::MatrixXi &                                         ,/*EI*/
+      const std::set<std::pair<double,int> > &                        ,/*Q*/
+      const std::vector<std::set<std::pair<double,int> >::iterator > &,/*Qit*/
+      const Eigen::MatrixXd &                                         ,/*C*/
+      const int                                                        /*e*/
+      )> & pre_collapse,
+    const std::function<void(
+      const Eigen::MatrixXd &                                         ,   /*V*/
+      const Eigen::MatrixXi &                                         ,   /*F*/
+      const Eigen::MatrixXi &                                         ,   /*E*/
+      const Eigen::VectorXi &                                         ,/*EMAP*/
+      const Eigen::MatrixXi &                                         ,  /*EF*/
+      const Eigen::MatrixXi &                                         ,  /*EI*/
+      const std::set<std::pair<double,int> > &                        ,   /*Q*/
+      const std::vector<std::set<std::pair<double,int> >::iterator > &, /*Qit*/
+      const Eigen::MatrixXd &                                         ,   /*C*/
+      const int                                                       ,   /*e*/
+      const int                                                       ,  /*e1*/
+      const int                                                       ,  /*e2*/
+      const int                                                       ,  /*f1*/
+      const int                                                       ,  /*f2*/
+      const bool                                                  /*collapsed*/
+      )> & post_collapse,
+  const Eigen::MatrixXi & OE,
+  const Eigen::VectorXi & OEMAP,
+  const Eigen::MatrixXi & OEF,
+  const Eigen::MatrixXi & OEI,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I,
+  std::vector<VertexSplit> & splits
+  )
+{
+  using namespace Eigen;
+  using namespace std;
+  // An edge collapse merging d into s, indices into OV and OF
+  struct Collapse
+  {
+    int s,d;
+    RowVectorXd s_position,d_position;
+    // The two faces removed and their corners before the collapse
+    int f[2];
+    Matrix<int,2,3> f_corners;
+    // Faces around d, including f
+    vector<int> d_faces;
+  };
+  vector<Collapse> collapses;
+  Collapse pending;
+  // Remember the neighborhood of the edge before it is collapsed
+  const auto record_pre_collapse = [&pre_collapse,&pending](
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const Eigen::MatrixXi & E,
+    const Eigen::VectorXi & EMAP,
+    const Eigen::MatrixXi & EF,
+    const Eigen::MatrixXi & EI,
+    const std::set<std::pair<double,int> > & Q,
+    const std::vector<std::set<std::pair<double,int> >::iterator > & Qit,
+    const Eigen::MatrixXd & C,
+    const int e) -> bool
+  {
+    if(!pre_collapse(V,F,E,EMAP,EF,EI,Q,Qit,C,e))
+    {
+      return false;
+    }
+    // Same convention as collapse_edge: the larger index is merged into the
+    // smaller
+    const bool eflip = E(e,0)>E(e,1);
+    pending.s = eflip?E(e,1):E(e,0);
+    pending.d = eflip?E(e,0):E(e,1);
+    pending.s_position = V.row(pending.s);
+    pending.d_position = V.row(pending.d);
+    for(int side = 0;side<2;side++)
+    {
+      pending.f[side] = EF(e,side);
+      pending.f_corners.row(side) = F.row(EF(e,side));
+    }
+    pending.d_faces = circulation(e,!eflip,EMAP,EF,EI);
+    return true;
+  };
+  const auto record_post_collapse = [&post_collapse,&pending,&collapses](
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const Eigen::MatrixXi & E,
+    const Eigen::VectorXi & EMAP,
+    const Eigen::MatrixXi & EF,
+    const Eigen::MatrixXi & EI,
+    const std::set<std::pair<double,int> > & Q,
+    const std::vector<std::set<std::pair<double,int> >::iterator > & Qit,
+    const Eigen::MatrixXd & C,
+    const int e,
+    const int e1,
+    const int e2,
+    const int f1,
+    const int f2,
+    const bool collapsed) -> void
+  {
+    if(collapsed)
+    {
+      collapses.push_back(pending);
+    }
+    post_collapse(V,F,E,EMAP,EF,EI,Q,Qit,C,e,e1,e2,f1,f2,collapsed);
+  };
+  const bool ret = igl::decimate(
+    OV,OF,
+    cost_and_placement,stopping_condition,
+    record_pre_collapse,record_post_collapse,
+    OE,OEMAP,OEF,OEI,
+    U,G,J,I);
+
+  // Undo the collapses in reverse order, numbering the vertices and faces
+  // they bring back after those of (U,G)
+  vector<int> vmap(OV.rows(),-1);
+  vector<int> fmap(OF.rows(),-1);
+  for(int u = 0;u<I.size();u++)
+  {
+    vmap[I(u)] = u;
+  }
+  for(int g = 0;g<J.size();g++)
+  {
+    fmap[J(g)] = g;
+  }
+  int n = U.rows();
+  int m = G.rows();
+  splits.resize(collapses.size());
+  for(int k = 0;k<(int)collapses.size();k++)
+  {
+    const Collapse & c = collapses[collapses.size()-1-k];
+    VertexSplit & split = splits[k];
+    assert(vmap[c.s] >= 0);
+    split.s = vmap[c.s];
+    split.t_birth = c.d;
+    vmap[c.d] = n++;
+    split.s_position = c.s_position;
+    split.t_position = c.d_position;
+    split.faces.clear();
+    for(const int f : c.d_faces)
+    {
+      if(f != c.f[0] && f != c.f[1])
+      {
+        assert(fmap[f] >= 0);
+        split.faces.push_back(fmap[f]);
+      }
+    }
+    std::sort(split.faces.begin(),split.faces.end());
+    split.new_faces.resize(2,3);
+    split.new_faces_birth.resize(2);
+    for(int side = 0;side<2;side++)
+    {
+      for(int j = 0;j<3;j++)
+      {
+        split.new_faces(side,j) = vmap[c.f_corners(side,j)];
+      }
+      split.new_faces_birth(side) = c.f[side];
+      fmap[c.f[side]] = m++;
+    }
+  }
+  return ret;
+}
@@ -34,6 +34,32 @@ namespace igl
     const std::vector<Q,QAlloc> & vQ,
     const std::vector<T> & vT,
     Eigen::PlainObjectBase<DerivedU> & U);
+  // Dual quaternion skinning with at most k influences per vertex (see
+  // sparse_skinning_weights.h), costs O(#V*k) instead of O(#V*#C).
+  //
+  // Inputs:
+  //   V  #V by 3 list of rest positions
+  //   I  #V by k list of handle indices
+  //   WK  #V by k list of corresponding weights
+  //   vQ  #C list of rotation quaternions 
+  //   vT  #C list of translation vectors
+  // Outputs:
+  //   U  #V by 3 list of new positions
+  template <
+    typename DerivedV,
+    typename DerivedI,
+    typename DerivedWK,
+    typename Q,
+    typename QAlloc,
+    typename T,
+    typename DerivedU>
+  IGL_INLINE void dqs(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::PlainObjectBase<DerivedI> & I,
+    const Eigen::PlainObjectBase<DerivedWK> & WK,
+    const std::vector<Q,QAlloc> & vQ,
+    const std::vector<T> & vT,
+    Eigen::PlainObjectBase<DerivedU> & U);
 };
 
 #ifndef IGL_STATIC_LIBRARY
@@ -7,6 +7,7 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "edge_flaps.h"
 #include "unique_edge_map.h"
+#include "parallel_for.h"
 #include <vector>
 #include <cassert>
 
@@ -51,10 +52,28 @@ IGL_INLINE void igl::edge_flaps(
   Eigen::MatrixXi & EI)
 {
   Eigen::MatrixXi allE;
-  std::vector<std::vector<int> > uE2E;
-  igl::unique_edge_map(F,allE,uE,EMAP,uE2E);
-  // Const-ify to call overload
-  const auto & cuE = uE;
-  const auto & cEMAP = EMAP;
-  return edge_flaps(F,cuE,cEMAP,EF,EI);
+  Eigen::VectorXi uEC,uEE;
+  igl::unique_edge_map(F,allE,uE,EMAP,uEC,uEE);
+  // Each unique edge looks up its own flaps, so edges are independent
+  EF.resize(uE.rows(),2);
+  EI.resize(uE.rows(),2);
+  const int m = F.rows();
+  igl::parallel_for(uE.rows(),[&](const int u)
+  {
+    EF.row(u).setConstant(-1);
+    EI.row(u).setConstant(-1);
+    for(int k = uEC(u);k<uEC(u+1);k++)
+    {
+      const int f = uEE(k)%m;
+      const int v = uEE(k)/m;
+      // Keep the last flap in face order on non-manifold edges, as above
+      const int side =
+        F(f,(v+1)%3) == uE(u,0) && F(f,(v+2)%3) == uE(u,1) ? 0 : 1;
+      if(EF(u,side) < f || (EF(u,side) == f && EI(u,side) < v))
+      {
+        EF(u,side) = f;
+        EI(u,side) = v;
+      }
+    }
+  },1000);
 }
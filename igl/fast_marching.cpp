@@ -0,0 +1,144 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 The libigl contributors
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "fast_marching.h"
+#include "vertex_triangle_adjacency.h"
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename Derivedgamma,
+  typename DerivedD>
+IGL_INLINE void igl::fast_marching(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const Eigen::MatrixBase<Derivedgamma> & gamma,
+  Eigen::PlainObjectBase<DerivedD> & D)
+{
+  Eigen::VectorXi VF,NI;
+  igl::vertex_triangle_adjacency(F,V.rows(),VF,NI);
+  fast_marching(V,F,VF,NI,gamma,D);
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedVF,
+  typename DerivedNI,
+  typename Derivedgamma,
+  typename DerivedD>
+IGL_INLINE void igl::fast_marching(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const Eigen::MatrixBase<DerivedVF> & VF,
+  const Eigen::MatrixBase<DerivedNI> & NI,
+  const Eigen::MatrixBase<Derivedgamma> & gamma,
+  Eigen::PlainObjectBase<DerivedD> & D)
+{
+  typedef typename DerivedD::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  const int n = V.rows();
+  const Scalar inf = std::numeric_limits<Scalar>::infinity();
+  D.setConstant(n,1,inf);
+  std::vector<bool> done(n,false);
+  typedef std::pair<Scalar,int> QueueEntry;
+  std::priority_queue<
+    QueueEntry,std::vector<QueueEntry>,std::greater<QueueEntry> > Q;
+  for(int g = 0;g<gamma.size();g++)
+  {
+    D(gamma(g)) = 0;
+    Q.push(QueueEntry(0,gamma(g)));
+  }
+
+  // Distance at c through the triangle (a,b,c) given known distances at a and
+  // b
+  const auto triangle_update = [&](const int a, const int b, const int c)->Scalar
+  {
+    const RowVector3S A = V.row(a).template cast<Scalar>();
+    const RowVector3S B = V.row(b).template cast<Scalar>();
+    const RowVector3S C = V.row(c).template cast<Scalar>();
+    const Scalar da = D(a);
+    const Scalar db = D(b);
+    const Scalar edge = std::min(da+(C-A).norm(),db+(C-B).norm());
+    // Unfold: A at the origin, B on the x-axis, C above it
+    const Scalar L = (B-A).norm();
+    if(L == 0)
+    {
+      return edge;
+    }
+    const RowVector3S x = (B-A)/L;
+    const Scalar cx = (C-A).dot(x);
+    const Scalar cy = ((C-A)-cx*x).norm();
+    // Virtual source below the x-axis at distances da, db from A, B
+    const Scalar sx = (da*da-db*db+L*L)/(2*L);
+    const Scalar sy2 = da*da-sx*sx;
+    if(sy2 < 0 || cy == 0)
+    {
+      return edge;
+    }
+    const Scalar sy = -std::sqrt(sy2);
+    // The wavefront has to reach C through the edge AB
+    const Scalar t = -sy/(cy-sy);
+    const Scalar ix = sx+t*(cx-sx);
+    if(ix < 0 || ix > L)
+    {
+      return edge;
+    }
+    return std::min(edge,std::sqrt((cx-sx)*(cx-sx)+(cy-sy)*(cy-sy)));
+  };
+
+  while(!Q.empty())
+  {
+    const QueueEntry top = Q.top();
+    Q.pop();
+    const int v = top.second;
+    if(done[v] || top.first > D(v))
+    {
+      continue;
+    }
+    done[v] = true;
+    for(int j = NI(v);j<NI(v+1);j++)
+    {
+      const int f = VF(j);
+      for(int c = 0;c<3;c++)
+      {
+        const int w = F(f,c);
+        if(done[w])
+        {
+          continue;
+        }
+        // Third vertex of f
+        const int o = F(f,0)+F(f,1)+F(f,2)-v-w;
+        Scalar d;
+        if(done[o])
+        {
+          d = triangle_update(v,o,w);
+        }else
+        {
+          d = D(v)+(V.row(w)-V.row(v)).template cast<Scalar>().norm();
+        }
+        if(d < D(w))
+        {
+          D(w) = d;
+          Q.push(QueueEntry(d,w));
+        }
+      }
+    }
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::fast_marching<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::fast_marching<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+#endif
@@ -0,0 +1,61 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 The libigl contributors
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_FAST_MARCHING_H
+#define IGL_FAST_MARCHING_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  // Approximate geodesic distances on a triangle mesh by fast marching
+  // [Kimmel & Sethian 1998]: vertices are finalized in increasing distance
+  // order and each incident triangle with two known vertices updates the
+  // third from an unfolded planar wavefront, falling back to edge lengths
+  // when the wavefront does not cross the opposite edge. Cheaper and less
+  // accurate than heat_geodesics/exact_geodesic, and needs no
+  // factorization.
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of mesh face indices into V
+  //   gamma  #gamma list of indices into V of source vertices
+  // Outputs:
+  //   D  #V list of distances to gamma (infinity if unreachable)
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename Derivedgamma,
+    typename DerivedD>
+  IGL_INLINE void fast_marching(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<Derivedgamma> & gamma,
+    Eigen::PlainObjectBase<DerivedD> & D);
+  // Inputs:
+  //   VF  #3*F list of incident faces, see vertex_triangle_adjacency
+  //   NI  #V+1 list of offsets into VF, see vertex_triangle_adjacency
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedVF,
+    typename DerivedNI,
+    typename Derivedgamma,
+    typename DerivedD>
+  IGL_INLINE void fast_marching(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<DerivedVF> & VF,
+    const Eigen::MatrixBase<DerivedNI> & NI,
+    const Eigen::MatrixBase<Derivedgamma> & gamma,
+    Eigen::PlainObjectBase<DerivedD> & D);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "fast_marching.cpp"
+#endif
+
+#endif
@@ -12,6 +12,8 @@
 #include "polar_dec.h"
 #include "polar_svd.h"
 #include "C_STR.h"
+#include "parallel_for.h"
+#include <algorithm>
 #include <iostream>
 
 template <typename DerivedS, typename DerivedD>
@@ -26,15 +28,30 @@ IGL_INLINE void igl::fit_rotations(
   assert(nr * dim == S.rows());
   assert(dim == 3);
 
+#if defined(__AVX__) || defined(__SSE__)
+  // Route through the vectorized kernels, which decompose 8 (AVX) or 4 (SSE)
+  // matrices at once in single precision
+  if(single_precision)
+  {
+    const Eigen::MatrixXf Sf = S.template cast<float>();
+    Eigen::MatrixXf Rf;
+#  ifdef __AVX__
+    fit_rotations_AVX(Sf,Rf);
+#  else
+    fit_rotations_SSE(Sf,Rf);
+#  endif
+    R = Rf.template cast<typename DerivedD::Scalar>();
+    return;
+  }
+#endif
+
   // resize output
   R.resize(dim,dim*nr); // hopefully no op (should be already allocated)
 
-  //std::cout<<"S=["<<std::endl<<S<<std::endl<<"];"<<std::endl;
-  //MatrixXd si(dim,dim);
-  Eigen::Matrix<typename DerivedS::Scalar,3,3> si;// = Eigen::Matrix3d::Identity();
   // loop over number of rotations we're computing
-  for(int r = 0;r<nr;r++)
+  igl::parallel_for(nr,[&](const int r)
   {
+    Eigen::Matrix<typename DerivedS::Scalar,3,3> si;
     // build this covariance matrix
     for(int i = 0;i<dim;i++)
     {
@@ -57,9 +74,7 @@ IGL_INLINE void igl::fit_rotations(
     }
     assert(ri.determinant() >= 0);
     R.block(0,r*dim,dim,dim) = ri.block(0,0,dim,dim).transpose();
-    //cout<<matlab_format(si,C_STR("si_"<<r))<<endl;
-    //cout<<matlab_format(ri.transpose().eval(),C_STR("ri_"<<r))<<endl;
-  }
+  },1000);
 }
 
 template <typename DerivedS, typename DerivedD>
@@ -76,10 +91,10 @@ IGL_INLINE void igl::fit_rotations_planar(
   // resize output
   R.resize(dim,dim*nr); // hopefully no op (should be already allocated)
 
-  Eigen::Matrix<typename DerivedS::Scalar,2,2> si;
   // loop over number of rotations we're computing
-  for(int r = 0;r<nr;r++)
+  igl::parallel_for(nr,[&](const int r)
   {
+    Eigen::Matrix<typename DerivedS::Scalar,2,2> si;
     // build this covariance matrix
     for(int i = 0;i<2;i++)
     {
@@ -106,7 +121,7 @@ IGL_INLINE void igl::fit_rotations_planar(
     // Not sure why polar_dec computes transpose...
     R.block(0,r*dim,dim,dim).setIdentity();
     R.block(0,r*dim,2,2) = ri.transpose();
-  }
+  },1000);
 }
 
 
@@ -125,14 +140,18 @@ IGL_INLINE void igl::fit_rotations_SSE(
   // resize output
   R.resize(dim,dim*nr); // hopefully no op (should be already allocated)
 
-  Eigen::Matrix<float, 3*cStep, 3> siBig;
-  // using SSE decompose cStep matrices at a time:
-  int r = 0;
-  for( ; r<nr; r+=cStep)
+  // using SIMD decompose cStep matrices at a time, batches in parallel
+  const int num_batches = (nr+cStep-1)/cStep;
+  igl::parallel_for(num_batches,[&](const int batch)
   {
-    int numMats = cStep;
-    if (r + cStep >= nr) numMats = nr - r;
-    // build siBig:
+    const int r = batch*cStep;
+    const int numMats = std::min(cStep,nr-r);
+    // build siBig, padding a partial batch with identities
+    Eigen::Matrix<float, 3*cStep, 3> siBig;
+    for (int k=numMats; k<cStep; k++)
+    {
+      siBig.block(3*k, 0, 3, 3).setIdentity();
+    }
     for (int k=0; k<numMats; k++)
     {
       for(int i = 0;i<dim;i++)
@@ -146,7 +165,7 @@ IGL_INLINE void igl::fit_rotations_SSE(
     Eigen::Matrix<float, 3*cStep, 3> ri;
     polar_svd3x3_sse(siBig, ri);    
 
-    for (int k=0; k<cStep; k++)
+    for (int k=0; k<numMats; k++)
       assert(ri.block(3*k, 0, 3, 3).determinant() >= 0);
 
     // Not sure why polar_dec computes transpose...
@@ -154,7 +173,7 @@ IGL_INLINE void igl::fit_rotations_SSE(
     {
       R.block(0, (r + k)*dim, dim, dim) = ri.block(3*k, 0, dim, dim).transpose();
     }    
-  }
+  },250);
 }
 
 IGL_INLINE void igl::fit_rotations_SSE(
@@ -183,14 +202,18 @@ IGL_INLINE void igl::fit_rotations_AVX(
   // resize output
   R.resize(dim,dim*nr); // hopefully no op (should be already allocated)
 
-  Eigen::Matrix<float, 3*cStep, 3> siBig;
-  // using SSE decompose cStep matrices at a time:
-  int r = 0;
-  for( ; r<nr; r+=cStep)
+  // using SIMD decompose cStep matrices at a time, batches in parallel
+  const int num_batches = (nr+cStep-1)/cStep;
+  igl::parallel_for(num_batches,[&](const int batch)
   {
-    int numMats = cStep;
-    if (r + cStep >= nr) numMats = nr - r;
-    // build siBig:
+    const int r = batch*cStep;
+    const int numMats = std::min(cStep,nr-r);
+    // build siBig, padding a partial batch with identities
+    Eigen::Matrix<float, 3*cStep, 3> siBig;
+    for (int k=numMats; k<cStep; k++)
+    {
+      siBig.block(3*k, 0, 3, 3).setIdentity();
+    }
     for (int k=0; k<numMats; k++)
     {
       for(int i = 0;i<dim;i++)
@@ -204,7 +227,7 @@ IGL_INLINE void igl::fit_rotations_AVX(
     Eigen::Matrix<float, 3*cStep, 3> ri;
     polar_svd3x3_avx(siBig, ri);    
 
-    for (int k=0; k<cStep; k++)
+    for (int k=0; k<numMats; k++)
       assert(ri.block(3*k, 0, 3, 3).determinant() >= 0);
 
     // Not sure why polar_dec computes transpose...
@@ -212,7 +235,17 @@ IGL_INLINE void igl::fit_rotations_AVX(
     {
       R.block(0, (r + k)*dim, dim, dim) = ri.block(3*k, 0, dim, dim).transpose();
     }    
-  }
+  },125);
+}
+
+IGL_INLINE void igl::fit_rotations_AVX(
+  const Eigen::MatrixXd & S,
+  Eigen::MatrixXd & R)
+{
+  const Eigen::MatrixXf Sf = S.cast<float>();
+  Eigen::MatrixXf Rf;
+  fit_rotations_AVX(Sf,Rf);
+  R = Rf.cast<double>();
 }
 #endif
 
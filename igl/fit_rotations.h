@@ -20,10 +20,14 @@ namespace igl
   // 
   // Inputs:
   //   S  nr*dim by dim stack of covariance matrices
-  //   single_precision  whether to use single precision (faster)
+  //   single_precision  whether to use single precision (faster). When
+  //     compiled with AVX or SSE this uses fit_rotations_AVX or
+  //     fit_rotations_SSE.
   // Outputs:
   //   R  dim by dim * nr list of rotations
   //
+  // Rotations are fit in parallel (see parallel_for).
+  //
   template <typename DerivedS, typename DerivedD>
   IGL_INLINE void fit_rotations(
     const Eigen::PlainObjectBase<DerivedS> & S,
@@ -50,6 +54,7 @@ namespace igl
 #endif
 #ifdef __AVX__
   IGL_INLINE void fit_rotations_AVX( const Eigen::MatrixXf & S, Eigen::MatrixXf & R);
+  IGL_INLINE void fit_rotations_AVX( const Eigen::MatrixXd & S, Eigen::MatrixXd & R);
 #endif
 }
 
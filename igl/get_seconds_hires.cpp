@@ -20,10 +20,13 @@ IGL_INLINE double igl::get_seconds_hires()
   return double(li_current.QuadPart) / double(li_freq.QuadPart);
 }
 #else
-#  include "get_seconds.h"
+#  include <chrono>
 IGL_INLINE double igl::get_seconds_hires()
 {
-  // Sorry I've no idea how performance counters work on Mac...
-  return igl::get_seconds();
+  // Monotonic clock, typically counting from boot rather than the epoch, so
+  // that the double keeps sub-microsecond resolution
+  return
+    std::chrono::duration<double>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 #endif
@@ -7,6 +7,262 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "hausdorff.h"
 #include "point_mesh_squared_distance.h"
+#include "parallel_for.h"
+#include "point_simplex_squared_distance.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+  // Upper bound on the distance to B of any point of a triangle
+  //
+  // Inputs:
+  //   e  3-long vector of opposite edge lengths
+  //   d  3-long vector of distance from each corner to B
+  template <typename Scalar>
+  Scalar hausdorff_triangle_upper_bound(
+    const Eigen::Matrix<Scalar,1,3> & e,
+    const Eigen::Matrix<Scalar,1,3> & d)
+  {
+    // Maximum edge length
+    const Scalar e_max = e.maxCoeff();
+    // Semiperimeter
+    const Scalar s = (e(0)+e(1)+e(2))*0.5;
+    // Area
+    const Scalar A = sqrt(s*(s-e(0))*(s-e(1))*(s-e(2)));
+    // Circumradius
+    const Scalar R = e(0)*e(1)*e(2)/(4.*A);
+    // inradius
+    const Scalar r = A/s;
+    Scalar u1 = std::numeric_limits<Scalar>::infinity();
+    Scalar u2 = 0;
+    for(int i=0;i<3;i++)
+    {
+      // u1 is the minimum of corner distances + maximum adjacent edge 
+      u1 = std::min(u1,d(i) + std::max(e((i+1)%3),e((i+2)%3)));
+      // u2 first takes the maximum over corner distances
+      u2 = std::max(u2,d(i));
+    }
+    // u2 is the distance from the circumcenter/midpoint of obtuse edge plus the
+    // largest corner distance 
+    u2 += (s-r>2.*R ? R : 0.5*e_max);
+    return std::min(u1,u2);
+  }
+
+  // tol raised to a floor relative to the bounding box diagonal of A and B:
+  // below the rounding error of the distances, refinement would never stop
+  template <typename DerivedVA, typename DerivedVB, typename Scalar>
+  Scalar hausdorff_tolerance(
+    const Eigen::MatrixBase<DerivedVA> & VA,
+    const Eigen::MatrixBase<DerivedVB> & VB,
+    const Scalar tol)
+  {
+    Eigen::AlignedBox<Scalar,3> box;
+    for(int v = 0;v<VA.rows();v++)
+    {
+      box.extend(VA.row(v).transpose().template cast<Scalar>());
+    }
+    for(int v = 0;v<VB.rows();v++)
+    {
+      box.extend(VB.row(v).transpose().template cast<Scalar>());
+    }
+    const Scalar diagonal = box.isEmpty() ? Scalar(0) : box.diagonal().norm();
+    const Scalar min_tol = std::max(
+      sqrt(std::numeric_limits<Scalar>::epsilon())*diagonal,
+      std::numeric_limits<Scalar>::min());
+    // Also catches a NaN tol
+    return tol > min_tol ? tol : min_tol;
+  }
+
+  // One-sided bounds from (VA,FA) to B, see igl::hausdorff. Triangles whose
+  // upper bound is at most l0+tol are not refined.
+  template <
+    typename DerivedVA,
+    typename DerivedFA,
+    typename DerivedVB,
+    typename DerivedFB,
+    typename Scalar>
+  void hausdorff_one_sided(
+    const Eigen::MatrixBase<DerivedVA> & VA,
+    const Eigen::MatrixBase<DerivedFA> & FA,
+    const igl::AABB<DerivedVB,3> & treeB,
+    const Eigen::MatrixBase<DerivedVB> & VB,
+    const Eigen::MatrixBase<DerivedFB> & FB,
+    const Scalar tol,
+    const Scalar l0,
+    Scalar & l,
+    Scalar & u)
+  {
+    typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+    typedef typename DerivedVB::Scalar ScalarB;
+    typedef Eigen::Matrix<ScalarB,1,3> RowVector3B;
+    // Corners of a triangle still being refined, their distances to B and
+    // their closest triangles of B
+    struct Triangle
+    {
+      Eigen::Matrix<Scalar,3,3> V;
+      RowVector3S d;
+      int I[3];
+    };
+    // Distance to B, known to be at most bound, and closest triangle i
+    const auto distance = [&](const RowVector3S & p, const Scalar bound, int & i)
+    {
+      const RowVector3B q = p.template cast<ScalarB>();
+      RowVector3B c;
+      i = -1;
+      // Slightly loosened so that rounding cannot exclude the closest point
+      const Scalar up = bound*(1.+1e-8) + std::numeric_limits<Scalar>::min();
+      Scalar sqr_d = treeB.squared_distance(VB,FB,q,ScalarB(up*up),i,c);
+      if(i < 0)
+      {
+        sqr_d = treeB.squared_distance(VB,FB,q,
+          std::numeric_limits<ScalarB>::infinity(),i,c);
+      }
+      return Scalar(sqrt(sqr_d));
+    };
+    const auto upper_bound = [&](const Triangle & T)
+    {
+      RowVector3S e;
+      for(int i=0;i<3;i++)
+      {
+        e(i) = (T.V.row((i+1)%3)-T.V.row((i+2)%3)).norm();
+      }
+      Scalar u = hausdorff_triangle_upper_bound(e,T.d);
+      // The distance to a triangle of B is convex, so over T it is largest
+      // at a corner: the closest triangles of the corners often bound the
+      // whole of T as tightly as its corners
+      for(int j=0;j<3;j++)
+      {
+        if(T.I[j] < 0 || (j>0 && T.I[j] == T.I[0]) || (j>1 && T.I[j] == T.I[1]))
+        {
+          continue;
+        }
+        Scalar m = 0;
+        for(int i=0;i<3 && m<u;i++)
+        {
+          ScalarB sqr_d;
+          RowVector3B c;
+          igl::point_simplex_squared_distance<3>(
+            T.V.row(i).template cast<ScalarB>().eval(),VB,FB,T.I[j],sqr_d,c);
+          m = std::max(m,Scalar(sqrt(sqr_d)));
+        }
+        u = std::min(u,m);
+      }
+      return u;
+    };
+
+    // Distances at the corners of FA
+    std::vector<Scalar> DA(VA.rows(),-1);
+    std::vector<int> IA(VA.rows(),-1);
+    std::vector<char> referenced(VA.rows(),0);
+    for(int f = 0;f<FA.rows();f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        referenced[FA(f,c)] = 1;
+      }
+    }
+    igl::parallel_for(VA.rows(),[&](const int v)
+    {
+      if(referenced[v])
+      {
+        DA[v] = distance(VA.row(v).template cast<Scalar>(),
+          std::numeric_limits<Scalar>::infinity(),IA[v]);
+      }
+    },1000);
+    l = std::max(l0,Scalar(0));
+    for(int v = 0;v<VA.rows();v++)
+    {
+      l = std::max(l,DA[v]);
+    }
+    u = l;
+
+    std::vector<Triangle> active(FA.rows());
+    for(int f = 0;f<FA.rows();f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        active[f].V.row(c) = VA.row(FA(f,c)).template cast<Scalar>();
+        active[f].d(c) = DA[FA(f,c)];
+        active[f].I[c] = IA[FA(f,c)];
+      }
+    }
+    std::vector<Triangle> next;
+    std::vector<Scalar> bound;
+    std::vector<Scalar> midpoint_max;
+    while(true)
+    {
+      // Bound every triangle and discard those that cannot raise l by more
+      // than tol
+      bound.resize(active.size());
+      igl::parallel_for(active.size(),[&](const size_t t)
+      {
+        bound[t] = upper_bound(active[t]);
+      },1000);
+      size_t kept = 0;
+      for(size_t t = 0;t<active.size();t++)
+      {
+        if(bound[t] <= l + tol)
+        {
+          u = std::max(u,bound[t]);
+        }else
+        {
+          active[kept++] = active[t];
+        }
+      }
+      active.resize(kept);
+      if(active.empty())
+      {
+        break;
+      }
+      // Split the others 1-to-4 and query their edge midpoints
+      next.resize(4*active.size());
+      midpoint_max.resize(active.size());
+      igl::parallel_for(active.size(),[&](const size_t t)
+      {
+        const Triangle & T = active[t];
+        Eigen::Matrix<Scalar,3,3> M;
+        RowVector3S dm;
+        int Im[3];
+        for(int i=0;i<3;i++)
+        {
+          const int j = (i+1)%3;
+          const int k = (i+2)%3;
+          M.row(i) = 0.5*(T.V.row(j)+T.V.row(k));
+          // 1-Lipschitz
+          dm(i) = distance(M.row(i),
+            std::min(T.d(j),T.d(k)) + 0.5*(T.V.row(j)-T.V.row(k)).norm(),Im[i]);
+        }
+        midpoint_max[t] = dm.maxCoeff();
+        // Corner i and the midpoints of its two edges, then the middle one
+        for(int i=0;i<3;i++)
+        {
+          const int j = (i+1)%3;
+          const int k = (i+2)%3;
+          Triangle & C = next[4*t+i];
+          C.V.row(0) = T.V.row(i);
+          C.V.row(1) = M.row(k);
+          C.V.row(2) = M.row(j);
+          C.d << T.d(i), dm(k), dm(j);
+          C.I[0] = T.I[i];
+          C.I[1] = Im[k];
+          C.I[2] = Im[j];
+        }
+        next[4*t+3].V = M;
+        next[4*t+3].d = dm;
+        std::copy(Im,Im+3,next[4*t+3].I);
+      },100);
+      for(size_t t = 0;t<active.size();t++)
+      {
+        l = std::max(l,midpoint_max[t]);
+      }
+      active.swap(next);
+    }
+    u = std::max(u,l);
+  }
+}
 
 template <
   typename DerivedVA, 
@@ -36,6 +292,57 @@ IGL_INLINE void igl::hausdorff(
   d = sqrt(std::max(dba,dab));
 }
 
+template <
+  typename DerivedVA,
+  typename DerivedFA,
+  typename DerivedVB,
+  typename DerivedFB,
+  typename Scalar>
+IGL_INLINE void igl::hausdorff(
+  const Eigen::MatrixBase<DerivedVA> & VA,
+  const Eigen::MatrixBase<DerivedFA> & FA,
+  const igl::AABB<DerivedVB,3> & treeB,
+  const Eigen::MatrixBase<DerivedVB> & VB,
+  const Eigen::MatrixBase<DerivedFB> & FB,
+  const Scalar tol,
+  Scalar & l,
+  Scalar & u)
+{
+  assert(VA.cols() == 3 && "VA should contain 3d points");
+  assert(FA.cols() == 3 && "FA should contain triangles");
+  const Scalar t = hausdorff_tolerance(VA,VB,tol);
+  hausdorff_one_sided(VA,FA,treeB,VB,FB,t,Scalar(0),l,u);
+}
+
+template <
+  typename DerivedVA,
+  typename DerivedFA,
+  typename DerivedVB,
+  typename DerivedFB,
+  typename Scalar>
+IGL_INLINE void igl::hausdorff(
+  const igl::AABB<DerivedVA,3> & treeA,
+  const Eigen::MatrixBase<DerivedVA> & VA,
+  const Eigen::MatrixBase<DerivedFA> & FA,
+  const igl::AABB<DerivedVB,3> & treeB,
+  const Eigen::MatrixBase<DerivedVB> & VB,
+  const Eigen::MatrixBase<DerivedFB> & FB,
+  const Scalar tol,
+  Scalar & l,
+  Scalar & u)
+{
+  assert(VA.cols() == 3 && "VA should contain 3d points");
+  assert(FA.cols() == 3 && "FA should contain triangles");
+  assert(VB.cols() == 3 && "VB should contain 3d points");
+  assert(FB.cols() == 3 && "FB should contain triangles");
+  const Scalar t = hausdorff_tolerance(VA,VB,tol);
+  Scalar lab,uab,lba,uba;
+  hausdorff_one_sided(VA,FA,treeB,VB,FB,t,Scalar(0),lab,uab);
+  hausdorff_one_sided(VB,FB,treeA,VA,FA,t,lab,lba,uba);
+  l = std::max(lab,lba);
+  u = std::max(uab,uba);
+}
+
 template <
   typename DerivedV,
   typename Scalar>
@@ -46,45 +353,23 @@ IGL_INLINE void igl::hausdorff(
   Scalar & u)
 {
   // e  3-long vector of opposite edge lengths
-  Eigen::Matrix<typename DerivedV::Scalar,1,3> e;
-  // Maximum edge length
-  Scalar e_max = 0;
-  for(int i=0;i<3;i++)
-  {
-    e(i) = (V.row((i+1)%3)-V.row((i+2)%3)).norm();
-    e_max = std::max(e_max,e(i));
-  }
-  // Semiperimeter
-  const Scalar s = (e(0)+e(1)+e(2))*0.5;
-  // Area
-  const Scalar A = sqrt(s*(s-e(0))*(s-e(1))*(s-e(2)));
-  // Circumradius
-  const Scalar R = e(0)*e(1)*e(2)/(4.*A);
-  // inradius
-  const Scalar r = A/s;
-  // Initialize lower bound to ∞
-  l = std::numeric_limits<Scalar>::infinity();
+  Eigen::Matrix<Scalar,1,3> e;
   // d  3-long vector of distance from each corner to B
-  Eigen::Matrix<typename DerivedV::Scalar,1,3> d;
-  Scalar u1 = std::numeric_limits<Scalar>::infinity();
-  Scalar u2 = 0;
+  Eigen::Matrix<Scalar,1,3> d;
+  // Lower bound is simply the max over vertex distances
+  l = 0;
   for(int i=0;i<3;i++)
   {
+    e(i) = (V.row((i+1)%3)-V.row((i+2)%3)).norm();
     d(i) = dist_to_B(V(i,0),V(i,1),V(i,2));
-    // Lower bound is simply the max over vertex distances
     l = std::max(d(i),l);
-    // u1 is the minimum of corner distances + maximum adjacent edge 
-    u1 = std::min(u1,d(i) + std::max(e((i+1)%3),e((i+2)%3)));
-    // u2 first takes the maximum over corner distances
-    u2 = std::max(u2,d(i));
   }
-  // u2 is the distance from the circumcenter/midpoint of obtuse edge plus the
-  // largest corner distance 
-  u2 += (s-r>2.*R ? R : 0.5*e_max);
-  u = std::min(u1,u2);
+  u = hausdorff_triangle_upper_bound(e,d);
 }
 
 #ifdef IGL_STATIC_LIBRARY
 template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double&);
+template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, double&, double&);
+template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, double&, double&);
 template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::function<double (double const&, double const&, double const&)> const&, double&, double&);
 #endif
@@ -8,6 +8,7 @@
 #ifndef IGL_HAUSDORFF_H
 #define IGL_HAUSDORFF_H
 #include "igl_inline.h"
+#include "AABB.h"
 
 #include <Eigen/Dense>
 #include <functional>
@@ -54,6 +55,81 @@ namespace igl
     const Eigen::PlainObjectBase<DerivedVB> & VB, 
     const Eigen::PlainObjectBase<DerivedFB> & FB,
     Scalar & d);
+  // Bounds (l,u) on the one-sided Hausdorff distance from the surface of mesh
+  // (VA,FA) to mesh (VB,FB)
+  //
+  // h(A,B) = max min d(a,b)
+  //          a∈A b∈B
+  //
+  // including points inside the triangles of A. Every triangle of A is
+  // bounded with the triangle overload below from the distances at its
+  // corners. Triangles whose upper bound cannot exceed the largest distance
+  // found so far (plus tol) are discarded, the others are split 1-to-4 and
+  // their midpoints queried, until l and u are less than tol apart. Distance
+  // queries of each round run in parallel against the prebuilt tree of B,
+  // so one tree can serve comparisons against many meshes A.
+  //
+  // Inputs:
+  //   VA  #VA by 3 list of vertex positions
+  //   FA  #FA by 3 list of face indices into VA
+  //   treeB  AABB hierarchy of (VB,FB), see AABB::init
+  //   VB  #VB by 3 list of vertex positions
+  //   FB  #FB by 3 list of face indices into VB
+  //   tol  absolute accuracy, raised to at least sqrt(machine epsilon) times
+  //     the bounding box diagonal of A and B
+  // Outputs:
+  //   l  lower bound, the distance to B of some point of A
+  //   u  upper bound, u-l <= tol (after raising it)
+  //
+  template <
+    typename DerivedVA,
+    typename DerivedFA,
+    typename DerivedVB,
+    typename DerivedFB,
+    typename Scalar>
+  IGL_INLINE void hausdorff(
+    const Eigen::MatrixBase<DerivedVA> & VA,
+    const Eigen::MatrixBase<DerivedFA> & FA,
+    const igl::AABB<DerivedVB,3> & treeB,
+    const Eigen::MatrixBase<DerivedVB> & VB,
+    const Eigen::MatrixBase<DerivedFB> & FB,
+    const Scalar tol,
+    Scalar & l,
+    Scalar & u);
+  // Bounds (l,u) on the two-sided Hausdorff distance max(h(A,B),h(B,A))
+  // between the surfaces of meshes (VA,FA) and (VB,FB). The second direction
+  // starts from the lower bound of the first, so triangles of B that cannot
+  // raise it are discarded without being refined.
+  //
+  // Inputs:
+  //   treeA  AABB hierarchy of (VA,FA)
+  //   VA  #VA by 3 list of vertex positions
+  //   FA  #FA by 3 list of face indices into VA
+  //   treeB  AABB hierarchy of (VB,FB)
+  //   VB  #VB by 3 list of vertex positions
+  //   FB  #FB by 3 list of face indices into VB
+  //   tol  absolute accuracy, raised to at least sqrt(machine epsilon) times
+  //     the bounding box diagonal of A and B
+  // Outputs:
+  //   l  lower bound on the Hausdorff distance
+  //   u  upper bound, u-l <= tol (after raising it)
+  //
+  template <
+    typename DerivedVA,
+    typename DerivedFA,
+    typename DerivedVB,
+    typename DerivedFB,
+    typename Scalar>
+  IGL_INLINE void hausdorff(
+    const igl::AABB<DerivedVA,3> & treeA,
+    const Eigen::MatrixBase<DerivedVA> & VA,
+    const Eigen::MatrixBase<DerivedFA> & FA,
+    const igl::AABB<DerivedVB,3> & treeB,
+    const Eigen::MatrixBase<DerivedVB> & VB,
+    const Eigen::MatrixBase<DerivedFB> & FB,
+    const Scalar tol,
+    Scalar & l,
+    Scalar & u);
   // Compute lower and upper bounds (l,u) on the Hausdorff distance between a triangle
   // (V) and a pointset (e.g., mesh, triangle soup) given by a distance function
   // handle (dist_to_B).
@@ -152,8 +152,87 @@ IGL_INLINE void igl::heat_geodesics_solve(
   }
 }
 
+template < typename Scalar, typename Derivedgamma, typename DerivedD>
+IGL_INLINE void igl::heat_geodesics_solve(
+  const HeatGeodesicsData<Scalar> & data,
+  const std::vector<Derivedgamma> & gammas,
+  Eigen::PlainObjectBase<DerivedD> & D)
+{
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+  // number of mesh vertices
+  const int n = data.Grad.cols();
+  // number of source sets
+  const int k = gammas.size();
+  // Set up delta at each gamma
+  MatrixXS U0 = MatrixXS::Zero(n,k);
+  for(int s = 0;s<k;s++)
+  {
+    for(int g = 0;g<gammas[s].size();g++)
+    {
+      U0(gammas[s](g),s) = 1;
+    }
+  }
+  // Neumann solution
+  MatrixXS U;
+  igl::min_quad_with_fixed_solve(
+    data.Neumann,U0,MatrixXS(MatrixXS::Zero(0,k)),MatrixXS(),U);
+  if(data.b.size()>0)
+  {
+    // Average Dirichelt and Neumann solutions
+    MatrixXS UD;
+    igl::min_quad_with_fixed_solve(
+      data.Dirichlet,U0,MatrixXS(MatrixXS::Zero(data.b.size(),k)),MatrixXS(),UD);
+    U += UD;
+    U *= 0.5;
+  }
+  MatrixXS grad_U = data.Grad*U;
+  const int m = data.Grad.rows()/data.ng;
+  for(int s = 0;s<k;s++)
+  {
+    for(int i = 0;i<m;i++)
+    {
+      Scalar norm = 0;
+      for(int d = 0;d<data.ng;d++)
+      {
+        norm += grad_U(d*m+i,s)*grad_U(d*m+i,s);
+      }
+      norm = sqrt(norm);
+      if(norm == 0)
+      {
+        for(int d = 0;d<data.ng;d++) { grad_U(d*m+i,s) = 0; }
+      }else
+      {
+        for(int d = 0;d<data.ng;d++) { grad_U(d*m+i,s) /= norm; }
+      }
+    }
+  }
+  const MatrixXS div_X = -data.Div*grad_U;
+  MatrixXS DS;
+  igl::min_quad_with_fixed_solve(
+    data.Poisson,(-2.0*div_X).eval(),MatrixXS(MatrixXS::Zero(0,k)),
+    MatrixXS(MatrixXS::Zero(1,k)),DS);
+  for(int s = 0;s<k;s++)
+  {
+    Scalar mean = 0;
+    for(int g = 0;g<gammas[s].size();g++)
+    {
+      mean += DS(gammas[s](g),s);
+    }
+    if(gammas[s].size() > 0)
+    {
+      DS.col(s).array() -= mean/gammas[s].size();
+    }
+    if(DS.col(s).mean() < 0)
+    {
+      DS.col(s) = -DS.col(s);
+    }
+  }
+  D = DS;
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
+template void igl::heat_geodesics_solve<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::HeatGeodesicsData<double> const&, std::vector<Eigen::Matrix<int, -1, 1, 0, -1, 1>, std::allocator<Eigen::Matrix<int, -1, 1, 0, -1, 1> > > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::heat_geodesics_solve<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::HeatGeodesicsData<double> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 template bool igl::heat_geodesics_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, igl::HeatGeodesicsData<double>&);
 template bool igl::heat_geodesics_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::HeatGeodesicsData<double>&);
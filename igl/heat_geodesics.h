@@ -11,6 +11,7 @@
 #include "min_quad_with_fixed.h"
 #include <Eigen/Sparse>
 #include <Eigen/Sparse>
+#include <vector>
 namespace igl
 {
   template <typename Scalar>
@@ -60,6 +61,20 @@ namespace igl
     const HeatGeodesicsData<Scalar> & data,
     const Eigen::MatrixBase<Derivedgamma> & gamma,
     Eigen::PlainObjectBase<DerivedD> & D);
+  // Compute distances to several sets of source vertices at once, solving
+  // all sets as one multi-column right-hand side against the precomputed
+  // factorizations
+  //
+  // Inputs: 
+  //   data  precomputation data (see heat_geodesics_precompute)
+  //   gammas  #sets list of lists of indices into V of source vertices
+  // Outputs:
+  //   D  #V by #sets list of distances, column s to gammas[s]
+  template < typename Scalar, typename Derivedgamma, typename DerivedD>
+  IGL_INLINE void heat_geodesics_solve(
+    const HeatGeodesicsData<Scalar> & data,
+    const std::vector<Derivedgamma> & gammas,
+    Eigen::PlainObjectBase<DerivedD> & D);
 }
 
 #ifndef IGL_STATIC_LIBRARY
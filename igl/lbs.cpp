@@ -0,0 +1,66 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 The libigl contributors
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "lbs.h"
+#include "parallel_for.h"
+#include <cassert>
+
+template <
+  typename DerivedV,
+  typename DerivedI,
+  typename DerivedWK,
+  typename DerivedT,
+  typename DerivedU>
+IGL_INLINE void igl::lbs(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedI> & I,
+  const Eigen::MatrixBase<DerivedWK> & WK,
+  const Eigen::MatrixBase<DerivedT> & T,
+  Eigen::PlainObjectBase<DerivedU> & U)
+{
+  typedef typename DerivedU::Scalar Scalar;
+  const int dim = V.cols();
+  const int n = V.rows();
+  const int k = I.cols();
+  assert(I.rows() >= n);
+  assert(I.rows() == WK.rows() && I.cols() == WK.cols());
+  assert(T.cols() == dim);
+  assert(T.rows() % (dim+1) == 0);
+  U.resize(n,dim);
+  igl::parallel_for(n,[&](const int i)
+  {
+    for(int d = 0;d<dim;d++)
+    {
+      U(i,d) = 0;
+    }
+    for(int j = 0;j<k;j++)
+    {
+      const Scalar w = WK(i,j);
+      if(w == 0)
+      {
+        continue;
+      }
+      // Rows of the transposed transformation of handle I(i,j)
+      const int c = I(i,j)*(dim+1);
+      assert(c >= 0 && c+dim < T.rows());
+      for(int d = 0;d<dim;d++)
+      {
+        Scalar u = T(c+dim,d);
+        for(int e = 0;e<dim;e++)
+        {
+          u += V(i,e)*T(c+e,d);
+        }
+        U(i,d) += w*u;
+      }
+    }
+  },10000);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::lbs<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+#endif
@@ -0,0 +1,44 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 The libigl contributors
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_LBS_H
+#define IGL_LBS_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  // Linear blend skinning with at most k influences per vertex (see
+  // sparse_skinning_weights.h). Computes the same U as lbs_matrix(V,W,M);
+  // U = M*T without forming the dense #V by #C*(dim+1) matrix M, so the cost
+  // is O(#V*k) instead of O(#V*#C).
+  //
+  // Inputs:
+  //   V  #V by dim list of rest positions
+  //   I  #V by k list of handle indices
+  //   WK  #V by k list of corresponding weights
+  //   T  #C*(dim+1) by dim list of stacked transposed transformation
+  //     matrices (e.g. as output by forward_kinematics)
+  // Outputs:
+  //   U  #V by dim list of new positions
+  template <
+    typename DerivedV,
+    typename DerivedI,
+    typename DerivedWK,
+    typename DerivedT,
+    typename DerivedU>
+  IGL_INLINE void lbs(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedI> & I,
+    const Eigen::MatrixBase<DerivedWK> & WK,
+    const Eigen::MatrixBase<DerivedT> & T,
+    Eigen::PlainObjectBase<DerivedU> & U);
+};
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "lbs.cpp"
+#endif
+#endif
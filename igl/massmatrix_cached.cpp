@@ -0,0 +1,92 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "massmatrix_cached.h"
+#include "massmatrix_intrinsic.h"
+#include "edge_lengths.h"
+#include "sparse_cached.h"
+#include <Eigen/Geometry>
+#include <vector>
+#include <cassert>
+
+template <typename DerivedV, typename DerivedF, typename Scalar>
+IGL_INLINE void igl::massmatrix_cached_precompute(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const MassMatrixType type,
+  Eigen::VectorXi & data,
+  Eigen::SparseMatrix<Scalar>& M)
+{
+  using namespace Eigen;
+  using namespace std;
+  const int m = F.rows();
+  // One diagonal entry per element corner, corner 0 of every element first
+  // as in massmatrix
+  vector<Triplet<Scalar> > IJV;
+  IJV.reserve(F.size());
+  for(int c = 0;c<F.cols();c++)
+  {
+    for(int i = 0;i<m;i++)
+    {
+      IJV.push_back(Triplet<Scalar>(F(i,c),F(i,c),0));
+    }
+  }
+  M.resize(V.rows(),V.rows());
+  sparse_cached_precompute(IJV,data,M);
+  massmatrix_cached(V,F,type,data,M);
+}
+
+template <typename DerivedV, typename DerivedF, typename Scalar>
+IGL_INLINE void igl::massmatrix_cached(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const MassMatrixType type,
+  const Eigen::VectorXi & data,
+  Eigen::SparseMatrix<Scalar>& M)
+{
+  using namespace Eigen;
+  const int m = F.rows();
+  const int simplex_size = F.cols();
+  assert(data.size() == F.size());
+  // Column major, so corner 0 of every element comes first like the
+  // triplets of the precomputation
+  Matrix<Scalar,Dynamic,Dynamic> C;
+  if(simplex_size == 3)
+  {
+    Matrix<Scalar,Dynamic,3> l;
+    igl::edge_lengths(V,F,l);
+    massmatrix_intrinsic(l,F,type,C);
+  }else if(simplex_size == 4)
+  {
+    assert(V.cols() == 3);
+    assert(type == MASSMATRIX_TYPE_DEFAULT || type == MASSMATRIX_TYPE_BARYCENTRIC);
+    C.resize(m,4);
+    for(int i = 0;i<m;i++)
+    {
+      // http://en.wikipedia.org/wiki/Tetrahedron#Volume
+      Matrix<Scalar,3,1> v0m3,v1m3,v2m3;
+      v0m3.head(V.cols()) = V.row(F(i,0)) - V.row(F(i,3));
+      v1m3.head(V.cols()) = V.row(F(i,1)) - V.row(F(i,3));
+      v2m3.head(V.cols()) = V.row(F(i,2)) - V.row(F(i,3));
+      const Scalar v = fabs(v0m3.dot(v1m3.cross(v2m3)))/6.0;
+      C.row(i).setConstant(v/4.0);
+    }
+  }else
+  {
+    // Unsupported simplex size
+    assert(false && "Unsupported simplex size");
+    return;
+  }
+  sparse_cached(
+    Map<const Matrix<Scalar,Dynamic,1> >(C.data(),C.size()),data,M);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::massmatrix_cached_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, Eigen::Matrix<int, -1, 1, 0, -1, 1>&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix_cached<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, Eigen::Matrix<int, -1, 1, 0, -1, 1> const&, Eigen::SparseMatrix<double, 0, int>&);
+#endif
@@ -0,0 +1,49 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_MASSMATRIX_CACHED_H
+#define IGL_MASSMATRIX_CACHED_H
+#include "igl_inline.h"
+#include "massmatrix.h"
+#define EIGEN_YES_I_KNOW_SPARSE_MODULE_IS_NOT_STABLE_YET
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+namespace igl
+{
+  // Constructs the mass matrix (see massmatrix) in two phases, one fixing
+  // the sparsity pattern for a given connectivity F, and one writing the
+  // values for the current vertex positions V in place (see sparse_cached
+  // and cotmatrix_cached).
+  //
+  // Inputs:
+  //   V  #V by dim list of mesh vertex positions
+  //   F  #F by simplex_size list of mesh elements (triangles or tetrahedra)
+  //   type  see massmatrix
+  // Outputs:
+  //   data  positions of each corner's contribution among the nonzeros of M
+  //   M  #V by #V mass matrix
+  template <typename DerivedV, typename DerivedF, typename Scalar>
+  IGL_INLINE void massmatrix_cached_precompute(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const MassMatrixType type,
+    Eigen::VectorXi & data,
+    Eigen::SparseMatrix<Scalar>& M);
+  template <typename DerivedV, typename DerivedF, typename Scalar>
+  IGL_INLINE void massmatrix_cached(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const MassMatrixType type,
+    const Eigen::VectorXi & data,
+    Eigen::SparseMatrix<Scalar>& M);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "massmatrix_cached.cpp"
+#endif
+
+#endif
@@ -33,9 +33,32 @@ IGL_INLINE void igl::massmatrix_intrinsic(
   const MassMatrixType type,
   const int n,
   Eigen::SparseMatrix<Scalar>& M)
+{
+  using namespace Eigen;
+  const int m = F.rows();
+  Matrix<Scalar,Dynamic,Dynamic> C;
+  massmatrix_intrinsic(l,F,type,C);
+  // diagonal entries for each face corner
+  Matrix<int,Dynamic,1> MI(m*3,1);
+  MI.block(0*m,0,m,1) = F.col(0);
+  MI.block(1*m,0,m,1) = F.col(1);
+  MI.block(2*m,0,m,1) = F.col(2);
+  // C is column major, so this lists corner 0 of every face first like MI
+  const Matrix<Scalar,Dynamic,1> MV =
+    Map<const Matrix<Scalar,Dynamic,1> >(C.data(),m*3);
+  sparse(MI,MI,MV,n,n,M);
+}
+
+template <typename Derivedl, typename DerivedF, typename DerivedC>
+IGL_INLINE void igl::massmatrix_intrinsic(
+  const Eigen::MatrixBase<Derivedl> & l, 
+  const Eigen::MatrixBase<DerivedF> & F, 
+  const MassMatrixType type,
+  Eigen::PlainObjectBase<DerivedC>& C)
 {
   using namespace Eigen;
   using namespace std;
+  typedef typename DerivedC::Scalar Scalar;
   MassMatrixType eff_type = type;
   const int m = F.rows();
   const int simplex_size = F.cols();
@@ -47,31 +70,18 @@ IGL_INLINE void igl::massmatrix_intrinsic(
   assert(F.cols() == 3 && "only triangles supported");
   Matrix<Scalar,Dynamic,1> dblA;
   doublearea(l,0.,dblA);
-  Matrix<int,Dynamic,1> MI;
-  Matrix<int,Dynamic,1> MJ;
-  Matrix<Scalar,Dynamic,1> MV;
+  C.resize(m,3);
 
   switch(eff_type)
   {
     case MASSMATRIX_TYPE_BARYCENTRIC:
-      // diagonal entries for each face corner
-      MI.resize(m*3,1); MJ.resize(m*3,1); MV.resize(m*3,1);
-      MI.block(0*m,0,m,1) = F.col(0);
-      MI.block(1*m,0,m,1) = F.col(1);
-      MI.block(2*m,0,m,1) = F.col(2);
-      MJ = MI;
-      repmat(dblA,3,1,MV);
-      MV.array() /= 6.0;
+      C.col(0) = dblA/6.0;
+      C.col(1) = dblA/6.0;
+      C.col(2) = dblA/6.0;
       break;
     case MASSMATRIX_TYPE_VORONOI:
       {
-        // diagonal entries for each face corner
         // http://www.alecjacobson.com/weblog/?p=874
-        MI.resize(m*3,1); MJ.resize(m*3,1); MV.resize(m*3,1);
-        MI.block(0*m,0,m,1) = F.col(0);
-        MI.block(1*m,0,m,1) = F.col(1);
-        MI.block(2*m,0,m,1) = F.col(2);
-        MJ = MI;
 
         // Holy shit this needs to be cleaned up and optimized
         Matrix<Scalar,Dynamic,3> cosines(m,3);
@@ -104,9 +114,7 @@ IGL_INLINE void igl::massmatrix_intrinsic(
         quads.col(1) = (cosines.col(2).array()<0).select(0.125*dblA,quads.col(1));
         quads.col(2) = (cosines.col(2).array()<0).select( 0.25*dblA,quads.col(2));
 
-        MV.block(0*m,0,m,1) = quads.col(0);
-        MV.block(1*m,0,m,1) = quads.col(1);
-        MV.block(2*m,0,m,1) = quads.col(2);
+        C = quads;
         
         break;
       }
@@ -116,7 +124,6 @@ IGL_INLINE void igl::massmatrix_intrinsic(
     default:
       assert(false && "Unknown Mass matrix eff_type");
   }
-  sparse(MI,MJ,MV,n,n,M);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -125,4 +132,5 @@ template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>,
 template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 #endif
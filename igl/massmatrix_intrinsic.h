@@ -45,6 +45,17 @@ namespace igl
     const MassMatrixType type,
     const int n,
     Eigen::SparseMatrix<Scalar>& M);
+  // Per-element contributions to the mass of each corner, M(i,i) is the sum
+  // of the entries of C at the corners of vertex i
+  //
+  // Outputs:
+  //   C  #F by simplex_size list of masses
+  template <typename Derivedl, typename DerivedF, typename DerivedC>
+  IGL_INLINE void massmatrix_intrinsic(
+    const Eigen::MatrixBase<Derivedl> & l, 
+    const Eigen::MatrixBase<DerivedF> & F, 
+    const MassMatrixType type,
+    Eigen::PlainObjectBase<DerivedC>& C);
 }
 
 #ifndef IGL_STATIC_LIBRARY
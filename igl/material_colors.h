@@ -35,16 +35,16 @@ namespace igl
   const float rubby_specular[4] = { 0.727811f, 0.626959f, 0.626959f, 0.55f };
 
   //Green plastic
-  float grass_mat_ambient[4] = { 0.0f,0.0f,0.0f,1.0f };
-  float grass_mat_diffuse[4] = { 0.1f,0.35f,0.1f,1.0f };
-  float grass_mat_specular[4] = { 0.45f,0.55f,0.45f,1.0f };
-  float shine = 32.0f;
+  const float grass_mat_ambient[4] = { 0.0f,0.0f,0.0f,1.0f };
+  const float grass_mat_diffuse[4] = { 0.1f,0.35f,0.1f,1.0f };
+  const float grass_mat_specular[4] = { 0.45f,0.55f,0.45f,1.0f };
+  const float shine = 32.0f;
 
 
   //Silver
-  float grey_mat_ambient[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-  float grey_mat_diffuse[4] = { 0.50754f, 0.50754f, 0.50754f, 1.0f };
-  float grey_mat_specular[4] = { 0.508273f, 0.508273f, 0.508273f, 1.0f };
+  const float grey_mat_ambient[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+  const float grey_mat_diffuse[4] = { 0.50754f, 0.50754f, 0.50754f, 1.0f };
+  const float grey_mat_specular[4] = { 0.508273f, 0.508273f, 0.508273f, 1.0f };
 
   // Blue/Cyan more similar to Jovan Popovic's blue than to Mario Botsch's blue
   const float CYAN_AMBIENT[4] =   {  59.0/255.0, 68.0/255.0,255.0/255.0,1.0f };
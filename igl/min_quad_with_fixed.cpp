@@ -8,6 +8,7 @@
 #include "min_quad_with_fixed.h"
 
 #include "slice.h"
+#include "slice_cached.h"
 #include "is_symmetric.h"
 #include "find.h"
 #include "sparse.h"
@@ -19,6 +20,7 @@
 // Bug in unsupported/Eigen/SparseExtra needs iostream first
 #include <iostream>
 #include <unsupported/Eigen/SparseExtra>
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <iostream>
@@ -102,8 +104,9 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
     data.unknown_lagrange.tail(data.lagrange.size()) = data.lagrange;
   }
 
-  SparseMatrix<T> Auu;
-  slice(A,data.unknown,data.unknown,Auu);
+  // Slices are cached so that min_quad_with_fixed_refactorize can refill them
+  slice_cached_precompute(A,data.unknown,data.unknown,data.Auu_slice,data.Auu);
+  const SparseMatrix<T> & Auu = data.Auu;
   assert(Auu.size() != 0 && Auu.rows() > 0 && "There should be at least one unknown.");
 
   // Positive definiteness is *not* determined, rather it is given as a
@@ -179,24 +182,58 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
     // This is a bit slower. But why isn't cat fast?
     new_A = cat(1, cat(2,   A, AeqT ),
                    cat(2, Aeq,    Z ));
+    // Positions in the values of A of the values of new_A, in the order
+    // slice_cached numbers them, or -1 for those of Aeq. Slices of new_A are
+    // refilled from A directly by min_quad_with_fixed_refactorize.
+    VectorXi new_A_in_A(new_A.nonZeros());
+    {
+      int p = 0;
+      for(int j = 0;j<new_A.outerSize();j++)
+      {
+        for(typename SparseMatrix<T>::InnerIterator it(new_A,j);it;++it,++p)
+        {
+          new_A_in_A(p) = -1;
+          if(j < n && it.row() < n)
+          {
+            const int * begin = A.innerIndexPtr()+A.outerIndexPtr()[j];
+            const int * end = A.innerIndexPtr()+A.outerIndexPtr()[j+1];
+            const int * r = std::lower_bound(begin,end,(int)it.row());
+            if(r != end && *r == it.row())
+            {
+              new_A_in_A(p) = r-A.innerIndexPtr();
+            }
+          }
+        }
+      }
+    }
+    const auto & to_A_positions = [&new_A_in_A](VectorXi & slice)
+    {
+      for(int i = 0;i<slice.size();i++)
+      {
+        slice(i) = new_A_in_A(slice(i));
+      }
+    };
 
     // precompute RHS builders
     if(kr > 0)
     {
-      SparseMatrix<T> Aulk,Akul;
       // Slow
-      slice(new_A,data.unknown_lagrange,data.known,Aulk);
+      slice_cached_precompute(
+        new_A,data.unknown_lagrange,data.known,data.preY1_slice,data.preY1);
+      to_A_positions(data.preY1_slice);
       //// This doesn't work!!!
       //data.preY = Aulk + Akul.transpose();
       // Slow
       if(data.Auu_sym)
       {
-        data.preY = Aulk*2;
+        data.preY = data.preY1*2;
       }else
       {
-        slice(new_A,data.known,data.unknown_lagrange,Akul);
-        SparseMatrix<T> AkulT = Akul.transpose();
-        data.preY = Aulk + AkulT;
+        slice_cached_precompute(
+          new_A,data.known,data.unknown_lagrange,data.preY2_slice,data.preY2);
+        to_A_positions(data.preY2_slice);
+        SparseMatrix<T> AkulT = data.preY2.transpose();
+        data.preY = data.preY1 + AkulT;
       }
     }else
     {
@@ -232,9 +269,10 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
     cout<<"    ldlt"<<endl;
 #endif
       // Either not PD or there are equality constraints
-      SparseMatrix<T> NA;
-      slice(new_A,data.unknown_lagrange,data.unknown_lagrange,NA);
-      data.NA = NA;
+      slice_cached_precompute(
+        new_A,data.unknown_lagrange,data.unknown_lagrange,data.NA_slice,data.NA);
+      to_A_positions(data.NA_slice);
+      const SparseMatrix<T> & NA = data.NA;
       // Ideally we'd use LDLT but Eigen doesn't support positive semi-definite
       // matrices:
       // http://forum.kde.org/viewtopic.php?f=74&t=106962&p=291990#p291990
@@ -362,14 +400,12 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
     cout<<"    smash"<<endl;
 #endif
     // Known value multiplier
-    SparseMatrix<T> Auk;
-    slice(A,data.unknown,data.known,Auk);
-    SparseMatrix<T> Aku;
-    slice(A,data.known,data.unknown,Aku);
-    SparseMatrix<T> AkuT = Aku.transpose();
-    data.preY = Auk + AkuT;
-    // Needed during solve
-    data.Auu = Auu;
+    slice_cached_precompute(
+      A,data.unknown,data.known,data.preY1_slice,data.preY1);
+    slice_cached_precompute(
+      A,data.known,data.unknown,data.preY2_slice,data.preY2);
+    SparseMatrix<T> AkuT = data.preY2.transpose();
+    data.preY = data.preY1 + AkuT;
     slice(Aeq,data.known,2,data.Aeqk);
     assert(data.Aeqk.rows() == neq);
     assert(data.Aeqk.cols() == data.known.size());
@@ -378,6 +414,111 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
 }
 
 
+template <typename T>
+IGL_INLINE bool igl::min_quad_with_fixed_refactorize(
+  const Eigen::SparseMatrix<T>& A2,
+  const Eigen::SparseMatrix<T>& Aeq,
+  min_quad_with_fixed_data<T> & data)
+{
+  using namespace Eigen;
+  using namespace std;
+  assert(A2.rows() == data.n && "A should match min_quad_with_fixed_precompute");
+  assert(Aeq.rows() == data.lagrange.size() &&
+    "Aeq should match min_quad_with_fixed_precompute");
+  // The cached positions index the compressed values of A
+  if(!A2.isCompressed())
+  {
+    SparseMatrix<T> A2c = A2;
+    A2c.makeCompressed();
+    return min_quad_with_fixed_refactorize(A2c,Aeq,data);
+  }
+  const T * A2_values = A2.valuePtr();
+  // Writes the values of A (with the 0.5 scaling of
+  // min_quad_with_fixed_precompute) into the block B sliced from it. Values
+  // at position -1 come from Aeq and don't change.
+  const auto & refill = [A2_values](
+    const VectorXi & positions,
+    SparseMatrix<T> & B)
+  {
+    T * B_values = B.valuePtr();
+    for(int i = 0;i<positions.size();i++)
+    {
+      if(positions(i) >= 0)
+      {
+        B_values[i] = 0.5*A2_values[positions(i)];
+      }
+    }
+  };
+  const int kr = data.known.size();
+  refill(data.Auu_slice,data.Auu);
+  // Returns false and reports if the last factorization failed
+  const auto & check = [](const Eigen::ComputationInfo info)->bool
+  {
+    switch(info)
+    {
+      case Eigen::Success:
+        return true;
+      case Eigen::NumericalIssue:
+        cerr<<"Error: Numerical issue."<<endl;
+        return false;
+      default:
+        cerr<<"Error: Other."<<endl;
+        return false;
+    }
+  };
+  if(data.Aeq_li)
+  {
+    if(kr > 0)
+    {
+      refill(data.preY1_slice,data.preY1);
+      if(data.Auu_sym)
+      {
+        // Same pattern as preY1
+        for(int i = 0;i<data.preY.nonZeros();i++)
+        {
+          data.preY.valuePtr()[i] = 2*data.preY1.valuePtr()[i];
+        }
+      }else
+      {
+        refill(data.preY2_slice,data.preY2);
+        SparseMatrix<T> AkulT = data.preY2.transpose();
+        data.preY = data.preY1 + AkulT;
+      }
+    }
+    switch(data.solver_type)
+    {
+      case min_quad_with_fixed_data<T>::LLT:
+        data.llt.factorize(data.Auu);
+        return check(data.llt.info());
+      case min_quad_with_fixed_data<T>::LDLT:
+        refill(data.NA_slice,data.NA);
+        data.ldlt.factorize(data.NA);
+        return check(data.ldlt.info());
+      case min_quad_with_fixed_data<T>::LU:
+        refill(data.NA_slice,data.NA);
+        data.lu.factorize(data.NA);
+        return check(data.lu.info());
+      default:
+        cerr<<"Error: invalid solver type"<<endl;
+        return false;
+    }
+  }
+  // The QR decomposition of the constraints is unchanged, only the projected
+  // hessian is refactored
+  assert(data.solver_type == min_quad_with_fixed_data<T>::QR_LLT);
+  SparseMatrix<T> QRAuu = data.AeqTQ2T * data.Auu * data.AeqTQ2;
+  data.llt.factorize(QRAuu);
+  if(!check(data.llt.info()))
+  {
+    return false;
+  }
+  refill(data.preY1_slice,data.preY1);
+  refill(data.preY2_slice,data.preY2);
+  SparseMatrix<T> AkuT = data.preY2.transpose();
+  data.preY = data.preY1 + AkuT;
+  return true;
+}
+
 template <
   typename T,
   typename DerivedB,
@@ -588,6 +729,7 @@ template bool igl::min_quad_with_fixed_solve<double, Eigen::Matrix<double, -1, 1
 #endif
 template bool igl::min_quad_with_fixed<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template bool igl::min_quad_with_fixed_solve<double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::min_quad_with_fixed_data<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template bool igl::min_quad_with_fixed_refactorize<double>(Eigen::SparseMatrix<double, 0, int> const&, Eigen::SparseMatrix<double, 0, int> const&, igl::min_quad_with_fixed_data<double>&);
 template bool igl::min_quad_with_fixed_precompute<double, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::SparseMatrix<double, 0, int> const&, bool, igl::min_quad_with_fixed_data<double>&);
 template bool igl::min_quad_with_fixed_solve<double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::min_quad_with_fixed_data<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 template bool igl::min_quad_with_fixed_solve<double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::min_quad_with_fixed_data<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
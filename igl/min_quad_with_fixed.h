@@ -59,6 +59,29 @@ namespace igl
     const bool pd,
     min_quad_with_fixed_data<T> & data
     );
+  // Refactor a system previously factored using min_quad_with_fixed_precompute
+  // after the values of A changed but not its sparsity pattern, for example
+  // the Laplacian of a deforming mesh (see cotmatrix_cached). The blocks of A
+  // are refilled in place and only the numeric factorization is redone, the
+  // fill-reducing ordering and symbolic analysis are reused.
+  //
+  // Templates:
+  //   T  should be a eigen matrix primitive type like int or double
+  // Inputs:
+  //   A  n by n matrix of quadratic coefficients, with the same sparsity
+  //     pattern as the A passed to min_quad_with_fixed_precompute
+  //   Aeq  m by n list of linear equality constraint coefficients, the same
+  //     as passed to min_quad_with_fixed_precompute
+  //   data  factorization struct from min_quad_with_fixed_precompute
+  // Outputs:
+  //   data  factorization struct ready for min_quad_with_fixed_solve
+  // Returns true on success, false on error
+  template <typename T>
+  IGL_INLINE bool min_quad_with_fixed_refactorize(
+    const Eigen::SparseMatrix<T>& A,
+    const Eigen::SparseMatrix<T>& Aeq,
+    min_quad_with_fixed_data<T> & data
+    );
   // Solves a system previously factored using min_quad_with_fixed_precompute
   //
   // Template:
@@ -167,7 +190,17 @@ struct igl::min_quad_with_fixed_data
   Eigen::SparseMatrix<T> AeqTR1T;
   Eigen::SparseMatrix<T> AeqTE;
   Eigen::SparseMatrix<T> AeqTET;
-  // Debug
+  // Blocks of A (or of [A Aeq';Aeq 0]) summed into preY
+  Eigen::SparseMatrix<T> preY1;
+  Eigen::SparseMatrix<T> preY2;
+  // Positions of the values of Auu, preY1, preY2 and NA in the compressed
+  // values of A, or -1 for those taken from Aeq, used by
+  // min_quad_with_fixed_refactorize to refill them in place
+  Eigen::VectorXi Auu_slice;
+  Eigen::VectorXi preY1_slice;
+  Eigen::VectorXi preY2_slice;
+  Eigen::VectorXi NA_slice;
+  // Matrix factored by lu
   Eigen::SparseMatrix<T> NA;
   Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> NB;
 };
@@ -89,7 +89,7 @@ public:
   Eigen::Matrix<unsigned, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> points_F_vbo;
 
   // Marks dirty buffers that need to be uploaded to OpenGL
-  uint32_t dirty;
+  uint32_t dirty = DIRTY_ALL;
 
   // Initialize shaders and buffers
   IGL_INLINE void init();
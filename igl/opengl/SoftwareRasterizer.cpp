@@ -0,0 +1,658 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "SoftwareRasterizer.h"
+#include "ViewerCore.h"
+#include "ViewerData.h"
+#include "../parallel_for.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+  // Clip space outcodes, one bit per plane of the view volume
+  enum SoftwareRasterizerOutcode
+  {
+    SOFTWARE_RASTERIZER_LEFT = 1,
+    SOFTWARE_RASTERIZER_RIGHT = 2,
+    SOFTWARE_RASTERIZER_BOTTOM = 4,
+    SOFTWARE_RASTERIZER_TOP = 8,
+    SOFTWARE_RASTERIZER_NEAR = 16,
+    SOFTWARE_RASTERIZER_FAR = 32
+  };
+
+  inline unsigned char software_rasterizer_outcode(const Eigen::Vector4f& c)
+  {
+    return
+      (c(0) < -c(3) ? SOFTWARE_RASTERIZER_LEFT : 0) |
+      (c(0) > c(3) ? SOFTWARE_RASTERIZER_RIGHT : 0) |
+      (c(1) < -c(3) ? SOFTWARE_RASTERIZER_BOTTOM : 0) |
+      (c(1) > c(3) ? SOFTWARE_RASTERIZER_TOP : 0) |
+      (c(2) < -c(3) ? SOFTWARE_RASTERIZER_NEAR : 0) |
+      (c(2) > c(3) ? SOFTWARE_RASTERIZER_FAR : 0);
+  }
+
+  inline unsigned char software_rasterizer_unorm(const float x)
+  {
+    return (unsigned char)(std::min(std::max(x,0.f),1.f)*255.f + 0.5f);
+  }
+}
+
+IGL_INLINE igl::opengl::SoftwareRasterizer::SoftwareRasterizer():
+  m_width(0),
+  m_height(0),
+  m_tiles_x(0),
+  m_tiles_y(0)
+{
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::resize(
+  const int width,
+  const int height)
+{
+  m_width = std::max(width,0);
+  m_height = std::max(height,0);
+  m_tiles_x = (m_width + TILE_SIZE - 1) / TILE_SIZE;
+  m_tiles_y = (m_height + TILE_SIZE - 1) / TILE_SIZE;
+  m_rgba.assign(size_t(m_width) * m_height * 4, 0);
+  m_depth.assign(size_t(m_width) * m_height, 1.f);
+  m_bins.resize(m_tiles_x * m_tiles_y);
+}
+
+IGL_INLINE int igl::opengl::SoftwareRasterizer::width() const
+{
+  return m_width;
+}
+
+IGL_INLINE int igl::opengl::SoftwareRasterizer::height() const
+{
+  return m_height;
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::clear(
+  const Eigen::Vector4f& color)
+{
+  unsigned char c[4];
+  for (int i = 0; i < 4; ++i)
+    c[i] = software_rasterizer_unorm(color(i));
+  for (size_t p = 0; p < m_depth.size(); ++p)
+    std::copy(c, c + 4, m_rgba.begin() + 4 * p);
+  std::fill(m_depth.begin(), m_depth.end(), 1.f);
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::draw(
+  ViewerCore& core,
+  const Eigen::Matrix4f& worldMat,
+  ViewerData& data,
+  bool update_matrices)
+{
+  if (m_width == 0 || m_height == 0)
+    return;
+
+  // Render into the whole buffer, as draw_buffer does
+  const Eigen::Vector4f viewport_ori = core.viewport;
+  core.viewport << 0, 0, m_width, m_height;
+  if (update_matrices)
+    core.update_camera(worldMat);
+  core.viewport = viewport_ori;
+
+  // Refresh the CPU side of the buffers only, the OpenGL upload is left to
+  // the next updateGL through meshgl.dirty
+  if (data.dirty)
+  {
+    ViewerData::update_buffers(data, data.invert_normals, data.meshgl);
+    data.dirty = MeshGL::DIRTY_NONE;
+  }
+
+  core.view = core.camera_view * data.MakeTrans();
+  core.norm = core.view.inverse().transpose();
+
+  const MeshGL& meshgl = data.meshgl;
+  if (data.V.rows() > 0 && (core.is_set(data.show_faces) || core.is_set(data.show_lines)))
+  {
+    shade_vertices(core, data);
+    setup_triangles(data);
+
+    if (core.is_set(data.show_faces))
+    {
+      bin_triangles();
+      igl::parallel_for(m_tiles_x * m_tiles_y, [&](const int t)
+      {
+        rasterize_tile(t, core, data);
+      }, 1);
+    }
+
+    if (core.is_set(data.show_lines))
+    {
+      const Eigen::Vector3f line_color = data.line_color.head<3>();
+      for (int f = 0; f < meshgl.F_vbo.rows(); ++f)
+      {
+        const unsigned * v = meshgl.F_vbo.row(f).data();
+        if (m_outcodes[v[0]] & m_outcodes[v[1]] & m_outcodes[v[2]])
+          continue;
+        for (int i = 0; i < 3; ++i)
+        {
+          draw_line(
+            m_vertices[v[i]].clip, m_vertices[v[(i + 1) % 3]].clip,
+            line_color, line_color, data.line_width, core.depth_test);
+        }
+      }
+    }
+  }
+
+  if (core.is_set(data.show_overlay))
+  {
+    const bool depth_test = core.is_set(data.show_overlay_depth);
+    const Eigen::Matrix4f clip = core.proj * core.view;
+    for (int i = 0; i + 1 < meshgl.lines_V_vbo.rows(); i += 2)
+    {
+      draw_line(
+        clip * meshgl.lines_V_vbo.row(i).transpose().homogeneous(),
+        clip * meshgl.lines_V_vbo.row(i + 1).transpose().homogeneous(),
+        meshgl.lines_V_colors_vbo.row(i).transpose(),
+        meshgl.lines_V_colors_vbo.row(i + 1).transpose(),
+        data.line_width, depth_test);
+    }
+    for (int i = 0; i < meshgl.points_V_vbo.rows(); ++i)
+    {
+      draw_point(
+        clip * meshgl.points_V_vbo.row(i).transpose().homogeneous(),
+        meshgl.points_V_colors_vbo.row(i).transpose(),
+        data.point_size, depth_test);
+    }
+  }
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::draw_buffer(
+  ViewerCore& core,
+  const Eigen::Matrix4f& worldMat,
+  ViewerData& data,
+  bool update_matrices,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& R,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& G,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& B,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& A)
+{
+  assert(R.rows() == G.rows() && G.rows() == B.rows() && B.rows() == A.rows());
+  assert(R.cols() == G.cols() && G.cols() == B.cols() && B.cols() == A.cols());
+
+  if (m_width != R.rows() || m_height != R.cols())
+    resize(R.rows(), R.cols());
+  const Eigen::Vector4f background = core.background_color;
+  clear(Eigen::Vector4f(background(0), background(1), background(2), 0.f));
+  draw(core, worldMat, data, update_matrices);
+  get_buffer(R, G, B, A);
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::get_buffer(
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& R,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& G,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& B,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& A) const
+{
+  R.resize(m_width, m_height);
+  G.resize(m_width, m_height);
+  B.resize(m_width, m_height);
+  A.resize(m_width, m_height);
+  // Pixel (i,j) is entry (i,j), which is also the layout of m_rgba
+  for (size_t p = 0; p < m_depth.size(); ++p)
+  {
+    R(p) = m_rgba[4 * p + 0];
+    G(p) = m_rgba[4 * p + 1];
+    B(p) = m_rgba[4 * p + 2];
+    A(p) = m_rgba[4 * p + 3];
+  }
+}
+
+IGL_INLINE const std::vector<unsigned char>& igl::opengl::SoftwareRasterizer::rgba() const
+{
+  return m_rgba;
+}
+
+IGL_INLINE const std::vector<float>& igl::opengl::SoftwareRasterizer::depth() const
+{
+  return m_depth;
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::shade_vertices(
+  const ViewerCore& core,
+  const ViewerData& data)
+{
+  // Vertex shader of MeshGL
+  const MeshGL& meshgl = data.meshgl;
+  const int n = meshgl.V_vbo.rows();
+  const int dim = std::min<int>(meshgl.V_vbo.cols(), 3);
+  const bool has_normals = meshgl.V_normals_vbo.rows() == n;
+  const bool has_uv = meshgl.V_uv_vbo.rows() == n && meshgl.V_uv_vbo.cols() >= 2;
+  const MeshGL::RowMatrixXf * materials[3] =
+    {&meshgl.V_ambient_vbo, &meshgl.V_diffuse_vbo, &meshgl.V_specular_vbo};
+  m_vertices.resize(n);
+  m_outcodes.resize(n);
+  igl::parallel_for(n, [&](const int i)
+  {
+    Vertex& vertex = m_vertices[i];
+    Eigen::Vector4f position(0, 0, 0, 1);
+    position.head(dim) = meshgl.V_vbo.row(i).head(dim).transpose();
+    const Eigen::Vector4f eye = core.view * position;
+    vertex.clip = core.proj * eye;
+    m_outcodes[i] = software_rasterizer_outcode(vertex.clip);
+
+    float * a = vertex.attributes;
+    Eigen::Vector3f normal = Eigen::Vector3f::Zero();
+    if (has_normals)
+    {
+      normal = (core.norm * Eigen::Vector4f(
+        meshgl.V_normals_vbo(i, 0),
+        meshgl.V_normals_vbo(i, 1),
+        meshgl.V_normals_vbo(i, 2), 0)).head<3>();
+      normal.normalize();
+    }
+    for (int k = 0; k < 3; ++k)
+    {
+      a[k] = eye(k);
+      a[3 + k] = normal(k);
+    }
+    for (int m = 0; m < 3; ++m)
+    {
+      const MeshGL::RowMatrixXf& K = *materials[m];
+      for (int c = 0; c < 4; ++c)
+        a[6 + 4 * m + c] = K.rows() == n && c < K.cols() ? K(i, c) : 0.f;
+    }
+    a[18] = has_uv ? meshgl.V_uv_vbo(i, 0) : 0.f;
+    a[19] = has_uv ? meshgl.V_uv_vbo(i, 1) : 0.f;
+  }, 1000);
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::setup_triangles(
+  const ViewerData& data)
+{
+  const MeshGL& meshgl = data.meshgl;
+
+  // Faces outside the view volume are dropped and faces crossing the near
+  // plane are clipped, so that every vertex left has w > 0. The other planes
+  // are handled by the pixel bounds and the depth range.
+  m_faces.clear();
+  for (int f = 0; f < meshgl.F_vbo.rows(); ++f)
+  {
+    const unsigned * v = meshgl.F_vbo.row(f).data();
+    const unsigned char o[3] = {m_outcodes[v[0]], m_outcodes[v[1]], m_outcodes[v[2]]};
+    if (o[0] & o[1] & o[2])
+      continue;
+    if (!((o[0] | o[1] | o[2]) & SOFTWARE_RASTERIZER_NEAR))
+    {
+      m_faces.emplace_back(v[0], v[1], v[2]);
+      continue;
+    }
+    // Sutherland-Hodgman against z + w >= 0, in clip space where all the
+    // attributes are linear
+    int polygon[4];
+    int count = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+      const int a = v[i];
+      const int b = v[(i + 1) % 3];
+      const float da = m_vertices[a].clip(2) + m_vertices[a].clip(3);
+      const float db = m_vertices[b].clip(2) + m_vertices[b].clip(3);
+      if (da >= 0)
+        polygon[count++] = a;
+      if ((da >= 0) != (db >= 0))
+      {
+        const float t = da / (da - db);
+        Vertex vertex;
+        const Vertex& va = m_vertices[a];
+        const Vertex& vb = m_vertices[b];
+        vertex.clip = va.clip + t * (vb.clip - va.clip);
+        for (int k = 0; k < NUM_ATTRIBUTES; ++k)
+          vertex.attributes[k] = va.attributes[k] + t * (vb.attributes[k] - va.attributes[k]);
+        polygon[count++] = m_vertices.size();
+        m_vertices.push_back(vertex);
+      }
+    }
+    for (int i = 2; i < count; ++i)
+      m_faces.emplace_back(polygon[0], polygon[i - 1], polygon[i]);
+  }
+
+  const float width = m_width;
+  const float height = m_height;
+  m_triangles.resize(m_faces.size());
+  igl::parallel_for((int)m_faces.size(), [&](const int f)
+  {
+    Triangle& triangle = m_triangles[f];
+    float x[3], y[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      const int v = m_faces[f](i);
+      const Eigen::Vector4f clip = m_vertices[v].clip;
+      triangle.v[i] = v;
+      triangle.inv_w[i] = 1.f / clip(3);
+      x[i] = (clip(0) * triangle.inv_w[i] + 1.f) * 0.5f * width;
+      y[i] = (clip(1) * triangle.inv_w[i] + 1.f) * 0.5f * height;
+      triangle.z[i] = clip(2) * triangle.inv_w[i] * 0.5f + 0.5f;
+    }
+    const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    triangle.area = std::abs(area);
+    // Empty bounds for degenerate triangles
+    triangle.x0 = triangle.y0 = 0;
+    triangle.x1 = triangle.y1 = -1;
+    if (!(triangle.area > 0) || !std::isfinite(triangle.area))
+      return;
+    // Both windings are drawn, as in ViewerCore::draw. The edge functions of
+    // a shared edge are exact opposites, which together with the top-left
+    // rule covers each pixel center once.
+    const float sign = area > 0 ? 1.f : -1.f;
+    for (int i = 0; i < 3; ++i)
+    {
+      const int j = (i + 1) % 3;
+      const int k = (i + 2) % 3;
+      Eigen::Vector3f& e = triangle.edge[i];
+      e << y[j] - y[k], x[k] - x[j], x[j] * y[k] - x[k] * y[j];
+      e *= sign;
+      triangle.top_left[i] = e(0) > 0 || (e(0) == 0 && e(1) < 0);
+    }
+    // Pixel centers are at half integers
+    const float xmin = std::min(x[0], std::min(x[1], x[2]));
+    const float xmax = std::max(x[0], std::max(x[1], x[2]));
+    const float ymin = std::min(y[0], std::min(y[1], y[2]));
+    const float ymax = std::max(y[0], std::max(y[1], y[2]));
+    const auto clamp = [](const float a, const float lo, const float hi)
+    {
+      return int(std::min(std::max(a, lo), hi));
+    };
+    triangle.x0 = clamp(std::ceil(xmin - 0.5f), 0.f, width);
+    triangle.y0 = clamp(std::ceil(ymin - 0.5f), 0.f, height);
+    triangle.x1 = clamp(std::floor(xmax - 0.5f), -1.f, width - 1.f);
+    triangle.y1 = clamp(std::floor(ymax - 0.5f), -1.f, height - 1.f);
+  }, 1000);
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::bin_triangles()
+{
+  for (auto& bin : m_bins)
+    bin.clear();
+  // In order, so that blending within a tile follows the face order
+  for (int t = 0; t < (int)m_triangles.size(); ++t)
+  {
+    const Triangle& triangle = m_triangles[t];
+    if (triangle.x0 > triangle.x1 || triangle.y0 > triangle.y1)
+      continue;
+    for (int ty = triangle.y0 / TILE_SIZE; ty <= triangle.y1 / TILE_SIZE; ++ty)
+      for (int tx = triangle.x0 / TILE_SIZE; tx <= triangle.x1 / TILE_SIZE; ++tx)
+        m_bins[ty * m_tiles_x + tx].push_back(t);
+  }
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::rasterize_tile(
+  const int t,
+  const ViewerCore& core,
+  const ViewerData& data)
+{
+  typedef Eigen::Array<float,8,1> Lanes;
+  const MeshGL& meshgl = data.meshgl;
+  const int tile_x0 = (t % m_tiles_x) * TILE_SIZE;
+  const int tile_y0 = (t / m_tiles_x) * TILE_SIZE;
+  const int tile_x1 = std::min(tile_x0 + TILE_SIZE, m_width) - 1;
+  const int tile_y1 = std::min(tile_y0 + TILE_SIZE, m_height) - 1;
+
+  // Uniforms of the mesh shader
+  const Eigen::Vector3f light = core.light_position;
+  const float lighting_factor = core.lighting_factor;
+  const float specular_exponent = data.shininess;
+  const bool textured = core.is_set(data.show_texture) &&
+    meshgl.tex_u > 0 && meshgl.tex_v > 0 &&
+    meshgl.tex.size() == 4 * meshgl.tex_u * meshgl.tex_v;
+  // Bilinear lookup with GL_REPEAT, as set up by MeshGL
+  const auto texture = [&](const float s, const float r) -> Eigen::Vector4f
+  {
+    const float u = s * meshgl.tex_u - 0.5f;
+    const float v = r * meshgl.tex_v - 0.5f;
+    const float fu = std::floor(u);
+    const float fv = std::floor(v);
+    const float wu = u - fu;
+    const float wv = v - fv;
+    Eigen::Vector4f color = Eigen::Vector4f::Zero();
+    for (int dv = 0; dv < 2; ++dv)
+    {
+      for (int du = 0; du < 2; ++du)
+      {
+        int i = (int(fu) + du) % meshgl.tex_u;
+        int j = (int(fv) + dv) % meshgl.tex_v;
+        i += i < 0 ? meshgl.tex_u : 0;
+        j += j < 0 ? meshgl.tex_v : 0;
+        const char * texel = meshgl.tex.data() + 4 * (i + meshgl.tex_u * j);
+        const float w = (du ? wu : 1.f - wu) * (dv ? wv : 1.f - wv);
+        for (int c = 0; c < 4; ++c)
+          color(c) += w * (unsigned char)texel[c] / 255.f;
+      }
+    }
+    return color;
+  };
+
+  const Lanes lane_offset = Lanes::LinSpaced(8, 0.5f, 7.5f);
+  for (const int index : m_bins[t])
+  {
+    const Triangle& triangle = m_triangles[index];
+    const int x0 = std::max(triangle.x0, tile_x0);
+    const int x1 = std::min(triangle.x1, tile_x1);
+    const int y0 = std::max(triangle.y0, tile_y0);
+    const int y1 = std::min(triangle.y1, tile_y1);
+    const Eigen::Vector3f* e = triangle.edge;
+    // Covered where e_i > bias_i: pixel centers on an edge belong to the
+    // triangle only if the edge is a top or left edge
+    float bias[3];
+    for (int i = 0; i < 3; ++i)
+      bias[i] = triangle.top_left[i] ? -FLT_MIN : 0.f;
+    // Window depth is affine in (x,y). glPolygonOffset(1,1) pushes faces
+    // behind the wireframe by their depth slope plus one depth unit.
+    const float inv_area = 1.f / triangle.area;
+    Eigen::Vector3f dz(0, 0, 0);
+    for (int i = 0; i < 3; ++i)
+      dz += triangle.z[i] * inv_area * e[i];
+    const float offset = std::max(std::abs(dz(0)), std::abs(dz(1))) + 1.f / (1 << 24);
+    const Vertex* v[3] =
+      {&m_vertices[triangle.v[0]], &m_vertices[triangle.v[1]], &m_vertices[triangle.v[2]]};
+
+    for (int y = y0; y <= y1; ++y)
+    {
+      const float py = y + 0.5f;
+      const float c0 = e[0](1) * py + e[0](2);
+      const float c1 = e[1](1) * py + e[1](2);
+      const float c2 = e[2](1) * py + e[2](2);
+      for (int x = x0; x <= x1; x += 8)
+      {
+        const Lanes px = lane_offset + float(x);
+        const Lanes w0 = e[0](0) * px + c0;
+        const Lanes w1 = e[1](0) * px + c1;
+        const Lanes w2 = e[2](0) * px + c2;
+        const Lanes inside = (w0 - bias[0]).min(w1 - bias[1]).min(w2 - bias[2]);
+        if (!(inside.maxCoeff() > 0))
+          continue;
+        const Lanes z = (w0 * triangle.z[0] + w1 * triangle.z[1] + w2 * triangle.z[2]) * inv_area + offset;
+        const int lanes = std::min(8, x1 - x + 1);
+        for (int l = 0; l < lanes; ++l)
+        {
+          if (!(inside(l) > 0) || z(l) < 0 || z(l) > 1)
+            continue;
+          const size_t p = size_t(y) * m_width + x + l;
+          if (core.depth_test && !(z(l) < m_depth[p]))
+            continue;
+
+          // Perspective correct interpolation
+          float b[3] = {w0(l) * triangle.inv_w[0], w1(l) * triangle.inv_w[1], w2(l) * triangle.inv_w[2]};
+          const float sum = b[0] + b[1] + b[2];
+          float a[NUM_ATTRIBUTES];
+          for (int k = 0; k < NUM_ATTRIBUTES; ++k)
+            a[k] = (b[0] * v[0]->attributes[k] + b[1] * v[1]->attributes[k] + b[2] * v[2]->attributes[k]) / sum;
+
+          // Fragment shader of MeshGL
+          const Eigen::Map<const Eigen::Vector3f> position_eye(a);
+          const Eigen::Vector3f normal_eye = Eigen::Map<const Eigen::Vector3f>(a + 3).normalized();
+          const Eigen::Map<const Eigen::Vector4f> Ka(a + 6);
+          const Eigen::Map<const Eigen::Vector4f> Kd(a + 10);
+          const Eigen::Map<const Eigen::Vector4f> Ks(a + 14);
+          const Eigen::Vector3f Ia = Ka.head<3>();
+          const Eigen::Vector3f direction_to_light_eye = (light - position_eye).normalized();
+          const float dot_prod = direction_to_light_eye.dot(normal_eye);
+          const Eigen::Vector3f Id = Kd.head<3>() * std::max(dot_prod, 0.f);
+          const Eigen::Vector3f reflection_eye =
+            -direction_to_light_eye + 2.f * dot_prod * normal_eye;
+          const Eigen::Vector3f surface_to_viewer_eye = (-position_eye).normalized();
+          float dot_prod_specular = reflection_eye.dot(surface_to_viewer_eye);
+          dot_prod_specular = dot_prod >= 0 ? std::max(dot_prod_specular, 0.f) : 0.f;
+          const Eigen::Vector3f Is =
+            Ks.head<3>() * std::pow(dot_prod_specular, specular_exponent);
+          Eigen::Vector4f color;
+          color.head<3>() =
+            lighting_factor * (Is + Id) + Ia + (1.f - lighting_factor) * Kd.head<3>();
+          color(3) = (Ka(3) + Ks(3) + Kd(3)) / 3.f;
+          if (textured)
+            color = color.cwiseProduct(texture(a[18], a[19]));
+
+          write_pixel(x + l, y, z(l), color, core.depth_test);
+        }
+      }
+    }
+  }
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::draw_line(
+  const Eigen::Vector4f& a,
+  const Eigen::Vector4f& b,
+  const Eigen::Vector3f& ca,
+  const Eigen::Vector3f& cb,
+  const float line_width,
+  const bool depth_test)
+{
+  if (software_rasterizer_outcode(a) & software_rasterizer_outcode(b))
+    return;
+  // Clip against the near plane
+  float t0 = 0, t1 = 1;
+  const float da = a(2) + a(3);
+  const float db = b(2) + b(3);
+  if (da < 0 && db < 0)
+    return;
+  if (da < 0)
+    t0 = da / (da - db);
+  else if (db < 0)
+    t1 = da / (da - db);
+  Eigen::Vector3f s[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    const Eigen::Vector4f c = a + (i == 0 ? t0 : t1) * (b - a);
+    s[i] <<
+      (c(0) / c(3) + 1.f) * 0.5f * m_width,
+      (c(1) / c(3) + 1.f) * 0.5f * m_height,
+      c(2) / c(3) * 0.5f + 0.5f;
+  }
+  const Eigen::Vector3f c0 = ca + t0 * (cb - ca);
+  const Eigen::Vector3f c1 = ca + t1 * (cb - ca);
+
+  // Clip to the window grown by the line width [Liang and Barsky 1984]
+  const int thickness = std::max(1, int(line_width + 0.5f));
+  const Eigen::Vector3f d = s[1] - s[0];
+  float u0 = 0, u1 = 1;
+  const float lo[2] = {-float(thickness), -float(thickness)};
+  const float hi[2] = {float(m_width + thickness), float(m_height + thickness)};
+  for (int k = 0; k < 2; ++k)
+  {
+    const float pk[2] = {-d(k), d(k)};
+    const float qk[2] = {s[0](k) - lo[k], hi[k] - s[0](k)};
+    for (int j = 0; j < 2; ++j)
+    {
+      if (pk[j] == 0)
+      {
+        if (qk[j] < 0)
+          return;
+        continue;
+      }
+      const float r = qk[j] / pk[j];
+      if (pk[j] < 0)
+        u0 = std::max(u0, r);
+      else
+        u1 = std::min(u1, r);
+    }
+  }
+  if (u0 > u1)
+    return;
+
+  // DDA along the major axis, thickness pixels across the minor axis
+  const int major = std::abs(d(0)) >= std::abs(d(1)) ? 0 : 1;
+  const int steps = std::max(1, int(std::ceil(std::abs(d(major)) * (u1 - u0))));
+  for (int i = 0; i <= steps; ++i)
+  {
+    const float u = u0 + (u1 - u0) * i / steps;
+    const Eigen::Vector3f p = s[0] + u * d;
+    Eigen::Vector4f color;
+    color << c0 + u * (c1 - c0), 1.f;
+    int pixel[2] = {int(std::floor(p(0))), int(std::floor(p(1)))};
+    const int first = int(std::floor(p(1 - major) - 0.5f * thickness + 0.5f));
+    for (int k = 0; k < thickness; ++k)
+    {
+      pixel[1 - major] = first + k;
+      if (pixel[0] < 0 || pixel[0] >= m_width || pixel[1] < 0 || pixel[1] >= m_height)
+        continue;
+      if (p(2) < 0 || p(2) > 1)
+        continue;
+      write_pixel(pixel[0], pixel[1], p(2), color, depth_test);
+    }
+  }
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::draw_point(
+  const Eigen::Vector4f& p,
+  const Eigen::Vector3f& color,
+  const float point_size,
+  const bool depth_test)
+{
+  if (software_rasterizer_outcode(p) & (SOFTWARE_RASTERIZER_NEAR | SOFTWARE_RASTERIZER_FAR))
+    return;
+  const float x = (p(0) / p(3) + 1.f) * 0.5f * m_width;
+  const float y = (p(1) / p(3) + 1.f) * 0.5f * m_height;
+  const float z = p(2) / p(3) * 0.5f + 0.5f;
+  const float r = 0.5f * point_size;
+  const int x0 = std::max(0, int(std::ceil(x - r - 0.5f)));
+  const int x1 = std::min(m_width - 1, int(std::floor(x + r - 0.5f)));
+  const int y0 = std::max(0, int(std::ceil(y - r - 0.5f)));
+  const int y1 = std::min(m_height - 1, int(std::floor(y + r - 0.5f)));
+  const Eigen::Vector4f rgba(color(0), color(1), color(2), 1.f);
+  for (int j = y0; j <= y1; ++j)
+  {
+    for (int i = x0; i <= x1; ++i)
+    {
+      // Round points, as the overlay point shader
+      const float dx = i + 0.5f - x;
+      const float dy = j + 0.5f - y;
+      if (dx * dx + dy * dy <= r * r)
+        write_pixel(i, j, z, rgba, depth_test);
+    }
+  }
+}
+
+IGL_INLINE void igl::opengl::SoftwareRasterizer::write_pixel(
+  const int x,
+  const int y,
+  const float z,
+  const Eigen::Vector4f& color,
+  const bool depth_test)
+{
+  const size_t p = size_t(y) * m_width + x;
+  if (depth_test)
+  {
+    if (!(z < m_depth[p]))
+      return;
+    m_depth[p] = z;
+  }
+  // glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) on all four channels
+  unsigned char * dst = m_rgba.data() + 4 * p;
+  const float alpha = std::min(std::max(color(3), 0.f), 1.f);
+  for (int c = 0; c < 4; ++c)
+  {
+    const float src = std::min(std::max(color(c), 0.f), 1.f);
+    dst[c] = software_rasterizer_unorm(alpha * src + (1.f - alpha) * dst[c] / 255.f);
+  }
+}
@@ -0,0 +1,182 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_OPENGL_SOFTWARERASTERIZER_H
+#define IGL_OPENGL_SOFTWARERASTERIZER_H
+
+#include <igl/igl_inline.h>
+#include <Eigen/Core>
+#include <vector>
+
+namespace igl
+{
+namespace opengl
+{
+
+class ViewerCore;
+class ViewerData;
+
+// CPU replacement for ViewerCore::draw/draw_buffer that needs no OpenGL
+// context, for rendering on machines without a GPU (tests, thumbnails).
+//
+// Meshes are drawn from the same buffers as the OpenGL path (MeshGL::V_vbo,
+// F_vbo, normals, materials, uvs and texture, refreshed with
+// ViewerData::update_buffers) using the camera of ViewerCore::update_camera
+// and the lighting of the mesh shader. Triangles are binned into square
+// tiles which are rasterized in parallel, each with edge functions evaluated
+// for 8 pixels at a time, against a float depth buffer. Wireframes and the
+// line and point overlays are drawn afterwards; labels are not supported.
+//
+// The color buffer follows glReadPixels: RGBA, bottom row first.
+//
+// Example:
+//   igl::opengl::SoftwareRasterizer rasterizer;
+//   Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic> R(800,600),G,B,A;
+//   G = B = A = R;
+//   rasterizer.draw_buffer(core,world,data,true,R,G,B,A);
+//   igl::png::writePNG(R,G,B,A,"thumbnail.png");
+class SoftwareRasterizer
+{
+public:
+  // Width and height of the tiles in pixels
+  static const int TILE_SIZE = 64;
+
+  IGL_INLINE SoftwareRasterizer();
+
+  // Resize the color and depth buffers, discarding their content
+  IGL_INLINE void resize(const int width, const int height);
+  IGL_INLINE int width() const;
+  IGL_INLINE int height() const;
+
+  // Fill the color buffer with color and the depth buffer with the far plane
+  IGL_INLINE void clear(const Eigen::Vector4f& color);
+
+  // Equivalent of ViewerCore::draw into the buffers of this rasterizer, with
+  // the viewport of core replaced by (0,0,width(),height())
+  //
+  // Inputs:
+  //   core  camera and lighting, core.view, core.proj and core.norm are
+  //     updated as ViewerCore::draw would
+  //   worldMat  scene transformation
+  //   data  mesh to draw, its buffers are refreshed if dirty
+  //   update_matrices  whether to recompute the camera with
+  //     core.update_camera, otherwise core.camera_view and core.proj are used
+  IGL_INLINE void draw(
+    ViewerCore& core,
+    const Eigen::Matrix4f& worldMat,
+    ViewerData& data,
+    bool update_matrices = true);
+
+  // Equivalent of ViewerCore::draw_buffer: render data into R,G,B,A, which
+  // must be preallocated to the desired width by height
+  IGL_INLINE void draw_buffer(
+    ViewerCore& core,
+    const Eigen::Matrix4f& worldMat,
+    ViewerData& data,
+    bool update_matrices,
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& R,
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& G,
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& B,
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& A);
+
+  // Copy the color buffer into width() by height() channels, as returned by
+  // ViewerCore::draw_buffer
+  IGL_INLINE void get_buffer(
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& R,
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& G,
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& B,
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& A) const;
+
+  // Raw color buffer, 4*width()*height() bytes
+  IGL_INLINE const std::vector<unsigned char>& rgba() const;
+  // Window depth of each pixel in [0,1], width()*height() values
+  IGL_INLINE const std::vector<float>& depth() const;
+
+private:
+  // Number of interpolated attributes: eye position (3), eye normal (3),
+  // ambient (4), diffuse (4), specular (4) and texture coordinates (2)
+  static const int NUM_ATTRIBUTES = 20;
+  // A vertex after the vertex shader
+  struct Vertex
+  {
+    Eigen::Matrix<float,4,1,Eigen::DontAlign> clip;
+    float attributes[NUM_ATTRIBUTES];
+  };
+  // A screen space triangle ready for rasterization
+  struct Triangle
+  {
+    // Vertices
+    int v[3];
+    // Edge function of the edge opposite each vertex, e(0)*x + e(1)*y + e(2)
+    // at the window position (x,y), positive inside. Divided by area it is
+    // the barycentric coordinate of the vertex.
+    Eigen::Vector3f edge[3];
+    float area;
+    // Whether pixel centers exactly on the opposite edge are covered
+    bool top_left[3];
+    // Window depth and 1/w of each vertex
+    float z[3];
+    float inv_w[3];
+    // Pixel bounds, inclusive
+    int x0, y0, x1, y1;
+  };
+  // Transform the vertex buffers of data into m_vertices
+  IGL_INLINE void shade_vertices(
+    const ViewerCore& core,
+    const ViewerData& data);
+  // Clip the faces of data against the near plane and set up m_triangles
+  IGL_INLINE void setup_triangles(const ViewerData& data);
+  // Sort m_triangles into the tiles they overlap
+  IGL_INLINE void bin_triangles();
+  // Rasterize the triangles binned in tile t
+  IGL_INLINE void rasterize_tile(
+    const int t,
+    const ViewerCore& core,
+    const ViewerData& data);
+  // Draw the segment from a to b (clip coordinates) with colors ca and cb
+  IGL_INLINE void draw_line(
+    const Eigen::Vector4f& a,
+    const Eigen::Vector4f& b,
+    const Eigen::Vector3f& ca,
+    const Eigen::Vector3f& cb,
+    const float line_width,
+    const bool depth_test);
+  // Draw a disc of the given diameter around p (clip coordinates)
+  IGL_INLINE void draw_point(
+    const Eigen::Vector4f& p,
+    const Eigen::Vector3f& color,
+    const float point_size,
+    const bool depth_test);
+  // Blend color into pixel (x,y) and write depth z if depth_test passes
+  IGL_INLINE void write_pixel(
+    const int x,
+    const int y,
+    const float z,
+    const Eigen::Vector4f& color,
+    const bool depth_test);
+  int m_width;
+  int m_height;
+  int m_tiles_x;
+  int m_tiles_y;
+  std::vector<unsigned char> m_rgba;
+  std::vector<float> m_depth;
+  // Scratch space reused by every draw
+  std::vector<Vertex> m_vertices;
+  std::vector<unsigned char> m_outcodes;
+  std::vector<Eigen::Vector3i> m_faces;
+  std::vector<Triangle> m_triangles;
+  std::vector<std::vector<int> > m_bins;
+};
+
+}
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "SoftwareRasterizer.cpp"
+#endif
+
+#endif
@@ -17,6 +17,7 @@
 #include "../massmatrix.h"
 #include "../barycenter.h"
 #include "../PI.h"
+#include "../Profiler.h"
 #include <Eigen/Geometry>
 #include <iostream>
 
@@ -100,14 +101,9 @@ IGL_INLINE void igl::opengl::ViewerCore::clear_framebuffers()
   glDisable(GL_SCISSOR_TEST);
 }
 
-IGL_INLINE void igl::opengl::ViewerCore::draw(
-  Eigen::Matrix4f &worldMat,
-  ViewerData& data,
-  bool update_matrices)
+IGL_INLINE void igl::opengl::ViewerCore::begin_draw(
+  const Eigen::Matrix4f &worldMat)
 {
-  using namespace std;
-  using namespace Eigen;
-
   if (depth_test)
     glEnable(GL_DEPTH_TEST);
   else
@@ -116,48 +112,87 @@ IGL_INLINE void igl::opengl::ViewerCore::draw(
   glEnable(GL_BLEND);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-  /* Bind and potentially refresh mesh/line/point data */
-  if (data.dirty)
-  {
-    data.updateGL(data, data.invert_normals, data.meshgl);
-    data.dirty = MeshGL::DIRTY_NONE;
-  }
-  data.meshgl.bind_mesh();
-
-  // Initialize uniform
   glViewport(viewport(0), viewport(1), viewport(2), viewport(3));
 
-  if(update_matrices)
+  update_camera(worldMat);
+}
+
+IGL_INLINE void igl::opengl::ViewerCore::update_camera(
+  const Eigen::Matrix4f &worldMat)
+{
+  camera_view = Eigen::Matrix4f::Identity();
+  proj = Eigen::Matrix4f::Identity();
+
+  float width  = viewport(2);
+  float height = viewport(3);
+
+  // Set view
+  look_at( camera_eye, camera_center, camera_up, camera_view);
+  camera_view = camera_view
+    * (trackball_angle * Eigen::Scaling(camera_zoom * camera_base_zoom)
+    * Eigen::Translation3f(camera_translation + camera_base_translation)).matrix()* worldMat;
+
+  // Set projection
+  if (orthographic)
+  {
+    float length = (camera_eye - camera_center).norm();
+    float h = tan(camera_view_angle/360.0 * igl::PI) * (length);
+    ortho(-h*width/height, h*width/height, -h, h, camera_dnear, camera_dfar,proj);
+  }
+  else
   {
-    view = Eigen::Matrix4f::Identity();
-    proj = Eigen::Matrix4f::Identity();
-    norm = Eigen::Matrix4f::Identity();
+    float fH = tan(camera_view_angle / 360.0 * igl::PI) * camera_dnear;
+    float fW = fH * (double)width/(double)height;
+    frustum(-fW, fW, -fH, fH, camera_dnear, camera_dfar,proj);
+  }
+}
 
-    float width  = viewport(2);
-    float height = viewport(3);
+IGL_INLINE bool igl::opengl::ViewerCore::in_frustum(
+  const Eigen::Matrix4f &model,
+  const Eigen::AlignedBox3f &box) const
+{
+  if (box.isEmpty())
+    return false;
+  // Planes of the clip volume in mesh coordinates [Gribb and Hartmann 2001]
+  const Eigen::Matrix4f clip = proj * camera_view * model;
+  for (int p = 0; p < 6; p++)
+  {
+    const Eigen::RowVector4f plane =
+      clip.row(3) + (p % 2 == 0 ? 1.f : -1.f) * clip.row(p / 2);
+    // Corner of the box farthest along the plane normal
+    Eigen::Vector3f corner;
+    for (int d = 0; d < 3; d++)
+      corner(d) = plane(d) >= 0 ? box.max()(d) : box.min()(d);
+    if (plane.head<3>().dot(corner) + plane(3) < 0)
+      return false;
+  }
+  return true;
+}
 
-    // Set view
-    look_at( camera_eye, camera_center, camera_up, view);
-    view = view
-      * (trackball_angle * Eigen::Scaling(camera_zoom * camera_base_zoom)
-      * Eigen::Translation3f(camera_translation + camera_base_translation)).matrix()* worldMat*data.MakeTrans();
+IGL_INLINE void igl::opengl::ViewerCore::draw(
+  Eigen::Matrix4f &worldMat,
+  ViewerData& data,
+  bool update_matrices)
+{
+  using namespace std;
+  using namespace Eigen;
 
-    norm = view.inverse().transpose() ;
+  if(update_matrices)
+  {
+    begin_draw(worldMat);
+  }
 
-    // Set projection
-    if (orthographic)
-    {
-      float length = (camera_eye - camera_center).norm();
-      float h = tan(camera_view_angle/360.0 * igl::PI) * (length);
-      ortho(-h*width/height, h*width/height, -h, h, camera_dnear, camera_dfar,proj);
-    }
-    else
-    {
-      float fH = tan(camera_view_angle / 360.0 * igl::PI) * camera_dnear;
-      float fW = fH * (double)width/(double)height;
-      frustum(-fW, fW, -fH, fH, camera_dnear, camera_dfar,proj);
-    }
+  /* Bind and potentially refresh mesh/line/point data */
+  if (data.dirty || !data.meshgl.is_initialized)
+  {
+    igl::Profiler::Scope scope("VBO upload");
+    data.updateGL(data, data.invert_normals, data.meshgl);
+    data.dirty = MeshGL::DIRTY_NONE;
   }
+  data.meshgl.bind_mesh();
+
+  view = camera_view * data.MakeTrans();
+  norm = view.inverse().transpose();
 
   // Send transformations to the GPU
   GLint viewi  = glGetUniformLocation(data.meshgl.shader_mesh,"view");
@@ -238,7 +273,10 @@ IGL_INLINE void igl::opengl::ViewerCore::draw(
       data.meshgl.draw_overlay_points();
     }
 
-    glEnable(GL_DEPTH_TEST);
+    if (depth_test)
+      glEnable(GL_DEPTH_TEST);
+    else
+      glDisable(GL_DEPTH_TEST);
   }
 
 }
@@ -306,6 +344,10 @@ IGL_INLINE void igl::opengl::ViewerCore::draw_buffer(Eigen::Matrix4f &worldMat,
   Eigen::Vector4f viewport_ori = viewport;
   viewport << 0,0,width,height;
   // Draw
+  if(!update_matrices)
+  {
+    glViewport(viewport(0), viewport(1), viewport(2), viewport(3));
+  }
   draw(worldMat,data,update_matrices);
   // Restore viewport
   viewport = viewport_ori;
@@ -414,6 +456,10 @@ IGL_INLINE igl::opengl::ViewerCore::ViewerCore()
   animation_max_fps = 30.;
 
   viewport.setZero();
+  view.setIdentity();
+  proj.setIdentity();
+  norm.setIdentity();
+  camera_view.setIdentity();
 }
 
 IGL_INLINE void igl::opengl::ViewerCore::init()
@@ -69,9 +69,33 @@ public:
   // Clear the frame buffers
   IGL_INLINE void clear_framebuffers();
 
+  // Set the viewport and GL state shared by all meshes drawn in this viewport
+  // and compute the camera matrices (see update_camera). Call once per frame
+  // before drawing meshes with update_matrices = false.
+  IGL_INLINE void begin_draw(const Eigen::Matrix4f &worldMat);
+
+  // Compute camera_view and proj for the current camera and viewport
+  IGL_INLINE void update_camera(const Eigen::Matrix4f &worldMat);
+
+  // Whether a box may intersect the view frustum of the last update_camera
+  //
+  // Inputs:
+  //   model  transformation of the mesh the box bounds (its MakeTrans()).
+  //     The world transformation passed to update_camera is already part of
+  //     camera_view and must not be included again.
+  //   box  bounding box in the coordinates of that mesh
+  // Returns false only if the box is entirely outside one of the planes
+  IGL_INLINE bool in_frustum(
+    const Eigen::Matrix4f &model,
+    const Eigen::AlignedBox3f &box) const;
+
   // Draw everything
   //
   // data cannot be const because it is being set to "clean"
+  //
+  // Inputs:
+  //   update_matrices  whether to call begin_draw first, otherwise the
+  //     matrices and state from the last begin_draw are used
   IGL_INLINE void draw(Eigen::Matrix4f &worldMat, ViewerData& data, bool update_matrices = true);
   IGL_INLINE void UpdateUniforms(Eigen::Matrix4f &worldMat, ViewerData& data, bool update_matrices = true);
 
@@ -152,6 +176,9 @@ public:
   Eigen::Matrix4f view;
   Eigen::Matrix4f proj;
   Eigen::Matrix4f norm;
+  // World to eye transformation of the current frame, view without the
+  // transformation of the mesh
+  Eigen::Matrix4f camera_view;
   public:
       EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
@@ -13,8 +13,10 @@
 #include "../material_colors.h"
 #include "../parula.h"
 #include "../per_vertex_normals.h"
+#include "../vertex_triangle_adjacency.h"
 
 #include <iostream>
+#include <utility>
 
 
 IGL_INLINE igl::opengl::ViewerData::ViewerData()
@@ -95,23 +97,53 @@ IGL_INLINE void igl::opengl::ViewerData::uniform_colors_index(int i)
 IGL_INLINE void igl::opengl::ViewerData::set_mesh(
 	const Eigen::MatrixXd& _V, const Eigen::MatrixXi& _F)
 {
-	using namespace std;
+	if (&_V == &V && &_F == &F)
+	{
+		// Plotting the mesh already held (e.g. set_mesh(data().V, data().F)
+		// after editing it in place) only needs the buffers refreshed, as long
+		// as its normals and colors were set up for it
+		if (V.cols() == 3 && V.rows() > 0 && F.rows() > 0 &&
+			V_normals.rows() == V.rows() && F_normals.rows() == F.rows() &&
+			V_material_diffuse.rows() == V.rows() &&
+			F_material_diffuse.rows() == F.rows())
+		{
+			normals_VF.resize(0);
+			normals_NI.resize(0);
+			normals_dirty = true;
+			V_bounds_dirty = true;
+			dirty |= MeshGL::DIRTY_FACE | MeshGL::DIRTY_POSITION;
+			return;
+		}
+		// Otherwise plot it as a new mesh
+		Eigen::MatrixXd V_new;
+		Eigen::MatrixXi F_new;
+		V_new.swap(V);
+		F_new.swap(F);
+		set_mesh(std::move(V_new), std::move(F_new));
+		return;
+	}
+	Eigen::MatrixXd V_copy = _V;
+	Eigen::MatrixXi F_copy = _F;
+	set_mesh(std::move(V_copy), std::move(F_copy));
+}
 
-	Eigen::MatrixXd V_temp;
+IGL_INLINE void igl::opengl::ViewerData::set_mesh(
+	Eigen::MatrixXd&& _V, Eigen::MatrixXi&& _F)
+{
+	using namespace std;
 
 	// If V only has two columns, pad with a column of zeros
 	if (_V.cols() == 2)
 	{
-		V_temp = Eigen::MatrixXd::Zero(_V.rows(), 3);
-		V_temp.block(0, 0, _V.rows(), 2) = _V;
+		Eigen::MatrixXd V_temp = Eigen::MatrixXd::Zero(_V.rows(), 3);
+		V_temp.leftCols(2) = _V;
+		_V.swap(V_temp);
 	}
-	else
-		V_temp = _V;
 
 	if (V.rows() == 0 && F.rows() == 0)
 	{
-		V = V_temp;
-		F = _F;
+		V.swap(_V);
+		F.swap(_F);
 
 		compute_normals();
 		uniform_colors(
@@ -125,22 +157,69 @@ IGL_INLINE void igl::opengl::ViewerData::set_mesh(
 	{
 		if (_V.rows() == V.rows() && _F.rows() == F.rows())
 		{
-			V = V_temp;
-			F = _F;
+			V.swap(_V);
+			F.swap(_F);
+			normals_VF.resize(0);
+			normals_NI.resize(0);
+			normals_dirty = true;
 		}
 		else
 			cerr << "ERROR (set_mesh): The new mesh has a different number of vertices/faces. Please clear the mesh before plotting." << endl;
 	}
+	V_bounds_dirty = true;
 	dirty |= MeshGL::DIRTY_FACE | MeshGL::DIRTY_POSITION;
 }
 
 IGL_INLINE void igl::opengl::ViewerData::set_vertices(const Eigen::MatrixXd& _V)
 {
-	V = _V;
+	if (&_V != &V)
+		V = _V;
+	assert(F.size() == 0 || F.maxCoeff() < V.rows());
+	normals_dirty = true;
+	V_bounds_dirty = true;
+	dirty |= MeshGL::DIRTY_POSITION;
+}
+
+IGL_INLINE void igl::opengl::ViewerData::set_vertices(Eigen::MatrixXd&& _V)
+{
+	V.swap(_V);
 	assert(F.size() == 0 || F.maxCoeff() < V.rows());
+	normals_dirty = true;
+	V_bounds_dirty = true;
+	dirty |= MeshGL::DIRTY_POSITION;
+}
+
+IGL_INLINE void igl::opengl::ViewerData::set_vertices(const Eigen::VectorXi& I, const Eigen::MatrixXd& VI)
+{
+	assert(I.size() == VI.rows());
+	for (int i = 0; i < I.size(); ++i)
+	{
+		V.row(I(i)) = VI.row(i);
+		touched_vertices.push_back(I(i));
+	}
+	V_bounds_dirty = true;
 	dirty |= MeshGL::DIRTY_POSITION;
 }
 
+IGL_INLINE const Eigen::AlignedBox3f& igl::opengl::ViewerData::mesh_bounds()
+{
+	if (V_bounds_dirty || (dirty & MeshGL::DIRTY_POSITION))
+	{
+		V_bounds.setEmpty();
+		if (V.rows() > 0)
+		{
+			// 2D meshes lie in z = 0
+			Eigen::Vector3f lo = Eigen::Vector3f::Zero(), hi = Eigen::Vector3f::Zero();
+			lo.head(V.cols()) = V.colwise().minCoeff().transpose().cast<float>();
+			hi.head(V.cols()) = V.colwise().maxCoeff().transpose().cast<float>();
+			V_bounds.extend(lo);
+			V_bounds.extend(hi);
+		}
+		V_bounds_dirty = false;
+	}
+	return V_bounds;
+}
+
 IGL_INLINE void igl::opengl::ViewerData::set_normals(const Eigen::MatrixXd& N)
 {
 	using namespace std;
@@ -301,6 +380,13 @@ IGL_INLINE void igl::opengl::ViewerData::set_texture(
 	dirty |= MeshGL::DIRTY_TEXTURE;
 }
 
+IGL_INLINE void igl::opengl::ViewerData::clear_overlays()
+{
+	lines = Eigen::MatrixXd(0, 9);
+	points = Eigen::MatrixXd(0, 6);
+	dirty |= MeshGL::DIRTY_OVERLAY_LINES | MeshGL::DIRTY_OVERLAY_POINTS;
+}
+
 IGL_INLINE void igl::opengl::ViewerData::set_points(
 	const Eigen::MatrixXd& P,
 	const Eigen::MatrixXd& C)
@@ -430,13 +516,39 @@ IGL_INLINE void igl::opengl::ViewerData::clear()
 	labels_positions = Eigen::MatrixXd(0, 3);
 	labels_strings.clear();
 
+	normals_VF = Eigen::VectorXi();
+	normals_NI = Eigen::VectorXi();
+	touched_vertices.clear();
+	normals_dirty = true;
+	V_bounds_dirty = true;
+
 	face_based = false;
 }
 
 IGL_INLINE void igl::opengl::ViewerData::compute_normals()
 {
-	igl::per_face_normals(V, F, F_normals);
-	igl::per_vertex_normals(V, F, F_normals, V_normals);
+	if (normals_NI.size() != V.rows() + 1 || normals_VF.size() != 3 * F.rows())
+	{
+		igl::vertex_triangle_adjacency(F, V.rows(), normals_VF, normals_NI);
+		normals_dirty = true;
+	}
+	// Anything but set_vertices(I,VI) may have moved every vertex
+	if (!normals_dirty && !touched_vertices.empty() &&
+		F_normals.rows() == F.rows() && V_normals.rows() == V.rows())
+	{
+		const Eigen::VectorXi I =
+			Eigen::Map<const Eigen::VectorXi>(touched_vertices.data(), touched_vertices.size());
+		igl::per_vertex_normals(V, F, PER_VERTEX_NORMALS_WEIGHTING_TYPE_DEFAULT,
+			normals_VF, normals_NI, I, F_normals, V_normals);
+	}
+	else
+	{
+		igl::per_face_normals(V, F, F_normals);
+		igl::per_vertex_normals(V, F, PER_VERTEX_NORMALS_WEIGHTING_TYPE_DEFAULT,
+			F_normals, normals_VF, normals_NI, V_normals);
+	}
+	touched_vertices.clear();
+	normals_dirty = false;
 	dirty |= MeshGL::DIRTY_NORMAL;
 }
 
@@ -534,6 +646,15 @@ IGL_INLINE void igl::opengl::ViewerData::updateGL(
 		meshgl.init();
 	}
 
+	update_buffers(data, invert_normals, meshgl);
+}
+
+IGL_INLINE void igl::opengl::ViewerData::update_buffers(
+	const igl::opengl::ViewerData& data,
+	const bool invert_normals,
+	igl::opengl::MeshGL& meshgl
+)
+{
 	bool per_corner_uv = (data.F_uv.rows() == data.F.rows());
 	bool per_corner_normals = (data.F_normals.rows() == 3 * data.F.rows());
 
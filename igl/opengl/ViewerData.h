@@ -55,11 +55,28 @@ namespace igl
 			// Change the visualization mode, invalidating the cache if necessary
 			IGL_INLINE void set_face_based(bool newvalue);
 
-			// Helpers that can draw the most common meshes
+			// Helpers that can draw the most common meshes. Passing V and F of this
+			// object copies nothing, passing temporaries (e.g. std::move of a mesh
+			// just read from file) hands their storage over instead of copying it.
 			IGL_INLINE void set_mesh(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F);
+			IGL_INLINE void set_mesh(Eigen::MatrixXd&& V, Eigen::MatrixXi&& F);
 			IGL_INLINE void set_vertices(const Eigen::MatrixXd& V);
+			IGL_INLINE void set_vertices(Eigen::MatrixXd&& V);
+			// Overwrite only some of the vertex positions. The touched vertices are
+			// remembered so that the next compute_normals() only refreshes the
+			// normals around them.
+			//
+			// Inputs:
+			//   I   #I list of vertex indices
+			//   VI  #I by 3 list of new positions for the vertices in I
+			IGL_INLINE void set_vertices(const Eigen::VectorXi& I, const Eigen::MatrixXd& VI);
 			IGL_INLINE void set_normals(const Eigen::MatrixXd& N);
 
+			// Bounding box of V, cached until V changes (through the setters above
+			// or a DIRTY_POSITION update), used for view frustum culling (see
+			// ViewerCore::in_frustum)
+			IGL_INLINE const Eigen::AlignedBox3f& mesh_bounds();
+
 			IGL_INLINE void set_visible(bool value, unsigned int core_id = 1);
 
 			// Set the color of the mesh
@@ -126,13 +143,18 @@ namespace igl
 			// set_edges?
 			IGL_INLINE void add_edges(const Eigen::MatrixXd& P1, const Eigen::MatrixXd& P2, const Eigen::MatrixXd& C);
 
+			// Remove the line and point overlays, leaving the mesh untouched
+			IGL_INLINE void clear_overlays();
+
 			// Adds text labels at the given positions in 3D.
 			// Note: This requires the ImGui viewer plugin to display text labels.
 			IGL_INLINE void add_label(const Eigen::VectorXd& P, const std::string& str);
 			// Clear the label data
 			IGL_INLINE void clear_labels();
 
-			// Computes the normals of the mesh
+			// Computes the normals of the mesh. If the only change since the last
+			// call went through set_vertices(I,VI), only the normals around those
+			// vertices are updated.
 			IGL_INLINE void compute_normals();
 
 			// Assigns uniform colors to all faces/vertices
@@ -153,6 +175,8 @@ namespace igl
 			// Copy visualization options from one viewport to another
 			IGL_INLINE void copy_options(const ViewerCore& from, const ViewerCore& to);
 
+			// Owned by this object, never shared with another one. The per vertex
+			// and per face normals, colors and UVs below take most of its memory.
 			Eigen::MatrixXd V; // Vertices of the current mesh (#V x 3)
 			Eigen::MatrixXi F; // Faces of the mesh (#F x 3)
 
@@ -166,6 +190,20 @@ namespace igl
 			// Per vertex attributes
 			Eigen::MatrixXd V_normals; // One normal per vertex
 
+			// Vertex-triangle adjacency of F used to gather vertex normals (see
+			// igl::vertex_triangle_adjacency). Rebuilt whenever F changes.
+			Eigen::VectorXi normals_VF;
+			Eigen::VectorXi normals_NI;
+			// Vertices moved by set_vertices(I,VI) since the last compute_normals()
+			std::vector<int> touched_vertices;
+			// Whether F_normals/V_normals are stale everywhere (not just around
+			// touched_vertices)
+			bool normals_dirty;
+
+			// Cache of mesh_bounds()
+			Eigen::AlignedBox3f V_bounds;
+			bool V_bounds_dirty;
+
 			Eigen::MatrixXd V_material_ambient; // Per vertex ambient color
 			Eigen::MatrixXd V_material_diffuse; // Per vertex diffuse color
 			Eigen::MatrixXd V_material_specular; // Per vertex specular color
@@ -239,6 +277,14 @@ namespace igl
 				const igl::opengl::ViewerData& data,
 				const bool invert_normals,
 				igl::opengl::MeshGL& meshgl);
+
+			// Refresh the CPU copies of the buffers in meshgl (V_vbo, F_vbo, ...)
+			// from 'data' without touching OpenGL, as needed by updateGL and by
+			// the SoftwareRasterizer
+			IGL_INLINE static void update_buffers(
+				const igl::opengl::ViewerData& data,
+				const bool invert_normals,
+				igl::opengl::MeshGL& meshgl);
 		};
 
 	} // namespace opengl
@@ -0,0 +1,141 @@
+#include "igl/opengl/glfw/InputRecorder.h"
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+InputRecorder::InputRecorder() :
+	mode(IDLE),
+	seed(1),
+	frame(0),
+	pick_mismatches(0),
+	level_mismatches(0),
+	replay_index(0)
+{
+}
+
+void InputRecorder::start_recording(unsigned int seed)
+{
+	this->seed = seed;
+	srand(seed);
+	frame = 0;
+	frame_delta_times.clear();
+	events.clear();
+	replay_index = 0;
+	mode = RECORDING;
+}
+
+bool InputRecorder::start_replay(const std::string& filename)
+{
+	std::ifstream in(filename);
+	if (!in)
+	{
+		std::cout << "can't open file " << filename << "!" << std::endl;
+		return false;
+	}
+
+	std::string tag;
+	int version = 0;
+	size_t n = 0;
+	in >> tag >> version;
+	if (!in || tag != "input_log" || version != 1)
+	{
+		std::cout << filename << " is not an input log" << std::endl;
+		return false;
+	}
+	in >> tag >> seed >> tag >> n;
+	frame_delta_times.resize(n);
+	for (size_t i = 0; i < n; i++)
+		in >> frame_delta_times[i];
+	in >> tag >> n;
+	events.resize(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		Event& e = events[i];
+		in >> e.frame >> e.type >> e.a >> e.b >> e.c >> e.x >> e.y;
+	}
+	if (!in)
+	{
+		std::cout << "error reading " << filename << std::endl;
+		return false;
+	}
+
+	srand(seed);
+	frame = 0;
+	pick_mismatches = 0;
+	level_mismatches = 0;
+	replay_index = 0;
+	mode = REPLAYING;
+	return true;
+}
+
+bool InputRecorder::save(const std::string& filename) const
+{
+	std::ofstream out(filename);
+	if (!out)
+		return false;
+	out << std::setprecision(std::numeric_limits<double>::max_digits10);
+	out << "input_log 1\n";
+	out << "seed " << seed << "\n";
+	out << "frames " << frame_delta_times.size() << "\n";
+	for (double dt : frame_delta_times)
+		out << dt << "\n";
+	out << "events " << events.size() << "\n";
+	for (const Event& e : events)
+		out << e.frame << " " << e.type << " " << e.a << " " << e.b << " " << e.c << " " << e.x << " " << e.y << "\n";
+	return out.good();
+}
+
+void InputRecorder::record(const Event& e)
+{
+	if (mode != RECORDING)
+		return;
+	events.push_back(e);
+	events.back().frame = frame;
+}
+
+void InputRecorder::next_frame(double& delta_time, std::vector<Event>& frame_events)
+{
+	frame_events.clear();
+	if (mode == RECORDING)
+	{
+		frame_delta_times.push_back(delta_time);
+		frame++;
+	}
+	else if (mode == REPLAYING)
+	{
+		if (frame >= (int)frame_delta_times.size())
+		{
+			std::cout << "Replay finished after " << frame << " frames" << std::endl;
+			mode = IDLE;
+			return;
+		}
+		while (replay_index < events.size() && events[replay_index].frame <= frame)
+			frame_events.push_back(events[replay_index++]);
+		delta_time = frame_delta_times[frame];
+		frame++;
+	}
+}
+
+bool InputRecorder::check_pick(const Event& e, int selected_index, bool found)
+{
+	if (mode != REPLAYING || (e.a == selected_index && (e.b != 0) == found))
+		return true;
+	std::cout << "Replayed pick in frame " << e.frame << " selected " << selected_index
+		<< (found ? "" : " (not found)") << ", recorded " << e.a
+		<< (e.b != 0 ? "" : " (not found)") << std::endl;
+	pick_mismatches++;
+	return false;
+}
+
+bool InputRecorder::check_level(const Event& e, int level, int score, double scale)
+{
+	if (mode != REPLAYING || (e.a == level && e.b == score && e.x == scale))
+		return true;
+	std::cout << "Replayed level load in frame " << e.frame << " reached level " << level
+		<< " with score " << score << " and scene scale " << scale << ", recorded level "
+		<< e.a << " with score " << e.b << " and scene scale " << e.x << std::endl;
+	level_mismatches++;
+	return false;
+}
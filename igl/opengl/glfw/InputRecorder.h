@@ -0,0 +1,96 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Records the input events, the RNG seed and the per-frame time step of a
+// session so that it can be replayed deterministically, with or without a
+// window. Events are tagged with the frame they are applied before.
+//
+// File format (text):
+//   input_log 1
+//   seed <seed>
+//   frames <n>
+//   <delta time of frame 0, in ms>
+//   ...
+//   events <m>
+//   <frame> <type> <a> <b> <c> <x> <y>
+//   ...
+class InputRecorder
+{
+public:
+	enum EventType
+	{
+		KEY = 0,          // a: key, b: action, c: modifiers
+		MOUSE_BUTTON = 1, // a: button, b: action, c: modifiers, (x, y): cursor
+		MOUSE_MOVE = 2,   // a: pressed buttons mask, c: framebuffer height, (x, y): cursor
+		MOUSE_SCROLL = 3, // y: scroll offset
+		RESIZE = 4,       // a: width, b: height
+		PICK = 5,         // a: selected mesh index, b: whether an object was
+		                  // found, after the preceding mouse button press
+		LEVEL = 6         // a: level, b: score, x: scene scale, at the end of
+		                  // the frame that loaded the level
+	};
+
+	struct Event
+	{
+		Event(int type = KEY, int a = 0, int b = 0, int c = 0, double x = 0, double y = 0)
+			: frame(0), type(type), a(a), b(b), c(c), x(x), y(y) {}
+		int frame;
+		int type;
+		int a, b, c;
+		double x, y;
+	};
+
+	enum Mode
+	{
+		IDLE = 0,
+		RECORDING = 1,
+		REPLAYING = 2
+	};
+
+	InputRecorder();
+
+	// Start a new recording and seed rand() with seed
+	void start_recording(unsigned int seed);
+	// Load a recording from file, seed rand() with its seed and start
+	// replaying it. Returns false if the file can't be read.
+	bool start_replay(const std::string& filename);
+	bool save(const std::string& filename) const;
+
+	// Append e to the recording (no-op unless recording)
+	void record(const Event& e);
+
+	// Advance to the next frame. While recording, stores delta_time. While
+	// replaying, overwrites delta_time with the recorded one and returns the
+	// events to apply before this frame; switches back to IDLE after the last
+	// recorded frame.
+	void next_frame(double& delta_time, std::vector<Event>& frame_events);
+
+	// While replaying, compares the outcome of a replayed pick with the
+	// recorded PICK event e and counts a mismatch if they differ. Returns
+	// whether they match.
+	bool check_pick(const Event& e, int selected_index, bool found);
+	// While replaying, compares the replayed scene after a level load with
+	// the recorded LEVEL event e and counts a mismatch if they differ.
+	// Returns whether they match.
+	bool check_level(const Event& e, int level, int score, double scale);
+
+	bool is_recording() const { return mode == RECORDING; }
+	bool is_replaying() const { return mode == REPLAYING; }
+
+	Mode mode;
+	unsigned int seed;
+	// Number of frames started since recording/replay began
+	int frame;
+	std::vector<double> frame_delta_times;
+	std::vector<Event> events;
+	// Replayed picks that selected a different mesh than the recording
+	int pick_mismatches;
+	// Replayed level loads that left the scene in a different state than the
+	// recording
+	int level_mismatches;
+
+private:
+	// Next event to replay
+	size_t replay_index;
+};
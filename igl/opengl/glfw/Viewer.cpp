@@ -19,6 +19,8 @@
 #include <igl/adjacency_list.h>
 #include <igl/writeOBJ.h>
 #include <igl/writeOFF.h>
+#include <igl/writePLY.h>
+#include <igl/writeSTL.h>
 #include <igl/massmatrix.h>
 #include <igl/file_dialog_open.h>
 #include <igl/file_dialog_save.h>
@@ -29,6 +31,9 @@
 #include <igl/snap_to_canonical_view_quat.h>
 #include <igl/unproject.h>
 #include <igl/serialize.h>
+#include <igl/Profiler.h>
+#include <igl/dqs.h>
+#include <igl/PI.h>
 #include <igl/collapse_edge.h>
 
 #include <igl/circulation.h>
@@ -119,14 +124,6 @@ namespace igl
 			IGL_INLINE bool Viewer::load_mesh_from_file(
 				const std::string& mesh_file_name_string)
 			{
-
-				// Create new data slot and set to selected
-				if (!(data().F.rows() == 0 && data().V.rows() == 0))
-				{
-					append_mesh();
-				}
-				data().clear();
-
 				size_t last_dot = mesh_file_name_string.rfind('.');
 				if (last_dot == std::string::npos)
 				{
@@ -143,7 +140,7 @@ namespace igl
 					Eigen::MatrixXi F;
 					if (!igl::readOFF(mesh_file_name_string, V, F))
 						return false;
-					data().set_mesh(V, F);
+					load_mesh(std::move(V), std::move(F));
 				}
 				else if (extension == "obj" || extension == "OBJ")
 				{
@@ -163,9 +160,7 @@ namespace igl
 						return false;
 					}
 
-					data().set_mesh(V, F);
-					data().set_uv(UV_V, UV_F);
-
+					load_mesh(std::move(V), std::move(F), UV_V, UV_F);
 				}
 				else
 				{
@@ -174,23 +169,56 @@ namespace igl
 					return false;
 				}
 
-				data().compute_normals();
-				data().uniform_colors(Eigen::Vector3d(51.0 / 255.0, 43.0 / 255.0, 33.3 / 255.0),
+
+				//for (unsigned int i = 0; i<plugins.size(); ++i)
+				//  if (plugins[i]->post_load())
+				//    return true;
+
+				return true;
+			}
+
+			// Normals, default colors and, without UVs, a grid texture of a mesh
+			// that was just loaded
+			static void viewer_init_loaded_mesh(ViewerData& data)
+			{
+				data.compute_normals();
+				data.uniform_colors(Eigen::Vector3d(51.0 / 255.0, 43.0 / 255.0, 33.3 / 255.0),
 					Eigen::Vector3d(255.0 / 255.0, 228.0 / 255.0, 58.0 / 255.0),
 					Eigen::Vector3d(255.0 / 255.0, 235.0 / 255.0, 80.0 / 255.0));
 
 				// Alec: why?
-				if (data().V_uv.rows() == 0)
+				if (data.V_uv.rows() == 0)
 				{
-					data().grid_texture();
+					data.grid_texture();
 				}
+			}
 
+			IGL_INLINE void Viewer::load_mesh(Eigen::MatrixXd&& V, Eigen::MatrixXi&& F)
+			{
+				// Create new data slot and set to selected
+				if (!(data().F.rows() == 0 && data().V.rows() == 0))
+				{
+					append_mesh();
+				}
+				data().clear();
+				data().set_mesh(std::move(V), std::move(F));
+				viewer_init_loaded_mesh(data());
+			}
 
-				//for (unsigned int i = 0; i<plugins.size(); ++i)
-				//  if (plugins[i]->post_load())
-				//    return true;
-
-				return true;
+			IGL_INLINE void Viewer::load_mesh(
+				Eigen::MatrixXd&& V,
+				Eigen::MatrixXi&& F,
+				const Eigen::MatrixXd& UV_V,
+				const Eigen::MatrixXi& UV_F)
+			{
+				if (!(data().F.rows() == 0 && data().V.rows() == 0))
+				{
+					append_mesh();
+				}
+				data().clear();
+				data().set_mesh(std::move(V), std::move(F));
+				data().set_uv(UV_V, UV_F);
+				viewer_init_loaded_mesh(data());
 			}
 
 			IGL_INLINE bool Viewer::save_mesh_to_file(
@@ -228,6 +256,16 @@ namespace igl
 						data().F,
 						corner_normals, fNormIndices, UV_V, UV_F);
 				}
+				else if (extension == "ply" || extension == "PLY")
+				{
+					return igl::writePLY(
+						mesh_file_name_string, data().V, data().F, false);
+				}
+				else if (extension == "stl" || extension == "STL")
+				{
+					return igl::writeSTL(
+						mesh_file_name_string, data().V, data().F, false);
+				}
 				else
 				{
 					// unrecognized file type
@@ -367,113 +405,148 @@ namespace igl
 				{
 					
 					finished_objective = true;
-					data_list[data_list.size() - 4].set_visible(true, left_view->id);
-					data_list[data_list.size() - 5].set_visible(true, right_view->id);
+					data_list[environment_index(ENVIRONMENT_ARROW_LEFT)].set_visible(true, left_view->id);
+					data_list[environment_index(ENVIRONMENT_ARROW_RIGHT)].set_visible(true, right_view->id);
 				}
 					
 
-				if(finished_objective && finished_level)
+				if (finished_objective && finished_level && level_state == LEVEL_PLAYING)
 				{				
 					PlaySound(NULL, NULL, SND_FILENAME | SND_ASYNC);
 					PlaySound(TEXT("level_up.wav"), NULL, SND_FILENAME | SND_ASYNC);
-					SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 10);
-					printf("\nCash: %d$               Lives: %d\n", cash, lives);
-					SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
-					printf("Great! You Finished The Level:\n\n");
-					printf("1.Procced To The Next Level.\n");
-					printf("2.Open The Shop.\n");
-					printf("3.Exit The Game.\n");
-					int input;
-					std::cin >> input;
-					switch (input)
+					level_state = LEVEL_MENU;
+					print_level_menu();
+				}
+
+				// Only consume what is already queued, never wait for input
+				while (!menu_input.empty() && level_state != LEVEL_PLAYING)
+				{
+					int option = menu_input.front();
+					menu_input.pop_front();
+					if (level_state == LEVEL_MENU)
+						handle_level_menu_option(option);
+					else
+						handle_shop_option(option);
+				}
+			}
+
+			void Viewer::push_menu_input(int option)
+			{
+				menu_input.push_back(option);
+			}
+
+			void Viewer::print_level_menu()
+			{
+				SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 10);
+				printf("\nCash: %d$               Lives: %d\n", cash, lives);
+				SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
+				printf("Great! You Finished The Level:\n\n");
+				printf("1.Procced To The Next Level.\n");
+				printf("2.Open The Shop.\n");
+				printf("3.Exit The Game.\n");
+			}
+
+			void Viewer::print_shop_menu()
+			{
+				SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 10);
+				printf("\nCash: %d$               Lives: %d\n", cash, lives);
+				SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
+				printf("What'd You Like To Purchase: \n");
+				printf("%-50s Price\n", "Item");
+				printf("%-50s 5$\n", "1.Crispy Chicken (Increases Snake Length)");
+				printf("%-50s 5$\n", "2.A Pair Of Sneakers (Increases Snake Speed)");
+				printf("%-50s 10$\n", "3.Extra Life");
+				printf("4.Return To Menu\n");
+			}
+
+			void Viewer::handle_level_menu_option(int option)
+			{
+				switch (option)
+				{
+					case 1:
 					{
-						case 1:
-						{
-							load_next_level();
-							break;
-						}
-						case 2:
-						{
-							int shop_opt = -1;
-							while (shop_opt != 4)
-							{
-								SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 10);
-								printf("\nCash: %d$               Lives: %d\n", cash, lives);
-								SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
-								printf("What'd You Like To Purchase: \n");
-								printf("%-50s Price\n", "Item");
-								printf("%-50s 5$\n", "1.Crispy Chicken (Increases Snake Length)");
-								printf("%-50s 5$\n", "2.A Pair Of Sneakers (Increases Snake Speed)");
-								printf("%-50s 10$\n", "3.Extra Life");
-								printf("4.Return To Menu\n");
-								
-								std::cin >> shop_opt;
-								switch (shop_opt)
-								{
-								case 1:
-								{
-									if (cash < 5)
-									{
-										SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 4);
-										printf("\nYou Don't Have Enough Money!\n");
-										SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
-									}									
-									else
-									{
-										PlaySound(NULL, NULL, SND_FILENAME | SND_ASYNC);
-										PlaySound(TEXT("length_upgrade.wav"), NULL, SND_FILENAME | SND_ASYNC);
-										snake_length_upgrade++;
-										cash -= 5;
-									}
-									break;
-								}
-								case 2:
-								{
-									if (cash < 5)
-									{
-										SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 4);
-										printf("\nYou Don't Have Enough Money!\n");
-										SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
-									}						
-									else
-									{
-										PlaySound(NULL, NULL, SND_FILENAME | SND_ASYNC);
-										PlaySound(TEXT("speed_upgrade.wav"), NULL, SND_FILENAME | SND_ASYNC);
-										snake_speed++;
-										snake_speed_upgrade++;
-										cash -= 5;
-									}
-									break;
-								}
-								case 3:
-								{
-									if (cash < 10)
-									{
-										SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 4);
-										printf("\nYou Don't Have Enough Money!\n");
-										SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
-									}
-									else
-									{
-										lives++;
-										cash -= 10;
-									}
-									break;
-								}
-								case 4:
-									break;
-								}
-							}
-							level_handler();
-							break;
-						}
-						case 3:
-						{
-							printf("Not Yet.\n");
-							break;
-						}
+						load_next_level();
+						break;
+					}
+					case 2:
+					{
+						level_state = LEVEL_SHOP;
+						print_shop_menu();
+						break;
+					}
+					case 3:
+					{
+						printf("Not Yet.\n");
+						print_level_menu();
+						break;
+					}
+				}
+			}
+
+			void Viewer::handle_shop_option(int option)
+			{
+				switch (option)
+				{
+				case 1:
+				{
+					if (cash < 5)
+					{
+						SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 4);
+						printf("\nYou Don't Have Enough Money!\n");
+						SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
+					}									
+					else
+					{
+						PlaySound(NULL, NULL, SND_FILENAME | SND_ASYNC);
+						PlaySound(TEXT("length_upgrade.wav"), NULL, SND_FILENAME | SND_ASYNC);
+						snake_length_upgrade++;
+						cash -= 5;
+					}
+					break;
+				}
+				case 2:
+				{
+					if (cash < 5)
+					{
+						SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 4);
+						printf("\nYou Don't Have Enough Money!\n");
+						SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
+					}						
+					else
+					{
+						PlaySound(NULL, NULL, SND_FILENAME | SND_ASYNC);
+						PlaySound(TEXT("speed_upgrade.wav"), NULL, SND_FILENAME | SND_ASYNC);
+						snake_speed++;
+						snake_speed_upgrade++;
+						cash -= 5;
+					}
+					break;
+				}
+				case 3:
+				{
+					if (cash < 10)
+					{
+						SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 4);
+						printf("\nYou Don't Have Enough Money!\n");
+						SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
+					}
+					else
+					{
+						lives++;
+						cash -= 10;
 					}
+					break;
+				}
+				case 4:
+				{
+					level_state = LEVEL_MENU;
+					print_level_menu();
+					return;
+				}
+				default:
+					return;
 				}
+				print_shop_menu();
 			}
 
 			void Viewer::load_next_level()
@@ -481,11 +554,13 @@ namespace igl
 				loading = true;
 				finished_level = false;
 				finished_objective = false;
+				level_state = LEVEL_PLAYING;
+				menu_input.clear();
 				run_ik = false;
 				found_obj = false;
 				cur_level++;
 
-				for (int i = data_list.size() - 1; i >= arm_length; i--)
+				for (int i = data_list.size() - 1; i > SNAKE_SKIN; i--)
 				{
 					erase_mesh(i);
 				}
@@ -493,28 +568,12 @@ namespace igl
 				load_snake();
 				if (snake_length_upgrade > 0)
 				{
-					
-
-					arm_length += 2 * snake_length_upgrade;
+					// More bones, the snake skin is rebound to all of them below
+					for (int i = 0; i < 2 * snake_length_upgrade; i++)
+						append_snake_bone();
 					SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 2);
 					printf("Snake Length Upgraded To %d!\n", arm_length);
 					SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
-					Eigen::MatrixXd& V = data().V;
-					Eigen::MatrixXi& F = data().F;
-					Eigen::Vector3d m = V.colwise().minCoeff();
-					Eigen::Vector3d M = V.colwise().maxCoeff();
-					link_length = abs(M(1) - m(1));
-
-					for (int i = 0; i < 2 * snake_length_upgrade; i++)
-					{
-						if (!load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/ycylinder.obj"))
-							std::cout << "Failed To Upgrade Snake Length" << std::endl;
-						data_list[selected_data_index].getTrans().pretranslate(Eigen::Vector3f(0, link_length * (selected_data_index), 0));
-						parent_axis_coordinates[selected_data_index] = Eigen::Vector4f(0, 0.8 + link_length * (selected_data_index), 0, 1);
-						parent_axis_rotation[selected_data_index] = Eigen::Matrix4f::Identity();
-						data().uniform_colors_index(1);
-						data().set_face_based(false);
-					}
 					snake_length_upgrade = 0;
 					save_snake();
 				}
@@ -541,6 +600,7 @@ namespace igl
 				}
 				load_environment();
 				build_kd_trees();
+				init_snake_skin();
 
 				for (auto& data : data_list)
 				{
@@ -565,11 +625,28 @@ namespace igl
 				loading = false;
 			}
 
+			bool Viewer::load_scene_mesh(SceneMesh mesh)
+			{
+				if (scene_mesh_loader)
+					return scene_mesh_loader(mesh);
+				return load_mesh_from_file(scene_mesh_files[mesh]);
+			}
+
+			int Viewer::environment_index(EnvironmentMesh mesh) const
+			{
+				return (int)data_list.size() - ENVIRONMENT_SIZE + mesh;
+			}
+
+			int Viewer::num_balls() const
+			{
+				return std::max(0, (int)data_list.size() - ENVIRONMENT_SIZE - FIRST_BALL);
+			}
+
 			void Viewer::load_balls(int n)
 			{
 				for (int i = 0; i < n; i++)
 				{
-					load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/sphere.obj");
+					load_scene_mesh(SCENE_MESH_BALL);
 					movement m1;
 					double x = (double)rand() / RAND_MAX;
 					x = -0.5f + x * (1.0f);
@@ -578,50 +655,60 @@ namespace igl
 
 					m1.velocity = Eigen::Vector3f(x, y, 0) / 30;
 					m1.elasticity = 0.80f;
-					if (i >= movement_data.size())
+					if (i >= (int)movement_data.size())
 						movement_data.push_back(m1);
 					else
 						movement_data.at(i) = m1;
 
 					data().Move(Eigen::Vector4f(1.5f * pow(-1.85f, i) + pow(-1, i), 1.5f * pow(-1.85f, i) + pow(-1, i), 0, 1));
-					data_list[i + arm_length].getTrans().pretranslate(Eigen::Vector3f(0, 0, 0.9f));
+					data_list[FIRST_BALL + i].getTrans().pretranslate(Eigen::Vector3f(0, 0, 0.9f));
 					data().set_face_based(false);
 				}
 			}
 
 			void Viewer::load_environment()
 			{
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/grass.obj");
+				// The arrows show up once the objective is reached
+				const auto hide = [this](ViewerData& data)
+				{
+					if (left_view && right_view)
+					{
+						data.set_visible(false, left_view->id);
+						data.set_visible(false, right_view->id);
+					}
+					else
+						data.set_visible(false);
+				};
+
+				load_scene_mesh(SCENE_MESH_GROUND);
 				data().uniform_colors_index(4);
 				data().shininess = 5.0f;
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/Wall.obj");
+				load_scene_mesh(SCENE_MESH_WALL);
 				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(0, 57, 0));
 				data().uniform_colors_index(5);
 				data().shininess = 100.0f;
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/Pyramid.obj");
+				load_scene_mesh(SCENE_MESH_PYRAMID);
 				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(0, 52.0f, 0));
 
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/ArrowRight.obj");
+				load_scene_mesh(SCENE_MESH_ARROW_RIGHT);
 				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(-15, 35.0f, 0));
-				data_list[data_list.size() - 1].set_visible(false, left_view->id);
-				data_list[data_list.size() - 1].set_visible(false, right_view->id);
+				hide(data_list[data_list.size() - 1]);
 				right_arrow = data_list[data_list.size() - 1].id;
 
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/ArrowLeft.obj");
+				load_scene_mesh(SCENE_MESH_ARROW_LEFT);
 				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(15, 35.0f, 0));
-				data_list[data_list.size() - 1].set_visible(false, left_view->id);
-				data_list[data_list.size() - 1].set_visible(false, right_view->id);
+				hide(data_list[data_list.size() - 1]);
 				left_arrow = data_list[data_list.size() - 1].id;
 
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/Wall.obj");
+				load_scene_mesh(SCENE_MESH_WALL);
 				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(0, -57, 0));
 				data().uniform_colors_index(5);
 				data().shininess = 100.0f;
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/WallSides.obj");
+				load_scene_mesh(SCENE_MESH_WALL_SIDES);
 				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(57, 0, 0));
 				data().uniform_colors_index(5);
 				data().shininess = 100.0f;
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/WallSides.obj");
+				load_scene_mesh(SCENE_MESH_WALL_SIDES);
 				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(-57, 0, 0));
 				data().uniform_colors_index(5);
 				data().shininess = 100.0f;
@@ -629,13 +716,12 @@ namespace igl
 
 			void Viewer::save_snake()
 			{
-				saved_snake_data.clear();
 				for (int i = 0; i < arm_length; i++)
 				{
 					saved_parent_axis_coordinates[i] = parent_axis_coordinates[i];
 					saved_parent_axis_rotation[i] = parent_axis_rotation[i];
-					saved_snake_data.push_back(data_list[i]);
 				}
+				saved_snake_bones = snake_bones;
 				saved_arm_root = arm_root;
 				saved_arm_root_rotation = arm_root_rotation;
 			}
@@ -646,8 +732,8 @@ namespace igl
 				{
 					parent_axis_coordinates[i] = saved_parent_axis_coordinates[i];
 					parent_axis_rotation[i] = saved_parent_axis_rotation[i];
-					data_list.at(i) = saved_snake_data.at(i);
 				}
+				snake_bones = saved_snake_bones;
 				arm_root = saved_arm_root;
 				arm_root_rotation = saved_arm_root_rotation;
 				arm_scale = 1.0f;
@@ -658,30 +744,80 @@ namespace igl
 			{
 				if (loading)
 					return;
+
+				// Broad phase: only the balls whose collision spheres overlap
+				// a bone's go through the box test.
+				// may_touch[i * num_balls + b]: bone i may touch ball b. ball_of
+				// maps data_list indices to balls as balls get erased below.
+				const int num_balls = this->num_balls();
+				std::vector<char> may_touch(arm_length * num_balls, 0);
+				std::vector<int> ball_of(num_balls);
+				{
+					igl::Profiler::Scope scope("collision broad");
+					Eigen::MatrixXd ball_centers(num_balls, 3);
+					Eigen::VectorXd ball_radii(num_balls);
+					Eigen::MatrixXd link_centers(arm_length, 3);
+					Eigen::VectorXd link_radii(arm_length);
+					for (int b = 0; b < num_balls; b++)
+					{
+						Eigen::Vector3d center;
+						collision_sphere(FIRST_BALL + b, center, ball_radii(b));
+						ball_centers.row(b) = center;
+					}
+					for (int i = 0; i < arm_length; i++)
+					{
+						Eigen::Vector3d center;
+						bone_collision_sphere(i, center, link_radii(i));
+						link_centers.row(i) = center;
+					}
+					if (ball_index.size() != num_balls)
+						ball_index.build(ball_centers);
+					else
+						ball_index.update(ball_centers);
+					std::vector<std::vector<int> > near_balls;
+					ball_index.radius_search(link_centers,
+						(arm_length > 0 ? link_radii.maxCoeff() : 0) + (num_balls > 0 ? ball_radii.maxCoeff() : 0),
+						near_balls);
+					for (int i = 0; i < arm_length; i++)
+						for (int b : near_balls[i])
+							if ((link_centers.row(i) - ball_centers.row(b)).norm() <= link_radii(i) + ball_radii(b))
+								may_touch[i * num_balls + b] = 1;
+					for (int b = 0; b < num_balls; b++)
+						ball_of[b] = b;
+				}
+
 				for (int i = 0; i < arm_length; i++)
 				{
 					if (finished_objective)
 					{
-						bool collision = check_for_collision(kd_trees.at(i), kd_trees.at(data_list.size() - 6), i, data_list.size() - 6);
+						igl::Profiler::Scope scope("collision narrow");
+						const int pyramid = environment_index(ENVIRONMENT_PYRAMID);
+						bool collision = check_bone_collision(i, pyramid);
 						if (collision)
 						{
 							finished_level = true;
 							return;
 						}
 					}
-					for (int j = arm_length; j < data_list.size() - 8; j++)
+					for (int j = FIRST_BALL; j < FIRST_BALL + this->num_balls(); j++)
 				{
 					bool collision = false;
+					if (!may_touch[i * num_balls + ball_of[j - FIRST_BALL]])
+						continue;
 					if (true/* || in % 5 == 0*/)
 					{
-						collision = check_for_collision(kd_trees.at(i), kd_trees.at(j), i, j);
+						{
+							igl::Profiler::Scope scope("collision narrow");
+							collision = check_bone_collision(i, j);
+						}
 						if (collision)
 						{
 							printf("There has been a collision! (%d, %d)\n", i, j);
 							PlaySound(NULL, NULL, SND_FILENAME | SND_ASYNC);
 							PlaySound(TEXT("bounce.wav"), NULL, SND_FILENAME | SND_ASYNC);
 							erase_mesh(j);
-							movement_data.erase(movement_data.begin() + (j - arm_length));
+							movement_data.erase(movement_data.begin() + (j - FIRST_BALL));
+							ball_of.erase(ball_of.begin() + (j - FIRST_BALL));
 							update = false;
 							score += 50;
 							cash += 5;
@@ -695,6 +831,30 @@ namespace igl
 				
 			}
 
+			// Sphere through the corners of the box check_for_collision tests,
+			// which encloses the oriented box
+			static void box_collision_sphere(const Eigen::AlignedBox<double, 3>& box, const Eigen::Vector3d& t, double scale,
+				Eigen::Vector3d& center, double& radius)
+			{
+				const Eigen::Vector3d b_min = scale * box.min() + t;
+				const Eigen::Vector3d b_max = scale * box.max() + t;
+				center = 0.5 * (b_min + b_max);
+				// Pad for the single precision box test
+				radius = 0.5 * (b_max - b_min).norm() * (1 + 1e-4) + 1e-6;
+			}
+
+			void Viewer::collision_sphere(int i, Eigen::Vector3d& center, double& radius)
+			{
+				box_collision_sphere(kd_trees.at(i).m_box, data_list[i].getTrans().translation().cast<double>(), scales.at(i),
+					center, radius);
+			}
+
+			void Viewer::bone_collision_sphere(int i, Eigen::Vector3d& center, double& radius)
+			{
+				box_collision_sphere(snake_link_tree.m_box, snake_bones[i].getTrans().translation().cast<double>(), 1,
+					center, radius);
+			}
+
 			bool Viewer::get_separating_axis(Eigen::Vector3f& delta, Eigen::Vector3f& plane, OBB& box1, OBB& box2)
 			{
 				return (fabs(delta.dot(plane)) >
@@ -730,6 +890,17 @@ namespace igl
 
 
 			bool Viewer::check_for_collision(AABB<Eigen::MatrixXd, 3>& aabb_0, AABB<Eigen::MatrixXd, 3>& aabb_1, int i, int j)
+			{
+				return check_for_collision(aabb_0, aabb_1, data_list[i].getTrans(), scales.at(i), data_list[j].getTrans(), scales.at(j));
+			}
+
+			bool Viewer::check_bone_collision(int i, int j)
+			{
+				return check_for_collision(snake_link_tree, kd_trees.at(j), snake_bones[i].getTrans(), 1, data_list[j].getTrans(), scales.at(j));
+			}
+
+			bool Viewer::check_for_collision(const AABB<Eigen::MatrixXd, 3>& aabb_0, const AABB<Eigen::MatrixXd, 3>& aabb_1,
+				const Eigen::Affine3f& T0, double s0, const Eigen::Affine3f& T1, double s1)
 			{
 				using namespace Eigen;
 				AlignedBox3f b0 = AlignedBox3f(aabb_0.m_box);
@@ -738,15 +909,15 @@ namespace igl
 				Matrix4f t1;
 
 				t0 <<
-					scales.at(i), 0, 0, data_list[i].getTrans().translation().x(),
-					0, scales.at(i), 0, data_list[i].getTrans().translation().y(),
-					0, 0, scales.at(i), data_list[i].getTrans().translation().z(),
+					s0, 0, 0, T0.translation().x(),
+					0, s0, 0, T0.translation().y(),
+					0, 0, s0, T0.translation().z(),
 					0, 0, 0, 1;
 
 				t1 <<
-					scales.at(j), 0, 0, data_list[j].getTrans().translation().x(),
-					0, scales.at(j), 0, data_list[j].getTrans().translation().y(),
-					0, 0, scales.at(j), data_list[j].getTrans().translation().z(),
+					s1, 0, 0, T1.translation().x(),
+					0, s1, 0, T1.translation().y(),
+					0, 0, s1, T1.translation().z(),
 					0, 0, 0, 1;
 
 				Vector4f b0_min(b0.m_min.x(), b0.m_min.y(), b0.m_min.z(), 1);
@@ -769,8 +940,8 @@ namespace igl
 				b1.m_max.x() = b1_max.x(); b1.m_max.y() = b1_max.y(); b1.m_max.z() = b1_max.z();
 
 				Vector3f right(1, 0, 0), up(0, 1, 0), forward(0, 0, 1);
-				Matrix3f rotation_0 = data_list[i].getTrans().rotation();
-				Matrix3f rotation_1 = data_list[j].getTrans().rotation();
+				Matrix3f rotation_0 = T0.rotation();
+				Matrix3f rotation_1 = T1.rotation();
 
 				OBB obb_0, obb_1;
 				obb_0.position = Vector3f(b0.center().x(), b0.center().y(), b0.center().z());
@@ -841,10 +1012,10 @@ namespace igl
 					}*/
 					else
 					{
-						return check_for_collision(*aabb_0.m_left, *aabb_1.m_left, i, j) ||
-							check_for_collision(*aabb_0.m_right, *aabb_1.m_right, i, j) ||
-							check_for_collision(*aabb_0.m_right, *aabb_1.m_left, i, j) ||
-							check_for_collision(*aabb_0.m_left, *aabb_1.m_right, i, j);
+						return check_for_collision(*aabb_0.m_left, *aabb_1.m_left, T0, s0, T1, s1) ||
+							check_for_collision(*aabb_0.m_right, *aabb_1.m_right, T0, s0, T1, s1) ||
+							check_for_collision(*aabb_0.m_right, *aabb_1.m_left, T0, s0, T1, s1) ||
+							check_for_collision(*aabb_0.m_left, *aabb_1.m_right, T0, s0, T1, s1);
 					}
 				}
 				return collision;
@@ -854,87 +1025,272 @@ namespace igl
 			void Viewer::build_kd_trees()
 			{
 				using namespace Eigen;
+				// Trees are built in place, a copy would be as large as the tree
+				kd_trees.reserve(kd_trees.size() + data_list.size() - 1);
 				for (int i = 0; i < data_list.size() - 1; i++)
 				{
-					igl::AABB<MatrixXd, 3> tree;
-					tree.init(data_list[i].V, data_list[i].F);
-					kd_trees.push_back(tree);
+					kd_trees.emplace_back();
+					// The snake collides through its bones
+					if (i != SNAKE_SKIN)
+						kd_trees.back().init(data_list[i].V, data_list[i].F);
 					scales.push_back(1);
 					//in = 0;
 				}
+				snake_link_tree.init(snake_link_V, snake_link_F);
 			}
 
-			void Viewer::draw_bounding_boxes()
+			void Viewer::append_snake_bone()
+			{
+				const int i = (int)snake_bones.size();
+				snake_bones.emplace_back();
+				snake_bones[i].MyTranslate(Eigen::Vector3f(0, link_length * i, 0), OBJECT_AXIS);
+				parent_axis_coordinates[i] = Eigen::Vector4f(0, 0.8 + link_length * i, 0, 1);
+				parent_axis_rotation[i] = Eigen::Matrix4f::Identity();
+				arm_length = (int)snake_bones.size();
+			}
+
+			void Viewer::init_snake_skin()
 			{
 				using namespace Eigen;
+				const int bones = arm_length;
+				// Tube resolution: around the tube, and rings per link
+				const int segments = 16;
+				const int rings = 4;
+
+				snake_bone_rest.resize(bones);
+				for (int i = 0; i < bones; i++)
+					snake_bone_rest[i] = snake_bones[i].MakeTrans();
+
+				// Link extents in bone coordinates
+				Vector3d m = snake_link_V.colwise().minCoeff();
+				Vector3d M = snake_link_V.colwise().maxCoeff();
+				const double radius = 0.5 * std::max(M(0) - m(0), M(2) - m(2));
+				const double cx = 0.5 * (M(0) + m(0));
+				const double cz = 0.5 * (M(2) + m(2));
+
+				// The chain runs along +y of the bones, or along -y of all of them
+				// once InvertSnake reversed their order: the end of a bone is the
+				// one nearer to the next bone
+				std::vector<char> reversed(bones, 0);
+				for (int b = 0; b < bones && bones > 1; b++)
+				{
+					const int o = b + 1 < bones ? b + 1 : b - 1;
+					const Vector4f other = snake_bone_rest[o] * Vector4f(cx, 0.5 * (m(1) + M(1)), cz, 1);
+					const float d_bottom = (snake_bone_rest[b] * Vector4f(cx, m(1), cz, 1) - other).norm();
+					const float d_top = (snake_bone_rest[b] * Vector4f(cx, M(1), cz, 1) - other).norm();
+					reversed[b] = o > b ? d_bottom < d_top : d_top < d_bottom;
+				}
+				// Position along bone b at t in [0, 1] from its start to its end
+				const auto bone_y = [&](int b, double t)
+				{
+					return reversed[b] ? M(1) - t * (M(1) - m(1)) : m(1) + t * (M(1) - m(1));
+				};
 
-				if (bounding_boxes_visible)
+				const int n_rings = bones * rings + 1;
+				const int n = n_rings * segments;
+				snake_skin_rest.resize(n + 2, 3);
+				snake_skin_bones.setZero(n + 2, 2);
+				snake_skin_weights.setZero(n + 2, 2);
+				for (int r = 0; r < n_rings; r++)
 				{
-					for (int i = 0; i < data_list.size(); i++)
+					const int b = std::min(r / rings, bones - 1);
+					// Position along link b in [0, 1]
+					const double t = double(r - b * rings) / rings;
+					const double y = bone_y(b, t);
+					// Blend with the neighbouring link within a quarter link of a joint
+					int b2 = b;
+					double w = 1;
+					if (t < 0.25 && b > 0)
 					{
-						MatrixXd V = data_list[i].V;
-						MatrixXi F = data_list[i].F;
-						data_list[i].clear();
-						data_list[i].set_mesh(V, F);
-						if (i < arm_length)
-							data_list[i].uniform_colors_index(1);
+						b2 = b - 1;
+						w = 0.5 + 2 * t;
 					}
+					else if (t > 0.75 && b < bones - 1)
+					{
+						b2 = b + 1;
+						w = 0.5 + 2 * (1 - t);
+					}
+					for (int s = 0; s < segments; s++)
+					{
+						// Turning the other way keeps the faces outwards on reversed bones
+						const double th = (reversed[b] ? -2.0 : 2.0) * igl::PI * s / segments;
+						Vector4f p = snake_bone_rest[b] * Vector4f(cx + radius * cos(th), y, cz + radius * sin(th), 1);
+						const int v = r * segments + s;
+						snake_skin_rest.row(v) = p.head<3>().cast<double>().transpose();
+						snake_skin_bones.row(v) << b, b2;
+						snake_skin_weights.row(v) << w, 1 - w;
+					}
+				}
+				// Cap centers
+				Vector4f bottom = snake_bone_rest[0] * Vector4f(cx, bone_y(0, 0), cz, 1);
+				Vector4f top = snake_bone_rest[bones - 1] * Vector4f(cx, bone_y(bones - 1, 1), cz, 1);
+				snake_skin_rest.row(n) = bottom.head<3>().cast<double>().transpose();
+				snake_skin_rest.row(n + 1) = top.head<3>().cast<double>().transpose();
+				snake_skin_bones.row(n + 1) << bones - 1, bones - 1;
+				snake_skin_weights.row(n) << 1, 0;
+				snake_skin_weights.row(n + 1) << 1, 0;
+
+				MatrixXi F((n_rings - 1) * segments * 2 + 2 * segments, 3);
+				int f = 0;
+				for (int r = 0; r + 1 < n_rings; r++)
+				{
+					for (int s = 0; s < segments; s++)
+					{
+						const int a = r * segments + s;
+						const int b = r * segments + (s + 1) % segments;
+						F.row(f++) << a, a + segments, b;
+						F.row(f++) << b, a + segments, b + segments;
+					}
+				}
+				for (int s = 0; s < segments; s++)
+				{
+					F.row(f++) << n, s, (s + 1) % segments;
+					F.row(f++) << n + 1, n - segments + (s + 1) % segments, n - segments + s;
+				}
+
+				ViewerData& skin = data_list[SNAKE_SKIN];
+				skin.clear();
+				skin.set_mesh(snake_skin_rest, F);
+				skin.compute_normals();
+				skin.uniform_colors_index(1);
+				skin.grid_texture();
+				skin.set_face_based(false);
+				update_snake_skin();
+			}
+
+			void Viewer::update_snake_skin()
+			{
+				using namespace Eigen;
+				if (snake_skin_rest.rows() == 0 || (int)snake_bone_rest.size() != arm_length)
 					return;
+
+				std::vector<Quaterniond, aligned_allocator<Quaterniond>> vQ(arm_length);
+				std::vector<Vector3d> vT(arm_length);
+				for (int i = 0; i < arm_length; i++)
+				{
+					const Matrix4f& rest = snake_bone_rest[i];
+					Matrix4f cur = snake_bones[i].MakeTrans();
+					// Only the rigid part is blended: bones are scaled uniformly about
+					// the arm root (ScaleArm), which already shows in their translations
+					Matrix3d R = (cur.block<3, 3>(0, 0) * rest.block<3, 3>(0, 0).inverse()).cast<double>();
+					R /= std::cbrt(R.determinant());
+					vQ[i] = Quaterniond(R).normalized();
+					vT[i] = cur.block<3, 1>(0, 3).cast<double>() - vQ[i] * rest.block<3, 1>(0, 3).cast<double>();
 				}
-				
-				for (int i = 0; i < data_list.size(); i++)
+
+				MatrixXd U;
+				igl::dqs(snake_skin_rest, snake_skin_bones, snake_skin_weights, vQ, vT, U);
+				// Only the position and normal buffers are marked dirty
+				data_list[SNAKE_SKIN].set_vertices(std::move(U));
+				data_list[SNAKE_SKIN].compute_normals();
+			}
+
+			void Viewer::draw_bounding_boxes()
+			{
+				// Called before the toggle: hiding empties the overlay, showing fills
+				// it, and the renderer keeps it up to date while shown
+				if (bounding_boxes_visible)
+					debug_overlay.clear_overlays();
+				else
+					update_debug_overlay();
+			}
+
+			void Viewer::update_debug_overlay()
+			{
+				using namespace Eigen;
+
+				// Edges of a box between the corners ordered as in the loop below
+				static const int E_box[12][2] = {
+					{0, 1}, {1, 2}, {2, 3}, {3, 0},
+					{4, 5}, {5, 6}, {6, 7}, {7, 4},
+					{0, 4}, {1, 5}, {2, 6}, {7, 3} };
+
+				// Boxes in the coordinates of their mesh, with the mesh transformation
+				struct DebugBox
 				{
-					MatrixXd V = data_list[i].V;
-					MatrixXi F = data_list[i].F;
-
-					// Find the bounding box
-					Vector3d m = V.colwise().minCoeff();
-					Vector3d M = V.colwise().maxCoeff();
-
-					// Corners of the bounding box
-					Eigen::MatrixXd V_box(8, 3);
-					V_box <<
-						m(0), m(1), m(2),
-						M(0), m(1), m(2),
-						M(0), M(1), m(2),
-						m(0), M(1), m(2),
-						m(0), m(1), M(2),
-						M(0), m(1), M(2),
-						M(0), M(1), M(2),
-						m(0), M(1), M(2);
-
-					// Edges of the bounding box
-					Eigen::MatrixXi E_box(12, 2);
-					E_box <<
-						0, 1,
-						1, 2,
-						2, 3,
-						3, 0,
-						4, 5,
-						5, 6,
-						6, 7,
-						7, 4,
-						0, 4,
-						1, 5,
-						2, 6,
-						7, 3;
-
-					data_list[i].clear();
-					data_list[i].set_mesh(V, F);
-					if (i < arm_length)
-						data_list[i].uniform_colors_index(1);
-					// Plot the corners of the bounding box as points
-					data_list[i].add_points(V_box, Eigen::RowVector3d(1, 0, 0));
-
-					// Plot the edges of the bounding box
-					for (unsigned j = 0;j < E_box.rows(); ++j)
-						data_list[i].add_edges
-						(
-							V_box.row(E_box(j, 0)),
-							V_box.row(E_box(j, 1)),
-							(i < arm_length ? Eigen::RowVector3d(0.2f, 0.8f, 0.6f) : Eigen::RowVector3d(0, 1, 0))
-						);
+					AlignedBox3f box;
+					Matrix4f T;
+					RowVector3d color;
+					bool corners;
+				};
+				std::vector<DebugBox, aligned_allocator<DebugBox>> boxes;
+				std::vector<std::pair<const AABB<MatrixXd, 3>*, int>> stack;
+				int num_corners = 0;
+				// The box of a mesh, and its inner kd-tree nodes from yellow below
+				// the root to red at the deepest level
+				const auto add_boxes = [&](const AlignedBox3f& box, const AABB<MatrixXd, 3>* tree, const Matrix4f& T,
+					const RowVector3d& color)
+				{
+					boxes.push_back({ box, T, color, true });
+					num_corners += 8;
+					if (bounding_boxes_depth <= 0 || !tree)
+						return;
+					stack.clear();
+					stack.emplace_back(tree, 0);
+					while (!stack.empty())
+					{
+						const AABB<MatrixXd, 3>* node = stack.back().first;
+						const int depth = stack.back().second;
+						stack.pop_back();
+						if (depth > 0 && !node->m_box.isEmpty())
+							boxes.push_back({ node->m_box.cast<float>(), T,
+								RowVector3d(1, 1 - double(depth - 1) / std::max(1, bounding_boxes_depth - 1), 0), false });
+						if (depth == bounding_boxes_depth)
+							continue;
+						if (node->m_left)
+							stack.emplace_back(node->m_left, depth + 1);
+						if (node->m_right)
+							stack.emplace_back(node->m_right, depth + 1);
+					}
+				};
+				for (int i = 0; i < (int)data_list.size(); i++)
+				{
+					ViewerData& mesh = data_list[i];
+					const AlignedBox3f& box = mesh.mesh_bounds();
+					if (!mesh.is_visible || box.isEmpty())
+						continue;
+					// The snake shows the boxes it collides with, those of its bones
+					if (i == SNAKE_SKIN)
+					{
+						const AlignedBox3f bone_box = snake_link_tree.m_box.cast<float>();
+						for (int b = 0; b < (int)snake_bones.size() && !bone_box.isEmpty(); b++)
+							add_boxes(bone_box, &snake_link_tree, snake_bones[b].MakeTrans(), RowVector3d(0.2, 0.8, 0.6));
+						continue;
+					}
+					add_boxes(box, i < (int)kd_trees.size() ? &kd_trees[i] : nullptr, mesh.MakeTrans(), RowVector3d(0, 1, 0));
 				}
+
+				// One pass into the final overlay matrices, whose buffers are the only
+				// ones uploaded
+				MatrixXd& lines = debug_overlay.lines;
+				MatrixXd& points = debug_overlay.points;
+				lines.resize(12 * boxes.size(), 9);
+				points.resize(num_corners, 6);
+				int p = 0;
+				for (int b = 0; b < (int)boxes.size(); b++)
+				{
+					const DebugBox& d = boxes[b];
+					const Vector3f& m = d.box.min();
+					const Vector3f& M = d.box.max();
+					Matrix<double, 8, 3> C;
+					for (int c = 0; c < 8; c++)
+					{
+						// 0..3 counterclockwise at min z, 4..7 above them at max z
+						const Vector4f corner(
+							(c & 3) == 1 || (c & 3) == 2 ? M(0) : m(0),
+							(c & 3) >= 2 ? M(1) : m(1),
+							c >= 4 ? M(2) : m(2),
+							1);
+						C.row(c) = (d.T * corner).head<3>().cast<double>().transpose();
+					}
+					for (int e = 0; e < 12; e++)
+						lines.row(12 * b + e) << C.row(E_box[e][0]), C.row(E_box[e][1]), d.color;
+					if (!d.corners)
+						continue;
+					for (int c = 0; c < 8; c++, p++)
+						points.row(p) << C.row(c), 1, 0, 0;
+				}
+				debug_overlay.dirty |= MeshGL::DIRTY_OVERLAY_LINES | MeshGL::DIRTY_OVERLAY_POINTS;
 			}
 
 
@@ -942,29 +1298,29 @@ namespace igl
 			{
 				if (loading)
 					return;
-				for (int i = 0; i < data_list.size() - arm_length - 8; i++)
+				for (int i = 0; i < num_balls(); i++)
 				{
-					if (data_list[i + arm_length].getTrans().translation().x() > 52.5f)
+					if (data_list[FIRST_BALL + i].getTrans().translation().x() > 52.5f)
 						movement_data[i].velocity.x() *= -1;
-					else if (data_list[i + arm_length].getTrans().translation().x() < -52.5f)
+					else if (data_list[FIRST_BALL + i].getTrans().translation().x() < -52.5f)
 						movement_data[i].velocity.x() *= -1;
 
-					if (data_list[i + arm_length].getTrans().translation().y() > 52.5f)
+					if (data_list[FIRST_BALL + i].getTrans().translation().y() > 52.5f)
 						movement_data[i].velocity.y() *= -1;
-					else if (data_list[i + arm_length].getTrans().translation().y() < -52.5f)
+					else if (data_list[FIRST_BALL + i].getTrans().translation().y() < -52.5f)
 						movement_data[i].velocity.y() *= -1;
 
 						
-					else if (data_list[i + arm_length].getTrans().translation().z() < 0.2f)
+					else if (data_list[FIRST_BALL + i].getTrans().translation().z() < 0.2f)
 						movement_data[i].velocity.z() *= -1;
 
 					if (fabs(movement_data[i].velocity.z()) > 0.001f)
 					{
 						Eigen::Vector3f translation_3 = deltaTime * movement_data[i].velocity / 5.0f;
-						data_list[i + arm_length].MyTranslate(translation_3, CAMERA_AXIS);
+						data_list[FIRST_BALL + i].MyTranslate(translation_3, CAMERA_AXIS);
 					}
 					
-					//data_list[i + arm_length].getTrans().pretranslate(translation_3);
+					//data_list[FIRST_BALL + i].getTrans().pretranslate(translation_3);
 				}	
 			}
 
@@ -973,141 +1329,81 @@ namespace igl
 				cur_level_max_score = 50 * n;
 				load_meshs(n);
 				int saved_index = selected_data_index;
-				for (int i = 0; i < data_list.size(); i++)
+				load_meshs_ik();
+				for (int i = FIRST_BALL; i < data_list.size(); i++)
 				{
 					selected_data_index = i;
-					if(i < arm_length)
-					data().uniform_colors_index(1);
-					load_meshs_ik();
-					if (i >= arm_length)
-					{
-						movement m1;
-						double x = (double)rand() / RAND_MAX;
-						x = -0.5f + x * (1.0f);
-						double y = (double)rand() / RAND_MAX;
-						y = -0.5f + y * (1.0f);
-
-						m1.velocity = Eigen::Vector3f(x, y, 0) / 40;
-						m1.elasticity = 0.82f;
-						movement_data.push_back(m1);
-						data_list[i].getTrans().pretranslate(Eigen::Vector3f(0, 0, 0.9f));
-					}
-				}
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/grass.obj");
-				data().uniform_colors_index(4);
-				data().shininess = 5.0f;
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/Wall.obj");
-				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(0, 57, 0));
-				data().uniform_colors_index(5);
-				data().shininess = 100.0f;
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/Pyramid.obj");
-				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(0, 52.0f, 0));
-
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/ArrowRight.obj");
-				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(-15, 35.0f, 0));
-				data_list[data_list.size() - 1].set_visible(false);
-				right_arrow = data_list[data_list.size() - 1].id;
+					// Spread the balls along y past the snake
+					const Eigen::MatrixXd& V = data().V;
+					const double ball_height = V.col(1).maxCoeff() - V.col(1).minCoeff();
+					data().MyTranslate(Eigen::Vector3f(0, ball_height * (arm_length + i - FIRST_BALL), 0), OBJECT_AXIS);
+					data().set_face_based(false);
 
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/ArrowLeft.obj");
-				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(15, 35.0f, 0));
-				data_list[data_list.size() - 1].set_visible(false);
-				left_arrow = data_list[data_list.size() - 1].id;
+					movement m1;
+					double x = (double)rand() / RAND_MAX;
+					x = -0.5f + x * (1.0f);
+					double y = (double)rand() / RAND_MAX;
+					y = -0.5f + y * (1.0f);
 
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/Wall.obj");
-				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(0, -57, 0));
-				data().uniform_colors_index(5);
-				data().shininess = 100.0f;
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/WallSides.obj");
-				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(57, 0, 0));
-				data().uniform_colors_index(5);
-				data().shininess = 100.0f;
-				load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/WallSides.obj");
-				data_list[data_list.size() - 1].getTrans().pretranslate(Eigen::Vector3f(-57, 0, 0));
-				data().uniform_colors_index(5);
-				data().shininess = 100.0f;
+					m1.velocity = Eigen::Vector3f(x, y, 0) / 40;
+					m1.elasticity = 0.82f;
+					movement_data.push_back(m1);
+					data_list[i].getTrans().pretranslate(Eigen::Vector3f(0, 0, 0.9f));
+				}
+				load_environment();
 				//load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/cTower.obj");
 
 				build_kd_trees();
+				init_snake_skin();
 				selected_data_index = saved_index;
 				return 0;
 			}
 
 			int Viewer::load_meshs_ik()
 			{
-				Eigen::MatrixXd& V = data().V;
-				Eigen::MatrixXi& F = data().F;
-				// Find the bounding box
-				Eigen::Vector3d m = V.colwise().minCoeff();
-				Eigen::Vector3d M = V.colwise().maxCoeff();
+				// Find the bounding box of the link
+				Eigen::Vector3d m = snake_link_V.colwise().minCoeff();
+				Eigen::Vector3d M = snake_link_V.colwise().maxCoeff();
 
 				link_length = abs(M(1) - m(1));
+				arm_geo_center = Eigen::Vector3f((M(0) + m(0)) / 2, m(1), (M(2) + m(2)) / 2);
+				arm_root = Eigen::Vector4f(0, -0.8, 0, 1);
+				arm_root_rotation = Eigen::Matrix4f::Identity();
 
-				if (selected_data_index == 0)
-				{
-					arm_geo_center = Eigen::Vector3f((M(0) + m(0)) / 2, m(1), (M(2) + m(2)) / 2);
-					parent_axis_coordinates[selected_data_index] = Eigen::Vector4f(0, 0.8, 0, 1);
-					arm_root = Eigen::Vector4f(0, -0.8, 0, 1);
-					arm_root_rotation = Eigen::Matrix4f::Identity();
-				}
-				else
-				{
-					data().MyTranslate(Eigen::Vector3f(0, link_length * (selected_data_index), 0), OBJECT_AXIS);
-					parent_axis_coordinates[selected_data_index] = Eigen::Vector4f(0, 0.8 + link_length * (selected_data_index), 0, 1);
-				}
-				parent_axis_rotation[selected_data_index] = Eigen::Matrix4f::Identity();
-
-				// Plot the mesh
-				data().set_mesh(V, F);
-				data().set_face_based(false);
+				const int bones = arm_length;
+				snake_bones.clear();
+				for (int i = 0; i < bones; i++)
+					append_snake_bone();
 
 				return 0;
 			}
 
 			int Viewer::load_meshs(int x)
 			{
-				std::ifstream in("./configuration.txt");
-				int cnt = 0;
-				if (!in)
+				if (!scene_mesh_loader)
 				{
-					std::cout << "can't open file configuration.txt!" << std::endl;
-					return 0;
+					std::ifstream in("./configuration.txt");
+					if (!in)
+					{
+						std::cout << "can't open file configuration.txt!" << std::endl;
+						return 0;
+					}
+					std::getline(in, scene_mesh_files[SCENE_MESH_LINK]);
+					std::getline(in, scene_mesh_files[SCENE_MESH_BALL]);
 				}
 
-				char str[255];
-				int line_index = 0;
-				while (in)
+				if (!load_scene_mesh(SCENE_MESH_LINK))
+					return 0;
+				snake_link_V = data().V;
+				snake_link_F = data().F;
+
+				int cnt = 1;
+				for (int p = 0; p < x; p++, cnt++)
 				{
-					in.getline(str, 255);
-					if (in)
-					{
-						int n = 0;
-						if (line_index == 0)
-						{
-							n = arm_length;
-						}
-						else
-						{
-							n = x;
-						}
-						for (int p = 0; p < n; p++)
-						{
-							/*if (line_index == 0 && p == arm_length - 1)
-							{
-								load_mesh_from_file("C:/Dev/EngineIGLnew/tutorial/data/trex.obj");
-							}
-							else */if (!this->load_mesh_from_file(str))
-							{
-								//std::cout << ("Error loading mesh at %s .", str) << std::endl;
-								return 0;
-							}
-							if(line_index == 1)
-								data().Move(Eigen::Vector4f(2 * pow(-1.5f, p), 3 * pow(-1.5f, p), 0, 1));
-							cnt++;
-						}
-						line_index++;
-					}
+					if (!load_scene_mesh(SCENE_MESH_BALL))
+						return cnt;
+					data().Move(Eigen::Vector4f(2 * pow(-1.5f, p), 3 * pow(-1.5f, p), 0, 1));
 				}
-				
 				return cnt;
 			}
 
@@ -1119,13 +1415,13 @@ namespace igl
 
 				for (unsigned int i = 0; i < movement_data.size(); ++i)
 				{
-					if (data_list[arm_length + i].getTrans().translation().z() > 0.50f)
+					if (data_list[FIRST_BALL + i].getTrans().translation().z() > 0.50f)
 						movement_data[i].velocity += gravityThisFrame;
 					else if (fabs(movement_data[i].velocity.z()) < 0.001f)
 						movement_data[i].velocity.z() = 0.0f;
 						
 
-					if (data_list[i + arm_length].getTrans().translation().z() <= 0.4f)
+					if (data_list[FIRST_BALL + i].getTrans().translation().z() <= 0.4f)
 						handle_ground_collision(i);
 				}
 				
@@ -1139,7 +1435,7 @@ namespace igl
 
 			void Viewer::handle_ground_collision(int index)
 			{
-				data_list[index + arm_length].getTrans().translation().z() = 0.4f;
+				data_list[FIRST_BALL + index].getTrans().translation().z() = 0.4f;
 				movement_data[index].velocity.z() *= -movement_data[index].elasticity;
 			}
 
@@ -22,11 +22,14 @@
 #include <Eigen/Geometry>
 
 #include <vector>
+#include <deque>
+#include <functional>
 #include <string>
 #include <cstdint>
 #include <igl/shortest_edge_and_midpoint.h>
 #include <igl/edge_flaps.h>
 #include <igl/AABB.h>
+#include <igl/PointIndex.h>
 
 #define IGL_MOD_SHIFT           0x0001
 #define IGL_MOD_CONTROL         0x0002
@@ -59,26 +62,113 @@ namespace igl
 					Eigen::Vector3f position, axisX, axisY, axisZ, halfSizes;
 				};
 
+				// Level-complete flow. level_handler() is called every frame and never
+				// blocks: menu choices are taken from menu_input, which is fed by the
+				// key callback (or by a script through push_menu_input). Outside
+				// LEVEL_PLAYING the game is paused: the renderer only calls
+				// level_handler() and skips IK, movement and collisions.
+				enum LevelState
+				{
+					LEVEL_PLAYING = 0,
+					LEVEL_MENU = 1,
+					LEVEL_SHOP = 2
+				};
 				void level_handler();
+				void push_menu_input(int option);
+				void print_level_menu();
+				void print_shop_menu();
+				void handle_level_menu_option(int option);
+				void handle_shop_option(int option);
 				void load_next_level();
 				void collision_handler();
 				void save_snake();
 				void load_snake();
+
+				// Scene layout: data_list holds the snake skin, then the balls, then
+				// the ENVIRONMENT_SIZE environment meshes in this order
+				enum
+				{
+					SNAKE_SKIN = 0,
+					FIRST_BALL = 1
+				};
+				enum EnvironmentMesh
+				{
+					ENVIRONMENT_GROUND = 0,
+					ENVIRONMENT_WALL_NORTH,
+					ENVIRONMENT_PYRAMID,
+					ENVIRONMENT_ARROW_RIGHT,
+					ENVIRONMENT_ARROW_LEFT,
+					ENVIRONMENT_WALL_SOUTH,
+					ENVIRONMENT_WALL_EAST,
+					ENVIRONMENT_WALL_WEST,
+					ENVIRONMENT_SIZE
+				};
+				int environment_index(EnvironmentMesh mesh) const;
+				int num_balls() const;
+
+				// Meshes the levels are built from
+				enum SceneMesh
+				{
+					SCENE_MESH_LINK = 0,
+					SCENE_MESH_BALL,
+					SCENE_MESH_GROUND,
+					SCENE_MESH_WALL,
+					SCENE_MESH_WALL_SIDES,
+					SCENE_MESH_PYRAMID,
+					SCENE_MESH_ARROW_RIGHT,
+					SCENE_MESH_ARROW_LEFT,
+					SCENE_MESH_COUNT
+				};
+				// Append a mesh of the scene to data_list and select it, through
+				// scene_mesh_loader if set, else by loading scene_mesh_files[mesh]
+				bool load_scene_mesh(SceneMesh mesh);
 				void load_environment();
 				void load_balls(int n);
+				// Show (fill) or hide (empty) debug_overlay, called before
+				// bounding_boxes_visible is toggled
 				void draw_bounding_boxes();
+				// Refill debug_overlay with the boxes of the visible meshes at their
+				// current transformations: the bounds of each mesh and its kd_trees
+				// nodes down to bounding_boxes_depth levels below the root
+				void update_debug_overlay();
 				bool get_separating_axis(Eigen::Vector3f& RPos, Eigen::Vector3f& Plane, OBB& box1, OBB& box2);
 				bool get_collision(OBB& box1, OBB& box2);
+				// Box test of aabb_0 under transformation T0 and scale s0 against
+				// aabb_1 under T1 and s1, down to the leaves of either tree
+				bool check_for_collision(const AABB<Eigen::MatrixXd, 3>& aabb_0, const AABB<Eigen::MatrixXd, 3>& aabb_1,
+					const Eigen::Affine3f& T0, double s0, const Eigen::Affine3f& T1, double s1);
+				// Same for data_list[i] against data_list[j]
 				bool check_for_collision(AABB<Eigen::MatrixXd, 3>& aabb_0, AABB<Eigen::MatrixXd, 3>& aabb_1, int i, int j);
+				// Same for snake bone i (snake_link_tree) against data_list[j]
+				bool check_bone_collision(int i, int j);
+				// Sphere around the box check_for_collision tests for data_list[i],
+				// or for snake bone i
+				void collision_sphere(int i, Eigen::Vector3d& center, double& radius);
+				void bone_collision_sphere(int i, Eigen::Vector3d& center, double& radius);
+				// Trees of data_list (none for the snake skin) and snake_link_tree
 				void build_kd_trees();
 
+				// Snake: arm_length bones (snake_bones) driven by IK, and one tube
+				// mesh in data_list[SNAKE_SKIN] deformed every frame by dual
+				// quaternion skinning from them. init_snake_skin binds the tube to
+				// the current bones, and has to be called again when bones are
+				// added or reordered.
+				void append_snake_bone();
+				void init_snake_skin();
+				void update_snake_skin();
+
 				void gravity_handler(double delta);
 				void snake_gravity_handler(double delta);
 				void handle_ground_collision(int index);
 				void update_pos(double deltaTime);
 				void sys_restart();
 				int sys_init(int n);
+				// Lay the arm_length bones out end to end along y
 				int load_meshs_ik();
+				// Load the link and n balls of the first level, whose files are the
+				// first two lines of configuration.txt unless scene_mesh_loader
+				// provides them. The link only gives the shape of the bones (see
+				// snake_link_V), its slot becomes the snake skin.
 				int load_meshs(int n);
 				IGL_INLINE bool init_ds();
 				IGL_INLINE bool collapse_edges(int num);
@@ -106,6 +196,15 @@ namespace igl
 					double& cost,
 					Eigen::RowVectorXd& p);
 				IGL_INLINE bool load_mesh_from_file(const std::string& mesh_file_name);
+				// Same as load_mesh_from_file for a mesh already in memory: fill the
+				// selected slot if it is empty (else a new one) with the mesh, its
+				// UVs, normals and default colors
+				IGL_INLINE void load_mesh(Eigen::MatrixXd&& V, Eigen::MatrixXi&& F);
+				IGL_INLINE void load_mesh(
+					Eigen::MatrixXd&& V,
+					Eigen::MatrixXi&& F,
+					const Eigen::MatrixXd& UV_V,
+					const Eigen::MatrixXi& UV_F);
 				IGL_INLINE bool save_mesh_to_file(const std::string& mesh_file_name);
 
 				// Scene IO
@@ -194,7 +293,22 @@ namespace igl
 				bool snake_inverted = false;
 				Eigen::Vector4f inverted_dist;
 
-				std::vector< ViewerData> saved_snake_data;
+				// Bone i spans link i of the IK chain, placed by its transformation
+				std::vector<Movable, Eigen::aligned_allocator<Movable>> snake_bones;
+				std::vector<Movable, Eigen::aligned_allocator<Movable>> saved_snake_bones;
+				// Bone picked on the skin, where RotateArmLinks starts
+				int selected_bone = 0;
+				// Link mesh in bone coordinates, shared by all the bones
+				Eigen::MatrixXd snake_link_V;
+				Eigen::MatrixXi snake_link_F;
+				AABB<Eigen::MatrixXd, 3> snake_link_tree;
+
+				Eigen::MatrixXd snake_skin_rest;
+				// Two bone indices/weights per vertex (see igl/sparse_skinning_weights.h)
+				Eigen::MatrixXi snake_skin_bones;
+				Eigen::MatrixXd snake_skin_weights;
+				// Rest transform of every bone (link)
+				std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>> snake_bone_rest;
 
 				int score = 0;
 				int lives = 1;
@@ -208,9 +322,28 @@ namespace igl
 				bool loaded_new_level = false;
 				int snake_length_upgrade = 0;
 				int snake_speed_upgrade = 0;
+				LevelState level_state = LEVEL_PLAYING;
+				std::deque<int> menu_input;
 
-				ViewerCore* left_view;
-				ViewerCore* right_view;
+				ViewerCore* left_view = nullptr;
+				ViewerCore* right_view = nullptr;
+
+				// Asset files of the scene meshes (see load_scene_mesh). The link and
+				// ball are read from configuration.txt by load_meshs.
+				std::string scene_mesh_files[SCENE_MESH_COUNT] =
+				{
+					"",
+					"C:/Dev/EngineIGLnew/tutorial/data/sphere.obj",
+					"C:/Dev/EngineIGLnew/tutorial/data/grass.obj",
+					"C:/Dev/EngineIGLnew/tutorial/data/Wall.obj",
+					"C:/Dev/EngineIGLnew/tutorial/data/WallSides.obj",
+					"C:/Dev/EngineIGLnew/tutorial/data/Pyramid.obj",
+					"C:/Dev/EngineIGLnew/tutorial/data/ArrowRight.obj",
+					"C:/Dev/EngineIGLnew/tutorial/data/ArrowLeft.obj"
+				};
+				// Replaces the asset files, e.g. to build the scene from generated
+				// meshes without any file (see tutorial/headless)
+				std::function<bool(SceneMesh)> scene_mesh_loader;
 
 				unsigned int left_arrow;
 				unsigned int right_arrow;
@@ -280,7 +413,15 @@ namespace igl
 				int in;
 				bool collision_0_1;
 				std::vector<AABB<Eigen::MatrixXd, 3>> kd_trees;
+				// Collision sphere centers of the balls, for the broad phase
+				igl::PointIndex ball_index;
 				bool bounding_boxes_visible = false;
+				// Levels of kd_trees nodes drawn below each mesh's bounding box
+				int bounding_boxes_depth = 0;
+				// Line and point overlay without a mesh, in scene coordinates, drawn
+				// after the meshes while bounding_boxes_visible. Refilling it only
+				// uploads its overlay buffers, the meshes are left alone.
+				ViewerData debug_overlay;
 
 
 
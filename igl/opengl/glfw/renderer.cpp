@@ -2,6 +2,7 @@
 
 #include <GLFW/glfw3.h>
 #include <igl/unproject_onto_mesh.h>
+#include <igl/Profiler.h>
 #include "igl/look_at.h"
 #include <Eigen/Dense>
 #include <time.h>
@@ -47,6 +48,8 @@ IGL_INLINE void Renderer::draw( GLFWwindow* window)
 	
 	std::chrono::high_resolution_clock timer;
 	auto start = timer.now();
+	igl::profiler().begin_frame();
+	BeginFrame();
 
 	int width, height;
 	glfwGetFramebufferSize(window, &width, &height);
@@ -66,47 +69,58 @@ IGL_INLINE void Renderer::draw( GLFWwindow* window)
 		core.clear_framebuffers();
 	}
 
+	Eigen::Matrix4f world = scn->MakeTrans();
+	// Boxes follow the meshes, only the overlay buffers are refilled
+	if (scn->bounding_boxes_visible)
+	{
+		scn->update_debug_overlay();
+	}
 	for (auto& core : core_list)
 	{
-		for (auto& mesh : scn->data_list)
+		igl::Profiler::Scope scope("draw core");
+		if (!core.id)
+			continue;
+		// Camera matrices and viewport state once per core
+		core.begin_draw(world);
+		// Visibility pass: keep the meshes whose bounds reach into this core's
+		// frustum. camera_view already contains world, so the bounds are moved
+		// by the mesh transformation only, as in ViewerCore::draw. Overlays are
+		// not part of the bounds, meshes showing them are always kept.
+		draw_list.clear();
+		const auto cull = [&](igl::opengl::ViewerData& mesh)
 		{
-			if (mesh.is_visible && core.id)
+			if (!mesh.is_visible)
+				return;
+			const bool has_overlay = core.is_set(mesh.show_overlay) &&
+				(mesh.lines.rows() > 0 || mesh.points.rows() > 0);
+			if (has_overlay || core.in_frustum(mesh.MakeTrans(), mesh.mesh_bounds()))
 			{
-				core.draw(scn->MakeTrans(), mesh);
+				draw_list.push_back(&mesh);
 			}
+		};
+		for (auto& mesh : scn->data_list)
+		{
+			cull(mesh);
 		}
-	}
-
-	if (scn->found_obj && !isArm())
-	{
-		scn->run_ik = true;
-	}
-	else
-		scn->run_ik = false;
-
-	if (scn->run_ik)
-	{
-		IK();
-	}
-
-	if (deltaTime > 0)
-	{
-
-		scn->update_pos(deltaTime);
-		scn->gravity_handler(deltaTime);
-		scn->collision_handler();
-		scn->level_handler();
-		
-
-		double min_z = INT_MAX;
-		for (int i = 0; i < scn->arm_length; i++)
+		// Group meshes sharing a shader and vertex array
+		std::stable_sort(draw_list.begin(), draw_list.end(),
+			[](const igl::opengl::ViewerData* a, const igl::opengl::ViewerData* b)
+		{
+			return a->meshgl.shader_mesh != b->meshgl.shader_mesh ?
+				a->meshgl.shader_mesh < b->meshgl.shader_mesh :
+				a->meshgl.vao_mesh < b->meshgl.vao_mesh;
+		});
+		for (auto mesh : draw_list)
 		{
-			if (scn->data_list[i].getTrans().translation().z() < min_z)
-				min_z = scn->data_list[i].getTrans().translation().z();
+			core.draw(world, *mesh, false);
+		}
+		if (scn->bounding_boxes_visible && scn->debug_overlay.is_visible)
+		{
+			core.draw(world, scn->debug_overlay, false);
 		}
-
-		LiftSnake(min_z - 0.4f);
 	}
+
+	UpdateScene();
 	/*if (inverted == 1)
 	{
 		//core_list[1].align_camera_center(scn->data_list[scn->arm_length - 1].V, scn->data_list[scn->arm_length - 1].F);
@@ -146,20 +160,13 @@ IGL_INLINE void Renderer::draw( GLFWwindow* window)
 	auto stop = timer.now();
 	using ms = std::chrono::duration<float, std::milli>;
 	deltaTime = std::chrono::duration_cast<ms>(stop - start).count();
+	igl::profiler().end_frame();
 
-	if (scn->loaded_new_level)
-	{
-		deltaTime = 0;
-		scn->loaded_new_level = false;
-		GetScene()->getTrans().matrix() << 0.025f, 0, 0, 0,
-			0, 0.025f, 0, 0,
-			0, 0, 0.025f, 0,
-			0, 0, 0, 1;
-	}
+	EndFrame();
 	if (deltaTime > 10.0f)
 	{
 		char buff[100];
-		snprintf(buff, sizeof(buff), "%.3d FPS									                              Score: %d", ((int)((1.0f / deltaTime) * 1000.0f)), scn->score);
+		snprintf(buff, sizeof(buff), "%.3d FPS   p99 %.1f ms									                              Score: %d", ((int)((1.0f / deltaTime) * 1000.0f)), 1000.0 * igl::profiler().frame_percentile(99), scn->score);
 		string buffAsStdStr(buff);
 		glfwSetWindowTitle(window, buffAsStdStr.c_str());
 
@@ -167,6 +174,101 @@ IGL_INLINE void Renderer::draw( GLFWwindow* window)
 	//std::cout << deltaTime << std::endl;
 }
 
+void Renderer::UpdateScene()
+{
+	// The level menu and shop pause the game: only the queued menu input is
+	// handled until a level is loaded again
+	if (scn->level_state != igl::opengl::glfw::Viewer::LEVEL_PLAYING)
+	{
+		scn->level_handler();
+		return;
+	}
+
+	if (scn->found_obj && !isArm())
+	{
+		scn->run_ik = true;
+	}
+	else
+		scn->run_ik = false;
+
+	if (scn->run_ik)
+	{
+		igl::Profiler::Scope scope("IK");
+		IK();
+	}
+
+	if (deltaTime > 0)
+	{
+		{
+			igl::Profiler::Scope scope("update_pos");
+			scn->update_pos(deltaTime);
+		}
+		{
+			igl::Profiler::Scope scope("gravity");
+			scn->gravity_handler(deltaTime);
+		}
+		{
+			igl::Profiler::Scope scope("collision");
+			scn->collision_handler();
+		}
+		{
+			igl::Profiler::Scope scope("level");
+			scn->level_handler();
+		}
+
+		igl::Profiler::Scope scope("LiftSnake");
+		double min_z = INT_MAX;
+		for (int i = 0; i < scn->arm_length; i++)
+		{
+			if (scn->snake_bones[i].getTrans().translation().z() < min_z)
+				min_z = scn->snake_bones[i].getTrans().translation().z();
+		}
+
+		LiftSnake(min_z - 0.4f);
+	}
+
+	igl::Profiler::Scope scope("snake skin");
+	scn->update_snake_skin();
+}
+
+void Renderer::BeginFrame()
+{
+	std::vector<InputRecorder::Event> events;
+	recorder.next_frame(deltaTime, events);
+	if (callback_replay_input)
+	{
+		for (const auto& e : events)
+			callback_replay_input(e);
+	}
+}
+
+void Renderer::EndFrame()
+{
+	if (!scn->loaded_new_level)
+		return;
+	// A new level starts from the default view and doesn't count the time
+	// spent loading it
+	deltaTime = 0;
+	scn->loaded_new_level = false;
+	GetScene()->getTrans().matrix() << 0.025f, 0, 0, 0,
+		0, 0.025f, 0, 0,
+		0, 0, 0.025f, 0,
+		0, 0, 0, 1;
+	recorder.record(InputRecorder::Event(InputRecorder::LEVEL, scn->cur_level, scn->score, 0,
+		GetScene()->getTrans().matrix()(0, 0)));
+}
+
+void Renderer::UpdateCameras()
+{
+	const Eigen::Matrix4f world = scn->MakeTrans();
+	for (auto& core : core_list)
+	{
+		// Cores without a viewport yet have no projection
+		if (core.viewport(2) > 0 && core.viewport(3) > 0)
+			core.update_camera(world);
+	}
+}
+
 void Renderer::SetScene(igl::opengl::glfw::Viewer* viewer)
 {
 	scn = viewer;
@@ -307,18 +409,18 @@ void Renderer::IKRotations(int root_index, float alpha, Eigen::Vector3f rot_vec)
 
 	for (int i = root_index; i < scn->arm_length; i++) {
 
-		scn->data_list[i].getTrans() = parent_axis_translation * scn->data_list[i].getTrans().matrix();
+		scn->snake_bones[i].getTrans() = parent_axis_translation * scn->snake_bones[i].getTrans().matrix();
 
-		scn->data_list[i].getTrans() = rot.getTrans().matrix() * scn->data_list[i].getTrans().matrix();
-		scn->data_list[i].getTrans() = parent_axis_translation_inv * scn->data_list[i].getTrans().matrix();
-		/*if (scn->data_list[i].getTrans().translation().z() < 0)
+		scn->snake_bones[i].getTrans() = rot.getTrans().matrix() * scn->snake_bones[i].getTrans().matrix();
+		scn->snake_bones[i].getTrans() = parent_axis_translation_inv * scn->snake_bones[i].getTrans().matrix();
+		/*if (scn->snake_bones[i].getTrans().translation().z() < 0)
 		{			
-			if (scn->data_list[i].getTrans().translation().z() < 0)
+			if (scn->snake_bones[i].getTrans().translation().z() < 0)
 			{
 				scn->need_to_lift_snake = true;
 			}
 		}*/
-		on_ground = on_ground || (scn->data_list[i].getTrans().translation().z() <= 0.3f);
+		on_ground = on_ground || (scn->snake_bones[i].getTrans().translation().z() <= 0.3f);
 	}
 	if(!on_ground)
 		scn->need_to_lift_snake = true;
@@ -437,10 +539,10 @@ void Renderer::InvertSnake()
 		scn->parent_axis_rotation[i] = scn->parent_axis_rotation[scn->arm_length - 2 - i];
 		scn->parent_axis_rotation[scn->arm_length - 2 - i] = tmp_rot;
 
-		igl::opengl::ViewerData tmp_data = scn->data_list[i];
-		scn->data_list[i] = scn->data_list[scn->arm_length - 1 - i];
-		scn->data_list[scn->arm_length - 1 - i] = tmp_data;
+		std::swap(scn->snake_bones[i], scn->snake_bones[scn->arm_length - 1 - i]);
 	}
+	// The skin is bound to the bones in chain order
+	scn->init_snake_skin();
 	inverted *= -1;
 }
 
@@ -465,7 +567,9 @@ void Renderer::PrintArmsTips()
 
 void Renderer::PrintDestination()
 {
-	Eigen::Vector3f pos = scn->data_list[scn->arm_length].getTrans().translation();
+	if (scn->num_balls() == 0)
+		return;
+	Eigen::Vector3f pos = scn->data_list[igl::opengl::glfw::Viewer::FIRST_BALL].getTrans().translation();
 	printf("Destination Position is: (%f, %f, %f).\n", pos.x(), pos.y(), pos.z());
 }
 
@@ -508,8 +612,8 @@ void Renderer::RotateArmLinkByKey(int key)
 	{
 		if (isArm())
 		{
-			RotateArmLinks(scn->selected_data_index);
-			UpdateParentsTranslations(scn->selected_data_index);
+			RotateArmLinks(scn->selected_bone);
+			UpdateParentsTranslations(scn->selected_bone);
 		}	
 		else
 		{
@@ -552,7 +656,7 @@ void Renderer::RotateArmLinks(int root_index)
 
 	for (int i = root_index; i < scn->arm_length; i++) {
 
-		scn->data_list[i].getTrans() = parent_axis_translation * scn->data_list[i].getTrans().matrix();
+		scn->snake_bones[i].getTrans() = parent_axis_translation * scn->snake_bones[i].getTrans().matrix();
 		Eigen::Matrix4f x_rot = Eigen::Matrix4f();
 		Eigen::Matrix4f y_rot = Eigen::Matrix4f();
 		double theta_x = xrel / 180.0f;
@@ -573,7 +677,7 @@ void Renderer::RotateArmLinks(int root_index)
 		y_rot = parent_axis_rotation_prev * y_rot * parent_axis_rotation_prev.inverse();
 		x_rot = parent_axis_rotation_cur * x_rot * parent_axis_rotation_cur.inverse();
 
-		scn->data_list[i].getTrans() = parent_axis_translation_inv * x_rot * y_rot * scn->data_list[i].getTrans().matrix();
+		scn->snake_bones[i].getTrans() = parent_axis_translation_inv * x_rot * y_rot * scn->snake_bones[i].getTrans().matrix();
 	}
 }
 
@@ -609,7 +713,7 @@ void Renderer::UpdateParentsTranslations(int root_index)
 		0, 0, 0, 1;
 	parent_axis_rotation_cur = scn->parent_axis_rotation[root_index];
 
-	for (int i = root_index; i <=  scn->arm_length; i++) {
+	for (int i = root_index; i < scn->arm_length; i++) {
 		scn->parent_axis_coordinates[i] = parent_axis_translation * scn->parent_axis_coordinates[i];
 		Eigen::Matrix4f x_rot = Eigen::Matrix4f();
 		Eigen::Matrix4f y_rot = Eigen::Matrix4f();
@@ -643,7 +747,7 @@ void Renderer::TranslateLinks(int root_index)
 	Eigen::Vector4f translation_4(translation_3.x(), translation_3.y(), translation_3.z(), 0);
 	for (int i = root_index; i < scn->arm_length; i++)
 	{
-		scn->data_list[i].MyTranslate(translation_3, CAMERA_AXIS);
+		scn->snake_bones[i].MyTranslate(translation_3, CAMERA_AXIS);
 		scn->parent_axis_coordinates[i] = scn->parent_axis_coordinates[i] + translation_4;
 	}
 	scn->arm_root = scn->arm_root + translation_4;
@@ -656,7 +760,7 @@ void Renderer::TranslateSnake(Eigen::Vector3f& delta)
 	Eigen::Vector4f translation_4(translation_3.x(), translation_3.y(), translation_3.z(), 0);
 	for (int i = 0; i < scn->arm_length; i++)
 	{
-		scn->data_list[i].MyTranslate(translation_3, CAMERA_AXIS);
+		scn->snake_bones[i].MyTranslate(translation_3, CAMERA_AXIS);
 		scn->parent_axis_coordinates[i] = scn->parent_axis_coordinates[i] + translation_4;
 	}
 	scn->arm_root = scn->arm_root + translation_4;
@@ -669,7 +773,7 @@ void Renderer::LiftSnake(double delta)
 	Eigen::Vector4f translation_4(translation_3.x(), translation_3.y(), translation_3.z(), 0);
 	for (int i = 0; i < scn->arm_length; i++)
 	{
-		scn->data_list[i].MyTranslate(translation_3, CAMERA_AXIS);
+		scn->snake_bones[i].MyTranslate(translation_3, CAMERA_AXIS);
 		scn->parent_axis_coordinates[i] = scn->parent_axis_coordinates[i] + translation_4;
 	}
 	scn->arm_root = scn->arm_root + translation_4;
@@ -682,7 +786,7 @@ void Renderer::TranslateArm()
 	Eigen::Vector4f translation_4(translation_3.x(), translation_3.y(), translation_3.z(), 0);
 	for (int i = 0; i < scn->arm_length; i++)
 	{		
-		scn->data_list[i].MyTranslate(translation_3, CAMERA_AXIS);
+		scn->snake_bones[i].MyTranslate(translation_3, CAMERA_AXIS);
 		scn->parent_axis_coordinates[i] = scn->parent_axis_coordinates[i] + translation_4;
 	}
 	scn->arm_root = scn->arm_root + translation_4;
@@ -702,7 +806,7 @@ void Renderer::ScaleArm(double scale)
 
 	for (int i = 0; i < scn->arm_length; i++) {
 
-		scn->data_list[i].getTrans() = parent_axis_translation * scn->data_list[i].getTrans().matrix();
+		scn->snake_bones[i].getTrans() = parent_axis_translation * scn->snake_bones[i].getTrans().matrix();
 		Eigen::Matrix4f scale_mat = Eigen::Matrix4f();
 
 		scale_mat <<
@@ -711,7 +815,7 @@ void Renderer::ScaleArm(double scale)
 			0, 0, scale, 0,
 			0, 0, 0, 1;
 
-		scn->data_list[i].getTrans() = parent_axis_translation_inv * scale_mat * scn->data_list[i].getTrans().matrix();
+		scn->snake_bones[i].getTrans() = parent_axis_translation_inv * scale_mat * scn->snake_bones[i].getTrans().matrix();
 		scn->parent_axis_coordinates[i] = parent_axis_translation_inv * scale_mat * parent_axis_translation * scn->parent_axis_coordinates[i];
 	}
 	scn->arm_scale *= scale;
@@ -736,7 +840,7 @@ void Renderer::MouseProcessing(int button)
 	{
 		if (isArm())
 		{
-			int root_index = scn->selected_data_index;
+			int root_index = scn->selected_bone;
 			RotateArmLinks(root_index);
 			UpdateParentsTranslations(root_index);
 		}
@@ -761,7 +865,7 @@ void Renderer::MouseProcessing(int button)
 bool Renderer::isArm()
 {
 	return
-		scn->selected_data_index < scn->arm_length ? true : false;
+		scn->selected_data_index == igl::opengl::glfw::Viewer::SNAKE_SKIN ? true : false;
 }
 
 Renderer::~Renderer()
@@ -770,7 +874,7 @@ Renderer::~Renderer()
 	//	delete scn;
 }
 
-float Renderer::Picking(double newx, double newy)
+float Renderer::Picking(double newx, double newy, int* picked_fid)
 {
 		int fid;
 		//Eigen::MatrixXd C = Eigen::MatrixXd::Constant(scn->data().F.rows(), 3, 1);
@@ -791,8 +895,12 @@ float Renderer::Picking(double newx, double newy)
 			Eigen::Vector4f pos_vec = Eigen::Vector4f::Zero() + Eigen::Map<Eigen::Vector4f>(tmp_array);
 			pos_vec = view * pos_vec;
 
+			if (picked_fid)
+				*picked_fid = fid;
 			return  (pos_vec.z());
 		}
+		if (picked_fid)
+			*picked_fid = -1;
 		return INT_MIN;
 }
 
@@ -806,6 +914,8 @@ IGL_INLINE void Renderer::resize(GLFWwindow* window,int w, int h)
 
 	IGL_INLINE void Renderer::post_resize(GLFWwindow* window, int w, int h)
 	{
+		// Viewports affect picking, so replays need them too
+		recorder.record(InputRecorder::Event(InputRecorder::RESIZE, w, h));
 		if (core_list.size() == 1)
 		{
 			core().viewport = Eigen::Vector4f(0, 0, w, h);
@@ -5,6 +5,7 @@
 #include <igl/opengl/ViewerCore.h>
 #include <igl/opengl/glfw/Viewer.h>
 #include "./../ViewerData.h"
+#include "igl/opengl/glfw/InputRecorder.h"
 
 
 #include <time.h>
@@ -57,6 +58,8 @@ public:
 	// THESE SHOULD BE DEPRECATED:
 	std::function<bool(GLFWwindow* window, unsigned int key, int modifiers)> callback_key_down;
 	std::function<bool(GLFWwindow* window, unsigned int key, int modifiers)> callback_key_up;
+	// Applies a recorded input event while replaying (see InputRecorder)
+	std::function<void(const InputRecorder::Event& e)> callback_replay_input;
 	// Pointers to per-callback data
 	void* callback_init_data;
 	void* callback_pre_draw_data;
@@ -108,7 +111,9 @@ public:
 	 IGL_INLINE void select_hovered_core();
 
 	// Callbacks
-	 float Picking(double x, double y);
+	 // Depth of the selected mesh under (x, y), INT_MIN if missed. fid, if
+	 // given, gets the face hit (-1 if missed).
+	 float Picking(double x, double y, int* fid = nullptr);
 	IGL_INLINE bool key_pressed(unsigned int unicode_key, int modifier);
 	IGL_INLINE void resize(GLFWwindow* window,int w, int h); // explicitly set window size
 	IGL_INLINE void post_resize(GLFWwindow* window, int w, int h); // external resize due to user interaction
@@ -142,6 +147,20 @@ public:
 	void ScaleArm(double scale);
 	void UpdateParentsTranslations(int beginIndex);
 	bool isArm();
+	// Records the frame time step or, while replaying, applies the recorded
+	// time step and input events. Called at the start of every frame.
+	void BeginFrame();
+	// Computes the camera matrices of every core for its current viewport, as
+	// drawing does. Picking un-projects through them, so input is applied
+	// after this both with and without a window.
+	void UpdateCameras();
+	// Advances the game by one frame (IK, ball motion, collisions, level
+	// logic) without drawing
+	void UpdateScene();
+	// Applies a level loaded during the frame: resets the scene transform
+	// and the time step, and records the new level so that a replay can
+	// check it. Called at the end of every frame.
+	void EndFrame();
 	Eigen::Vector4f GetRootCoords();
 
 	enum Axis
@@ -155,6 +174,8 @@ public:
 	
 	double time_acc = 0;
 
+	InputRecorder recorder;
+
 	std::vector<igl::opengl::ViewerCore> core_list;
 	size_t selected_core_index;
 private:
@@ -164,6 +185,8 @@ private:
 	
 	int next_core_id;
 	float highdpi;
+	// Meshes drawn in the current core, after culling, reused across frames
+	std::vector<igl::opengl::ViewerData*> draw_list;
 	double xold, yold, xrel, yrel;
 
 };
@@ -12,6 +12,9 @@
 #include "doublearea.h"
 #include "parallel_for.h"
 #include "internal_angles.h"
+#include "vertex_triangle_adjacency.h"
+#include <algorithm>
+#include <vector>
 
 template <
   typename DerivedV,
@@ -44,12 +47,35 @@ IGL_INLINE void igl::per_vertex_normals(
   const igl::PerVertexNormalsWeightingType weighting,
   const Eigen::MatrixBase<DerivedFN>& FN,
   Eigen::PlainObjectBase<DerivedN> & N)
+{
+  Eigen::VectorXi VF,NI;
+  vertex_triangle_adjacency(F,V.rows(),VF,NI);
+  return per_vertex_normals(V,F,weighting,FN,VF,NI,N);
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedFN,
+  typename DerivedVF,
+  typename DerivedNI,
+  typename DerivedN>
+IGL_INLINE void igl::per_vertex_normals(
+  const Eigen::MatrixBase<DerivedV>& V,
+  const Eigen::MatrixBase<DerivedF>& F,
+  const igl::PerVertexNormalsWeightingType weighting,
+  const Eigen::MatrixBase<DerivedFN>& FN,
+  const Eigen::MatrixBase<DerivedVF>& VF,
+  const Eigen::MatrixBase<DerivedNI>& NI,
+  Eigen::PlainObjectBase<DerivedN> & N)
 {
   using namespace std;
+  typedef typename DerivedN::Scalar Scalar;
+  assert(NI.size() == V.rows()+1 && "NI should be #V+1 long");
   // Resize for output
-  N.setZero(V.rows(),3);
+  N.resize(V.rows(),3);
 
-  Eigen::Matrix<typename DerivedN::Scalar,DerivedF::RowsAtCompileTime,3>
+  Eigen::Matrix<Scalar,DerivedF::RowsAtCompileTime,3>
     W(F.rows(),3);
   switch(weighting)
   {
@@ -61,7 +87,7 @@ IGL_INLINE void igl::per_vertex_normals(
     case PER_VERTEX_NORMALS_WEIGHTING_TYPE_DEFAULT:
     case PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA:
     {
-      Eigen::Matrix<typename DerivedN::Scalar,DerivedF::RowsAtCompileTime,1> A;
+      Eigen::Matrix<Scalar,DerivedF::RowsAtCompileTime,1> A;
       doublearea(V,F,A);
       W = A.replicate(1,3);
       break;
@@ -71,37 +97,161 @@ IGL_INLINE void igl::per_vertex_normals(
       break;
   }
 
-  // loop over faces
-  for(int i = 0;i<F.rows();i++)
+  // Gather rather than scatter: every vertex only reads its incident faces
+  // and only writes its own row, so there is nothing to synchronize.
+  parallel_for(
+    V.rows(),
+    [&F,&W,&FN,&VF,&NI,&N](const int v)
+    {
+      Eigen::Matrix<Scalar,1,3> n(0,0,0);
+      for(int k = NI(v);k<NI(v+1);k++)
+      {
+        const int f = VF(k);
+        // Degenerate faces are listed once per occurrence of v, but the
+        // corner loop below already visits each occurrence
+        if(k>NI(v) && VF(k-1) == f)
+        {
+          continue;
+        }
+        for(int j = 0;j<3;j++)
+        {
+          if(F(f,j) == v)
+          {
+            n += W(f,j) * FN.row(f).template cast<Scalar>();
+          }
+        }
+      }
+      N.row(v) = n;
+    },
+    1000);
+
+  // take average via normalization
+  N.rowwise().normalize();
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedVF,
+  typename DerivedNI,
+  typename DerivedI,
+  typename DerivedFN,
+  typename DerivedN>
+IGL_INLINE void igl::per_vertex_normals(
+  const Eigen::MatrixBase<DerivedV>& V,
+  const Eigen::MatrixBase<DerivedF>& F,
+  const igl::PerVertexNormalsWeightingType weighting,
+  const Eigen::MatrixBase<DerivedVF>& VF,
+  const Eigen::MatrixBase<DerivedNI>& NI,
+  const Eigen::MatrixBase<DerivedI>& I,
+  Eigen::PlainObjectBase<DerivedFN> & FN,
+  Eigen::PlainObjectBase<DerivedN> & N)
+{
+  using namespace std;
+  typedef typename DerivedV::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  assert(NI.size() == V.rows()+1 && "NI should be #V+1 long");
+  assert(FN.rows() == F.rows() && "FN should be up to date away from I");
+  assert(N.rows() == V.rows() && "N should be up to date away from I");
+
+  // Faces incident on any moved vertex
+  vector<int> dirty_faces;
+  for(int i = 0;i<I.size();i++)
+  {
+    for(int k = NI(I(i));k<NI(I(i)+1);k++)
+    {
+      dirty_faces.push_back(VF(k));
+    }
+  }
+  sort(dirty_faces.begin(),dirty_faces.end());
+  dirty_faces.erase(
+    unique(dirty_faces.begin(),dirty_faces.end()),dirty_faces.end());
+
+  // Vertices whose one-ring contains a dirty face
+  vector<int> dirty_vertices;
+  dirty_vertices.reserve(3*dirty_faces.size());
+  for(const int f : dirty_faces)
   {
-    // throw normal at each corner
-    for(int j = 0; j < 3;j++)
+    for(int j = 0;j<3;j++)
     {
-      N.row(F(i,j)) += W(i,j) * FN.row(i);
+      dirty_vertices.push_back(F(f,j));
     }
   }
+  sort(dirty_vertices.begin(),dirty_vertices.end());
+  dirty_vertices.erase(
+    unique(dirty_vertices.begin(),dirty_vertices.end()),dirty_vertices.end());
 
-  //// loop over faces
-  //std::mutex critical;
-  //std::vector<DerivedN> NN;
-  //parallel_for(
-  //  F.rows(),
-  //  [&NN,&N](const size_t n){ NN.resize(n,DerivedN::Zero(N.rows(),3));},
-  //  [&F,&W,&FN,&NN,&critical](const int i, const size_t t)
-  //  {
-  //    // throw normal at each corner
-  //    for(int j = 0; j < 3;j++)
-  //    {
-  //      // Q: Does this need to be critical?
-  //      // A: Yes. Different (i,j)'s could produce the same F(i,j)
-  //      NN[t].row(F(i,j)) += W(i,j) * FN.row(i);
-  //    }
-  //  },
-  //  [&N,&NN](const size_t t){ N += NN[t]; },
-  //  1000l);
+  // Unnormalized face normal (length is twice the area)
+  const auto face_cross = [&V,&F](const int f)->RowVector3S
+  {
+    const RowVector3S v1 = V.row(F(f,1)) - V.row(F(f,0));
+    const RowVector3S v2 = V.row(F(f,2)) - V.row(F(f,0));
+    return v1.cross(v2);
+  };
 
-  // take average via normalization
-  N.rowwise().normalize();
+  parallel_for(
+    dirty_faces.size(),
+    [&dirty_faces,&face_cross,&FN](const size_t i)
+    {
+      const int f = dirty_faces[i];
+      const RowVector3S n = face_cross(f);
+      const Scalar r = n.norm();
+      if(r == 0)
+      {
+        FN.row(f).setZero();
+      }else
+      {
+        FN.row(f) = (n/r).template cast<typename DerivedFN::Scalar>();
+      }
+    },
+    1000);
+
+  // Weight of face f at its corner j (see the switch in the full overload)
+  const auto corner_weight =
+    [&V,&F,&weighting,&face_cross](const int f, const int j)->Scalar
+  {
+    switch(weighting)
+    {
+      case PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM:
+        return 1.;
+      default:
+      case PER_VERTEX_NORMALS_WEIGHTING_TYPE_DEFAULT:
+      case PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA:
+        return face_cross(f).norm();
+      case PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE:
+      {
+        const RowVector3S e1 = V.row(F(f,(j+1)%3)) - V.row(F(f,j));
+        const RowVector3S e2 = V.row(F(f,(j+2)%3)) - V.row(F(f,j));
+        return atan2(e1.cross(e2).norm(),e1.dot(e2));
+      }
+    }
+  };
+
+  parallel_for(
+    dirty_vertices.size(),
+    [&dirty_vertices,&F,&FN,&VF,&NI,&N,&corner_weight](const size_t i)
+    {
+      const int v = dirty_vertices[i];
+      Eigen::Matrix<typename DerivedN::Scalar,1,3> n(0,0,0);
+      for(int k = NI(v);k<NI(v+1);k++)
+      {
+        const int f = VF(k);
+        if(k>NI(v) && VF(k-1) == f)
+        {
+          continue;
+        }
+        for(int j = 0;j<3;j++)
+        {
+          if(F(f,j) == v)
+          {
+            n += corner_weight(f,j) *
+              FN.row(f).template cast<typename DerivedN::Scalar>();
+          }
+        }
+      }
+      N.row(v) = n.normalized();
+    },
+    1000);
 }
 
 template <
@@ -130,4 +280,6 @@ template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>,
 template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::PerVertexNormalsWeightingType, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&);
 template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::PerVertexNormalsWeightingType, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::PerVertexNormalsWeightingType, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::PerVertexNormalsWeightingType, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 #endif
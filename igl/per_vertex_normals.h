@@ -70,6 +70,65 @@ namespace igl
     const Eigen::MatrixBase<DerivedF>& F,
     const Eigen::MatrixBase<DerivedFN>& FN,
     Eigen::PlainObjectBase<DerivedN> & N);
+  // Inputs:
+  //   VF  3*#F list of incident faces per vertex (see
+  //     vertex_triangle_adjacency)
+  //   NI  #V+1 list of cumulative vertex-triangle degrees into VF
+  //
+  // Each vertex gathers from its own incident faces, so the loop over vertices
+  // is run in parallel without any shared accumulation. Callers that reuse a
+  // fixed connectivity should cache VF and NI across calls.
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedFN,
+    typename DerivedVF,
+    typename DerivedNI,
+    typename DerivedN>
+  IGL_INLINE void per_vertex_normals(
+    const Eigen::MatrixBase<DerivedV>& V,
+    const Eigen::MatrixBase<DerivedF>& F,
+    const PerVertexNormalsWeightingType weighting,
+    const Eigen::MatrixBase<DerivedFN>& FN,
+    const Eigen::MatrixBase<DerivedVF>& VF,
+    const Eigen::MatrixBase<DerivedNI>& NI,
+    Eigen::PlainObjectBase<DerivedN> & N);
+  // Incrementally update face and vertex normals after only a subset of the
+  // vertices has moved. The normals of every face incident on a moved vertex
+  // are recomputed, then every vertex of those faces re-gathers its normal.
+  // All other rows of FN and N are left untouched.
+  //
+  // Inputs:
+  //   V  #V by 3 eigen Matrix of (updated) mesh vertex 3D positions
+  //   F  #F by 3 eigne Matrix of face (triangle) indices
+  //   weighting  Weighting type
+  //   VF  3*#F list of incident faces per vertex (see
+  //     vertex_triangle_adjacency)
+  //   NI  #V+1 list of cumulative vertex-triangle degrees into VF
+  //   I  #I list of indices of vertices that moved since FN and N were
+  //     last computed
+  //   FN  #F by 3 matrix of face normals, valid away from I
+  //   N  #V by 3 matrix of vertex normals, valid away from I
+  // Outputs:
+  //   FN  #F by 3 matrix of face normals
+  //   N  #V by 3 matrix of vertex normals
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedVF,
+    typename DerivedNI,
+    typename DerivedI,
+    typename DerivedFN,
+    typename DerivedN>
+  IGL_INLINE void per_vertex_normals(
+    const Eigen::MatrixBase<DerivedV>& V,
+    const Eigen::MatrixBase<DerivedF>& F,
+    const PerVertexNormalsWeightingType weighting,
+    const Eigen::MatrixBase<DerivedVF>& VF,
+    const Eigen::MatrixBase<DerivedNI>& NI,
+    const Eigen::MatrixBase<DerivedI>& I,
+    Eigen::PlainObjectBase<DerivedFN> & FN,
+    Eigen::PlainObjectBase<DerivedN> & N);
 
 }
 
@@ -8,6 +8,7 @@
 #ifndef IGL_POINT_MESH_SQUARED_DISTANCE_H
 #define IGL_POINT_MESH_SQUARED_DISTANCE_H
 #include "igl_inline.h"
+#include "AABB.h"
 #include <Eigen/Core>
 #include <vector>
 
@@ -43,6 +44,35 @@ namespace igl
     Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
     Eigen::PlainObjectBase<DerivedI> & I,
     Eigen::PlainObjectBase<DerivedC> & C);
+  // Same as above, reusing a prebuilt hierarchy of (V,Ele) so that meshes
+  // queried many times are not reprocessed on every call. Queries run in
+  // parallel.
+  //
+  // Inputs:
+  //   P  #P by DIM list of query point positions
+  //   tree  AABB hierarchy of (V,Ele), see AABB::init
+  //   V  #V by DIM list of vertex positions
+  //   Ele  #Ele by (3|2|1) list of (triangle|edge|point) indices
+  // Outputs:
+  //   sqrD  #P list of smallest squared distances
+  //   I  #P list of primitive indices corresponding to smallest distances
+  //   C  #P by DIM list of closest points
+  template <
+    typename DerivedP,
+    typename DerivedV,
+    int DIM,
+    typename DerivedEle,
+    typename DerivedsqrD,
+    typename DerivedI,
+    typename DerivedC>
+  IGL_INLINE void point_mesh_squared_distance(
+    const Eigen::MatrixBase<DerivedP> & P,
+    const igl::AABB<DerivedV,DIM> & tree,
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedEle> & Ele,
+    Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
+    Eigen::PlainObjectBase<DerivedI> & I,
+    Eigen::PlainObjectBase<DerivedC> & C);
 }
 
 #ifndef IGL_STATIC_LIBRARY
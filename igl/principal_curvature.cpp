@@ -14,6 +14,7 @@
 #include <list>
 #include <cmath>
 #include <limits>
+#include <algorithm>
 
 #include <Eigen/SparseCholesky>
 
@@ -23,6 +24,7 @@
 #include <igl/per_vertex_normals.h>
 #include <igl/avg_edge_length.h>
 #include <igl/vertex_triangle_adjacency.h>
+#include <igl/parallel_for.h>
 
 typedef enum
 {
@@ -40,13 +42,16 @@ class CurvatureCalculator
 {
 public:
   /* Row number i represents the i-th vertex, whose columns are:
-   curv[i][0] : K2
-   curv[i][1] : K1
-   curvDir[i][0] : PD1
-   curvDir[i][1] : PD2
+   curv(i,0) : K2
+   curv(i,1) : K1
+   curvDir1.row(i) : PD1
+   curvDir2.row(i) : PD2
+   computed[i] is 0 if the curvature could not be computed at i
    */
-  std::vector< std::vector<double> > curv;
-  std::vector< std::vector<Eigen::Vector3d> > curvDir;
+  Eigen::MatrixXd curv;
+  Eigen::MatrixXd curvDir1;
+  Eigen::MatrixXd curvDir2;
+  std::vector<char> computed;
   bool curvatureComputed;
   class Quadric
   {
@@ -141,16 +146,25 @@ public:
 
 public:
 
-  Eigen::MatrixXd vertices;
-  // Face list of current mesh    (#F x 3) or (#F x 4)
-  // The i-th row contains the indices of the vertices that forms the i-th face in ccw order
-  Eigen::MatrixXi faces;
+  /* Buffers of one thread, reused across the vertices it processes */
+  class Scratch
+  {
+  public:
+    IGL_INLINE Scratch(int n) : visited(n,-1) {}
+    std::vector<int> vv;
+    std::vector<int> vvtmp;
+    /* Ring of each entry of vv during a k-ring search */
+    std::vector<int> ring;
+    /* visited[j]==start iff j was reached by the search from start */
+    std::vector<int> visited;
+    std::vector<std::pair<int, double> > candidates;
+  };
 
-  std::vector<std::vector<int> > vertex_to_vertices;
-  std::vector<std::vector<int> > vertex_to_faces;
-  std::vector<std::vector<int> > vertex_to_faces_index;
-  Eigen::MatrixXd face_normals;
-  Eigen::MatrixXd vertex_normals;
+  /* Mesh, normals and adjacency (see igl::PrincipalCurvatureData) */
+  const igl::PrincipalCurvatureData& data;
+  const Eigen::MatrixXd& vertices;
+  const Eigen::MatrixXd& face_normals;
+  const Eigen::MatrixXd& vertex_normals;
 
   /* Size of the neighborhood */
   double sphereRadius;
@@ -173,14 +187,14 @@ public:
   int step;  /* If expStep==false, by how much rhe radius increases on every step */
   int maxSize; /* The maximum limit of the radius in the benchmark */
 
-  IGL_INLINE CurvatureCalculator();
-  IGL_INLINE void init(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F);
+  IGL_INLINE CurvatureCalculator(const igl::PrincipalCurvatureData& data);
 
   IGL_INLINE void finalEigenStuff(int, const std::vector<Eigen::Vector3d>&, Quadric&);
   IGL_INLINE void fitQuadric(const Eigen::Vector3d&, const std::vector<Eigen::Vector3d>& ref, const std::vector<int>& , Quadric *);
   IGL_INLINE void applyProjOnPlane(const Eigen::Vector3d&, const std::vector<int>&, std::vector<int>&);
-  IGL_INLINE void getSphere(const int, const double, std::vector<int>&, int min);
-  IGL_INLINE void getKRing(const int, const double,std::vector<int>&);
+  IGL_INLINE void getSphere(const int, const double, Scratch&, int min);
+  IGL_INLINE void getKRing(const int, const int, Scratch&);
+  IGL_INLINE static void searchKRing(const Eigen::VectorXi& A, const Eigen::VectorXi& AI, const int, const int, Scratch&);
   IGL_INLINE Eigen::Vector3d project(const Eigen::Vector3d&, const Eigen::Vector3d&, const Eigen::Vector3d&);
   IGL_INLINE void computeReferenceFrame(int, const Eigen::Vector3d&, std::vector<Eigen::Vector3d>&);
   IGL_INLINE void getAverageNormal(int, const std::vector<int>&, Eigen::Vector3d&);
@@ -188,7 +202,6 @@ public:
   IGL_INLINE void applyMontecarlo(const std::vector<int>&,std::vector<int>*);
   IGL_INLINE void computeCurvature();
   IGL_INLINE void printCurvature(const std::string& outpath);
-  IGL_INLINE double getAverageEdge();
 
   IGL_INLINE static int rotateForward (double *v0, double *v1, double *v2)
   {
@@ -301,7 +314,11 @@ public:
   }
 };
 
-IGL_INLINE CurvatureCalculator::CurvatureCalculator()
+IGL_INLINE CurvatureCalculator::CurvatureCalculator(const igl::PrincipalCurvatureData& data) :
+  data(data),
+  vertices(data.V),
+  face_normals(data.FN),
+  vertex_normals(data.VN)
 {
   this->localMode=true;
   this->projectionPlaneCheck=true;
@@ -315,22 +332,6 @@ IGL_INLINE CurvatureCalculator::CurvatureCalculator()
   this->expStep=true;
 }
 
-IGL_INLINE void CurvatureCalculator::init(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F)
-{
-  // Normalize vertices
-  vertices = V;
-
-//  vertices = vertices.array() - vertices.minCoeff();
-//  vertices = vertices.array() / vertices.maxCoeff();
-//  vertices = vertices.array() * (1.0/igl::avg_edge_length(V,F));
-
-  faces = F;
-  igl::adjacency_list(F, vertex_to_vertices);
-  igl::vertex_triangle_adjacency(V, F, vertex_to_faces, vertex_to_faces_index);
-  igl::per_face_normals(V, F, face_normals);
-  igl::per_vertex_normals(V, F, face_normals, vertex_normals);
-}
-
 IGL_INLINE void CurvatureCalculator::fitQuadric(const Eigen::Vector3d& v, const std::vector<Eigen::Vector3d>& ref, const std::vector<int>& vv, Quadric *q)
 {
   std::vector<Eigen::Vector3d> points;
@@ -424,99 +425,114 @@ IGL_INLINE void CurvatureCalculator::finalEigenStuff(int i, const std::vector<Ei
 
   if (c_val[0] > c_val[1])
   {
-    curv[i]=std::vector<double>(2);
-    curv[i][0]=c_val(1);
-    curv[i][1]=c_val(0);
-    curvDir[i]=std::vector<Eigen::Vector3d>(2);
-    curvDir[i][0]=v2global;
-    curvDir[i][1]=v1global;
+    curv(i,0)=c_val(1);
+    curv(i,1)=c_val(0);
+    curvDir1.row(i)=v2global;
+    curvDir2.row(i)=v1global;
   }
   else
   {
-    curv[i]=std::vector<double>(2);
-    curv[i][0]=c_val(0);
-    curv[i][1]=c_val(1);
-    curvDir[i]=std::vector<Eigen::Vector3d>(2);
-    curvDir[i][0]=v1global;
-    curvDir[i][1]=v2global;
+    curv(i,0)=c_val(0);
+    curv(i,1)=c_val(1);
+    curvDir1.row(i)=v1global;
+    curvDir2.row(i)=v2global;
   }
+  computed[i]=1;
   // ---- end Eigen stuff
 }
 
-IGL_INLINE void CurvatureCalculator::getKRing(const int start, const double r, std::vector<int>&vv)
+IGL_INLINE void CurvatureCalculator::searchKRing(const Eigen::VectorXi& A, const Eigen::VectorXi& AI, const int start, const int r, Scratch& s)
 {
-  int bufsize=vertices.rows();
-  vv.reserve(bufsize);
-  std::list<std::pair<int,int> > queue;
-  std::vector<bool> visited(bufsize, false);
-  queue.push_back(std::pair<int,int>(start,0));
-  visited[start]=true;
-  while (!queue.empty())
-  {
-    int toVisit=queue.front().first;
-    int distance=queue.front().second;
-    queue.pop_front();
-    vv.push_back(toVisit);
-    if (distance<(int)r)
+  std::vector<int>& vv=s.vv;
+  std::vector<int>& ring=s.ring;
+  vv.clear();
+  ring.clear();
+  vv.push_back(start);
+  ring.push_back(0);
+  s.visited[start]=start;
+  // vv doubles as the breadth first queue
+  for (size_t head=0; head<vv.size(); ++head)
+  {
+    int toVisit=vv[head];
+    int distance=ring[head];
+    if (distance<r)
     {
-      for (unsigned int i=0; i<vertex_to_vertices[toVisit].size(); ++i)
+      for (int a=AI(toVisit); a<AI(toVisit+1); ++a)
       {
-        int neighbor=vertex_to_vertices[toVisit][i];
-        if (!visited[neighbor])
+        int neighbor=A(a);
+        if (s.visited[neighbor]!=start)
         {
-          queue.push_back(std::pair<int,int> (neighbor,distance+1));
-          visited[neighbor]=true;
+          vv.push_back(neighbor);
+          ring.push_back(distance+1);
+          s.visited[neighbor]=start;
         }
       }
     }
   }
 }
 
+IGL_INLINE void CurvatureCalculator::getKRing(const int start, const int r, Scratch& s)
+{
+  if (r>data.max_ring)
+  {
+    searchKRing(data.A,data.AI,start,r,s);
+    return;
+  }
+  // Prefix of the cached max_ring-ring
+  s.vv.clear();
+  for (int k=data.KI(start); k<data.KI(start+1) && data.KD(k)<=r; ++k)
+    s.vv.push_back(data.K(k));
+}
+
 
-IGL_INLINE void CurvatureCalculator::getSphere(const int start, const double r, std::vector<int> &vv, int min)
+IGL_INLINE void CurvatureCalculator::getSphere(const int start, const double r, Scratch& s, int min)
 {
-  int bufsize=vertices.rows();
-  vv.reserve(bufsize);
-  std::list<int> queue;
-  std::vector<bool> visited(bufsize, false);
-  queue.push_back(start);
-  visited[start]=true;
+  std::vector<int>& vv=s.vv;
+  std::vector<std::pair<int, double> >& extra_candidates=s.candidates;
+  vv.clear();
+  extra_candidates.clear();
+  vv.push_back(start);
+  s.visited[start]=start;
   Eigen::Vector3d me=vertices.row(start);
-  std::priority_queue<std::pair<int, double>, std::vector<std::pair<int, double> >, comparer > extra_candidates;
-  while (!queue.empty())
+  // vv doubles as the breadth first queue, its first head+1 entries have
+  // been visited
+  for (size_t head=0; head<vv.size(); ++head)
   {
-    int toVisit=queue.front();
-    queue.pop_front();
-    vv.push_back(toVisit);
-    for (unsigned int i=0; i<vertex_to_vertices[toVisit].size(); ++i)
+    int toVisit=vv[head];
+    for (int a=data.AI(toVisit); a<data.AI(toVisit+1); ++a)
     {
-      int neighbor=vertex_to_vertices[toVisit][i];
-      if (!visited[neighbor])
+      int neighbor=data.A(a);
+      if (s.visited[neighbor]!=start)
       {
         Eigen::Vector3d neigh=vertices.row(neighbor);
         double distance=(me-neigh).norm();
         if (distance<r)
-          queue.push_back(neighbor);
-        else if ((int)vv.size()<min)
-          extra_candidates.push(std::pair<int,double>(neighbor,distance));
-        visited[neighbor]=true;
+          vv.push_back(neighbor);
+        else if ((int)head+1<min)
+        {
+          extra_candidates.push_back(std::pair<int,double>(neighbor,distance));
+          std::push_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+        }
+        s.visited[neighbor]=start;
       }
     }
   }
   while (!extra_candidates.empty() && (int)vv.size()<min)
   {
-    std::pair<int, double> cand=extra_candidates.top();
-    extra_candidates.pop();
+    std::pop_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+    std::pair<int, double> cand=extra_candidates.back();
+    extra_candidates.pop_back();
     vv.push_back(cand.first);
-    for (unsigned int i=0; i<vertex_to_vertices[cand.first].size(); ++i)
+    for (int a=data.AI(cand.first); a<data.AI(cand.first+1); ++a)
     {
-      int neighbor=vertex_to_vertices[cand.first][i];
-      if (!visited[neighbor])
+      int neighbor=data.A(a);
+      if (s.visited[neighbor]!=start)
       {
         Eigen::Vector3d neigh=vertices.row(neighbor);
         double distance=(me-neigh).norm();
-        extra_candidates.push(std::pair<int,double>(neighbor,distance));
-        visited[neighbor]=true;
+        extra_candidates.push_back(std::pair<int,double>(neighbor,distance));
+        std::push_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+        s.visited[neighbor]=start;
       }
     }
   }
@@ -530,7 +546,7 @@ IGL_INLINE Eigen::Vector3d CurvatureCalculator::project(const Eigen::Vector3d& v
 IGL_INLINE void CurvatureCalculator::computeReferenceFrame(int i, const Eigen::Vector3d& normal, std::vector<Eigen::Vector3d>& ref )
 {
 
-  Eigen::Vector3d longest_v=Eigen::Vector3d(vertices.row(vertex_to_vertices[i][0]));
+  Eigen::Vector3d longest_v=Eigen::Vector3d(vertices.row(data.A(data.AI(i))));
 
   longest_v=(project(vertices.row(i),longest_v,normal)-Eigen::Vector3d(vertices.row(i))).normalized();
 
@@ -566,9 +582,9 @@ IGL_INLINE void CurvatureCalculator::getProjPlane(int j, const std::vector<int>&
 
   if (localMode)
   {
-    for (unsigned int i=0; i<vertex_to_faces.at(j).size(); ++i)
+    for (int i=data.NI(j); i<data.NI(j+1); ++i)
     {
-      Eigen::Vector3d faceNormal=face_normals.row(vertex_to_faces.at(j).at(i));
+      Eigen::Vector3d faceNormal=face_normals.row(data.VF(i));
       a += faceNormal[0];
       b += faceNormal[1];
       c += faceNormal[2];
@@ -596,29 +612,6 @@ IGL_INLINE void CurvatureCalculator::getProjPlane(int j, const std::vector<int>&
 }
 
 
-IGL_INLINE double CurvatureCalculator::getAverageEdge()
-{
-  double sum = 0;
-  int count = 0;
-
-  for (int i = 0; i<faces.rows(); ++i)
-  {
-    for (short unsigned j=0; j<3; ++j)
-    {
-      Eigen::Vector3d p1=vertices.row(faces.row(i)[j]);
-      Eigen::Vector3d p2=vertices.row(faces.row(i)[(j+1)%3]);
-
-      double l = (p1-p2).norm();
-
-      sum+=l;
-      ++count;
-    }
-  }
-
-  return (sum/(double)count);
-}
-
-
 IGL_INLINE void CurvatureCalculator::applyProjOnPlane(const Eigen::Vector3d& ppn, const std::vector<int>& vin, std::vector<int> &vout)
 {
   for (std::vector<int>::const_iterator vpi = vin.begin(); vpi != vin.end(); ++vpi)
@@ -653,51 +646,48 @@ IGL_INLINE void CurvatureCalculator::computeCurvature()
   if (vertices_count ==0)
     return;
 
-  curvDir=std::vector< std::vector<Eigen::Vector3d> >(vertices_count);
-  curv=std::vector<std::vector<double> >(vertices_count);
-
-
-
-  scaledRadius=getAverageEdge()*sphereRadius;
-
-  std::vector<int> vv;
-  std::vector<int> vvtmp;
-  Eigen::Vector3d normal;
+  curv=Eigen::MatrixXd::Zero(vertices_count,2);
+  curvDir1=Eigen::MatrixXd::Zero(vertices_count,3);
+  curvDir2=Eigen::MatrixXd::Zero(vertices_count,3);
+  computed=std::vector<char>(vertices_count,0);
 
-  //double time_spent;
-  //double searchtime=0, ref_time=0, fit_time=0, final_time=0;
+  scaledRadius=data.avg_edge_length*sphereRadius;
 
-  for (size_t i=0; i<vertices_count; ++i)
+  std::vector<Scratch> scratch;
+  const auto & prep = [&](const size_t nt)
   {
-    vv.clear();
+    scratch.assign(nt,Scratch(vertices_count));
+  };
+  const auto & func = [&](const int i, const size_t t)
+  {
+    Scratch& s=scratch[t];
+    std::vector<int>& vv=s.vv;
+    std::vector<int>& vvtmp=s.vvtmp;
+    Eigen::Vector3d normal;
     vvtmp.clear();
     Eigen::Vector3d me=vertices.row(i);
     switch (st)
     {
       case SPHERE_SEARCH:
-        getSphere(i,scaledRadius,vv,6);
+        getSphere(i,scaledRadius,s,6);
         break;
       case K_RING_SEARCH:
-        getKRing(i,kRing,vv);
+        getKRing(i,kRing,s);
         break;
-      default:
-        fprintf(stderr,"Error: search type not recognized");
-        return;
     }
 
     if (vv.size()<6)
     {
       //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
-      continue;
+      return;
     }
 
 
     if (projectionPlaneCheck)
     {
-      vvtmp.reserve (vv.size ());
       applyProjOnPlane (vertex_normals.row(i), vv, vvtmp);
       if (vvtmp.size() >= 6 && vvtmp.size()<vv.size())
-        vv = vvtmp;
+        vv.swap(vvtmp);
     }
 
 
@@ -709,22 +699,19 @@ IGL_INLINE void CurvatureCalculator::computeCurvature()
       case PROJ_PLANE:
         getProjPlane(i,vv,normal);
         break;
-      default:
-        fprintf(stderr,"Error: normal type not recognized");
-        return;
     }
     if (vv.size()<6)
     {
       //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
-      continue;
+      return;
     }
     if (montecarlo)
     {
       if(montecarloN<6)
-        break;
-      vvtmp.reserve(vv.size());
+        return;
+      vvtmp.clear();
       applyMontecarlo(vv,&vvtmp);
-      vv=vvtmp;
+      vv.swap(vvtmp);
     }
 
     if (vv.size()<6)
@@ -735,7 +722,11 @@ IGL_INLINE void CurvatureCalculator::computeCurvature()
     Quadric q;
     fitQuadric (me, ref, vv, &q);
     finalEigenStuff(i,ref,q);
-  }
+  };
+  // Montecarlo sampling draws from rand(), keep it serial
+  igl::parallel_for(
+    (int)vertices_count,prep,func,[](const size_t){},
+    montecarlo ? std::numeric_limits<size_t>::max() : 1000);
 
   lastRadius=sphereRadius;
   curvatureComputed=true;
@@ -760,25 +751,83 @@ IGL_INLINE void CurvatureCalculator::printCurvature(const std::string& outpath)
   of << vertices_count << endl;
   for (int i=0; i<vertices_count; ++i)
   {
-    of << curv[i][0] << " " << curv[i][1] << " " << curvDir[i][0][0] << " " << curvDir[i][0][1] << " " << curvDir[i][0][2] << " " <<
-    curvDir[i][1][0] << " " << curvDir[i][1][1] << " " << curvDir[i][1][2] << endl;
+    of << curv(i,0) << " " << curv(i,1) << " " << curvDir1(i,0) << " " << curvDir1(i,1) << " " << curvDir1(i,2) << " " <<
+    curvDir2(i,0) << " " << curvDir2(i,1) << " " << curvDir2(i,2) << endl;
   }
 
   of.close();
 
 }
 
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::principal_curvature_precompute(
+  const Eigen::PlainObjectBase<DerivedV>& V,
+  const Eigen::PlainObjectBase<DerivedF>& F,
+  const int max_ring,
+  PrincipalCurvatureData & data)
+{
+  data.V = V.template cast<double>();
+  data.F = F.template cast<int>();
+  const int n = data.V.rows();
+  igl::per_face_normals(data.V, data.F, data.FN);
+  igl::per_vertex_normals(data.V, data.F, data.FN, data.VN);
+  igl::vertex_triangle_adjacency(data.F, n, data.VF, data.NI);
+  // Average over half-edges, so that interior edges count twice
+  data.avg_edge_length = 0;
+  for (int f = 0; f < data.F.rows(); ++f)
+    for (int c = 0; c < 3; ++c)
+      data.avg_edge_length += (data.V.row(data.F(f,c)) - data.V.row(data.F(f,(c+1)%3))).norm();
+  if (data.F.rows() > 0)
+    data.avg_edge_length /= 3.0*data.F.rows();
+
+  // Flatten the one-ring, keeping the order of adjacency_list since the
+  // first neighbour defines the reference frame
+  std::vector<std::vector<int> > A;
+  igl::adjacency_list(data.F, A);
+  A.resize(n);
+  data.AI.resize(n+1);
+  data.AI(0) = 0;
+  for (int i = 0; i < n; ++i)
+    data.AI(i+1) = data.AI(i) + A[i].size();
+  data.A.resize(data.AI(n));
+  for (int i = 0; i < n; ++i)
+    std::copy(A[i].begin(), A[i].end(), data.A.data() + data.AI(i));
+
+  // Cache the max_ring-rings: count, then fill
+  data.max_ring = std::max(max_ring, 0);
+  data.KI.resize(n+1);
+  data.KI(0) = 0;
+  std::vector<CurvatureCalculator::Scratch> scratch;
+  const auto & prep = [&](const size_t nt)
+  {
+    scratch.assign(nt, CurvatureCalculator::Scratch(n));
+  };
+  igl::parallel_for(n, prep, [&](const int i, const size_t t)
+  {
+    CurvatureCalculator::searchKRing(data.A, data.AI, i, data.max_ring, scratch[t]);
+    data.KI(i+1) = scratch[t].vv.size();
+  }, [](const size_t){}, 1000);
+  for (int i = 0; i < n; ++i)
+    data.KI(i+1) += data.KI(i);
+  data.K.resize(data.KI(n));
+  data.KD.resize(data.KI(n));
+  igl::parallel_for(n, prep, [&](const int i, const size_t t)
+  {
+    CurvatureCalculator::Scratch& s = scratch[t];
+    CurvatureCalculator::searchKRing(data.A, data.AI, i, data.max_ring, s);
+    std::copy(s.vv.begin(), s.vv.end(), data.K.data() + data.KI(i));
+    std::copy(s.ring.begin(), s.ring.end(), data.KD.data() + data.KI(i));
+  }, [](const size_t){}, 1000);
+}
+
 template <
-  typename DerivedV,
-  typename DerivedF,
   typename DerivedPD1,
   typename DerivedPD2,
   typename DerivedPV1,
   typename DerivedPV2,
   typename Index>
 IGL_INLINE void igl::principal_curvature(
-  const Eigen::PlainObjectBase<DerivedV>& V,
-  const Eigen::PlainObjectBase<DerivedF>& F,
+  const PrincipalCurvatureData & data,
   Eigen::PlainObjectBase<DerivedPD1>& PD1,
   Eigen::PlainObjectBase<DerivedPD2>& PD2,
   Eigen::PlainObjectBase<DerivedPV1>& PV1,
@@ -787,24 +836,22 @@ IGL_INLINE void igl::principal_curvature(
   unsigned radius,
   bool useKring)
 {
-
   if (radius < 2)
   {
     radius = 2;
     std::cout << "WARNING: igl::principal_curvature needs a radius >= 2, fixing it to 2." << std::endl;
   }
 
+  const int n = data.V.rows();
   // Preallocate memory
-  PD1.resize(V.rows(),3);
-  PD2.resize(V.rows(),3);
+  PD1.resize(n,3);
+  PD2.resize(n,3);
 
   // Preallocate memory
-  PV1.resize(V.rows(),1);
-  PV2.resize(V.rows(),1);
+  PV1.resize(n,1);
+  PV2.resize(n,1);
 
-  // Precomputation
-  CurvatureCalculator cc;
-  cc.init(V.template cast<double>(),F.template cast<int>());
+  CurvatureCalculator cc(data);
   cc.sphereRadius = radius;
 
   if (useKring)
@@ -817,12 +864,12 @@ IGL_INLINE void igl::principal_curvature(
   cc.computeCurvature();
 
   // Copy it back
-  for (unsigned i=0; i<V.rows(); ++i)
+  for (int i=0; i<n; ++i)
   {
-    if (!cc.curv[i].empty())
+    if (cc.computed[i])
     {
-      PD1.row(i) << cc.curvDir[i][0][0], cc.curvDir[i][0][1], cc.curvDir[i][0][2];
-      PD2.row(i) << cc.curvDir[i][1][0], cc.curvDir[i][1][1], cc.curvDir[i][1][2];
+      PD1.row(i) = cc.curvDir1.row(i).template cast<typename DerivedPD1::Scalar>();
+      PD2.row(i) = cc.curvDir2.row(i).template cast<typename DerivedPD2::Scalar>();
       PD1.row(i).normalize();
       PD2.row(i).normalize();
 
@@ -832,8 +879,8 @@ IGL_INLINE void igl::principal_curvature(
         PD2.row(i) << 0,0,0;
       }
 
-      PV1(i) = cc.curv[i][0];
-      PV2(i) = cc.curv[i][1];
+      PV1(i) = cc.curv(i,0);
+      PV2(i) = cc.curv(i,1);
 
       if (PD1.row(i) * PD2.row(i).transpose() > 10e-6)
       {
@@ -851,7 +898,32 @@ IGL_INLINE void igl::principal_curvature(
       PD2.row(i) << 0,0,0;
     }
   }
+}
 
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedPD1,
+  typename DerivedPD2,
+  typename DerivedPV1,
+  typename DerivedPV2,
+  typename Index>
+IGL_INLINE void igl::principal_curvature(
+  const Eigen::PlainObjectBase<DerivedV>& V,
+  const Eigen::PlainObjectBase<DerivedF>& F,
+  Eigen::PlainObjectBase<DerivedPD1>& PD1,
+  Eigen::PlainObjectBase<DerivedPD2>& PD2,
+  Eigen::PlainObjectBase<DerivedPV1>& PV1,
+  Eigen::PlainObjectBase<DerivedPV2>& PV2,
+  std::vector<Index>& bad_vertices,
+  unsigned radius,
+  bool useKring)
+{
+  // Precomputation. A single evaluation searches every k-ring once anyway,
+  // so caching them would only cost memory.
+  PrincipalCurvatureData data;
+  principal_curvature_precompute(V, F, 0, data);
+  principal_curvature(data, PD1, PD2, PV1, PV2, bad_vertices, radius, useKring);
 }
 
 template <
@@ -886,8 +958,9 @@ IGL_INLINE void igl::principal_curvature(
   PV2.resize(V.rows(),1);
 
   // Precomputation
-  CurvatureCalculator cc;
-  cc.init(V.template cast<double>(),F.template cast<int>());
+  PrincipalCurvatureData data;
+  principal_curvature_precompute(V, F, 0, data);
+  CurvatureCalculator cc(data);
   cc.sphereRadius = radius;
 
   if (useKring)
@@ -902,8 +975,8 @@ IGL_INLINE void igl::principal_curvature(
   // Copy it back
   for (unsigned i=0; i<V.rows(); ++i)
   {
-    PD1.row(i) << cc.curvDir[i][0][0], cc.curvDir[i][0][1], cc.curvDir[i][0][2];
-    PD2.row(i) << cc.curvDir[i][1][0], cc.curvDir[i][1][1], cc.curvDir[i][1][2];
+    PD1.row(i) = cc.curvDir1.row(i).template cast<typename DerivedPD1::Scalar>();
+    PD2.row(i) = cc.curvDir2.row(i).template cast<typename DerivedPD2::Scalar>();
     PD1.row(i).normalize();
     PD2.row(i).normalize();
 
@@ -913,8 +986,8 @@ IGL_INLINE void igl::principal_curvature(
       PD2.row(i) << 0,0,0;
     }
 
-    PV1(i) = cc.curv[i][0];
-    PV2(i) = cc.curv[i][1];
+    PV1(i) = cc.curv(i,0);
+    PV2(i) = cc.curv(i,1);
 
     if (PD1.row(i) * PD2.row(i).transpose() > 10e-6)
     {
@@ -933,4 +1006,6 @@ template void igl::principal_curvature<Eigen::Matrix<double, -1, -1, 0, -1, -1>,
 template void igl::principal_curvature<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, unsigned int, bool);
 template void igl::principal_curvature<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, unsigned int, bool);
 template void igl::principal_curvature<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, int>(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, std::vector<int, std::allocator<int> >&, unsigned int, bool);
+template void igl::principal_curvature_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, igl::PrincipalCurvatureData&);
+template void igl::principal_curvature<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, int>(igl::PrincipalCurvatureData const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, std::vector<int, std::allocator<int> >&, unsigned int, bool);
 #endif
@@ -83,6 +83,64 @@ IGL_INLINE void principal_curvature(
   unsigned radius = 5,
   bool useKring = true);
 
+  // Mesh quantities and neighbourhoods used by principal_curvature, so that
+  // they can be computed once and reused across calls with different radii.
+  struct PrincipalCurvatureData
+  {
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi F;
+    // #F by 3 face normals and #V by 3 vertex normals
+    Eigen::MatrixXd FN,VN;
+    // One-ring adjacency in CSR layout: the neighbours of vertex i are
+    // A(AI(i)) ... A(AI(i+1)-1)
+    Eigen::VectorXi A,AI;
+    // Incident faces in CSR layout (see vertex_triangle_adjacency)
+    Eigen::VectorXi VF,NI;
+    // Average half-edge length, the unit of the sphere search radius
+    double avg_edge_length;
+    // Cached k-rings for k <= max_ring in CSR layout: K(KI(i)) ...
+    // K(KI(i+1)-1) lists the max_ring-ring of vertex i in breadth first
+    // order and KD holds the ring of each entry, so the k-ring of i is the
+    // prefix with KD <= k.
+    int max_ring;
+    Eigen::VectorXi K,KI,KD;
+  };
+  // Precompute data for principal_curvature
+  //
+  // Inputs:
+  //   V  #V by 3 list of vertex positions
+  //   F  #F by 3 list of mesh faces (must be triangles)
+  //   max_ring  largest k-ring radius to cache (0 caches none, larger radii
+  //     fall back to a search per vertex)
+  // Outputs:
+  //   data  precomputed data
+  template <typename DerivedV, typename DerivedF>
+  IGL_INLINE void principal_curvature_precompute(
+    const Eigen::PlainObjectBase<DerivedV>& V,
+    const Eigen::PlainObjectBase<DerivedF>& F,
+    const int max_ring,
+    PrincipalCurvatureData & data);
+  // Compute the principal curvature from precomputed data, see above for the
+  // remaining parameters.
+  //
+  // Inputs:
+  //   data  precomputed data (see principal_curvature_precompute)
+  template <
+    typename DerivedPD1,
+    typename DerivedPD2,
+    typename DerivedPV1,
+    typename DerivedPV2,
+    typename Index>
+  IGL_INLINE void principal_curvature(
+    const PrincipalCurvatureData & data,
+    Eigen::PlainObjectBase<DerivedPD1>& PD1,
+    Eigen::PlainObjectBase<DerivedPD2>& PD2,
+    Eigen::PlainObjectBase<DerivedPV1>& PV1,
+    Eigen::PlainObjectBase<DerivedPV2>& PV2,
+    std::vector<Index>& bad_vertices,
+    unsigned radius = 5,
+    bool useKring = true);
+
 }
 
 
@@ -0,0 +1,59 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "progressive_mesh_refine.h"
+#include <cassert>
+
+IGL_INLINE int igl::progressive_mesh_refine(
+  const std::vector<VertexSplit> & splits,
+  const size_t max_m,
+  Eigen::MatrixXd & V,
+  Eigen::MatrixXi & F,
+  int & k)
+{
+  // Find how far to go first so that V and F are resized only once
+  int end = k;
+  size_t m = F.rows();
+  while(end < (int)splits.size() && m+splits[end].new_faces.rows() <= max_m)
+  {
+    m += splits[end].new_faces.rows();
+    end++;
+  }
+  if(end == k)
+  {
+    return 0;
+  }
+  const int applied = end-k;
+  int n = V.rows();
+  int f = F.rows();
+  V.conservativeResize(n+applied,V.cols());
+  F.conservativeResize(m,3);
+  for(;k<end;k++)
+  {
+    const VertexSplit & split = splits[k];
+    const int t = n++;
+    V.row(split.s) = split.s_position;
+    V.row(t) = split.t_position;
+    for(const int g : split.faces)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        if(F(g,c) == split.s)
+        {
+          F(g,c) = t;
+          break;
+        }
+      }
+    }
+    for(int i = 0;i<split.new_faces.rows();i++)
+    {
+      F.row(f++) = split.new_faces.row(i);
+    }
+  }
+  assert(f == F.rows());
+  return applied;
+}
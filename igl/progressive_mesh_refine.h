@@ -0,0 +1,51 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PROGRESSIVE_MESH_REFINE_H
+#define IGL_PROGRESSIVE_MESH_REFINE_H
+#include "igl_inline.h"
+#include "VertexSplit.h"
+#include <Eigen/Core>
+#include <vector>
+namespace igl
+{
+  // Refine a progressive mesh by applying its vertex splits in order until
+  // the desired number of faces is reached. The mesh grows in place and the
+  // split to resume from is returned in k, so refinement can proceed
+  // incrementally, e.g., as more splits are read (see ProgressiveMeshReader)
+  // or as the camera approaches.
+  //
+  // Inputs:
+  //   splits  list of vertex splits, e.g., as output by decimate or qslim
+  //   max_m  desired number of faces, splits are applied as long as #F stays
+  //     below or at max_m
+  //   V  #V by dim list of vertex positions, the base mesh refined by
+  //     splits[0],...,splits[k-1]
+  //   F  #F by 3 list of face indices into V
+  //   k  index into splits of the next split to apply
+  // Outputs:
+  //   V,F  refined mesh
+  //   k  index into splits of the next split to apply
+  // Returns number of splits applied
+  //
+  // Example:
+  //   igl::qslim(V,F,1000,U,G,J,I,splits);
+  //   int k = 0;
+  //   // ... later, when more detail is needed
+  //   igl::progressive_mesh_refine(splits,20000,U,G,k);
+  IGL_INLINE int progressive_mesh_refine(
+    const std::vector<VertexSplit> & splits,
+    const size_t max_m,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F,
+    int & k);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "progressive_mesh_refine.cpp"
+#endif
+#endif
@@ -19,6 +19,128 @@
 #include "remove_unreferenced.h"
 #include "slice.h"
 #include "slice_mask.h"
+#include "slice_mask_vertex_splits.h"
+
+namespace
+{
+  // Shared by both qslim overloads, splits is null if not requested
+  IGL_INLINE bool qslim_decimate(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const size_t max_m,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I,
+    std::vector<igl::VertexSplit> * splits)
+  {
+    using namespace igl;
+
+    // Original number of faces
+    const int orig_m = F.rows();
+    // Tracking number of faces
+    int m = F.rows();
+    typedef Eigen::MatrixXd DerivedV;
+    typedef Eigen::MatrixXi DerivedF;
+    DerivedV VO;
+    DerivedF FO;
+    igl::connect_boundary_to_infinity(V,F,VO,FO);
+    // decimate will not work correctly on non-edge-manifold meshes. By extension
+    // this includes meshes with non-manifold vertices on the boundary since these
+    // will create a non-manifold edge when connected to infinity.
+    if(!is_edge_manifold(FO))
+    {
+      return false;
+    }
+    Eigen::VectorXi EMAP;
+    Eigen::MatrixXi E,EF,EI;
+    edge_flaps(FO,E,EMAP,EF,EI);
+    // Quadrics per vertex
+    typedef std::tuple<Eigen::MatrixXd,Eigen::RowVectorXd,double> Quadric;
+    std::vector<Quadric> quadrics;
+    per_vertex_point_to_plane_quadrics(VO,FO,EMAP,EF,EI,quadrics);
+    // State variables keeping track of edge we just collapsed
+    int v1 = -1;
+    int v2 = -1;
+    // Callbacks for computing and updating metric
+    std::function<void(
+      const int e,
+      const Eigen::MatrixXd &,
+      const Eigen::MatrixXi &,
+      const Eigen::MatrixXi &,
+      const Eigen::VectorXi &,
+      const Eigen::MatrixXi &,
+      const Eigen::MatrixXi &,
+      double &,
+      Eigen::RowVectorXd &)> cost_and_placement;
+    std::function<bool(
+      const Eigen::MatrixXd &                                         ,/*V*/
+      const Eigen::MatrixXi &                                         ,/*F*/
+      const Eigen::MatrixXi &                                         ,/*E*/
+      const Eigen::VectorXi &                                         ,/*EMAP*/
+      const Eigen::MatrixXi &                                         ,/*EF*/
+      const Eigen::MatrixXi &                                         ,/*EI*/
+      const std::set<std::pair<double,int> > &                        ,/*Q*/
+      const std::vector<std::set<std::pair<double,int> >::iterator > &,/*Qit*/
+      const Eigen::MatrixXd &                                         ,/*C*/
+      const int                                                        /*e*/
+      )> pre_collapse;
+    std::function<void(
+      const Eigen::MatrixXd &                                         ,   /*V*/
+      const Eigen::MatrixXi &                                         ,   /*F*/
+      const Eigen::MatrixXi &                                         ,   /*E*/
+      const Eigen::VectorXi &                                         ,/*EMAP*/
+      const Eigen::MatrixXi &                                         ,  /*EF*/
+      const Eigen::MatrixXi &                                         ,  /*EI*/
+      const std::set<std::pair<double,int> > &                        ,   /*Q*/
+      const std::vector<std::set<std::pair<double,int> >::iterator > &, /*Qit*/
+      const Eigen::MatrixXd &                                         ,   /*C*/
+      const int                                                       ,   /*e*/
+      const int                                                       ,  /*e1*/
+      const int                                                       ,  /*e2*/
+      const int                                                       ,  /*f1*/
+      const int                                                       ,  /*f2*/
+      const bool                                                  /*collapsed*/
+      )> post_collapse;
+    qslim_optimal_collapse_edge_callbacks(
+      E,quadrics,v1,v2, cost_and_placement, pre_collapse,post_collapse);
+    if(splits)
+    {
+      bool ret = decimate(
+        VO, FO,
+        cost_and_placement,
+        max_faces_stopping_condition(m,orig_m,max_m),
+        pre_collapse,
+        post_collapse,
+        E, EMAP, EF, EI,
+        U, G, J, I, *splits);
+      // Remove phony boundary faces, also from the splits
+      Eigen::Array<bool,Eigen::Dynamic,1> keep(FO.rows());
+      keep.head(orig_m).setConstant(true);
+      keep.tail(FO.rows()-orig_m).setConstant(false);
+      slice_mask_vertex_splits(keep,U,G,J,I,*splits);
+      return ret;
+    }
+    // Call to greedy decimator
+    bool ret = decimate(
+      VO, FO,
+      cost_and_placement,
+      max_faces_stopping_condition(m,orig_m,max_m),
+      pre_collapse,
+      post_collapse,
+      E, EMAP, EF, EI,
+      U, G, J, I);
+    // Remove phony boundary faces and clean up
+    const Eigen::Array<bool,Eigen::Dynamic,1> keep = (J.array()<orig_m);
+    igl::slice_mask(Eigen::MatrixXi(G),keep,1,G);
+    igl::slice_mask(Eigen::VectorXi(J),keep,1,J);
+    Eigen::VectorXi _1,I2;
+    igl::remove_unreferenced(Eigen::MatrixXd(U),Eigen::MatrixXi(G),U,G,_1,I2);
+    igl::slice(Eigen::VectorXi(I),I2,1,I);
+
+    return ret;
+  }
+}
 
 IGL_INLINE bool igl::qslim(
   const Eigen::MatrixXd & V,
@@ -29,92 +151,18 @@ IGL_INLINE bool igl::qslim(
   Eigen::VectorXi & J,
   Eigen::VectorXi & I)
 {
-  using namespace igl;
-
-  // Original number of faces
-  const int orig_m = F.rows();
-  // Tracking number of faces
-  int m = F.rows();
-  typedef Eigen::MatrixXd DerivedV;
-  typedef Eigen::MatrixXi DerivedF;
-  DerivedV VO;
-  DerivedF FO;
-  igl::connect_boundary_to_infinity(V,F,VO,FO);
-  // decimate will not work correctly on non-edge-manifold meshes. By extension
-  // this includes meshes with non-manifold vertices on the boundary since these
-  // will create a non-manifold edge when connected to infinity.
-  if(!is_edge_manifold(FO))
-  {
-    return false;
-  }
-  Eigen::VectorXi EMAP;
-  Eigen::MatrixXi E,EF,EI;
-  edge_flaps(FO,E,EMAP,EF,EI);
-  // Quadrics per vertex
-  typedef std::tuple<Eigen::MatrixXd,Eigen::RowVectorXd,double> Quadric;
-  std::vector<Quadric> quadrics;
-  per_vertex_point_to_plane_quadrics(VO,FO,EMAP,EF,EI,quadrics);
-  // State variables keeping track of edge we just collapsed
-  int v1 = -1;
-  int v2 = -1;
-  // Callbacks for computing and updating metric
-  std::function<void(
-    const int e,
-    const Eigen::MatrixXd &,
-    const Eigen::MatrixXi &,
-    const Eigen::MatrixXi &,
-    const Eigen::VectorXi &,
-    const Eigen::MatrixXi &,
-    const Eigen::MatrixXi &,
-    double &,
-    Eigen::RowVectorXd &)> cost_and_placement;
-  std::function<bool(
-    const Eigen::MatrixXd &                                         ,/*V*/
-    const Eigen::MatrixXi &                                         ,/*F*/
-    const Eigen::MatrixXi &                                         ,/*E*/
-    const Eigen::VectorXi &                                         ,/*EMAP*/
-    const Eigen::MatrixXi &                                         ,/*EF*/
-    const Eigen::MatrixXi &                                         ,/*EI*/
-    const std::set<std::pair<double,int> > &                        ,/*Q*/
-    const std::vector<std::set<std::pair<double,int> >::iterator > &,/*Qit*/
-    const Eigen::MatrixXd &                                         ,/*C*/
-    const int                                                        /*e*/
-    )> pre_collapse;
-  std::function<void(
-    const Eigen::MatrixXd &                                         ,   /*V*/
-    const Eigen::MatrixXi &                                         ,   /*F*/
-    const Eigen::MatrixXi &                                         ,   /*E*/
-    const Eigen::VectorXi &                                         ,/*EMAP*/
-    const Eigen::MatrixXi &                                         ,  /*EF*/
-    const Eigen::MatrixXi &                                         ,  /*EI*/
-    const std::set<std::pair<double,int> > &                        ,   /*Q*/
-    const std::vector<std::set<std::pair<double,int> >::iterator > &, /*Qit*/
-    const Eigen::MatrixXd &                                         ,   /*C*/
-    const int                                                       ,   /*e*/
-    const int                                                       ,  /*e1*/
-    const int                                                       ,  /*e2*/
-    const int                                                       ,  /*f1*/
-    const int                                                       ,  /*f2*/
-    const bool                                                  /*collapsed*/
-    )> post_collapse;
-  qslim_optimal_collapse_edge_callbacks(
-    E,quadrics,v1,v2, cost_and_placement, pre_collapse,post_collapse);
-  // Call to greedy decimator
-  bool ret = decimate(
-    VO, FO,
-    cost_and_placement,
-    max_faces_stopping_condition(m,orig_m,max_m),
-    pre_collapse,
-    post_collapse,
-    E, EMAP, EF, EI,
-    U, G, J, I);
-  // Remove phony boundary faces and clean up
-  const Eigen::Array<bool,Eigen::Dynamic,1> keep = (J.array()<orig_m);
-  igl::slice_mask(Eigen::MatrixXi(G),keep,1,G);
-  igl::slice_mask(Eigen::VectorXi(J),keep,1,J);
-  Eigen::VectorXi _1,I2;
-  igl::remove_unreferenced(Eigen::MatrixXd(U),Eigen::MatrixXi(G),U,G,_1,I2);
-  igl::slice(Eigen::VectorXi(I),I2,1,I);
+  return qslim_decimate(V,F,max_m,U,G,J,I,nullptr);
+}
 
-  return ret;
+IGL_INLINE bool igl::qslim(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const size_t max_m,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I,
+  std::vector<VertexSplit> & splits)
+{
+  return qslim_decimate(V,F,max_m,U,G,J,I,&splits);
 }
@@ -8,7 +8,9 @@
 #ifndef IGL_QSLIM_H
 #define IGL_QSLIM_H
 #include "igl_inline.h"
+#include "VertexSplit.h"
 #include <Eigen/Core>
+#include <vector>
 namespace igl
 {
 
@@ -38,6 +40,19 @@ namespace igl
     Eigen::MatrixXi & G,
     Eigen::VectorXi & J,
     Eigen::VectorXi & I);
+  // Outputs:
+  //   splits  #V-#U list of vertex splits undoing the collapses in reverse
+  //     order, refining (U,G) back to (V,F) (see decimate and
+  //     progressive_mesh_refine)
+  IGL_INLINE bool qslim(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const size_t max_m,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I,
+    std::vector<VertexSplit> & splits);
 }
 #ifndef IGL_STATIC_LIBRARY
 #  include "qslim.cpp"
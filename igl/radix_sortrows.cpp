@@ -0,0 +1,199 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "radix_sortrows.h"
+#include "parallel_for.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+  // Maps a scalar to an unsigned integer key with the same order
+  template <
+    typename Scalar,
+    bool integral =
+      std::is_integral<Scalar>::value && !std::is_same<Scalar,bool>::value,
+    bool floating = std::is_floating_point<Scalar>::value>
+  struct radix_sortrows_key
+  {
+    static const bool supported = false;
+    typedef std::uint32_t Key;
+    static Key key(const Scalar &){ return 0; }
+  };
+  template <typename Scalar>
+  struct radix_sortrows_key<Scalar,true,false>
+  {
+    static const bool supported = true;
+    typedef typename std::conditional<
+      sizeof(Scalar) <= 4,std::uint32_t,std::uint64_t>::type Key;
+    static Key key(const Scalar & x)
+    {
+      typedef typename std::make_unsigned<Scalar>::type Unsigned;
+      // Flipping the sign bit orders two's complement values as unsigned
+      const Key sign = std::is_signed<Scalar>::value ?
+        Key(1) << (8*sizeof(Scalar)-1) : Key(0);
+      return Key(Unsigned(x)) ^ sign;
+    }
+  };
+  template <typename Scalar>
+  struct radix_sortrows_key<Scalar,false,true>
+  {
+    static const bool supported = sizeof(Scalar) == 4 || sizeof(Scalar) == 8;
+    typedef typename std::conditional<
+      sizeof(Scalar) <= 4,std::uint32_t,std::uint64_t>::type Key;
+    static Key key(Scalar x)
+    {
+      // -0 == 0
+      if(x == Scalar(0))
+      {
+        x = Scalar(0);
+      }
+      Key bits = 0;
+      std::memcpy(&bits,&x,std::min(sizeof(Key),sizeof(Scalar)));
+      // Negative values are ordered backwards and before positive ones
+      const Key sign = Key(1) << (8*sizeof(Key)-1);
+      return (bits & sign) ? ~bits : (bits | sign);
+    }
+  };
+}
+
+template <typename DerivedX, typename DerivedI>
+IGL_INLINE bool igl::radix_sortrows(
+  const Eigen::DenseBase<DerivedX>& X,
+  const bool ascending,
+  Eigen::PlainObjectBase<DerivedI>& I)
+{
+  typedef typename DerivedX::Scalar Scalar;
+  typedef radix_sortrows_key<Scalar> KeyMap;
+  typedef typename KeyMap::Key Key;
+  if(!KeyMap::supported)
+  {
+    return false;
+  }
+  const int num_rows = X.rows();
+  const int num_cols = X.cols();
+  const int num_bytes = sizeof(Key);
+  // Descending order is ascending order of the complemented keys
+  const Key flip = ascending ? Key(0) : ~Key(0);
+  // Each pass is a stable counting sort of (key,index) pairs over contiguous
+  // chunks which have their own histograms
+  const int num_chunks = num_rows < 100000 ? 1 :
+    std::max(1,std::min(16,(int)std::thread::hardware_concurrency()));
+  const auto chunk_begin = [num_rows,num_chunks](const int c)
+  {
+    return int((long long)num_rows*c/num_chunks);
+  };
+  std::vector<int> index(num_rows),next_index(num_rows);
+  std::vector<Key> key(num_rows),next_key(num_rows);
+  std::vector<int> count(256*num_chunks);
+  for(int i = 0;i<num_rows;i++)
+  {
+    index[i] = i;
+  }
+  for(int j = num_cols-1;j>=0;j--)
+  {
+    // Keys of column j in the current order
+    igl::parallel_for(num_rows,[&](const int i)
+    {
+      key[i] = KeyMap::key(X.coeff(index[i],j)) ^ flip;
+    },10000);
+    for(int b = 0;b<num_bytes;b++)
+    {
+      const int shift = 8*b;
+      std::fill(count.begin(),count.end(),0);
+      igl::parallel_for(num_chunks,[&](const int c)
+      {
+        int * chunk_count = count.data() + 256*c;
+        for(int i = chunk_begin(c),end = chunk_begin(c+1);i<end;i++)
+        {
+          chunk_count[(key[i] >> shift) & 0xFF]++;
+        }
+      },2);
+      // Skip bytes shared by all keys, e.g. the high bytes of indices
+      bool trivial = false;
+      for(int d = 0;d<256 && !trivial;d++)
+      {
+        int total = 0;
+        for(int c = 0;c<num_chunks;c++)
+        {
+          total += count[256*c+d];
+        }
+        trivial = total == num_rows;
+      }
+      if(trivial)
+      {
+        continue;
+      }
+      // Counts become the position where each chunk writes each digit
+      int k = 0;
+      for(int d = 0;d<256;d++)
+      {
+        for(int c = 0;c<num_chunks;c++)
+        {
+          const int n = count[256*c+d];
+          count[256*c+d] = k;
+          k += n;
+        }
+      }
+      igl::parallel_for(num_chunks,[&](const int c)
+      {
+        int * chunk_next = count.data() + 256*c;
+        for(int i = chunk_begin(c),end = chunk_begin(c+1);i<end;i++)
+        {
+          const int p = chunk_next[(key[i] >> shift) & 0xFF]++;
+          next_key[p] = key[i];
+          next_index[p] = index[i];
+        }
+      },2);
+      key.swap(next_key);
+      index.swap(next_index);
+    }
+  }
+  I.resize(num_rows,1);
+  for(int i = 0;i<num_rows;i++)
+  {
+    I(i) = index[i];
+  }
+  return true;
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template bool igl::radix_sortrows<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<double, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<double, -1, 2, 0, -1, 2> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<long, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::DenseBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<long, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<double, -1, -1, 1, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<double, -1, -1, 1, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<float, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, 12, 4, 0, 12, 4>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, 12, 4, 0, 12, 4> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, 12, 4, 0, 12, 4>, Eigen::Matrix<long, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, 12, 4, 0, 12, 4> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, 12, 4, 0, 12, 4>, Eigen::Matrix<long long, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, 12, 4, 0, 12, 4> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<long long, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, 2, 0, -1, 2> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, -1, 2, 0, -1, 2>, Eigen::Matrix<long, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, 2, 0, -1, 2> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, -1, 4, 0, -1, 4>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, 4, 0, -1, 4> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, -1, 4, 0, -1, 4>, Eigen::Matrix<long, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, 4, 0, -1, 4> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, -1, 4, 0, -1, 4>, Eigen::Matrix<long long, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, 4, 0, -1, 4> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<long long, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<unsigned int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<unsigned int, -1, 1, 0, -1, 1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template bool igl::radix_sortrows<Eigen::Matrix<long, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+#endif
@@ -0,0 +1,45 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_RADIX_SORTROWS_H
+#define IGL_RADIX_SORTROWS_H
+#include "igl_inline.h"
+
+#include <Eigen/Core>
+namespace igl
+{
+  // Stable sort of the rows of X in lexicographic order with a least
+  // significant digit radix sort: one counting sort per byte of each column,
+  // last column first, skipping the bytes that are the same for all rows. The
+  // passes are split into contiguous chunks which are counted and scattered
+  // in parallel.
+  //
+  // Only integer and floating point scalars have radix keys, other scalars
+  // are left to comparison sorts (see sortrows). Floating point -0 and 0 are
+  // equal, NaNs end up before -inf or after +inf depending on their sign bit.
+  //
+  // Inputs:
+  //   X  m by n matrix whose rows are to be sorted
+  //   ascending  sort ascending (true) or descending (false), equal rows
+  //     keep their order either way
+  // Outputs:
+  //   I  m list of indices so that X(I,:) is sorted
+  // Returns false and leaves I untouched if X's scalar type is not supported
+  //
+  // See also: sortrows, sort
+  template <typename DerivedX, typename DerivedI>
+  IGL_INLINE bool radix_sortrows(
+    const Eigen::DenseBase<DerivedX>& X,
+    const bool ascending,
+    Eigen::PlainObjectBase<DerivedI>& I);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "radix_sortrows.cpp"
+#endif
+
+#endif
@@ -8,7 +8,125 @@
 #include "readPLY.h"
 #include "list_to_matrix.h"
 #include "ply.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <sstream>
+
+namespace
+{
+  // Scalar types of the .ply format
+  enum PLYStreamType
+  {
+    PLY_STREAM_INT8 = 0,
+    PLY_STREAM_UINT8,
+    PLY_STREAM_INT16,
+    PLY_STREAM_UINT16,
+    PLY_STREAM_INT32,
+    PLY_STREAM_UINT32,
+    PLY_STREAM_FLOAT32,
+    PLY_STREAM_FLOAT64,
+    PLY_STREAM_UNKNOWN
+  };
+
+  inline PLYStreamType ply_stream_type(const std::string & name)
+  {
+    if(name == "char" || name == "int8") return PLY_STREAM_INT8;
+    if(name == "uchar" || name == "uint8") return PLY_STREAM_UINT8;
+    if(name == "short" || name == "int16") return PLY_STREAM_INT16;
+    if(name == "ushort" || name == "uint16") return PLY_STREAM_UINT16;
+    if(name == "int" || name == "int32") return PLY_STREAM_INT32;
+    if(name == "uint" || name == "uint32") return PLY_STREAM_UINT32;
+    if(name == "float" || name == "float32") return PLY_STREAM_FLOAT32;
+    if(name == "double" || name == "float64") return PLY_STREAM_FLOAT64;
+    return PLY_STREAM_UNKNOWN;
+  }
+
+  struct PLYStreamProperty
+  {
+    std::string name;
+    PLYStreamType type;
+    // For list properties, type of the number of items
+    bool is_list;
+    PLYStreamType count_type;
+  };
+
+  struct PLYStreamElement
+  {
+    std::string name;
+    size_t count;
+    std::vector<PLYStreamProperty> properties;
+  };
+
+  // Reads the values of a binary .ply body through a fixed size buffer
+  class PLYStreamReader
+  {
+  public:
+    PLYStreamReader(FILE * file, const bool swap_bytes):
+      file(file),swap_bytes(swap_bytes),buffer(1<<16),pos(0),end(0)
+    {}
+    bool read(const PLYStreamType type, double & value)
+    {
+      static const size_t sizes[] = {1,1,2,2,4,4,4,8};
+      const size_t size = sizes[type];
+      if(end-pos < size && !refill(size))
+      {
+        return false;
+      }
+      unsigned char bytes[8];
+      std::memcpy(bytes,buffer.data()+pos,size);
+      pos += size;
+      if(swap_bytes)
+      {
+        std::reverse(bytes,bytes+size);
+      }
+      switch(type)
+      {
+        case PLY_STREAM_INT8: value = as<signed char>(bytes); break;
+        case PLY_STREAM_UINT8: value = as<unsigned char>(bytes); break;
+        case PLY_STREAM_INT16: value = as<short>(bytes); break;
+        case PLY_STREAM_UINT16: value = as<unsigned short>(bytes); break;
+        case PLY_STREAM_INT32: value = as<int>(bytes); break;
+        case PLY_STREAM_UINT32: value = as<unsigned int>(bytes); break;
+        case PLY_STREAM_FLOAT32: value = as<float>(bytes); break;
+        case PLY_STREAM_FLOAT64: value = as<double>(bytes); break;
+        default: return false;
+      }
+      return true;
+    }
+  private:
+    template <typename T>
+    static T as(const unsigned char * bytes)
+    {
+      T t;
+      std::memcpy(&t,bytes,sizeof(T));
+      return t;
+    }
+    // Move the unread bytes to the front and fill up the rest, returns
+    // whether at least size bytes are available
+    bool refill(const size_t size)
+    {
+      std::memmove(buffer.data(),buffer.data()+pos,end-pos);
+      end -= pos;
+      pos = 0;
+      end += fread(buffer.data()+end,1,buffer.size()-end,file);
+      return end >= size;
+    }
+    FILE * file;
+    bool swap_bytes;
+    std::vector<char> buffer;
+    size_t pos;
+    size_t end;
+  };
+
+  template <typename Derived>
+  inline void ply_stream_clear(Eigen::PlainObjectBase<Derived> & M)
+  {
+    M.resize(0,Derived::ColsAtCompileTime == Eigen::Dynamic ?
+      0 : int(Derived::ColsAtCompileTime));
+  }
+}
 
 template <
   typename Vtype,
@@ -186,19 +304,236 @@ IGL_INLINE bool igl::readPLY(
   Eigen::PlainObjectBase<DerivedN> & N,
   Eigen::PlainObjectBase<DerivedUV> & UV)
 {
-  std::vector<std::vector<typename DerivedV::Scalar> > vV;
-  std::vector<std::vector<typename DerivedF::Scalar> > vF;
-  std::vector<std::vector<typename DerivedN::Scalar> > vN;
-  std::vector<std::vector<typename DerivedUV::Scalar> > vUV;
-  if(!readPLY(filename,vV,vF,vN,vUV))
+  FILE * ply_file = fopen(filename.c_str(),"rb");
+  if(ply_file == NULL)
+  {
+    return false;
+  }
+  return readPLY(ply_file,V,F,N,UV);
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedN,
+  typename DerivedUV>
+IGL_INLINE bool igl::readPLY(
+  FILE * ply_file,
+  Eigen::PlainObjectBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedF> & F,
+  Eigen::PlainObjectBase<DerivedN> & N,
+  Eigen::PlainObjectBase<DerivedUV> & UV)
+{
+  using namespace std;
+  // Parse the header
+  string format;
+  vector<PLYStreamElement> elements;
+  bool supported = true;
+  {
+    char line[4096];
+    bool first = true;
+    while(true)
+    {
+      if(fgets(line,sizeof(line),ply_file) == NULL)
+      {
+        fclose(ply_file);
+        return false;
+      }
+      istringstream words(line);
+      string keyword;
+      words >> keyword;
+      if(first)
+      {
+        if(keyword != "ply")
+        {
+          fclose(ply_file);
+          return false;
+        }
+        first = false;
+      }else if(keyword == "format")
+      {
+        words >> format;
+      }else if(keyword == "element")
+      {
+        PLYStreamElement element;
+        words >> element.name >> element.count;
+        elements.push_back(element);
+      }else if(keyword == "property")
+      {
+        if(elements.empty())
+        {
+          supported = false;
+          continue;
+        }
+        PLYStreamProperty property;
+        string type;
+        words >> type;
+        property.is_list = type == "list";
+        if(property.is_list)
+        {
+          string count_type;
+          words >> count_type >> type;
+          property.count_type = ply_stream_type(count_type);
+          supported &= property.count_type != PLY_STREAM_UNKNOWN &&
+            property.count_type != PLY_STREAM_FLOAT32 &&
+            property.count_type != PLY_STREAM_FLOAT64;
+        }
+        property.type = ply_stream_type(type);
+        supported &= property.type != PLY_STREAM_UNKNOWN;
+        words >> property.name;
+        elements.back().properties.push_back(property);
+      }else if(keyword == "end_header")
+      {
+        break;
+      }
+    }
+  }
+  const bool little_endian_host = []()
+  {
+    const unsigned int one = 1;
+    return *reinterpret_cast<const unsigned char*>(&one) == 1;
+  }();
+  if(format != "binary_little_endian" && format != "binary_big_endian")
+  {
+    supported = false;
+  }
+  if(!supported)
+  {
+    // ascii or unusual files go through the list version
+    fseek(ply_file,0,SEEK_SET);
+    vector<vector<typename DerivedV::Scalar> > vV;
+    vector<vector<typename DerivedF::Scalar> > vF;
+    vector<vector<typename DerivedN::Scalar> > vN;
+    vector<vector<typename DerivedUV::Scalar> > vUV;
+    if(!readPLY(ply_file,vV,vF,vN,vUV))
+    {
+      return false;
+    }
+    return 
+      list_to_matrix(vV,V) &&
+      list_to_matrix(vF,F) &&
+      list_to_matrix(vN,N) &&
+      list_to_matrix(vUV,UV);
+  }
+
+  PLYStreamReader reader(ply_file,
+    (format == "binary_little_endian") != little_endian_host);
+  ply_stream_clear(V);
+  ply_stream_clear(F);
+  ply_stream_clear(N);
+  ply_stream_clear(UV);
+  const auto fail = [&ply_file]()
   {
+    cerr<<"IOError: bad binary ply body."<<endl;
+    fclose(ply_file);
     return false;
+  };
+  for(const PLYStreamElement & element : elements)
+  {
+    const bool is_vertex = element.name == "vertex";
+    const bool is_face = element.name == "face";
+    const int num_props = element.properties.size();
+    // Where each property goes: 0-2 position, 3-5 normal, 6-7 texture
+    // coordinates, 8 face indices, -1 nowhere
+    vector<int> slot(num_props,-1);
+    bool has_normals = false;
+    bool has_texture_coords = false;
+    for(int p = 0;p<num_props;p++)
+    {
+      const PLYStreamProperty & property = element.properties[p];
+      if(is_vertex && !property.is_list)
+      {
+        static const char * names[] = {"x","y","z","nx","ny","nz","s","t"};
+        for(int n = 0;n<8;n++)
+        {
+          if(property.name == names[n])
+          {
+            slot[p] = n;
+            has_normals |= n >= 3 && n < 6;
+            has_texture_coords |= n >= 6;
+          }
+        }
+      }else if(is_face && property.is_list &&
+        (property.name == "vertex_indices" || property.name == "vertex_index"))
+      {
+        slot[p] = 8;
+      }
+    }
+    if(is_vertex)
+    {
+      V.setZero(element.count,3);
+      if(has_normals)
+      {
+        N.setZero(element.count,3);
+      }
+      if(has_texture_coords)
+      {
+        UV.setZero(element.count,2);
+      }
+    }
+    int face_size = -1;
+    for(size_t e = 0;e<element.count;e++)
+    {
+      for(int p = 0;p<num_props;p++)
+      {
+        const PLYStreamProperty & property = element.properties[p];
+        double value;
+        if(!property.is_list)
+        {
+          if(!reader.read(property.type,value))
+          {
+            return fail();
+          }
+          switch(slot[p])
+          {
+            case 0: case 1: case 2:
+              V(e,slot[p]) = typename DerivedV::Scalar(value);
+              break;
+            case 3: case 4: case 5:
+              N(e,slot[p]-3) = typename DerivedN::Scalar(value);
+              break;
+            case 6: case 7:
+              UV(e,slot[p]-6) = typename DerivedUV::Scalar(value);
+              break;
+            default:
+              break;
+          }
+          continue;
+        }
+        double count;
+        if(!reader.read(property.count_type,count))
+        {
+          return fail();
+        }
+        if(slot[p] == 8)
+        {
+          if(face_size < 0)
+          {
+            face_size = int(count);
+            F.resize(element.count,face_size);
+          }else if(face_size != int(count))
+          {
+            cerr<<"IOError: faces of different sizes."<<endl;
+            fclose(ply_file);
+            return false;
+          }
+        }
+        for(int c = 0;c<int(count);c++)
+        {
+          if(!reader.read(property.type,value))
+          {
+            return fail();
+          }
+          if(slot[p] == 8)
+          {
+            F(e,c) = typename DerivedF::Scalar(value);
+          }
+        }
+      }
+    }
   }
-  return 
-    list_to_matrix(vV,V) &&
-    list_to_matrix(vF,F) &&
-    list_to_matrix(vN,N) &&
-    list_to_matrix(vUV,UV);
+  fclose(ply_file);
+  return true;
 }
 
 template <
@@ -62,6 +62,25 @@ namespace igl
     Eigen::PlainObjectBase<DerivedF> & F,
     Eigen::PlainObjectBase<DerivedN> & N,
     Eigen::PlainObjectBase<DerivedUV> & UV);
+  // Binary files are streamed in chunks straight into V, F, N and UV
+  // without intermediate lists, other files are read through the list
+  // version. F must have a fixed number of vertices per face.
+  //
+  // Inputs:
+  //   ply_file  pointer to already opened .ply file (opened with "rb")
+  // Outputs:
+  //   ply_file  closed file
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedN,
+    typename DerivedUV>
+  IGL_INLINE bool readPLY(
+    FILE * ply_file,
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DerivedN> & N,
+    Eigen::PlainObjectBase<DerivedUV> & UV);
   template <
     typename DerivedV,
     typename DerivedF>
@@ -0,0 +1,45 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "readPM.h"
+#include "ProgressiveMeshReader.h"
+#include <cstdio>
+
+IGL_INLINE bool igl::readPM(
+  const std::string & filename,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  std::vector<VertexSplit> & splits)
+{
+  FILE * fp = fopen(filename.c_str(),"rb");
+  if(NULL == fp)
+  {
+    fprintf(stderr,"IOError: readPM() could not open %s\n",filename.c_str());
+    return false;
+  }
+  ProgressiveMeshReader reader;
+  std::vector<char> chunk(1<<16);
+  size_t size;
+  while(!reader.done() && (size = fread(chunk.data(),1,chunk.size(),fp)) > 0)
+  {
+    if(!reader.push(chunk.data(),size))
+    {
+      break;
+    }
+  }
+  fclose(fp);
+  if(!reader.done())
+  {
+    fprintf(stderr,"Error: readPM() %s is %s\n",filename.c_str(),
+      reader.failed() ? "malformed" : "truncated");
+    return false;
+  }
+  U = reader.base_vertices();
+  G = reader.base_faces();
+  splits = reader.splits();
+  return true;
+}
@@ -0,0 +1,42 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_READPM_H
+#define IGL_READPM_H
+#include "igl_inline.h"
+#include "VertexSplit.h"
+#include <Eigen/Core>
+#include <string>
+#include <vector>
+
+namespace igl
+{
+  // Read a whole progressive mesh from a .pm file written by writePM. To
+  // start using the mesh before the file is complete use
+  // ProgressiveMeshReader instead.
+  //
+  // Inputs:
+  //   filename  path to .pm file
+  // Outputs:
+  //   U  #U by dim list of base vertex positions
+  //   G  #G by 3 list of base face indices into U
+  //   splits  list of vertex splits refining (U,G)
+  // Returns true on success, false on errors
+  //
+  // See also: writePM, progressive_mesh_refine
+  IGL_INLINE bool readPM(
+    const std::string & filename,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    std::vector<VertexSplit> & splits);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "readPM.cpp"
+#endif
+
+#endif
@@ -8,7 +8,72 @@
 #include "readSTL.h"
 #include "list_to_matrix.h"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <unordered_set>
+
+namespace
+{
+  // Unique vertex positions, merged by exact value with a hash set of
+  // indices into the positions themselves
+  template <typename T>
+  class STLVertexMerger
+  {
+  public:
+    STLVertexMerger():
+      unique(0,Hash(positions),Equal(positions))
+    {}
+    // Index of the vertex at p, adding it if it's new
+    int insert(const T * p)
+    {
+      const int id = positions.size()/3;
+      for(int d = 0;d<3;d++)
+      {
+        // +0 turns -0 into 0
+        positions.push_back(p[d]+T(0));
+      }
+      const auto found = unique.insert(id);
+      if(!found.second)
+      {
+        positions.resize(positions.size()-3);
+      }
+      return *found.first;
+    }
+    std::vector<T> positions;
+  private:
+    struct Hash
+    {
+      const std::vector<T> & P;
+      Hash(const std::vector<T> & P):P(P){}
+      size_t operator()(const int i) const
+      {
+        // FNV-1a over the bytes of the position
+        const unsigned char * b =
+          reinterpret_cast<const unsigned char*>(P.data()+3*size_t(i));
+        size_t h = 14695981039346656037ULL;
+        for(size_t k = 0;k<3*sizeof(T);k++)
+        {
+          h = (h ^ b[k]) * 1099511628211ULL;
+        }
+        return h;
+      }
+    };
+    struct Equal
+    {
+      const std::vector<T> & P;
+      Equal(const std::vector<T> & P):P(P){}
+      bool operator()(const int i, const int j) const
+      {
+        return std::memcmp(
+          P.data()+3*size_t(i),P.data()+3*size_t(j),3*sizeof(T)) == 0;
+      }
+    };
+    std::unordered_set<int,Hash,Equal> unique;
+  };
+}
+
 template <typename DerivedV, typename DerivedF, typename DerivedN>
 IGL_INLINE bool igl::readSTL(
   const std::string & filename,
@@ -16,28 +81,157 @@ IGL_INLINE bool igl::readSTL(
   Eigen::PlainObjectBase<DerivedF> & F,
   Eigen::PlainObjectBase<DerivedN> & N)
 {
-  using namespace std;
-  vector<vector<typename DerivedV::Scalar> > vV;
-  vector<vector<typename DerivedN::Scalar> > vN;
-  vector<vector<typename DerivedF::Scalar> > vF;
-  if(!readSTL(filename,vV,vF,vN))
+  return readSTL(filename,V,F,N,false);
+}
+
+template <typename DerivedV, typename DerivedF, typename DerivedN>
+IGL_INLINE bool igl::readSTL(
+  const std::string & filename,
+  Eigen::PlainObjectBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedF> & F,
+  Eigen::PlainObjectBase<DerivedN> & N,
+  const bool merge_duplicates)
+{
+  FILE * stl_file = fopen(filename.c_str(),"rb");
+  if(NULL==stl_file)
   {
+    fprintf(stderr,"IOError: %s could not be opened...\n",
+            filename.c_str());
     return false;
   }
+  return readSTL(stl_file,V,F,N,merge_duplicates);
+}
 
-  if(!list_to_matrix(vV,V))
+template <typename DerivedV, typename DerivedF, typename DerivedN>
+IGL_INLINE bool igl::readSTL(
+  FILE * stl_file, 
+  Eigen::PlainObjectBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedF> & F,
+  Eigen::PlainObjectBase<DerivedN> & N,
+  const bool merge_duplicates)
+{
+  using namespace std;
+  typedef typename DerivedV::Scalar VScalar;
+  if(NULL==stl_file)
   {
+    fprintf(stderr,"IOError: stl file could not be reopened as binary (1) ...\n");
     return false;
   }
-
-  if(!list_to_matrix(vF,F))
+  // Same test for binary files as the list version
+  char header[81] = "";
+  char solid[81] = "";
+  unsigned int num_tri = 0;
+  bool is_ascii = true;
+  if(fread(header,1,80,stl_file) != 80 ||
+    fread(&num_tri,sizeof(unsigned int),1,stl_file) != 1)
   {
+    cerr<<"IOError: too short (1)."<<endl;
+    fclose(stl_file);
     return false;
   }
+  sscanf(header,"%80s",solid);
+  if(string("solid") != solid)
+  {
+    is_ascii = false;
+  }else
+  {
+    fseek(stl_file,0,SEEK_END);
+    const long file_size = ftell(stl_file);
+    is_ascii = file_size != long(80 + 4 + (4*12 + 2) * size_t(num_tri));
+    fseek(stl_file,80+4,SEEK_SET);
+  }
 
-  if(!list_to_matrix(vN,N))
+  if(is_ascii)
   {
-    return false;
+    fseek(stl_file,0,SEEK_SET);
+    vector<vector<VScalar> > vV;
+    vector<vector<typename DerivedN::Scalar> > vN;
+    vector<vector<typename DerivedF::Scalar> > vF;
+    if(!readSTL(stl_file,vV,vF,vN) ||
+      !list_to_matrix(vN,N) ||
+      !list_to_matrix(vF,F))
+    {
+      return false;
+    }
+    if(!merge_duplicates)
+    {
+      return list_to_matrix(vV,V);
+    }
+    STLVertexMerger<VScalar> merger;
+    vector<int> J(vV.size());
+    for(size_t v = 0;v<vV.size();v++)
+    {
+      J[v] = merger.insert(vV[v].data());
+    }
+    for(int f = 0;f<F.size();f++)
+    {
+      F.data()[f] = J[F.data()[f]];
+    }
+    V.resize(merger.positions.size()/3,3);
+    for(int v = 0;v<V.rows();v++)
+    {
+      for(int d = 0;d<3;d++)
+      {
+        V(v,d) = merger.positions[3*v+d];
+      }
+    }
+    return true;
+  }
+
+  // Binary: 50 byte records of normal, 3 corners and attribute count, read a
+  // chunk at a time
+  const size_t record_size = 4*12 + 2;
+  const size_t chunk_size = 4096;
+  vector<char> chunk(record_size*chunk_size);
+  STLVertexMerger<float> merger;
+  F.resize(num_tri,3);
+  N.resize(num_tri,3);
+  if(!merge_duplicates)
+  {
+    V.resize(3*size_t(num_tri),3);
+  }
+  for(size_t t0 = 0;t0<num_tri;t0+=chunk_size)
+  {
+    const size_t k = std::min(chunk_size,size_t(num_tri)-t0);
+    if(fread(chunk.data(),record_size,k,stl_file) != k)
+    {
+      cerr<<"IOError: bad format (8)."<<endl;
+      fclose(stl_file);
+      return false;
+    }
+    for(size_t r = 0;r<k;r++)
+    {
+      const size_t t = t0+r;
+      float record[12];
+      memcpy(record,chunk.data()+r*record_size,sizeof(record));
+      for(int c = 0;c<3;c++)
+      {
+        N(t,c) = record[c];
+        const float * v = record+3*(c+1);
+        if(merge_duplicates)
+        {
+          F(t,c) = merger.insert(v);
+        }else
+        {
+          F(t,c) = 3*t+c;
+          V(3*t+c,0) = v[0];
+          V(3*t+c,1) = v[1];
+          V(3*t+c,2) = v[2];
+        }
+      }
+    }
+  }
+  fclose(stl_file);
+  if(merge_duplicates)
+  {
+    V.resize(merger.positions.size()/3,3);
+    for(int v = 0;v<V.rows();v++)
+    {
+      for(int d = 0;d<3;d++)
+      {
+        V(v,d) = merger.positions[3*v+d];
+      }
+    }
   }
   return true;
 }
@@ -286,5 +480,6 @@ template bool igl::readSTL<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix
 // generated by autoexplicit.sh
 template bool igl::readSTL<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template bool igl::readSTL<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
+template bool igl::readSTL<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, bool);
 template bool igl::readSTL<Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 #endif
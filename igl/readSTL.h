@@ -42,6 +42,35 @@ namespace igl
     Eigen::PlainObjectBase<DerivedV> & V,
     Eigen::PlainObjectBase<DerivedF> & F,
     Eigen::PlainObjectBase<DerivedN> & N);
+  // Binary files are read in chunks straight into V, F and N. With
+  // merge_duplicates, corners with exactly the same position share a vertex,
+  // found with a hash map while reading (vertices are numbered in order of
+  // first appearance), so large scans load in one pass without the 3*#F
+  // vertex intermediate.
+  //
+  // Inputs:
+  //   merge_duplicates  whether to merge vertices with identical positions
+  //
+  // Example:
+  //   bool success = readSTL(filename,V,F,N,true);
+  template <typename DerivedV, typename DerivedF, typename DerivedN>
+  IGL_INLINE bool readSTL(
+    const std::string & filename,
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DerivedN> & N,
+    const bool merge_duplicates);
+  // Inputs:
+  //   stl_file  pointer to already opened .stl file 
+  // Outputs:
+  //   stl_file  closed file
+  template <typename DerivedV, typename DerivedF, typename DerivedN>
+  IGL_INLINE bool readSTL(
+    FILE * stl_file, 
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DerivedN> & N,
+    const bool merge_duplicates = false);
   // Inputs:
   //   stl_file  pointer to already opened .stl file 
   // Outputs:
@@ -11,6 +11,7 @@
 #include "igl_inline.h"
 #include "AABB.h"
 #include "WindingNumberAABB.h"
+#include "FastWindingNumber.h"
 #include <Eigen/Core>
 #include <vector>
 namespace igl
@@ -221,6 +222,29 @@ namespace igl
     Scalar & sqrd,
     int & i,
     Eigen::PlainObjectBase<Derivedc> & c);
+  // Sign from a prebuilt fast winding number hierarchy, which may be shared
+  // by concurrent callers
+  //
+  // Inputs:
+  //   fwn  fast winding number hierarchy built for (V,F)
+  // Outputs:
+  //   s  sign, -1 where the winding number exceeds 0.5
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename Derivedq,
+    typename Scalar,
+    typename Derivedc>
+  IGL_INLINE void signed_distance_winding_number(
+    const AABB<DerivedV,3> & tree,
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const igl::FastWindingNumber & fwn,
+    const Eigen::MatrixBase<Derivedq> & q,
+    Scalar & s,
+    Scalar & sqrd,
+    int & i,
+    Eigen::PlainObjectBase<Derivedc> & c);
   template <
     typename DerivedV,
     typename DerivedF,
@@ -32,7 +32,7 @@ IGL_INLINE void igl::slice_cached_precompute(
   igl::slice(TS,R,C,TS_sliced);
   Y = TS_sliced.cast<TY>();
 
-  data.resize(TS_sliced.nonZeros());
+  data.derived().resize(TS_sliced.nonZeros());
   for (unsigned i=0;i<data.size();++i)
   {
     data[i] = *(TS_sliced.valuePtr() + i);
@@ -0,0 +1,124 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "slice_mask_vertex_splits.h"
+#include <cassert>
+
+IGL_INLINE void igl::slice_mask_vertex_splits(
+  const Eigen::Array<bool,Eigen::Dynamic,1> & keep,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I,
+  std::vector<VertexSplit> & splits)
+{
+  const int nb = U.rows();
+  // Old to new face indices, -1 for removed faces, over the base faces
+  // followed by the faces appended by each split
+  std::vector<int> fmap;
+  fmap.reserve(G.rows() + 2*splits.size());
+  int m = 0;
+  for(int g = 0;g<G.rows();g++)
+  {
+    if(keep(J(g)))
+    {
+      G.row(m) = G.row(g);
+      J(m) = J(g);
+      fmap.push_back(m++);
+    }else
+    {
+      fmap.push_back(-1);
+    }
+  }
+  G.conservativeResize(m,G.cols());
+  J.conservativeResize(m);
+
+  // Base vertices referenced by a kept face
+  std::vector<int> vmap(nb,-1);
+  const auto mark = [&](const Eigen::MatrixXi & X, const int r)
+  {
+    for(int c = 0;c<X.cols();c++)
+    {
+      if(X(r,c) < nb)
+      {
+        vmap[X(r,c)] = 0;
+      }
+    }
+  };
+  for(int g = 0;g<G.rows();g++)
+  {
+    mark(G,g);
+  }
+  for(const auto & split : splits)
+  {
+    for(int f = 0;f<split.new_faces.rows();f++)
+    {
+      if(keep(split.new_faces_birth(f)))
+      {
+        mark(split.new_faces,f);
+      }
+    }
+  }
+  int n = 0;
+  for(int u = 0;u<nb;u++)
+  {
+    if(vmap[u] == 0)
+    {
+      vmap[u] = n;
+      U.row(n) = U.row(u);
+      I(n) = I(u);
+      n++;
+    }
+  }
+  U.conservativeResize(n,U.cols());
+  I.conservativeResize(n);
+  for(int g = 0;g<G.rows();g++)
+  {
+    for(int c = 0;c<G.cols();c++)
+    {
+      G(g,c) = vmap[G(g,c)];
+    }
+  }
+
+  for(int k = 0;k<(int)splits.size();k++)
+  {
+    VertexSplit & split = splits[k];
+    // t of this split
+    vmap.push_back(n+k);
+    split.s = vmap[split.s];
+    assert(split.s >= 0 && "Split vertex should be referenced");
+    // Removal preserves order so the kept faces stay sorted
+    int nf = 0;
+    for(const int f : split.faces)
+    {
+      if(fmap[f] >= 0)
+      {
+        split.faces[nf++] = fmap[f];
+      }
+    }
+    split.faces.resize(nf);
+    int nn = 0;
+    for(int f = 0;f<split.new_faces.rows();f++)
+    {
+      if(keep(split.new_faces_birth(f)))
+      {
+        for(int c = 0;c<split.new_faces.cols();c++)
+        {
+          split.new_faces(nn,c) = vmap[split.new_faces(f,c)];
+        }
+        split.new_faces_birth(nn) = split.new_faces_birth(f);
+        nn++;
+        fmap.push_back(m++);
+      }else
+      {
+        fmap.push_back(-1);
+      }
+    }
+    split.new_faces.conservativeResize(nn,split.new_faces.cols());
+    split.new_faces_birth.conservativeResize(nn);
+  }
+}
@@ -0,0 +1,47 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SLICE_MASK_VERTEX_SPLITS_H
+#define IGL_SLICE_MASK_VERTEX_SPLITS_H
+#include "igl_inline.h"
+#include "VertexSplit.h"
+#include <Eigen/Core>
+#include <vector>
+namespace igl
+{
+  // Remove faces from a progressive mesh, a base mesh followed by vertex
+  // splits as output by decimate, along with the base vertices they leave
+  // unreferenced. The faces are selected by birth index, so that the result
+  // is the same as slicing the fully refined mesh. For example, this removes
+  // the faces connecting boundaries to the point at infinity (see
+  // connect_boundary_to_infinity).
+  //
+  // Inputs:
+  //   keep  list of flags over birth face indices (J and
+  //     VertexSplit::new_faces_birth), whether to keep each face
+  //   U  #U by dim list of base vertex positions
+  //   G  #G by 3 list of base face indices into U
+  //   J  #G list of birth face indices
+  //   I  #U list of birth vertex indices
+  //   splits  list of vertex splits refining (U,G)
+  // Outputs:
+  //   U,G,J,I,splits  progressive mesh without the removed faces and vertices
+  //
+  // See also: decimate, slice_mask, remove_unreferenced
+  IGL_INLINE void slice_mask_vertex_splits(
+    const Eigen::Array<bool,Eigen::Dynamic,1> & keep,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I,
+    std::vector<VertexSplit> & splits);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "slice_mask_vertex_splits.cpp"
+#endif
+#endif
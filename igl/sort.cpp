@@ -12,10 +12,12 @@
 #include "IndexComparison.h"
 #include "colon.h"
 #include "parallel_for.h"
+#include "radix_sortrows.h"
 
 #include <cassert>
 #include <algorithm>
 #include <iostream>
+#include <type_traits>
 
 template <typename DerivedX, typename DerivedY, typename DerivedIX>
 IGL_INLINE void igl::sort(
@@ -295,6 +297,42 @@ IGL_INLINE void igl::sort3(
   parallel_for(num_outer,inner,16000);
 }
 
+namespace
+{
+  // Radix sort for vectors of numbers (see radix_sortrows), false otherwise
+  template <class T>
+  bool sort_radix_index_map(
+    const std::vector<T> & unsorted,
+    const bool ascending,
+    std::vector<size_t> & index_map,
+    std::true_type)
+  {
+    if(unsorted.size() < 1000)
+    {
+      return false;
+    }
+    const Eigen::Matrix<T,Eigen::Dynamic,1> X =
+      Eigen::Map<const Eigen::Matrix<T,Eigen::Dynamic,1> >(
+        unsorted.data(),unsorted.size());
+    Eigen::VectorXi I;
+    if(!igl::radix_sortrows(X,ascending,I))
+    {
+      return false;
+    }
+    index_map.assign(I.data(),I.data()+I.size());
+    return true;
+  }
+  template <class T>
+  bool sort_radix_index_map(
+    const std::vector<T> &,
+    const bool,
+    std::vector<size_t> &,
+    std::false_type)
+  {
+    return false;
+  }
+}
+
 template <class T>
 IGL_INLINE void igl::sort(
 const std::vector<T> & unsorted,
@@ -302,22 +340,27 @@ const bool ascending,
 std::vector<T> & sorted,
 std::vector<size_t> & index_map)
 {
-// Original unsorted index map
-index_map.resize(unsorted.size());
-for(size_t i=0;i<unsorted.size();i++)
+if(!sort_radix_index_map(unsorted,ascending,index_map,
+  std::integral_constant<bool,
+    std::is_arithmetic<T>::value && !std::is_same<T,bool>::value>()))
 {
-  index_map[i] = i;
-}
-// Sort the index map, using unsorted for comparison
-std::sort(
-  index_map.begin(),
-  index_map.end(),
-  igl::IndexLessThan<const std::vector<T>& >(unsorted));
+  // Original unsorted index map
+  index_map.resize(unsorted.size());
+  for(size_t i=0;i<unsorted.size();i++)
+  {
+    index_map[i] = i;
+  }
+  // Sort the index map, using unsorted for comparison
+  std::sort(
+    index_map.begin(),
+    index_map.end(),
+    igl::IndexLessThan<const std::vector<T>& >(unsorted));
 
-// if not ascending then reverse
-if(!ascending)
-{
-  std::reverse(index_map.begin(),index_map.end());
+  // if not ascending then reverse
+  if(!ascending)
+  {
+    std::reverse(index_map.begin(),index_map.end());
+  }
 }
   // make space for output without clobbering
   sorted.resize(unsorted.size());
@@ -12,6 +12,7 @@
 #include "sort.h"
 #include "colon.h"
 #include "IndexComparison.h"
+#include "radix_sortrows.h"
 
 #include <vector>
 
@@ -65,6 +66,20 @@ IGL_INLINE void igl::sortrows(
   const size_t num_rows = X.rows();
   const size_t num_cols = X.cols();
   Y.resize(num_rows,num_cols);
+  // Integer and floating point rows are radix sorted, which is linear and
+  // cache friendly for large index matrices (faces, edges). Other scalars and
+  // small inputs use a comparison sort.
+  if(num_rows >= 1000 && radix_sortrows(X,ascending,IX))
+  {
+    for(size_t j = 0;j<num_cols;j++)
+    {
+      for(size_t i = 0;i<num_rows;i++)
+      {
+        Y(i,j) = X(IX(i),j);
+      }
+    }
+    return;
+  }
   IX.resize(num_rows,1);
   for(int i = 0;i<num_rows;i++)
   {
@@ -0,0 +1,59 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 The libigl contributors
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "sparse_skinning_weights.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <vector>
+
+template <typename DerivedW, typename DerivedI, typename DerivedWK>
+IGL_INLINE void igl::sparse_skinning_weights(
+  const Eigen::MatrixBase<DerivedW> & W,
+  const int k,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedWK> & WK)
+{
+  typedef typename DerivedWK::Scalar Scalar;
+  const int nc = W.cols();
+  const int kk = std::max(std::min(k,nc),0);
+  I.setZero(W.rows(),kk);
+  WK.setZero(W.rows(),kk);
+  igl::parallel_for(W.rows(),[&](const int i)
+  {
+    std::vector<int> order(nc);
+    for(int c = 0;c<nc;c++)
+    {
+      order[c] = c;
+    }
+    // Ties keep the lower handle index first
+    std::partial_sort(order.begin(),order.begin()+kk,order.end(),
+      [&](const int a, const int b)
+      {
+        return W(i,a) > W(i,b) || (W(i,a) == W(i,b) && a < b);
+      });
+    Scalar sum = 0;
+    for(int j = 0;j<kk;j++)
+    {
+      if(W(i,order[j]) <= 0)
+      {
+        break;
+      }
+      I(i,j) = order[j];
+      WK(i,j) = W(i,order[j]);
+      sum += WK(i,j);
+    }
+    if(sum > 0)
+    {
+      WK.row(i) /= sum;
+    }
+  },1000);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::sparse_skinning_weights<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+#endif
@@ -0,0 +1,37 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 The libigl contributors
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SPARSE_SKINNING_WEIGHTS_H
+#define IGL_SPARSE_SKINNING_WEIGHTS_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  // Compact a dense matrix of skinning weights to the k largest weights per
+  // vertex, so that skinning (see lbs.h and dqs.h) costs O(#V*k) instead of
+  // O(#V*#C). The kept weights of each vertex are rescaled to sum to one.
+  //
+  // Inputs:
+  //   W  #V by #C list of weights
+  //   k  number of influences kept per vertex (clamped to #C)
+  // Outputs:
+  //   I  #V by k list of handle indices, sorted by decreasing weight. Rows
+  //     with fewer than k positive weights are padded with index 0 and
+  //     weight 0.
+  //   WK  #V by k list of corresponding weights
+  template <typename DerivedW, typename DerivedI, typename DerivedWK>
+  IGL_INLINE void sparse_skinning_weights(
+    const Eigen::MatrixBase<DerivedW> & W,
+    const int k,
+    Eigen::PlainObjectBase<DerivedI> & I,
+    Eigen::PlainObjectBase<DerivedWK> & WK);
+};
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "sparse_skinning_weights.cpp"
+#endif
+#endif
@@ -0,0 +1,500 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "to_chars.h"
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+  // Grisu2 as in "Printing Floating-Point Numbers Quickly and Accurately with
+  // Integers" [Loitsch 2010], arranged as in Milo Yip's and Niels Lohmann's
+  // implementations: the digits are generated from 64-bit fixed point
+  // approximations of the number and its rounding boundaries scaled by a
+  // cached power of ten.
+
+  // f * 2^e
+  struct to_chars_diyfp
+  {
+    std::uint64_t f;
+    int e;
+    to_chars_diyfp(const std::uint64_t f_, const int e_) : f(f_), e(e_) {}
+  };
+
+  // x - y, same exponent and x.f >= y.f
+  inline to_chars_diyfp to_chars_sub(
+    const to_chars_diyfp & x,
+    const to_chars_diyfp & y)
+  {
+    return to_chars_diyfp(x.f - y.f, x.e);
+  }
+
+  // x * y rounded to the upper 64 bits of the product
+  inline to_chars_diyfp to_chars_mul(
+    const to_chars_diyfp & x,
+    const to_chars_diyfp & y)
+  {
+    const std::uint64_t u_lo = x.f & 0xFFFFFFFFu;
+    const std::uint64_t u_hi = x.f >> 32u;
+    const std::uint64_t v_lo = y.f & 0xFFFFFFFFu;
+    const std::uint64_t v_hi = y.f >> 32u;
+    const std::uint64_t p0 = u_lo * v_lo;
+    const std::uint64_t p1 = u_lo * v_hi;
+    const std::uint64_t p2 = u_hi * v_lo;
+    const std::uint64_t p3 = u_hi * v_hi;
+    std::uint64_t Q =
+      (p0 >> 32u) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+    Q += std::uint64_t(1) << 31u;
+    const std::uint64_t h = p3 + (p2 >> 32u) + (p1 >> 32u) + (Q >> 32u);
+    return to_chars_diyfp(h, x.e + y.e + 64);
+  }
+
+  inline to_chars_diyfp to_chars_normalize(to_chars_diyfp x)
+  {
+    while((x.f >> 63u) == 0)
+    {
+      x.f <<= 1u;
+      x.e--;
+    }
+    return x;
+  }
+
+  // Boundaries m- < v < m+ of the rounding interval of a positive finite
+  // float or double v, normalized to m+'s exponent
+  struct to_chars_boundaries
+  {
+    to_chars_diyfp w;
+    to_chars_diyfp minus;
+    to_chars_diyfp plus;
+  };
+
+  template <typename Float, typename Bits>
+  inline to_chars_boundaries to_chars_compute_boundaries(const Float value)
+  {
+    const int precision = std::numeric_limits<Float>::digits;
+    const int bias = std::numeric_limits<Float>::max_exponent - 1 +
+      (precision - 1);
+    const int min_exp = 1 - bias;
+    const std::uint64_t hidden_bit = std::uint64_t(1) << (precision - 1);
+    Bits bits;
+    std::memcpy(&bits, &value, sizeof(Float));
+    const std::uint64_t E = std::uint64_t(bits) >> (precision - 1);
+    const std::uint64_t F = std::uint64_t(bits) & (hidden_bit - 1);
+    const to_chars_diyfp v = E == 0 ?
+      to_chars_diyfp(F, min_exp) :
+      to_chars_diyfp(F + hidden_bit, int(E) - bias);
+    // The lower boundary is closer for powers of two (except the smallest
+    // normal number)
+    const bool lower_is_closer = F == 0 && E > 1;
+    const to_chars_diyfp m_plus(2 * v.f + 1, v.e - 1);
+    const to_chars_diyfp m_minus = lower_is_closer ?
+      to_chars_diyfp(4 * v.f - 1, v.e - 2) :
+      to_chars_diyfp(2 * v.f - 1, v.e - 1);
+    const to_chars_diyfp w_plus = to_chars_normalize(m_plus);
+    const to_chars_diyfp w_minus(
+      m_minus.f << (m_minus.e - w_plus.e), w_plus.e);
+    return {to_chars_normalize(v), w_minus, w_plus};
+  }
+
+  // Scaled boundaries must land in [2^alpha, 2^gamma) so that the integral
+  // part of the generated digits fits 32 bits
+  const int TO_CHARS_ALPHA = -60;
+  const int TO_CHARS_GAMMA = -32;
+  const int TO_CHARS_MIN_DEC_EXP = -300;
+  const int TO_CHARS_DEC_STEP = 8;
+  const int TO_CHARS_NUM_POWERS = 79;
+
+  // 10^k ≈ f * 2^e with f normalized
+  struct to_chars_cached_power
+  {
+    std::uint64_t f;
+    int e;
+    int k;
+  };
+
+  // Powers of ten 10^-300, 10^-292, ..., 10^324 correctly rounded to 64 bit
+  // significands, computed once with big integers rather than tabulated
+  inline const to_chars_cached_power * to_chars_cached_powers()
+  {
+    struct Table
+    {
+      to_chars_cached_power powers[TO_CHARS_NUM_POWERS];
+      Table()
+      {
+        // little endian base 2^32 digits
+        typedef std::vector<std::uint32_t> Big;
+        const auto bit_length = [](const Big & a)->int
+        {
+          int n = int(a.size());
+          while(n > 0 && a[n-1] == 0) { n--; }
+          if(n == 0) { return 0; }
+          int l = 32*(n-1);
+          for(std::uint32_t top = a[n-1];top;top >>= 1) { l++; }
+          return l;
+        };
+        const auto bit = [](const Big & a, const int i)->std::uint64_t
+        {
+          return (a[i/32] >> (i%32)) & 1u;
+        };
+        // round a to its leading 64 bits: a ≈ f * 2^shift
+        const auto round_to_64 = [&](const Big & a, int & shift)
+        {
+          const int l = bit_length(a);
+          shift = l - 64;
+          std::uint64_t f = 0;
+          for(int i = l-1;i >= shift;i--)
+          {
+            f = (f << 1u) | bit(a, i);
+          }
+          if(shift > 0 && bit(a, shift-1))
+          {
+            f++;
+            if(f == 0)
+            {
+              f = std::uint64_t(1) << 63u;
+              shift++;
+            }
+          }
+          return f;
+        };
+        for(int i = 0;i < TO_CHARS_NUM_POWERS;i++)
+        {
+          const int k = TO_CHARS_MIN_DEC_EXP + i*TO_CHARS_DEC_STEP;
+          to_chars_cached_power & p = powers[i];
+          p.k = k;
+          if(k >= 0)
+          {
+            Big a(1, 1);
+            for(int j = 0;j < k;j++)
+            {
+              std::uint64_t carry = 0;
+              for(auto & d : a)
+              {
+                const std::uint64_t t = std::uint64_t(d) * 10 + carry;
+                d = std::uint32_t(t);
+                carry = t >> 32u;
+              }
+              if(carry) { a.push_back(std::uint32_t(carry)); }
+            }
+            // 10^4 and 10^12 have fewer than 64 bits
+            const int l = bit_length(a);
+            if(l < 64)
+            {
+              const std::uint64_t a01 = a.size() > 1 ?
+                (std::uint64_t(a[1]) << 32u) | a[0] : a[0];
+              p.f = a01 << (64 - l);
+              p.e = l - 64;
+            }else
+            {
+              p.f = round_to_64(a, p.e);
+            }
+          }else
+          {
+            // floor(2^M / 10^-k) with enough bits to round, floor of
+            // repeated floored divisions is the floor of the quotient
+            const int M = (-k*3322)/1000 + 1 + 66;
+            Big a(M/32 + 1, 0);
+            a[M/32] = std::uint32_t(1) << (M%32);
+            for(int j = 0;j < -k;j++)
+            {
+              std::uint64_t r = 0;
+              for(int d = int(a.size())-1;d >= 0;d--)
+              {
+                const std::uint64_t t = (r << 32u) | a[d];
+                a[d] = std::uint32_t(t / 10);
+                r = t % 10;
+              }
+            }
+            int shift;
+            p.f = round_to_64(a, shift);
+            p.e = shift - M;
+          }
+        }
+      }
+    };
+    static const Table table;
+    return table.powers;
+  }
+
+  // Cached power c = 10^k such that alpha <= c.e + e + 64 <= gamma
+  inline to_chars_cached_power to_chars_cached_power_for_binary_exponent(
+    const int e)
+  {
+    // k = ceil((alpha - e - 1) * log10(2))
+    const int f = TO_CHARS_ALPHA - e - 1;
+    const int k = (f * 78913) / (1 << 18) + int(f > 0);
+    const int index =
+      (-TO_CHARS_MIN_DEC_EXP + k + (TO_CHARS_DEC_STEP - 1)) /
+      TO_CHARS_DEC_STEP;
+    return to_chars_cached_powers()[index];
+  }
+
+  // Number of decimal digits of n > 0 and the largest power of ten <= n
+  inline int to_chars_find_largest_pow10(
+    const std::uint32_t n,
+    std::uint32_t & pow10)
+  {
+    if(n >= 1000000000) { pow10 = 1000000000; return 10; }
+    if(n >= 100000000) { pow10 = 100000000; return 9; }
+    if(n >= 10000000) { pow10 = 10000000; return 8; }
+    if(n >= 1000000) { pow10 = 1000000; return 7; }
+    if(n >= 100000) { pow10 = 100000; return 6; }
+    if(n >= 10000) { pow10 = 10000; return 5; }
+    if(n >= 1000) { pow10 = 1000; return 4; }
+    if(n >= 100) { pow10 = 100; return 3; }
+    if(n >= 10) { pow10 = 10; return 2; }
+    pow10 = 1;
+    return 1;
+  }
+
+  // Move the last digit down while that brings the digits closer to w and
+  // keeps them inside the boundaries
+  inline void to_chars_grisu2_round(
+    char * buf,
+    const int len,
+    const std::uint64_t dist,
+    const std::uint64_t delta,
+    std::uint64_t rest,
+    const std::uint64_t ten_k)
+  {
+    while(rest < dist && delta - rest >= ten_k &&
+      (rest + ten_k < dist || dist - rest > rest + ten_k - dist))
+    {
+      buf[len - 1]--;
+      rest += ten_k;
+    }
+  }
+
+  // Shortest digits in (M-, M+), as close as possible to w
+  inline void to_chars_grisu2_digit_gen(
+    char * buffer,
+    int & length,
+    int & decimal_exponent,
+    const to_chars_diyfp & M_minus,
+    const to_chars_diyfp & w,
+    const to_chars_diyfp & M_plus)
+  {
+    std::uint64_t delta = to_chars_sub(M_plus, M_minus).f;
+    std::uint64_t dist = to_chars_sub(M_plus, w).f;
+    // M+ = p1 + p2 * 2^e with the integral part p1 and fraction p2
+    const to_chars_diyfp one(std::uint64_t(1) << -M_plus.e, M_plus.e);
+    std::uint32_t p1 = std::uint32_t(M_plus.f >> -one.e);
+    std::uint64_t p2 = M_plus.f & (one.f - 1);
+    std::uint32_t pow10;
+    int n = to_chars_find_largest_pow10(p1, pow10);
+    while(n > 0)
+    {
+      const std::uint32_t d = p1 / pow10;
+      p1 = p1 % pow10;
+      buffer[length++] = char('0' + d);
+      n--;
+      const std::uint64_t rest = (std::uint64_t(p1) << -one.e) + p2;
+      if(rest <= delta)
+      {
+        decimal_exponent += n;
+        to_chars_grisu2_round(
+          buffer, length, dist, delta, rest, std::uint64_t(pow10) << -one.e);
+        return;
+      }
+      pow10 /= 10;
+    }
+    int m = 0;
+    while(true)
+    {
+      p2 *= 10;
+      buffer[length++] = char('0' + (p2 >> -one.e));
+      p2 &= one.f - 1;
+      m++;
+      delta *= 10;
+      dist *= 10;
+      if(p2 <= delta)
+      {
+        break;
+      }
+    }
+    decimal_exponent -= m;
+    to_chars_grisu2_round(buffer, length, dist, delta, p2, one.f);
+  }
+
+  // Digits and exponent of a positive finite value: value ≈ digits *
+  // 10^decimal_exponent
+  template <typename Float, typename Bits>
+  inline void to_chars_grisu2(
+    char * buffer,
+    int & length,
+    int & decimal_exponent,
+    const Float value)
+  {
+    const to_chars_boundaries b =
+      to_chars_compute_boundaries<Float, Bits>(value);
+    const to_chars_cached_power cached =
+      to_chars_cached_power_for_binary_exponent(b.plus.e);
+    const to_chars_diyfp c(cached.f, cached.e);
+    const to_chars_diyfp w = to_chars_mul(b.w, c);
+    const to_chars_diyfp w_minus = to_chars_mul(b.minus, c);
+    const to_chars_diyfp w_plus = to_chars_mul(b.plus, c);
+    // Stay strictly inside the boundaries to make up for the rounding errors
+    // of the multiplications
+    const to_chars_diyfp M_minus(w_minus.f + 1, w_minus.e);
+    const to_chars_diyfp M_plus(w_plus.f - 1, w_plus.e);
+    length = 0;
+    decimal_exponent = -cached.k;
+    to_chars_grisu2_digit_gen(
+      buffer, length, decimal_exponent, M_minus, w, M_plus);
+  }
+
+  inline char * to_chars_unsigned(char * first, unsigned long long x)
+  {
+    char digits[20];
+    int n = 0;
+    do
+    {
+      digits[n++] = char('0' + x % 10);
+      x /= 10;
+    }while(x);
+    while(n) { *first++ = digits[--n]; }
+    return first;
+  }
+
+  inline char * to_chars_signed(char * first, const long long x)
+  {
+    if(x < 0)
+    {
+      *first++ = '-';
+      return to_chars_unsigned(first, 0ull - (unsigned long long)(x));
+    }
+    return to_chars_unsigned(first, (unsigned long long)(x));
+  }
+
+  // %g-like layout of digits * 10^decimal_exponent: fixed notation for
+  // decimal points in (min_exp, max_exp], otherwise d.ddde±XX
+  inline char * to_chars_format(
+    char * buf,
+    const int k,
+    const int decimal_exponent,
+    const int min_exp,
+    const int max_exp)
+  {
+    const int n = k + decimal_exponent;
+    if(k <= n && n <= max_exp)
+    {
+      // digits[000]
+      std::memset(buf + k, '0', n - k);
+      return buf + n;
+    }
+    if(0 < n && n <= max_exp)
+    {
+      // dig.its
+      std::memmove(buf + n + 1, buf + n, k - n);
+      buf[n] = '.';
+      return buf + k + 1;
+    }
+    if(min_exp < n && n <= 0)
+    {
+      // 0.[000]digits
+      std::memmove(buf + 2 - n, buf, k);
+      buf[0] = '0';
+      buf[1] = '.';
+      std::memset(buf + 2, '0', -n);
+      return buf + 2 - n + k;
+    }
+    if(k > 1)
+    {
+      std::memmove(buf + 2, buf + 1, k - 1);
+      buf[1] = '.';
+      buf += k + 1;
+    }else
+    {
+      buf += 1;
+    }
+    *buf++ = 'e';
+    int e = n - 1;
+    *buf++ = e < 0 ? '-' : '+';
+    e = e < 0 ? -e : e;
+    if(e < 10)
+    {
+      *buf++ = '0';
+    }
+    return to_chars_unsigned(buf, (unsigned long long)(e));
+  }
+
+  template <typename Float, typename Bits>
+  inline char * to_chars_float(char * first, const Float x)
+  {
+    if(std::isnan(x))
+    {
+      std::memcpy(first, "nan", 3);
+      return first + 3;
+    }
+    if(std::signbit(x))
+    {
+      *first++ = '-';
+    }
+    if(std::isinf(x))
+    {
+      std::memcpy(first, "inf", 3);
+      return first + 3;
+    }
+    if(x == 0)
+    {
+      *first++ = '0';
+      return first;
+    }
+    int length, decimal_exponent;
+    to_chars_grisu2<Float, Bits>(
+      first, length, decimal_exponent, std::signbit(x) ? -x : x);
+    return to_chars_format(
+      first,
+      length,
+      decimal_exponent,
+      -4,
+      std::numeric_limits<Float>::digits10);
+  }
+}
+
+IGL_INLINE char * igl::to_chars(char * first, const double x)
+{
+  return to_chars_float<double, std::uint64_t>(first, x);
+}
+
+IGL_INLINE char * igl::to_chars(char * first, const float x)
+{
+  return to_chars_float<float, std::uint32_t>(first, x);
+}
+
+IGL_INLINE char * igl::to_chars(char * first, const int x)
+{
+  return to_chars_signed(first, x);
+}
+
+IGL_INLINE char * igl::to_chars(char * first, const unsigned int x)
+{
+  return to_chars_unsigned(first, x);
+}
+
+IGL_INLINE char * igl::to_chars(char * first, const long x)
+{
+  return to_chars_signed(first, x);
+}
+
+IGL_INLINE char * igl::to_chars(char * first, const unsigned long x)
+{
+  return to_chars_unsigned(first, x);
+}
+
+IGL_INLINE char * igl::to_chars(char * first, const long long x)
+{
+  return to_chars_signed(first, x);
+}
+
+IGL_INLINE char * igl::to_chars(char * first, const unsigned long long x)
+{
+  return to_chars_unsigned(first, x);
+}
@@ -0,0 +1,45 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_TO_CHARS_H
+#define IGL_TO_CHARS_H
+#include "igl_inline.h"
+
+namespace igl
+{
+  // Maximum number of characters written by to_chars
+  const int TO_CHARS_MAX_LENGTH = 32;
+
+  // Write a number in decimal without going through printf, for writers of
+  // large text files (see writeOBJ).
+  //
+  // Floating point numbers are written with as few significant digits as
+  // needed for strtod (or >>) to read back exactly the same value, using
+  // Grisu2 [Loitsch 2010]: e.g. 0.1 rather than the 0.10000000000000001 of
+  // "%0.17g". Floats round trip as floats. Small and large magnitudes use
+  // exponent notation (1e-05, 1.5e+20). NaN and infinity are written as nan,
+  // inf and -inf.
+  //
+  // Inputs:
+  //   first  output buffer with room for TO_CHARS_MAX_LENGTH characters
+  //   x  number to write
+  // Returns pointer past the last character written (no null terminator)
+  IGL_INLINE char * to_chars(char * first, const double x);
+  IGL_INLINE char * to_chars(char * first, const float x);
+  IGL_INLINE char * to_chars(char * first, const int x);
+  IGL_INLINE char * to_chars(char * first, const unsigned int x);
+  IGL_INLINE char * to_chars(char * first, const long x);
+  IGL_INLINE char * to_chars(char * first, const unsigned long x);
+  IGL_INLINE char * to_chars(char * first, const long long x);
+  IGL_INLINE char * to_chars(char * first, const unsigned long long x);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "to_chars.cpp"
+#endif
+
+#endif
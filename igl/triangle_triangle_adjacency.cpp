@@ -34,40 +34,68 @@ IGL_INLINE void igl::triangle_triangle_adjacency_extractTT(
   }
 }
 
-template <typename DerivedF, typename DerivedTT>
-IGL_INLINE void igl::triangle_triangle_adjacency(
-  const Eigen::MatrixBase<DerivedF>& F,
-  Eigen::PlainObjectBase<DerivedTT>& TT)
+namespace
 {
-  const int n = F.maxCoeff()+1;
-  typedef Eigen::Matrix<typename DerivedTT::Scalar,Eigen::Dynamic,1> VectorXI;
-  VectorXI VF,NI;
-  vertex_triangle_adjacency(F,n,VF,NI);
-  TT = DerivedTT::Constant(F.rows(),3,-1);
-  // Loop over faces
-  igl::parallel_for(F.rows(),[&](int f)
+  // Shared body of the TT and TT,TTi overloads: TTi is only written when
+  // construct_TTi is true, so that both are found in a single pass.
+  template <bool construct_TTi, typename DerivedF, typename DerivedTT, typename DerivedTTi>
+  void triangle_triangle_adjacency_from_VF(
+    const Eigen::MatrixBase<DerivedF>& F,
+    Eigen::PlainObjectBase<DerivedTT>& TT,
+    Eigen::PlainObjectBase<DerivedTTi>& TTi)
   {
-    // Loop over corners
-    for (int k = 0; k < 3; k++)
+    const int n = F.maxCoeff()+1;
+    typedef Eigen::Matrix<typename DerivedTT::Scalar,Eigen::Dynamic,1> VectorXI;
+    VectorXI VF,NI;
+    igl::vertex_triangle_adjacency(F,n,VF,NI);
+    TT.setConstant(F.rows(),3,-1);
+    if(construct_TTi)
     {
-      int vi = F(f,k), vin = F(f,(k+1)%3);
-      // Loop over face neighbors incident on this corner
-      for (int j = NI[vi]; j < NI[vi+1]; j++)
+      TTi.setConstant(F.rows(),3,-1);
+    }
+    // Loop over faces
+    igl::parallel_for(F.rows(),[&](int f)
+    {
+      // Loop over corners
+      for (int k = 0; k < 3; k++)
       {
-        int fn = VF[j];
-        // Not this face
-        if (fn != f)
+        int vi = F(f,k), vin = F(f,(k+1)%3);
+        // Loop over face neighbors incident on this corner
+        for (int j = NI[vi]; j < NI[vi+1]; j++)
         {
-          // Face neighbor also has [vi,vin] edge
-          if (F(fn,0) == vin || F(fn,1) == vin || F(fn,2) == vin)
+          int fn = VF[j];
+          // Not this face
+          if (fn != f)
           {
-            TT(f,k) = fn;
-            break;
+            // Face neighbor also has [vi,vin] edge
+            if (F(fn,0) == vin || F(fn,1) == vin || F(fn,2) == vin)
+            {
+              TT(f,k) = fn;
+              // Index of the edge in fn if oriented consistently with f
+              for(int kn = 0;construct_TTi && kn<3;kn++)
+              {
+                if(F(fn,kn) == vin && F(fn,(kn+1)%3) == vi)
+                {
+                  TTi(f,k) = kn;
+                  break;
+                }
+              }
+              break;
+            }
           }
         }
       }
-    }
-  });
+    },1000);
+  }
+}
+
+template <typename DerivedF, typename DerivedTT>
+IGL_INLINE void igl::triangle_triangle_adjacency(
+  const Eigen::MatrixBase<DerivedF>& F,
+  Eigen::PlainObjectBase<DerivedTT>& TT)
+{
+  Eigen::Matrix<typename DerivedTT::Scalar,Eigen::Dynamic,3> not_used;
+  triangle_triangle_adjacency_from_VF<false>(F,TT,not_used);
 }
 
 template <typename DerivedF, typename TTT_type>
@@ -75,6 +103,7 @@ IGL_INLINE void igl::triangle_triangle_adjacency_preprocess(
   const Eigen::MatrixBase<DerivedF>& F,
   std::vector<std::vector<TTT_type> >& TTT)
 {
+  TTT.reserve(TTT.size()+F.rows()*F.cols());
   for(int f=0;f<F.rows();++f)
     for (int i=0;i<F.cols();++i)
     {
@@ -118,29 +147,7 @@ IGL_INLINE void igl::triangle_triangle_adjacency(
   Eigen::PlainObjectBase<DerivedTT>& TT,
   Eigen::PlainObjectBase<DerivedTTi>& TTi)
 {
-  triangle_triangle_adjacency(F,TT);
-  TTi = DerivedTTi::Constant(TT.rows(),TT.cols(),-1);
-  //for(int f = 0; f<F.rows(); f++)
-  igl::parallel_for(F.rows(),[&](int f)
-  {
-    for(int k = 0;k<3;k++)
-    {
-      int vi = F(f,k), vj = F(f,(k+1)%3);
-      int fn = TT(f,k);
-      if(fn >= 0)
-      {
-        for(int kn = 0;kn<3;kn++)
-        {
-          int vin = F(fn,kn), vjn = F(fn,(kn+1)%3);
-          if(vi == vjn && vin == vj)
-          {
-            TTi(f,k) = kn;
-            break;
-          }
-        }
-      }
-    }
-  });
+  triangle_triangle_adjacency_from_VF<true>(F,TT,TTi);
 }
 
 template <
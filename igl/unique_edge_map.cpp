@@ -8,8 +8,11 @@
 #include "unique_edge_map.h"
 #include "oriented_facets.h"
 #include "unique_simplices.h"
+#include "parallel_for.h"
+#include <thread>
 #include <cassert>
 #include <algorithm>
+#include <vector>
 template <
   typename DerivedF,
   typename DerivedE,
@@ -25,6 +28,17 @@ IGL_INLINE void igl::unique_edge_map(
 {
   using namespace Eigen;
   using namespace std;
+  if(F.cols() == 3)
+  {
+    Matrix<typename DerivedEMAP::Scalar,Dynamic,1> uEC,uEE;
+    unique_edge_map(F,E,uE,EMAP,uEC,uEE);
+    uE2E.resize(uE.rows());
+    for(int u = 0;u<(int)uE.rows();u++)
+    {
+      uE2E[u].assign(uEE.data()+uEC(u),uEE.data()+uEC(u+1));
+    }
+    return;
+  }
   // All occurrences of directed edges
   oriented_facets(F,E);
   const size_t ne = E.rows();
@@ -43,6 +57,136 @@ IGL_INLINE void igl::unique_edge_map(
   }
 }
 
+template <
+  typename DerivedF,
+  typename DerivedE,
+  typename DeriveduE,
+  typename DerivedEMAP,
+  typename DeriveduEC,
+  typename DeriveduEE>
+IGL_INLINE void igl::unique_edge_map(
+  const Eigen::MatrixBase<DerivedF> & F,
+  Eigen::PlainObjectBase<DerivedE> & E,
+  Eigen::PlainObjectBase<DeriveduE> & uE,
+  Eigen::PlainObjectBase<DerivedEMAP> & EMAP,
+  Eigen::PlainObjectBase<DeriveduEC> & uEC,
+  Eigen::PlainObjectBase<DeriveduEE> & uEE)
+{
+  typedef typename DeriveduEE::Scalar uEEScalar;
+  typedef typename DeriveduE::Scalar uEScalar;
+  assert(F.cols() == 3 && "Faces must be triangles");
+  // All occurrences of directed edges
+  oriented_facets(F,E);
+  const int ne = E.rows();
+  const int n = ne == 0 ? 0 : int(F.maxCoeff())+1;
+  const auto lo = [&E](const int e)->int
+  {
+    return int(std::min(E(e,0),E(e,1)));
+  };
+  const auto hi = [&E](const int e)->int
+  {
+    return int(std::max(E(e,0),E(e,1)));
+  };
+  // Counting sort of the directed edges by their smaller vertex, over
+  // contiguous chunks of edges with their own counts as in
+  // vertex_triangle_adjacency. offset holds the bucket starts.
+  const int num_chunks = ne < 30000 || n == 0 ? 1 :
+    std::max(1,std::min((int)std::thread::hardware_concurrency(),ne/n));
+  const auto chunk_begin = [ne,num_chunks](const int c)
+  {
+    return int((long long)ne*c/num_chunks);
+  };
+  std::vector<int> cursor(size_t(num_chunks)*n,0);
+  igl::parallel_for(num_chunks,[&](const int c)
+  {
+    int * count = cursor.data() + size_t(c)*n;
+    for(int e = chunk_begin(c),end = chunk_begin(c+1);e<end;e++)
+    {
+      count[lo(e)]++;
+    }
+  },2);
+  std::vector<int> offset(n+1);
+  offset[0] = 0;
+  igl::parallel_for(n,[&](const int v)
+  {
+    int k = 0;
+    for(int c = 0;c<num_chunks;c++)
+    {
+      const int d = cursor[size_t(c)*n+v];
+      cursor[size_t(c)*n+v] = k;
+      k += d;
+    }
+    offset[v+1] = k;
+  },10000);
+  for(int v = 0;v<n;v++)
+  {
+    offset[v+1] += offset[v];
+  }
+  uEE.resize(ne);
+  igl::parallel_for(num_chunks,[&](const int c)
+  {
+    int * next = cursor.data() + size_t(c)*n;
+    for(int e = chunk_begin(c),end = chunk_begin(c+1);e<end;e++)
+    {
+      const int v = lo(e);
+      uEE(offset[v] + next[v]++) = uEEScalar(e);
+    }
+  },2);
+  // Sort each bucket by larger vertex, so that the directed edges of a unique
+  // edge are consecutive and still increasing. Buckets hold about one vertex
+  // star so (stable) insertion sort is enough. Then count the unique edges
+  // of each bucket.
+  std::vector<int> unique_offset(n+1);
+  unique_offset[0] = 0;
+  igl::parallel_for(n,[&](const int v)
+  {
+    for(int k = offset[v]+1;k<offset[v+1];k++)
+    {
+      const uEEScalar e = uEE(k);
+      const int he = hi(e);
+      int j = k;
+      for(;j>offset[v] && hi(uEE(j-1)) > he;j--)
+      {
+        uEE(j) = uEE(j-1);
+      }
+      uEE(j) = e;
+    }
+    int count = 0;
+    for(int k = offset[v];k<offset[v+1];k++)
+    {
+      count += k == offset[v] || hi(uEE(k-1)) != hi(uEE(k));
+    }
+    unique_offset[v+1] = count;
+  },10000);
+  for(int v = 0;v<n;v++)
+  {
+    unique_offset[v+1] += unique_offset[v];
+  }
+  // Unique edges are numbered in lexicographic order of their sorted
+  // vertices and oriented like their first directed edge
+  const int nu = unique_offset[n];
+  uE.resize(nu,2);
+  uEC.resize(nu+1);
+  uEC(nu) = ne;
+  EMAP.resize(ne,1);
+  igl::parallel_for(n,[&](const int v)
+  {
+    int u = unique_offset[v]-1;
+    for(int k = offset[v];k<offset[v+1];k++)
+    {
+      const int e = uEE(k);
+      if(k == offset[v] || hi(uEE(k-1)) != hi(e))
+      {
+        u++;
+        uE(u,0) = uEScalar(E(e,0));
+        uE(u,1) = uEScalar(E(e,1));
+        uEC(u) = k;
+      }
+      EMAP(e) = u;
+    }
+  },10000);
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 // generated by autoexplicit.sh
@@ -60,6 +204,8 @@ template void igl::unique_edge_map<Eigen::Matrix<int, -1, 3, 0, -1, 3>, Eigen::M
 template void igl::unique_edge_map<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, unsigned long>(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, std::vector<std::vector<unsigned long, std::allocator<unsigned long> >, std::allocator<std::vector<unsigned long, std::allocator<unsigned long> > > >&);
 template void igl::unique_edge_map<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, int>(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 2, 0, -1, 2> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 2, 0, -1, 2> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&);
 
+template void igl::unique_edge_map<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+
 #ifdef WIN32
 template void igl::unique_edge_map<class Eigen::Matrix<int, -1, 3, 0, -1, 3>, class Eigen::Matrix<int, -1, 2, 0, -1, 2>, class Eigen::Matrix<int, -1, 2, 0, -1, 2>, class Eigen::Matrix<__int64, -1, 1, 0, -1, 1>, __int64>(class Eigen::MatrixBase<class Eigen::Matrix<int, -1, 3, 0, -1, 3> > const &, class Eigen::PlainObjectBase<class Eigen::Matrix<int, -1, 2, 0, -1, 2> > &, class Eigen::PlainObjectBase<class Eigen::Matrix<int, -1, 2, 0, -1, 2> > &, class Eigen::PlainObjectBase<class Eigen::Matrix<__int64, -1, 1, 0, -1, 1> > &, class std::vector<class std::vector<__int64, class std::allocator<__int64> >, class std::allocator<class std::vector<__int64, class std::allocator<__int64> > > > &);
 template void igl::unique_edge_map<class Eigen::Matrix<int,-1,-1,0,-1,-1>,class Eigen::Matrix<int,-1,2,0,-1,2>,class Eigen::Matrix<int,-1,2,0,-1,2>,class Eigen::Matrix<__int64,-1,1,0,-1,1>,__int64>(class Eigen::MatrixBase<class Eigen::Matrix<int,-1,-1,0,-1,-1> > const &,class Eigen::PlainObjectBase<class Eigen::Matrix<int,-1,2,0,-1,2> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<int,-1,2,0,-1,2> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<__int64,-1,1,0,-1,1> > &,class std::vector<class std::vector<__int64,class std::allocator<__int64> >,class std::allocator<class std::vector<__int64,class std::allocator<__int64> > > > &);
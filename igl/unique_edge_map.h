@@ -20,7 +20,9 @@ namespace igl
   // Outputs:
   //   E  #F*3 by 2 list of all directed edges, such that E.row(f+#F*c) is the
   //     edge opposite F(f,c)
-  //   uE  #uE by 2 list of unique undirected edges
+  //   uE  #uE by 2 list of unique undirected edges. For triangles these are
+  //     sorted by (smaller vertex, larger vertex) and each is oriented like
+  //     the first of its directed edges in E.
   //   EMAP #F*3 list of indices into uE, mapping each directed edge to unique
   //     undirected edge so that uE(EMAP(f+#F*c)) is the unique edge
   //     corresponding to E.row(f+#F*c)
@@ -39,6 +41,29 @@ namespace igl
     Eigen::PlainObjectBase<DeriveduE> & uE,
     Eigen::PlainObjectBase<DerivedEMAP> & EMAP,
     std::vector<std::vector<uE2EType> > & uE2E);
+  // Outputs:
+  //   uEC  #uE+1 list of cumulative counts of directed edges per unique edge,
+  //     so that uEE(uEC(u)) ... uEE(uEC(u+1)-1) are the directed edges of
+  //     uE.row(u), as in uE2E[u]
+  //   uEE  #F*3 list of indices into E
+  //
+  // For triangles this is built with a parallel counting sort of the edges by
+  // their smaller vertex rather than by sorting rows, and avoids allocating a
+  // list per unique edge.
+  template <
+    typename DerivedF,
+    typename DerivedE,
+    typename DeriveduE,
+    typename DerivedEMAP,
+    typename DeriveduEC,
+    typename DeriveduEE>
+  IGL_INLINE void unique_edge_map(
+    const Eigen::MatrixBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DerivedE> & E,
+    Eigen::PlainObjectBase<DeriveduE> & uE,
+    Eigen::PlainObjectBase<DerivedEMAP> & EMAP,
+    Eigen::PlainObjectBase<DeriveduEC> & uEC,
+    Eigen::PlainObjectBase<DeriveduEE> & uEE);
 
 }
 #ifndef IGL_STATIC_LIBRARY
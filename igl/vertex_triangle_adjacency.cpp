@@ -6,7 +6,10 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "vertex_triangle_adjacency.h"
-#include "cumsum.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 template <typename DerivedF, typename VFType, typename VFiType>
 IGL_INLINE void igl::vertex_triangle_adjacency(
@@ -43,6 +46,93 @@ IGL_INLINE void igl::vertex_triangle_adjacency(
   return vertex_triangle_adjacency(V.rows(),F,VF,VFi);
 }
 
+namespace
+{
+  // Shared body of the CSR overloads, VFi is only filled if not null
+  template <
+    typename DerivedF,
+    typename DerivedVF,
+    typename DerivedVFi,
+    typename DerivedNI>
+  void vertex_triangle_adjacency_csr(
+    const Eigen::MatrixBase<DerivedF> & F,
+    const int n,
+    Eigen::PlainObjectBase<DerivedVF> & VF,
+    Eigen::PlainObjectBase<DerivedVFi> * VFi,
+    Eigen::PlainObjectBase<DerivedNI> & NI)
+  {
+    typedef typename DerivedVF::Scalar VFScalar;
+    typedef typename DerivedNI::Scalar NIScalar;
+    const int m = F.rows();
+    const int ss = F.cols();
+    // Counting sort of the corners by vertex. Faces are split into
+    // contiguous chunks with their own degree counts, so that the chunks are
+    // counted and scattered in parallel without atomics, each pass reads
+    // every face once, and each list still comes out in face order. There
+    // are at most as many counts as corners, so they take no more memory
+    // than VF.
+    const int num_chunks = m < 10000 || n == 0 ? 1 :
+      std::max(1,std::min((int)std::thread::hardware_concurrency(),
+        int((long long)ss*m/n)));
+    const auto chunk_begin = [m,num_chunks](const int c)
+    {
+      return int((long long)m*c/num_chunks);
+    };
+    std::vector<int> cursor(size_t(num_chunks)*n,0);
+    igl::parallel_for(num_chunks,[&](const int c)
+    {
+      int * count = cursor.data() + size_t(c)*n;
+      for(int f = chunk_begin(c),end = chunk_begin(c+1);f<end;f++)
+      {
+        for(int k = 0;k<ss;k++)
+        {
+          count[F(f,k)]++;
+        }
+      }
+    },2);
+    // Counts become the offset of each chunk in the list of the vertex
+    NI.resize(n+1);
+    NI(0) = 0;
+    igl::parallel_for(n,[&](const int v)
+    {
+      int k = 0;
+      for(int c = 0;c<num_chunks;c++)
+      {
+        const int d = cursor[size_t(c)*n+v];
+        cursor[size_t(c)*n+v] = k;
+        k += d;
+      }
+      NI(v+1) = NIScalar(k);
+    },10000);
+    for(int i = 0;i<n;i++)
+    {
+      NI(i+1) += NI(i);
+    }
+    VF.resize(ss*m);
+    if(VFi)
+    {
+      VFi->resize(ss*m);
+    }
+    igl::parallel_for(num_chunks,[&](const int c)
+    {
+      int * next = cursor.data() + size_t(c)*n;
+      for(int f = chunk_begin(c),end = chunk_begin(c+1);f<end;f++)
+      {
+        for(int k = 0;k<ss;k++)
+        {
+          const int v = F(f,k);
+          const NIScalar j = NI(v) + next[v]++;
+          VF(j) = VFScalar(f);
+          if(VFi)
+          {
+            (*VFi)(j) = typename DerivedVFi::Scalar(k);
+          }
+        }
+      }
+    },2);
+  }
+}
+
 template <
   typename DerivedF,
   typename DerivedVF,
@@ -53,32 +143,23 @@ IGL_INLINE void igl::vertex_triangle_adjacency(
   Eigen::PlainObjectBase<DerivedVF> & VF,
   Eigen::PlainObjectBase<DerivedNI> & NI)
 {
-  typedef Eigen::Matrix<typename DerivedVF::Scalar,Eigen::Dynamic,1> VectorXI;
-  // vfd  #V list so that vfd(i) contains the vertex-face degree (number of
-  // faces incident on vertex i)
-  VectorXI vfd = VectorXI::Zero(n);
-  for (int i = 0; i < F.rows(); i++)
-  {
-    for (int j = 0; j < 3; j++)
-    {
-      vfd[F(i,j)]++;
-    }
-  }
-  igl::cumsum(vfd,1,NI);
-  // Prepend a zero
-  NI = (DerivedNI(n+1)<<0,NI).finished();
-  // vfd now acts as a counter
-  vfd = NI;
+  vertex_triangle_adjacency_csr(
+    F,n,VF,(Eigen::PlainObjectBase<DerivedVF>*)nullptr,NI);
+}
 
-  VF.derived()= Eigen::VectorXi(3*F.rows());
-  for (int i = 0; i < F.rows(); i++)
-  {
-    for (int j = 0; j < 3; j++)
-    {
-      VF[vfd[F(i,j)]] = i;
-      vfd[F(i,j)]++;
-    }
-  }
+template <
+  typename DerivedF,
+  typename DerivedVF,
+  typename DerivedVFi,
+  typename DerivedNI>
+IGL_INLINE void igl::vertex_triangle_adjacency(
+  const Eigen::MatrixBase<DerivedF> & F,
+  const int n,
+  Eigen::PlainObjectBase<DerivedVF> & VF,
+  Eigen::PlainObjectBase<DerivedVFi> & VFi,
+  Eigen::PlainObjectBase<DerivedNI> & NI)
+{
+  vertex_triangle_adjacency_csr(F,n,VF,&VFi,NI);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -95,7 +176,9 @@ template void igl::vertex_triangle_adjacency<Eigen::Matrix<int, -1, -1, 0, -1, -
 template void igl::vertex_triangle_adjacency<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, int>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&);
 template void igl::vertex_triangle_adjacency<Eigen::Matrix<int, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 template void igl::vertex_triangle_adjacency<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::vertex_triangle_adjacency<Eigen::Matrix<int, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 template void igl::vertex_triangle_adjacency<Eigen::Matrix<int, -1, 3, 0, -1, 3>, int, int>(Eigen::Matrix<int, -1, 3, 0, -1, 3>::Scalar, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&);
+template void igl::vertex_triangle_adjacency<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 #ifdef WIN32
 template void igl::vertex_triangle_adjacency<class Eigen::Matrix<int, -1, -1, 0, -1, -1>, unsigned __int64, unsigned __int64>(int, class Eigen::MatrixBase<class Eigen::Matrix<int, -1, -1, 0, -1, -1>> const &, class std::vector<class std::vector<unsigned __int64, class std::allocator<unsigned __int64>>, class std::allocator<class std::vector<unsigned __int64, class std::allocator<unsigned __int64>>>> &, class std::vector<class std::vector<unsigned __int64, class std::allocator<unsigned __int64>>, class std::allocator<class std::vector<unsigned __int64, class std::allocator<unsigned __int64>>>> &);
 template void igl::vertex_triangle_adjacency<class Eigen::Matrix<int, -1, 3, 1, -1, 3>, unsigned __int64, unsigned __int64>(int, class Eigen::MatrixBase<class Eigen::Matrix<int, -1, 3, 1, -1, 3>> const &, class std::vector<class std::vector<unsigned __int64, class std::allocator<unsigned __int64>>, class std::allocator<class std::vector<unsigned __int64, class std::allocator<unsigned __int64>>>> &, class std::vector<class std::vector<unsigned __int64, class std::allocator<unsigned __int64>>, class std::allocator<class std::vector<unsigned __int64, class std::allocator<unsigned __int64>>>> &);
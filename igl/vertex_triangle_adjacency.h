@@ -53,14 +53,29 @@ namespace igl
   //   NI  #V+1 list  cumulative sum of vertex-triangle degrees with a
   //     preceeding zero. "How many faces" have been seen before visiting this
   //     vertex and its incident faces.
+  //
+  // The lists are built in parallel and each is sorted by face index.
+  template <
+    typename DerivedF,
+    typename DerivedVF,
+    typename DerivedNI>
+  IGL_INLINE void vertex_triangle_adjacency(
+    const Eigen::MatrixBase<DerivedF> & F,
+    const int n,
+    Eigen::PlainObjectBase<DerivedVF> & VF,
+    Eigen::PlainObjectBase<DerivedNI> & NI);
+  // Outputs:
+  //   VFi  3*#F list of corners, so that F(VF(NI(i)+j),VFi(NI(i)+j)) = i
   template <
     typename DerivedF,
     typename DerivedVF,
+    typename DerivedVFi,
     typename DerivedNI>
   IGL_INLINE void vertex_triangle_adjacency(
     const Eigen::MatrixBase<DerivedF> & F,
     const int n,
     Eigen::PlainObjectBase<DerivedVF> & VF,
+    Eigen::PlainObjectBase<DerivedVFi> & VFi,
     Eigen::PlainObjectBase<DerivedNI> & NI);
 }
 
@@ -6,14 +6,38 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "writeOBJ.h"
+#include "to_chars.h"
+#include "write_formatted_rows.h"
 
-#include <iostream>
-#include <limits>
-#include <iomanip>
-#include <fstream>
+#include <algorithm>
 #include <cstdio>
 #include <cassert>
 
+namespace
+{
+  // Format "prefix x y z\n" from the first cols entries of row i of X
+  template <typename DerivedX>
+  char * writeOBJ_format_row(
+    const char * prefix,
+    const Eigen::MatrixBase<DerivedX> & X,
+    const size_t i,
+    const int cols,
+    char * p)
+  {
+    while(*prefix)
+    {
+      *p++ = *prefix++;
+    }
+    for(int j = 0;j<cols;++j)
+    {
+      *p++ = ' ';
+      p = igl::to_chars(p,X(i,j));
+    }
+    *p++ = '\n';
+    return p;
+  }
+}
+
 template <
   typename DerivedV, 
   typename DerivedF,
@@ -36,28 +60,20 @@ IGL_INLINE bool igl::writeOBJ(
     printf("IOError: %s could not be opened for writing...",str.c_str());
     return false;
   }
+  bool ok = true;
   // Loop over V
-  for(int i = 0;i<(int)V.rows();i++)
-  {
-    fprintf(obj_file,"v");
-    for(int j = 0;j<(int)V.cols();++j)
-    {
-      fprintf(obj_file," %0.17g", V(i,j));
-    }
-    fprintf(obj_file,"\n");
-  }
+  ok = ok && write_formatted_rows(obj_file,V.rows(),
+    2+V.cols()*(TO_CHARS_MAX_LENGTH+1),
+    [&V](const size_t i,char * p)
+    { return writeOBJ_format_row("v",V,i,(int)V.cols(),p); });
   bool write_N = CN.rows() >0;
 
   if(write_N)
   {
-    for(int i = 0;i<(int)CN.rows();i++)
-    {
-      fprintf(obj_file,"vn %0.17g %0.17g %0.17g\n",
-              CN(i,0),
-              CN(i,1),
-              CN(i,2)
-              );
-    }
+    ok = ok && write_formatted_rows(obj_file,CN.rows(),
+      3+3*(TO_CHARS_MAX_LENGTH+1),
+      [&CN](const size_t i,char * p)
+      { return writeOBJ_format_row("vn",CN,i,3,p); });
     fprintf(obj_file,"\n");
   }
 
@@ -65,36 +81,44 @@ IGL_INLINE bool igl::writeOBJ(
 
   if(write_texture_coords)
   {
-    for(int i = 0;i<(int)TC.rows();i++)
-    {
-      fprintf(obj_file, "vt %0.17g %0.17g\n",TC(i,0),TC(i,1));
-    }
+    ok = ok && write_formatted_rows(obj_file,TC.rows(),
+      3+2*(TO_CHARS_MAX_LENGTH+1),
+      [&TC](const size_t i,char * p)
+      { return writeOBJ_format_row("vt",TC,i,2,p); });
     fprintf(obj_file,"\n");
   }
 
   // loop over F
-  for(int i = 0;i<(int)F.rows();++i)
-  {
-    fprintf(obj_file,"f");
-    for(int j = 0; j<(int)F.cols();++j)
+  ok = ok && write_formatted_rows(obj_file,F.rows(),
+    2+F.cols()*3*(TO_CHARS_MAX_LENGTH+2),
+    [&](const size_t i,char * p)
     {
-      // OBJ is 1-indexed
-      fprintf(obj_file," %u",F(i,j)+1);
-
-      if(write_texture_coords)
-        fprintf(obj_file,"/%u",FTC(i,j)+1);
-      if(write_N)
+      *p++ = 'f';
+      for(int j = 0; j<(int)F.cols();++j)
       {
-        if (write_texture_coords)
-          fprintf(obj_file,"/%u",FN(i,j)+1);
-        else
-          fprintf(obj_file,"//%u",FN(i,j)+1);
+        // OBJ is 1-indexed
+        *p++ = ' ';
+        p = to_chars(p,F(i,j)+1);
+        if(write_texture_coords)
+        {
+          *p++ = '/';
+          p = to_chars(p,FTC(i,j)+1);
+        }
+        if(write_N)
+        {
+          *p++ = '/';
+          if(!write_texture_coords)
+          {
+            *p++ = '/';
+          }
+          p = to_chars(p,FN(i,j)+1);
+        }
       }
-    }
-    fprintf(obj_file,"\n");
-  }
+      *p++ = '\n';
+      return p;
+    });
   fclose(obj_file);
-  return true;
+  return ok;
 }
 
 template <typename DerivedV, typename DerivedF>
@@ -103,19 +127,33 @@ IGL_INLINE bool igl::writeOBJ(
   const Eigen::MatrixBase<DerivedV>& V,
   const Eigen::MatrixBase<DerivedF>& F)
 {
-  using namespace std;
-  using namespace Eigen;
   assert(V.cols() == 3 && "V should have 3 columns");
-  ofstream s(str);
-  if(!s.is_open())
+  FILE * obj_file = fopen(str.c_str(),"w");
+  if(NULL==obj_file)
   {
     fprintf(stderr,"IOError: writeOBJ() could not open %s\n",str.c_str());
     return false;
   }
-  s<<
-    V.format(IOFormat(FullPrecision,DontAlignCols," ","\n","v ","","","\n"))<<
-    (F.array()+1).format(IOFormat(FullPrecision,DontAlignCols," ","\n","f ","","","\n"));
-  return true;
+  const bool ok = 
+    write_formatted_rows(obj_file,V.rows(),
+      2+V.cols()*(TO_CHARS_MAX_LENGTH+1),
+      [&V](const size_t i,char * p)
+      { return writeOBJ_format_row("v",V,i,(int)V.cols(),p); }) &&
+    write_formatted_rows(obj_file,F.rows(),
+      2+F.cols()*(TO_CHARS_MAX_LENGTH+1),
+      [&F](const size_t i,char * p)
+      {
+        *p++ = 'f';
+        for(int j = 0;j<(int)F.cols();++j)
+        {
+          *p++ = ' ';
+          p = to_chars(p,F(i,j)+1);
+        }
+        *p++ = '\n';
+        return p;
+      });
+  fclose(obj_file);
+  return ok;
 }
 
 template <typename DerivedV, typename T>
@@ -124,31 +162,39 @@ IGL_INLINE bool igl::writeOBJ(
   const Eigen::MatrixBase<DerivedV>& V,
   const std::vector<std::vector<T> >& F)
 {
-  using namespace std;
-  using namespace Eigen;
   assert(V.cols() == 3 && "V should have 3 columns");
-  ofstream s(str);
-  if(!s.is_open())
+  FILE * obj_file = fopen(str.c_str(),"w");
+  if(NULL==obj_file)
   {
     fprintf(stderr,"IOError: writeOBJ() could not open %s\n",str.c_str());
     return false;
   }
-  s<<V.format(IOFormat(FullPrecision,DontAlignCols," ","\n","v ","","","\n"));
-  
+  size_t max_face_size = 0;
   for(const auto& face : F)
   {
-    int face_size = face.size();
-    assert(face_size != 0);
-
-    s << (face_size == 2 ? "l" : "f");
-
-    for(const auto& vi : face)
-    {
-      s<<" "<<vi; 
-    }
-    s<<"\n";
+    assert(face.size() != 0);
+    max_face_size = std::max(max_face_size,face.size());
   }
-  return true;
+  const bool ok = 
+    write_formatted_rows(obj_file,V.rows(),
+      2+V.cols()*(TO_CHARS_MAX_LENGTH+1),
+      [&V](const size_t i,char * p)
+      { return writeOBJ_format_row("v",V,i,(int)V.cols(),p); }) &&
+    write_formatted_rows(obj_file,F.size(),
+      2+max_face_size*(TO_CHARS_MAX_LENGTH+1),
+      [&F](const size_t i,char * p)
+      {
+        *p++ = (F[i].size() == 2 ? 'l' : 'f');
+        for(const auto& vi : F[i])
+        {
+          *p++ = ' ';
+          p = to_chars(p,vi);
+        }
+        *p++ = '\n';
+        return p;
+      });
+  fclose(obj_file);
+  return ok;
 }
 
 #ifdef IGL_STATIC_LIBRARY
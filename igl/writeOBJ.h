@@ -17,7 +17,10 @@
 
 namespace igl 
 {
-  // Write a mesh in an ascii obj file
+  // Write a mesh in an ascii obj file. Numbers are written with as few digits
+  // as read back exactly (see to_chars), blocks of lines are formatted in
+  // parallel.
+  //
   // Inputs:
   //   str  path to outputfile
   //   V  #V by 3 mesh vertex positions
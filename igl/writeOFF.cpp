@@ -6,8 +6,29 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "writeOFF.h"
+#include "to_chars.h"
+#include "write_formatted_rows.h"
 #include <cstdio>
-#include <fstream>
+
+namespace
+{
+  // Format "#corners i j k ...\n" for face f
+  template <typename DerivedF>
+  char * writeOFF_format_face(
+    const Eigen::PlainObjectBase<DerivedF>& F,
+    const size_t f,
+    char * p)
+  {
+    p = igl::to_chars(p,int(F.cols()));
+    for(int c = 0;c<F.cols();c++)
+    {
+      *p++ = ' ';
+      p = igl::to_chars(p,F(f,c));
+    }
+    *p++ = '\n';
+    return p;
+  }
+}
 
 // write mesh to an ascii off file
 template <typename DerivedV, typename DerivedF>
@@ -16,21 +37,34 @@ IGL_INLINE bool igl::writeOFF(
   const Eigen::PlainObjectBase<DerivedV>& V,
   const Eigen::PlainObjectBase<DerivedF>& F)
 {
-  using namespace std;
-  using namespace Eigen;
   assert(V.cols() == 3 && "V should have 3 columns");
-  ofstream s(fname);
-  if(!s.is_open())
+  FILE * fp = fopen(fname.c_str(),"w");
+  if(fp == NULL)
   {
     fprintf(stderr,"IOError: writeOFF() could not open %s\n",fname.c_str());
     return false;
   }
 
-  s<<
-    "OFF\n"<<V.rows()<<" "<<F.rows()<<" 0\n"<<
-    V.format(IOFormat(FullPrecision,DontAlignCols," ","\n","","","","\n"))<<
-    (F.array()).format(IOFormat(FullPrecision,DontAlignCols," ","\n","3 ","","","\n"));
-  return true;
+  fprintf(fp,"OFF\n%d %d 0\n",int(V.rows()),int(F.rows()));
+  const bool ok = 
+    write_formatted_rows(fp,V.rows(),V.cols()*(TO_CHARS_MAX_LENGTH+1),
+      [&V](const size_t i,char * p)
+      {
+        for(int c = 0;c<V.cols();c++)
+        {
+          if(c>0)
+          {
+            *p++ = ' ';
+          }
+          p = to_chars(p,V(i,c));
+        }
+        *p++ = '\n';
+        return p;
+      }) &&
+    write_formatted_rows(fp,F.rows(),(F.cols()+1)*(TO_CHARS_MAX_LENGTH+1),
+      [&F](const size_t f,char * p){ return writeOFF_format_face(F,f,p); });
+  fclose(fp);
+  return ok;
 }
 
 // write mesh and colors-by-vertex to an ascii off file
@@ -52,8 +86,8 @@ IGL_INLINE bool igl::writeOFF(
     return false;
   }
 
-  ofstream s(fname);
-  if(!s.is_open())
+  FILE * fp = fopen(fname.c_str(),"w");
+  if(fp == NULL)
   {
     fprintf(stderr,"IOError: writeOFF() could not open %s\n",fname.c_str());
     return false;
@@ -65,15 +99,31 @@ IGL_INLINE bool igl::writeOFF(
   // (https://github.com/libigl/libigl/pull/679)
   Eigen::MatrixXd RGB_Array = rgbScale * C;
 
-  s<< "COFF\n"<<V.rows()<<" "<<F.rows()<<" 0\n";
-  for (unsigned i=0; i< V.rows(); i++)
-  {
-    s <<V.row(i).format(IOFormat(FullPrecision,DontAlignCols," "," ","","",""," "));
-    s << unsigned(RGB_Array(i,0)) << " " << unsigned(RGB_Array(i,1)) << " " << unsigned(RGB_Array(i,2)) << " 255\n";
-  }
-
-  s<<(F.array()).format(IOFormat(FullPrecision,DontAlignCols," ","\n","3 ","","","\n"));
-  return true;
+  fprintf(fp,"COFF\n%d %d 0\n",int(V.rows()),int(F.rows()));
+  const bool ok = 
+    write_formatted_rows(fp,V.rows(),(V.cols()+4)*(TO_CHARS_MAX_LENGTH+1),
+      [&V,&RGB_Array](const size_t i,char * p)
+      {
+        for(int c = 0;c<V.cols();c++)
+        {
+          p = to_chars(p,V(i,c));
+          *p++ = ' ';
+        }
+        for(int c = 0;c<3;c++)
+        {
+          p = to_chars(p,unsigned(RGB_Array(i,c)));
+          *p++ = ' ';
+        }
+        *p++ = '2';
+        *p++ = '5';
+        *p++ = '5';
+        *p++ = '\n';
+        return p;
+      }) &&
+    write_formatted_rows(fp,F.rows(),(F.cols()+1)*(TO_CHARS_MAX_LENGTH+1),
+      [&F](const size_t f,char * p){ return writeOFF_format_face(F,f,p); });
+  fclose(fp);
+  return ok;
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -6,22 +6,82 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "writePLY.h"
-#include <vector>
-
-#include <igl/ply.h>
+#include "parallel_for.h"
+#include "to_chars.h"
+#include "write_formatted_rows.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
 #include <vector>
 
 namespace
 {
-  template <typename Scalar> int ply_type();
-  template <> int ply_type<char>(){ return PLY_CHAR; }
-  template <> int ply_type<short>(){ return PLY_SHORT; }
-  template <> int ply_type<int>(){ return PLY_INT; }
-  template <> int ply_type<unsigned char>(){ return PLY_UCHAR; }
-  template <> int ply_type<unsigned short>(){ return PLY_SHORT; }
-  template <> int ply_type<unsigned int>(){ return PLY_UINT; }
-  template <> int ply_type<float>(){ return PLY_FLOAT; }
-  template <> int ply_type<double>(){ return PLY_DOUBLE; }
+  // Name of the PLY scalar type of the given kind and size in bytes
+  const char * writePLY_type_name(
+    const bool is_float,
+    const bool is_signed,
+    const size_t size)
+  {
+    if(is_float)
+    {
+      return size == 4 ? "float" : "double";
+    }
+    switch(size)
+    {
+      case 1: return is_signed ? "char" : "uchar";
+      case 2: return is_signed ? "short" : "ushort";
+      default: return is_signed ? "int" : "uint";
+    }
+  }
+
+  template <typename Scalar>
+  const char * writePLY_type_name()
+  {
+    static_assert(
+      std::is_floating_point<Scalar>::value ?
+        sizeof(Scalar) == 4 || sizeof(Scalar) == 8 :
+        std::is_integral<Scalar>::value && sizeof(Scalar) <= 4,
+      "PLY only stores 8 to 32 bit integers and 32 or 64 bit floats");
+    return writePLY_type_name(
+      std::is_floating_point<Scalar>::value,
+      std::is_signed<Scalar>::value,
+      sizeof(Scalar));
+  }
+
+  // Copy the first cols entries of row i of X as Scalar to p
+  template <typename Scalar, typename DerivedX>
+  char * writePLY_copy_row(
+    const Eigen::MatrixBase<DerivedX> & X,
+    const size_t i,
+    const int cols,
+    char * p)
+  {
+    for(int j = 0;j<cols;j++)
+    {
+      const Scalar x = X(i,j);
+      std::memcpy(p,&x,sizeof(Scalar));
+      p += sizeof(Scalar);
+    }
+    return p;
+  }
+
+  // Format entries [begin,end) of row i of X, each after a space
+  template <typename DerivedX>
+  char * writePLY_format_row(
+    const Eigen::MatrixBase<DerivedX> & X,
+    const size_t i,
+    const int begin,
+    const int end,
+    char * p)
+  {
+    for(int j = begin;j<end;j++)
+    {
+      *p++ = ' ';
+      p = igl::to_chars(p,X(i,j));
+    }
+    return p;
+  }
 }
 
 template <
@@ -37,124 +97,113 @@ IGL_INLINE bool igl::writePLY(
   const Eigen::MatrixBase<DerivedUV> & UV,
   const bool ascii)
 {
-  // Largely based on obj2ply.c
   typedef typename DerivedV::Scalar VScalar;
   typedef typename DerivedN::Scalar NScalar;
   typedef typename DerivedUV::Scalar UVScalar;
   typedef typename DerivedF::Scalar FScalar;
-
-  typedef struct Vertex
-  {
-    VScalar x,y,z,w;          /* position */
-    NScalar nx,ny,nz;         /* surface normal */
-    UVScalar s,t;              /* texture coordinates */
-  } Vertex;
-
-  typedef struct Face
-  {
-    unsigned char nverts;    /* number of vertex indices in list */
-    FScalar *verts;              /* vertex index list */
-  } Face;
-
-  igl::ply::PlyProperty vert_props[] =
-  { /* list of property information for a vertex */
-    {"x", ply_type<VScalar>(), ply_type<VScalar>(),offsetof(Vertex,x),0,0,0,0},
-    {"y", ply_type<VScalar>(), ply_type<VScalar>(),offsetof(Vertex,y),0,0,0,0},
-    {"z", ply_type<VScalar>(), ply_type<VScalar>(),offsetof(Vertex,z),0,0,0,0},
-    {"nx",ply_type<NScalar>(), ply_type<NScalar>(),offsetof(Vertex,nx),0,0,0,0},
-    {"ny",ply_type<NScalar>(), ply_type<NScalar>(),offsetof(Vertex,ny),0,0,0,0},
-    {"nz",ply_type<NScalar>(), ply_type<NScalar>(),offsetof(Vertex,nz),0,0,0,0},
-    {"s", ply_type<UVScalar>(),ply_type<UVScalar>(),offsetof(Vertex,s),0,0,0,0},
-    {"t", ply_type<UVScalar>(),ply_type<UVScalar>(),offsetof(Vertex,t),0,0,0,0},
-  };
-
-  igl::ply::PlyProperty face_props[] =
-  { /* list of property information for a face */
-    {"vertex_indices", ply_type<FScalar>(), ply_type<FScalar>(),
-      offsetof(Face,verts), 1, PLY_UCHAR, PLY_UCHAR, offsetof(Face,nverts)},
-  };
   const bool has_normals = N.rows() > 0;
   const bool has_texture_coords = UV.rows() > 0;
-  std::vector<Vertex> vlist(V.rows());
-  std::vector<Face> flist(F.rows());
-  for(size_t i = 0;i<(size_t)V.rows();i++)
-  {
-    vlist[i].x = V(i,0);
-    vlist[i].y = V(i,1);
-    vlist[i].z = V(i,2);
-    if(has_normals)
-    {
-      vlist[i].nx = N(i,0);
-      vlist[i].ny = N(i,1);
-      vlist[i].nz = N(i,2);
-    }
-    if(has_texture_coords)
-    {
-      vlist[i].s = UV(i,0);
-      vlist[i].t = UV(i,1);
-    }
-  }
-  for(size_t i = 0;i<(size_t)F.rows();i++)
-  {
-    flist[i].nverts = F.cols();
-    flist[i].verts = new FScalar[F.cols()];
-    for(size_t c = 0;c<(size_t)F.cols();c++)
-    {
-      flist[i].verts[c] = F(i,c);
-    }
-  }
 
-  const char * elem_names[] = {"vertex","face"};
-  FILE * fp = fopen(filename.c_str(),"w");
+  FILE * fp = fopen(filename.c_str(),ascii ? "w" : "wb");
   if(fp==NULL)
   {
     return false;
   }
-  igl::ply::PlyFile * ply = igl::ply::ply_write(fp, 2,elem_names,
-      (ascii ? PLY_ASCII : PLY_BINARY_LE));
-  if(ply==NULL)
+  // Binary data is written in native byte order
+  const uint16_t endian_test = 1;
+  const bool little_endian = *reinterpret_cast<const char *>(&endian_test);
+  fprintf(fp,"ply\nformat %s 1.0\n",
+    ascii ? "ascii" :
+      (little_endian ? "binary_little_endian" : "binary_big_endian"));
+  fprintf(fp,"element vertex %d\n",int(V.rows()));
+  const char * vertex_props[] = {"x","y","z","nx","ny","nz","s","t"};
+  for(int p = 0;p<3;p++)
   {
-    return false;
+    fprintf(fp,"property %s %s\n",
+      writePLY_type_name<VScalar>(),vertex_props[p]);
   }
-
-  std::vector<igl::ply::PlyProperty> plist;
-  plist.push_back(vert_props[0]);
-  plist.push_back(vert_props[1]);
-  plist.push_back(vert_props[2]);
-  if (has_normals)
+  if(has_normals)
   {
-    plist.push_back(vert_props[3]);
-    plist.push_back(vert_props[4]);
-    plist.push_back(vert_props[5]);
+    for(int p = 3;p<6;p++)
+    {
+      fprintf(fp,"property %s %s\n",
+        writePLY_type_name<NScalar>(),vertex_props[p]);
+    }
   }
-  if (has_texture_coords)
+  if(has_texture_coords)
   {
-    plist.push_back(vert_props[6]);
-    plist.push_back(vert_props[7]);
+    for(int p = 6;p<8;p++)
+    {
+      fprintf(fp,"property %s %s\n",
+        writePLY_type_name<UVScalar>(),vertex_props[p]);
+    }
   }
-  ply_describe_element(ply, "vertex", V.rows(),plist.size(),
-    &plist[0]);
+  fprintf(fp,"element face %d\n",int(F.rows()));
+  fprintf(fp,"property list uchar %s vertex_indices\n",
+    writePLY_type_name<FScalar>());
+  fprintf(fp,"end_header\n");
 
-  ply_describe_element(ply, "face", F.rows(),1,&face_props[0]);
-  ply_header_complete(ply);
-  int native_binary_type = igl::ply::get_native_binary_type2();
-  ply_put_element_setup(ply, "vertex");
-  for(const auto v : vlist)
+  bool ok;
+  if(ascii)
   {
-    ply_put_element(ply, (void *) &v, &native_binary_type);
-  }
-  ply_put_element_setup(ply, "face");
-  for(const auto f : flist)
-  {
-    ply_put_element(ply, (void *) &f, &native_binary_type);
-  }
-
-  ply_close(ply);
-  for(size_t i = 0;i<(size_t)F.rows();i++)
+    ok = 
+      write_formatted_rows(fp,V.rows(),8*(TO_CHARS_MAX_LENGTH+1)+1,
+        [&](const size_t i,char * p)
+        {
+          p = to_chars(p,V(i,0));
+          p = writePLY_format_row(V,i,1,3,p);
+          if(has_normals)
+          {
+            p = writePLY_format_row(N,i,0,3,p);
+          }
+          if(has_texture_coords)
+          {
+            p = writePLY_format_row(UV,i,0,2,p);
+          }
+          *p++ = '\n';
+          return p;
+        }) &&
+      write_formatted_rows(fp,F.rows(),(F.cols()+1)*(TO_CHARS_MAX_LENGTH+1),
+        [&F](const size_t i,char * p)
+        {
+          p = to_chars(p,int(F.cols()));
+          p = writePLY_format_row(F,i,0,F.cols(),p);
+          *p++ = '\n';
+          return p;
+        });
+  }else
   {
-    delete[] flist[i].verts;
+    // Vertex and face records packed row after row
+    const size_t vertex_size = 3*sizeof(VScalar) + 
+      (has_normals ? 3*sizeof(NScalar) : 0) +
+      (has_texture_coords ? 2*sizeof(UVScalar) : 0);
+    const size_t face_size = 1 + F.cols()*sizeof(FScalar);
+    std::vector<char> buffer(V.rows()*vertex_size + F.rows()*face_size);
+    char * vertices = buffer.data();
+    char * faces = vertices + V.rows()*vertex_size;
+    parallel_for(V.rows(),[&](const int i)
+    {
+      char * p = vertices + i*vertex_size;
+      p = writePLY_copy_row<VScalar>(V,i,3,p);
+      if(has_normals)
+      {
+        p = writePLY_copy_row<NScalar>(N,i,3,p);
+      }
+      if(has_texture_coords)
+      {
+        p = writePLY_copy_row<UVScalar>(UV,i,2,p);
+      }
+    },10000);
+    parallel_for(F.rows(),[&](const int f)
+    {
+      char * p = faces + f*face_size;
+      *p++ = (unsigned char)F.cols();
+      writePLY_copy_row<FScalar>(F,f,F.cols(),p);
+    },10000);
+    ok = fwrite(buffer.data(),1,buffer.size(),fp) == buffer.size();
   }
-  return true;
+  fclose(fp);
+  return ok;
 }
 
 template <
@@ -21,6 +21,8 @@ namespace igl
   //   F  #F by 3 list of triangle indices
   //   N  #V by 3 list of vertex normals
   //   UV  #V by 2 list of vertex texture coordinates
+  //   ascii  write an ascii file {true}, otherwise binary in native byte
+  //     order with all elements written at once
   // Returns true iff success
   template <
     typename DerivedV,
@@ -0,0 +1,189 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "writePM.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+  inline void write_pm_varint(std::vector<unsigned char> & out, std::uint64_t x)
+  {
+    while(x >= 0x80)
+    {
+      out.push_back((unsigned char)(x | 0x80));
+      x >>= 7;
+    }
+    out.push_back((unsigned char)x);
+  }
+
+  inline void write_pm_float(std::vector<unsigned char> & out, const double x)
+  {
+    const float f = float(x);
+    std::uint32_t u;
+    std::memcpy(&u,&f,sizeof(u));
+    for(int b = 0;b<4;b++)
+    {
+      out.push_back((unsigned char)(u >> (8*b)));
+    }
+  }
+}
+
+IGL_INLINE bool igl::writePM(
+  const std::string & filename,
+  const Eigen::MatrixXd & U,
+  const Eigen::MatrixXi & G,
+  const std::vector<VertexSplit> & splits)
+{
+  std::ofstream out(filename,std::ios::binary);
+  if(!out)
+  {
+    fprintf(stderr,"IOError: writePM() could not open %s\n",filename.c_str());
+    return false;
+  }
+  return writePM(out,U,G,splits);
+}
+
+IGL_INLINE bool igl::writePM(
+  std::ostream & out,
+  const Eigen::MatrixXd & U,
+  const Eigen::MatrixXi & G,
+  const std::vector<VertexSplit> & splits)
+{
+  const int dim = U.cols();
+  if(G.size() > 0 && G.cols() != 3)
+  {
+    fprintf(stderr,"Error: writePM() only supports triangle meshes\n");
+    return false;
+  }
+  std::vector<unsigned char> buffer;
+  const char magic[6] = {'I','G','L','P','M',1};
+  buffer.insert(buffer.end(),magic,magic+6);
+  write_pm_varint(buffer,dim);
+  write_pm_varint(buffer,U.rows());
+  write_pm_varint(buffer,G.rows());
+  write_pm_varint(buffer,splits.size());
+  for(int u = 0;u<U.rows();u++)
+  {
+    for(int d = 0;d<dim;d++)
+    {
+      write_pm_float(buffer,U(u,d));
+    }
+  }
+  for(int g = 0;g<G.rows();g++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      write_pm_varint(buffer,G(g,c));
+    }
+  }
+  // Faces incident on each vertex, sorted by index, to encode which of them
+  // are split off
+  std::vector<std::vector<int> > VF(U.rows()+splits.size());
+  for(int g = 0;g<G.rows();g++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      VF[G(g,c)].push_back(g);
+    }
+  }
+  // Flush every so often rather than holding the whole file
+  const size_t flush_size = 1<<16;
+  int n = U.rows();
+  int m = G.rows();
+  for(const auto & split : splits)
+  {
+    const int t = n++;
+    if(split.s < 0 || split.s >= t)
+    {
+      fprintf(stderr,
+        "Error: writePM() split %d has invalid s\n",t-int(U.rows()));
+      return false;
+    }
+    write_pm_varint(buffer,split.s);
+    for(int d = 0;d<dim;d++)
+    {
+      write_pm_float(buffer,split.s_position(d));
+    }
+    for(int d = 0;d<dim;d++)
+    {
+      write_pm_float(buffer,split.t_position(d));
+    }
+    // Both lists are sorted: walk them together
+    std::vector<int> & Ls = VF[split.s];
+    std::vector<int> & Lt = VF[t];
+    std::vector<int> rest;
+    rest.reserve(Ls.size());
+    size_t j = 0;
+    unsigned char bits = 0;
+    for(size_t i = 0;i<Ls.size();i++)
+    {
+      const bool moved = j<split.faces.size() && split.faces[j] == Ls[i];
+      if(moved)
+      {
+        bits |= 1<<(i%8);
+        Lt.push_back(Ls[i]);
+        j++;
+      }else
+      {
+        rest.push_back(Ls[i]);
+      }
+      if(i%8 == 7 || i+1 == Ls.size())
+      {
+        buffer.push_back(bits);
+        bits = 0;
+      }
+    }
+    if(j != split.faces.size())
+    {
+      fprintf(stderr,
+        "Error: writePM() split %d moves faces not incident on s\n",
+        t-int(U.rows()));
+      return false;
+    }
+    Ls.swap(rest);
+    write_pm_varint(buffer,split.new_faces.rows());
+    for(int i = 0;i<split.new_faces.rows();i++)
+    {
+      // Rotate the face to start at s
+      int c = 0;
+      while(c<3 && split.new_faces(i,c) != split.s)
+      {
+        c++;
+      }
+      const int a = c<3 ? split.new_faces(i,(c+1)%3) : -1;
+      const int b = c<3 ? split.new_faces(i,(c+2)%3) : -1;
+      if(a == t && b != t && b >= 0)
+      {
+        write_pm_varint(buffer,2*std::uint64_t(b));
+        VF[b].push_back(m);
+      }else if(b == t && a != t && a >= 0)
+      {
+        write_pm_varint(buffer,2*std::uint64_t(a)+1);
+        VF[a].push_back(m);
+      }else
+      {
+        fprintf(stderr,
+          "Error: writePM() new face of split %d does not contain s and t\n",
+          t-int(U.rows()));
+        return false;
+      }
+      Ls.push_back(m);
+      Lt.push_back(m);
+      m++;
+    }
+    if(buffer.size() >= flush_size)
+    {
+      out.write((const char *)buffer.data(),buffer.size());
+      buffer.clear();
+    }
+  }
+  out.write((const char *)buffer.data(),buffer.size());
+  return bool(out);
+}
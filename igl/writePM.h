@@ -0,0 +1,69 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_WRITEPM_H
+#define IGL_WRITEPM_H
+#include "igl_inline.h"
+#include "VertexSplit.h"
+#include <Eigen/Core>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace igl
+{
+  // Write a progressive mesh, a base mesh followed by its vertex splits, to a
+  // compact binary .pm file. The base mesh comes first so that a reader can
+  // display it as soon as it arrives and then refine it one split at a time
+  // (see ProgressiveMeshReader).
+  //
+  // Layout, all integers as unsigned LEB128 varints and all reals as little
+  // endian 32-bit floats:
+  //   "IGLPM" 1  magic and version (6 bytes)
+  //   dim #U #G #splits
+  //   U  #U*dim positions, row after row
+  //   G  #G*3 indices
+  //   for each split:
+  //     s  s_position  t_position
+  //     faces  one bit per face incident on s before the split, in order of
+  //       face index, packed in ceil(#incident/8) bytes, least significant
+  //       bit first
+  //     #new_faces  new faces, each (s,t,o) as 2*o and each (s,o,t) as 2*o+1
+  //
+  // Positions are rounded to single precision and the corners of new faces
+  // are rotated to start at s. Birth indices are not written. Reading
+  // requires tracking the faces incident on each vertex as the splits are
+  // applied.
+  //
+  // Inputs:
+  //   filename  path to .pm file
+  //   U  #U by dim list of base vertex positions
+  //   G  #G by 3 list of base face indices into U
+  //   splits  list of vertex splits refining (U,G), each new face must contain
+  //     s and t as do those output by decimate and qslim
+  // Returns true on success, false on errors
+  //
+  // See also: decimate, qslim, readPM
+  IGL_INLINE bool writePM(
+    const std::string & filename,
+    const Eigen::MatrixXd & U,
+    const Eigen::MatrixXi & G,
+    const std::vector<VertexSplit> & splits);
+  // Inputs:
+  //   out  binary stream to write to
+  IGL_INLINE bool writePM(
+    std::ostream & out,
+    const Eigen::MatrixXd & U,
+    const Eigen::MatrixXi & G,
+    const std::vector<VertexSplit> & splits);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "writePM.cpp"
+#endif
+
+#endif
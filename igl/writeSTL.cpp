@@ -6,7 +6,13 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "writeSTL.h"
+#include "parallel_for.h"
+#include "to_chars.h"
+#include "write_formatted_rows.h"
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 template <typename DerivedV, typename DerivedF, typename DerivedN>
 IGL_INLINE bool igl::writeSTL(
@@ -26,34 +32,39 @@ IGL_INLINE bool igl::writeSTL(
       cerr<<"IOError: "<<filename<<" could not be opened for writing."<<endl;
       return false;
     }
-    fprintf(stl_file,"solid %s\n",filename.c_str());
-    for(int f = 0;f<F.rows();f++)
+    const auto & append = [](char * p, const char * s)
     {
-      fprintf(stl_file,"facet normal ");
-      if(N.rows()>0)
-      {
-        fprintf(stl_file,"%e %e %e\n",
-          (float)N(f,0),
-          (float)N(f,1),
-          (float)N(f,2));
-      }else
-      {
-        fprintf(stl_file,"0 0 0\n");
-      }
-      fprintf(stl_file,"outer loop\n");
-      for(int c = 0;c<F.cols();c++)
+      const size_t n = strlen(s);
+      memcpy(p,s,n);
+      return p+n;
+    };
+    fprintf(stl_file,"solid %s\n",filename.c_str());
+    const bool ok = write_formatted_rows(stl_file,F.rows(),
+      64+(F.cols()+1)*(16+3*(TO_CHARS_MAX_LENGTH+1)),
+      [&](const size_t f,char * p)
       {
-        fprintf(stl_file,"vertex %e %e %e\n",
-          (float)V(F(f,c),0),
-          (float)V(F(f,c),1),
-          (float)V(F(f,c),2));
-      }
-      fprintf(stl_file,"endloop\n");
-      fprintf(stl_file,"endfacet\n");
-    }
+        p = append(p,"facet normal");
+        for(int d = 0;d<3;d++)
+        {
+          *p++ = ' ';
+          p = N.rows()>0 ? to_chars(p,(float)N(f,d)) : append(p,"0");
+        }
+        p = append(p,"\nouter loop\n");
+        for(int c = 0;c<F.cols();c++)
+        {
+          p = append(p,"vertex");
+          for(int d = 0;d<3;d++)
+          {
+            *p++ = ' ';
+            p = to_chars(p,(float)V(F(f,c),d));
+          }
+          *p++ = '\n';
+        }
+        return append(p,"endloop\nendfacet\n");
+      });
     fprintf(stl_file,"endsolid %s\n",filename.c_str());
     fclose(stl_file);
-    return true;
+    return ok;
   }else
   {
     FILE * stl_file = fopen(filename.c_str(),"wb");
@@ -62,39 +73,43 @@ IGL_INLINE bool igl::writeSTL(
       cerr<<"IOError: "<<filename<<" could not be opened for writing."<<endl;
       return false;
     }
-    // Write unused 80-char header
+    assert(F.cols() == 3);
+    // 80-char header, number of triangles and 50 bytes per triangle: normal,
+    // corners and attribute byte count, filled in parallel and written at
+    // once
+    const size_t triangle_size = 12*sizeof(float)+sizeof(uint16_t);
+    std::vector<char> buffer(80+sizeof(uint32_t)+F.rows()*triangle_size,0);
     for(char h = 0;h<80;h++)
     {
-      fwrite(&h,sizeof(char),1,stl_file);
+      buffer[h] = h;
     }
-    // Write number of triangles
-    unsigned int num_tri = F.rows();
-    fwrite(&num_tri,sizeof(unsigned int),1,stl_file);
-    assert(F.cols() == 3);
-    // Write each triangle
-    for(int f = 0;f<F.rows();f++)
+    const uint32_t num_tri = F.rows();
+    memcpy(&buffer[80],&num_tri,sizeof(uint32_t));
+    char * triangles = &buffer[80+sizeof(uint32_t)];
+    parallel_for(F.rows(),[&](const int f)
     {
-      vector<float> n(3,0);
+      float t[12] = {0,0,0};
       if(N.rows() > 0)
       {
-        n[0] = N(f,0);
-        n[1] = N(f,1);
-        n[2] = N(f,2);
+        for(int d = 0;d<3;d++)
+        {
+          t[d] = N(f,d);
+        }
       }
-      fwrite(&n[0],sizeof(float),3,stl_file);
       for(int c = 0;c<3;c++)
       {
-        vector<float> v(3);
-        v[0] = V(F(f,c),0);
-        v[1] = V(F(f,c),1);
-        v[2] = V(F(f,c),2);
-        fwrite(&v[0],sizeof(float),3,stl_file);
+        for(int d = 0;d<3;d++)
+        {
+          t[3+3*c+d] = V(F(f,c),d);
+        }
       }
-      unsigned short att_count = 0;
-      fwrite(&att_count,sizeof(unsigned short),1,stl_file);
-    }
+      // attribute byte count stays zero
+      memcpy(triangles+f*triangle_size,t,sizeof(t));
+    },10000);
+    const bool ok =
+      fwrite(buffer.data(),1,buffer.size(),stl_file) == buffer.size();
     fclose(stl_file);
-    return true;
+    return ok;
   }
 }
 
@@ -27,7 +27,8 @@ namespace igl
   //   V  double matrix of vertex positions  #F*3 by 3
   //   F  index matrix of triangle indices #F by 3
   //   N  double matrix of vertex positions  #F by 3
-  //   asci  write ascii file {true}
+  //   asci  write ascii file {true}, otherwise binary with all triangles
+  //     written at once
   // Returns true on success, false on errors
   //
   template <typename DerivedV, typename DerivedF, typename DerivedN>
@@ -0,0 +1,91 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_WRITE_FORMATTED_ROWS_H
+#define IGL_WRITE_FORMATTED_ROWS_H
+#include <cstdio>
+
+namespace igl
+{
+  // Write the rows of a text file (e.g. the vertex lines of an .obj) by
+  // formatting blocks of rows into memory buffers, blocks in parallel, and
+  // writing each buffer with a single fwrite, in order. Meant to be used with
+  // to_chars rather than fprintf for each number.
+  //
+  // Inputs:
+  //   fp  file open for writing
+  //   num_rows  number of rows
+  //   max_row_length  upper bound on the number of characters of a row
+  //   format_row  function handle writing row i starting at first and
+  //     returning the position past its last character:
+  //       char * format_row(const size_t i, char * first)
+  // Returns true iff all rows were written
+  //
+  // See also: to_chars, parallel_for
+  template <typename FormatFunctionType>
+  inline bool write_formatted_rows(
+    FILE * fp,
+    const size_t num_rows,
+    const size_t max_row_length,
+    const FormatFunctionType & format_row);
+}
+
+// Implementation
+
+#include "parallel_for.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+template <typename FormatFunctionType>
+inline bool igl::write_formatted_rows(
+  FILE * fp,
+  const size_t num_rows,
+  const size_t max_row_length,
+  const FormatFunctionType & format_row)
+{
+  if(num_rows == 0)
+  {
+    return true;
+  }
+  // Blocks of about a megabyte, one block per thread at a time
+  const size_t block_rows = std::min(
+    num_rows,
+    std::max<size_t>(1,(size_t(1)<<20)/std::max<size_t>(1,max_row_length)));
+  const size_t num_blocks = (num_rows+block_rows-1)/block_rows;
+  const static size_t sthc = std::thread::hardware_concurrency();
+  const size_t batch_size = std::max<size_t>(1,std::min(sthc,num_blocks));
+  std::vector<std::vector<char> > buffers(
+    batch_size,std::vector<char>(block_rows*max_row_length));
+  std::vector<size_t> lengths(batch_size);
+  for(size_t b0 = 0;b0<num_blocks;b0+=batch_size)
+  {
+    const size_t nb = std::min(batch_size,num_blocks-b0);
+    parallel_for(nb,[&](const size_t b)
+    {
+      char * first = buffers[b].data();
+      char * last = first;
+      const size_t begin = (b0+b)*block_rows;
+      const size_t end = std::min(num_rows,begin+block_rows);
+      for(size_t i = begin;i<end;i++)
+      {
+        last = format_row(i,last);
+      }
+      lengths[b] = last-first;
+    },2);
+    for(size_t b = 0;b<nb;b++)
+    {
+      if(fwrite(buffers[b].data(),1,lengths[b],fp) != lengths[b])
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+#endif
@@ -0,0 +1,175 @@
+#include <test_common.h>
+#include <igl/FastWindingNumber.h>
+#include <igl/AABB.h>
+#include <igl/doublearea.h>
+#include <igl/per_vertex_normals.h>
+#include <igl/signed_distance.h>
+#include <igl/winding_number.h>
+#include <vector>
+
+namespace
+{
+  // Query points inside, near and outside the unit sphere
+  Eigen::MatrixXd sphere_queries()
+  {
+    srand(0);
+    Eigen::MatrixXd Q = Eigen::MatrixXd::Random(300,3);
+    Q.rowwise().normalize();
+    const Eigen::VectorXd r =
+      (Eigen::VectorXd::Random(Q.rows()).array()+1.)*1.5;
+    return Q.array().colwise()*r.array();
+  }
+}
+
+IGL_TEST_CASE("triangles")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(40,20,V,F);
+  const Eigen::MatrixXd Q = sphere_queries();
+  Eigen::VectorXd W_exact;
+  igl::winding_number(V,F,Q,W_exact);
+  for(const int order : {0,1,2})
+  {
+    igl::FastWindingNumber fwn(order,8);
+    fwn.build(V,F);
+    IGL_TEST_CHECK(fwn.size() == F.rows());
+    Eigen::VectorXd W;
+    // Direct summation is exact
+    fwn.winding_number(Q,W,0);
+    IGL_TEST_CHECK_CLOSE(W,W_exact,1e-10);
+    fwn.winding_number(Q,W);
+    IGL_TEST_CHECK_CLOSE(W,W_exact,order == 2 ? 0.01 : 0.1);
+    for(int q = 0;q<Q.rows();q += 37)
+    {
+      IGL_TEST_CHECK(fwn.winding_number(Eigen::RowVector3d(Q.row(q))) == W(q));
+    }
+  }
+}
+
+IGL_TEST_CASE("triangle_moments")
+{
+  // The expansions of a triangle must match those of many point dipoles
+  // sampled over it, so that only the truncation of the series is left
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(8,5,V,F);
+  V.col(0) *= 1.3;
+  const int n = 20;
+  std::vector<Eigen::RowVector3d> samples,normals;
+  std::vector<double> areas;
+  for(int f = 0;f<F.rows();f++)
+  {
+    const Eigen::RowVector3d a = V.row(F(f,0)), b = V.row(F(f,1)),
+      c = V.row(F(f,2));
+    const Eigen::RowVector3d an = 0.5*(b-a).cross(c-a);
+    // Centroids of the n*n congruent sub-triangles
+    for(int i = 0;i<n;i++)
+    {
+      for(int j = 0;i+j<n;j++)
+      {
+        for(const double o : {1./3.,2./3.})
+        {
+          if(o > 0.5 && i+j == n-1)
+          {
+            continue;
+          }
+          samples.push_back(a+(i+o)/n*(b-a)+(j+o)/n*(c-a));
+          normals.push_back(an.normalized());
+          areas.push_back(an.norm()/(n*n));
+        }
+      }
+    }
+  }
+  Eigen::MatrixXd P(samples.size(),3),N(samples.size(),3);
+  Eigen::VectorXd A(samples.size());
+  for(size_t s = 0;s<samples.size();s++)
+  {
+    P.row(s) = samples[s];
+    N.row(s) = normals[s];
+    A(s) = areas[s];
+  }
+  Eigen::MatrixXd Q(3,3);
+  Q <<
+    3,0.5,1,
+    -3,1,2,
+    1,1,6;
+  for(const int order : {0,1,2})
+  {
+    // One cell, always approximated by its expansion
+    igl::FastWindingNumber fwn_triangles(order,1<<30),fwn_points(order,1<<30);
+    fwn_triangles.build(V,F);
+    fwn_points.build(P,N,A);
+    Eigen::VectorXd W_triangles,W_points;
+    fwn_triangles.winding_number(Q,W_triangles,0.5);
+    fwn_points.winding_number(Q,W_points,0.5);
+    IGL_TEST_CHECK_CLOSE(W_triangles,W_points,1e-7);
+  }
+}
+
+IGL_TEST_CASE("points")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(80,40,V,F);
+  Eigen::MatrixXd N;
+  igl::per_vertex_normals(V,F,N);
+  Eigen::VectorXd dblA;
+  igl::doublearea(V,F,dblA);
+  // Barycentric area of each vertex
+  Eigen::VectorXd A = Eigen::VectorXd::Zero(V.rows());
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      A(F(f,c)) += dblA(f)/6.;
+    }
+  }
+  igl::FastWindingNumber fwn;
+  fwn.build(V,N,A);
+  IGL_TEST_CHECK(fwn.size() == V.rows());
+  const Eigen::MatrixXd Q = sphere_queries();
+  Eigen::VectorXd W,W_direct;
+  fwn.winding_number(Q,W);
+  fwn.winding_number(Q,W_direct,0);
+  IGL_TEST_CHECK_CLOSE(W,W_direct,0.01);
+  for(int q = 0;q<Q.rows();q++)
+  {
+    // Away from the points a point cloud approximates the surface
+    const double r = Q.row(q).norm();
+    if(r < 0.8 || r > 1.2)
+    {
+      IGL_TEST_CHECK(std::abs(W(q)-(r < 1 ? 1 : 0)) < 0.1);
+    }
+  }
+}
+
+IGL_TEST_CASE("signed_distance_sign")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(30,15,V,F);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  igl::FastWindingNumber fwn;
+  fwn.build(V,F);
+  igl::WindingNumberAABB<Eigen::RowVector3d,Eigen::MatrixXd,Eigen::MatrixXi>
+    hier;
+  hier.set_mesh(V,F);
+  hier.grow();
+  const Eigen::MatrixXd Q = sphere_queries();
+  for(int q = 0;q<Q.rows();q++)
+  {
+    const Eigen::RowVector3d p = Q.row(q);
+    double s,sqrd,s_hier,sqrd_hier;
+    int i,i_hier;
+    Eigen::RowVector3d c,c_hier;
+    igl::signed_distance_winding_number(tree,V,F,fwn,p,s,sqrd,i,c);
+    igl::signed_distance_winding_number(
+      tree,V,F,hier,p,s_hier,sqrd_hier,i_hier,c_hier);
+    // The hierarchy returns 1-2w rather than only its sign
+    IGL_TEST_CHECK((s < 0) == (s_hier < 0));
+    IGL_TEST_CHECK(s == (p.norm() < 1 ? -1 : 1));
+    IGL_TEST_CHECK(sqrd == sqrd_hier && i == i_hier);
+  }
+}
@@ -0,0 +1,63 @@
+#include <test_common.h>
+#include <igl/GeodesicService.h>
+#include <igl/fast_marching.h>
+#include <igl/heat_geodesics.h>
+#include <vector>
+
+IGL_TEST_CASE("matches_direct_calls")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(20,10,V,F);
+  std::vector<Eigen::VectorXi> gammas(2);
+  gammas[0] = Eigen::VectorXi::Constant(1,5);
+  gammas[1].resize(2);
+  gammas[1] << 0, V.rows()-2;
+
+  igl::GeodesicService geodesics;
+  geodesics.set_mesh(7,V,F);
+  IGL_TEST_CHECK(geodesics.has_mesh(7));
+
+  igl::HeatGeodesicsData<double> data;
+  igl::heat_geodesics_precompute(V,F,data);
+  Eigen::MatrixXd D,D_direct;
+  IGL_TEST_CHECK(geodesics.distances(7,gammas,D));
+  igl::heat_geodesics_solve(data,gammas,D_direct);
+  IGL_TEST_CHECK_CLOSE(D,D_direct,1e-10);
+  // Later queries reuse the factorization
+  IGL_TEST_CHECK(geodesics.distances(7,gammas,D));
+  IGL_TEST_CHECK_CLOSE(D,D_direct,1e-10);
+
+  IGL_TEST_CHECK(geodesics.distances(
+    7,gammas,D,igl::GeodesicService::GEODESIC_FAST_MARCHING));
+  IGL_TEST_CHECK(D.rows() == V.rows() && D.cols() == 2);
+  for(int s = 0;s<2;s++)
+  {
+    Eigen::VectorXd Ds;
+    igl::fast_marching(V,F,gammas[s],Ds);
+    IGL_TEST_CHECK_CLOSE(D.col(s),Ds,0);
+  }
+}
+
+IGL_TEST_CASE("replace_and_erase")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::grid(5,V,F);
+  igl::GeodesicService geodesics;
+  Eigen::MatrixXd D;
+  const std::vector<Eigen::VectorXi> gammas(1,Eigen::VectorXi::Zero(1));
+  IGL_TEST_CHECK(!geodesics.distances(0,gammas,D));
+  geodesics.set_mesh(0,V,F);
+  IGL_TEST_CHECK(geodesics.precompute(0));
+  IGL_TEST_CHECK(geodesics.distances(0,gammas,D));
+  // Replacing the mesh drops the old factorization
+  const Eigen::MatrixXd V2 = 2*V;
+  geodesics.set_mesh(0,V2,F);
+  Eigen::MatrixXd D2;
+  IGL_TEST_CHECK(geodesics.distances(0,gammas,D2));
+  IGL_TEST_CHECK_CLOSE(D2,2*D,1e-8);
+  geodesics.erase_mesh(0);
+  IGL_TEST_CHECK(!geodesics.has_mesh(0));
+  IGL_TEST_CHECK(!geodesics.distances(0,gammas,D));
+}
@@ -0,0 +1,140 @@
+#include <test_common.h>
+#include <igl/PointIndex.h>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  // Compares the queries of index with brute force over the points P(i,:)
+  // with alive(i)
+  void check_against_brute_force(
+    const igl::PointIndex & index,
+    const Eigen::MatrixXd & P,
+    const std::vector<bool> & alive,
+    const Eigen::MatrixXd & Q)
+  {
+    const int k = 5;
+    const double radius = 0.3;
+    Eigen::MatrixXi I;
+    Eigen::MatrixXd sqrD;
+    index.knn(Q,k,I,sqrD);
+    std::vector<std::vector<int> > R;
+    index.radius_search(Q,radius,R);
+    IGL_TEST_CHECK(I.rows() == Q.rows() && I.cols() == k);
+    IGL_TEST_CHECK(R.size() == (size_t)Q.rows());
+    for(int q = 0;q<Q.rows();q++)
+    {
+      std::vector<std::pair<double,int> > D;
+      std::vector<int> R_brute;
+      for(int i = 0;i<P.rows();i++)
+      {
+        if(!alive[i])
+        {
+          continue;
+        }
+        const double d = (P.row(i)-Q.row(q)).squaredNorm();
+        D.emplace_back(d,i);
+        if(d <= radius*radius)
+        {
+          R_brute.push_back(i);
+        }
+      }
+      std::sort(D.begin(),D.end());
+      for(int j = 0;j<k;j++)
+      {
+        if(j < (int)D.size())
+        {
+          IGL_TEST_CHECK(I(q,j) == D[j].second);
+          IGL_TEST_CHECK(sqrD(q,j) == D[j].first);
+        }else
+        {
+          IGL_TEST_CHECK(I(q,j) == -1);
+          IGL_TEST_CHECK(sqrD(q,j) == std::numeric_limits<double>::infinity());
+        }
+      }
+      std::vector<int> Rq = R[q];
+      std::sort(Rq.begin(),Rq.end());
+      IGL_TEST_CHECK(Rq == R_brute);
+    }
+  }
+}
+
+IGL_TEST_CASE("queries_match_brute_force")
+{
+  srand(0);
+  Eigen::MatrixXd P = Eigen::MatrixXd::Random(500,3);
+  const Eigen::MatrixXd Q = 1.2*Eigen::MatrixXd::Random(50,3);
+  std::vector<bool> alive(P.rows(),true);
+  igl::PointIndex index(8);
+  index.build(P);
+  IGL_TEST_CHECK(index.size() == P.rows());
+  check_against_brute_force(index,P,alive,Q);
+
+  // Small moves stay in their cells, large ones leave the root cell
+  P += 0.01*Eigen::MatrixXd::Random(P.rows(),3);
+  P.topRows(20) *= 4;
+  index.update(P);
+  check_against_brute_force(index,P,alive,Q);
+
+  for(int i = 0;i<P.rows();i += 3)
+  {
+    IGL_TEST_CHECK(index.remove(i));
+    alive[i] = false;
+  }
+  IGL_TEST_CHECK(!index.remove(0));
+  IGL_TEST_CHECK(!index.contains(0) && index.contains(1));
+  check_against_brute_force(index,P,alive,Q);
+
+  // Removed ids are reused
+  const Eigen::RowVector3d p(0.1,0.2,0.3);
+  const int id = index.insert(p);
+  IGL_TEST_CHECK(id >= 0 && id < P.rows() && !alive[id]);
+  P.row(id) = p;
+  alive[id] = true;
+  IGL_TEST_CHECK(index.point(id) == p);
+  IGL_TEST_CHECK(index.update(1,Eigen::RowVector3d(5,5,5)));
+  P.row(1) << 5,5,5;
+  IGL_TEST_CHECK(index.size() == (int)std::count(alive.begin(),alive.end(),true));
+  check_against_brute_force(index,P,alive,Q);
+}
+
+IGL_TEST_CASE("fewer_points_than_k")
+{
+  Eigen::MatrixXd P(3,3);
+  P <<
+    0,0,0,
+    1,0,0,
+    0,2,0;
+  igl::PointIndex index;
+  index.build(P);
+  const std::vector<bool> alive(3,true);
+  check_against_brute_force(index,P,alive,Eigen::MatrixXd::Zero(2,3));
+  index.clear();
+  IGL_TEST_CHECK(index.size() == 0);
+  check_against_brute_force(
+    index,Eigen::MatrixXd(0,3),std::vector<bool>(),Eigen::MatrixXd::Ones(1,3));
+}
+
+IGL_TEST_CASE("non_finite_points_are_rejected")
+{
+  Eigen::MatrixXd P(2,3);
+  P <<
+    0,0,0,
+    1,1,1;
+  igl::PointIndex index;
+  index.build(P);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  IGL_TEST_CHECK(index.insert(Eigen::RowVector3d(nan,0,0)) == -1);
+  IGL_TEST_CHECK(index.insert(Eigen::RowVector3d(0,inf,0)) == -1);
+  IGL_TEST_CHECK(!index.update(0,Eigen::RowVector3d(0,0,-inf)));
+  IGL_TEST_CHECK(index.size() == 2);
+  IGL_TEST_CHECK(index.point(0) == P.row(0));
+  Eigen::MatrixXd Q = P;
+  Q.row(1) << nan,nan,nan;
+  index.update(Q);
+  IGL_TEST_CHECK(index.point(1) == P.row(1));
+  check_against_brute_force(index,P,std::vector<bool>(2,true),P);
+}
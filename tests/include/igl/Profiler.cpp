@@ -0,0 +1,119 @@
+#include <test_common.h>
+#include <igl/Profiler.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+IGL_TEST_CASE("nested_scopes")
+{
+  igl::Profiler profiler(64);
+  profiler.begin_frame();
+  {
+    igl::Profiler::Scope outer(profiler,"outer");
+    {
+      igl::Profiler::Scope inner(profiler,"inner");
+    }
+  }
+  profiler.end_frame();
+  std::vector<igl::Profiler::Event> E;
+  profiler.events(E);
+  // Scopes are recorded when they end: inner, outer, then the frame
+  IGL_TEST_CHECK(E.size() == 3);
+  if(E.size() != 3)
+  {
+    return;
+  }
+  IGL_TEST_CHECK(std::strcmp(E[0].name,"inner") == 0);
+  IGL_TEST_CHECK(std::strcmp(E[1].name,"outer") == 0);
+  IGL_TEST_CHECK(std::strcmp(E[2].name,"frame") == 0);
+  IGL_TEST_CHECK(E[0].depth == 2);
+  IGL_TEST_CHECK(E[1].depth == 1);
+  IGL_TEST_CHECK(E[2].depth == 0);
+  IGL_TEST_CHECK(E[1].begin <= E[0].begin && E[0].end <= E[1].end);
+  IGL_TEST_CHECK(E[2].begin <= E[1].begin && E[1].end <= E[2].end);
+}
+
+IGL_TEST_CASE("ring_buffer_keeps_newest")
+{
+  igl::Profiler profiler(8);
+  for(int i = 0;i<20;i++)
+  {
+    profiler.record("event",i,i+1,0);
+  }
+  std::vector<igl::Profiler::Event> E;
+  profiler.events(E);
+  IGL_TEST_CHECK(E.size() == 8);
+  for(size_t e = 0;e<E.size();e++)
+  {
+    IGL_TEST_CHECK(E[e].begin == 12+double(e));
+  }
+}
+
+IGL_TEST_CASE("disabled")
+{
+  igl::Profiler profiler(8);
+  profiler.enabled = false;
+  profiler.record("event",0,1,0);
+  std::vector<igl::Profiler::Event> E;
+  profiler.events(E);
+  IGL_TEST_CHECK(E.empty());
+}
+
+IGL_TEST_CASE("percentiles")
+{
+  igl::Profiler profiler(256);
+  for(int i = 1;i<=100;i++)
+  {
+    profiler.record("scope",0,i,0);
+  }
+  IGL_TEST_CHECK(profiler.scope_percentile("scope",50) == 50);
+  IGL_TEST_CHECK(profiler.scope_percentile("scope",99) == 99);
+  IGL_TEST_CHECK(profiler.scope_percentile("scope",100) == 100);
+  IGL_TEST_CHECK(profiler.scope_percentile("other",50) == 0);
+  IGL_TEST_CHECK(profiler.frame_percentile(50) == 0);
+}
+
+IGL_TEST_CASE("concurrent_record_and_read")
+{
+  // Readers must only ever see complete events, even while writers keep
+  // overwriting the slots they are copying
+  igl::Profiler profiler(64);
+  std::atomic<bool> done(false);
+  std::vector<std::thread> writers;
+  for(int t = 0;t<3;t++)
+  {
+    writers.emplace_back([&profiler,t]()
+    {
+      for(int i = 0;i<20000;i++)
+      {
+        const double b = t*1e6+i;
+        profiler.record("event",b,b+0.5,t);
+      }
+    });
+  }
+  bool consistent = true;
+  std::thread reader([&]()
+  {
+    std::vector<igl::Profiler::Event> E;
+    while(!done)
+    {
+      profiler.events(E);
+      for(const auto & e : E)
+      {
+        if(e.name == nullptr || e.end != e.begin+0.5 ||
+          e.depth != int(e.begin/1e6))
+        {
+          consistent = false;
+        }
+      }
+    }
+  });
+  for(auto & w : writers)
+  {
+    w.join();
+  }
+  done = true;
+  reader.join();
+  IGL_TEST_CHECK(consistent);
+}
@@ -0,0 +1,58 @@
+#include <test_common.h>
+#include <igl/SparseSignedDistance.h>
+#include <igl/signed_distance.h>
+#include <cmath>
+#include <vector>
+
+IGL_TEST_CASE("band_values")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(40,20,V,F);
+  const double h = 0.05, band = 0.15;
+  igl::SparseSignedDistance sdf(4);
+  sdf.build(V,F,h,band);
+  IGL_TEST_CHECK(sdf.num_blocks() > 0);
+  IGL_TEST_CHECK(sdf.spacing() == h && sdf.band() == band);
+  // Every sample of the lattice around the sphere, against the dense signed
+  // distance
+  const int r = 24;
+  std::vector<Eigen::RowVector3i> samples;
+  for(int i = -r;i<=r;i++)
+  {
+    for(int j = -r;j<=r;j++)
+    {
+      for(int k = -r;k<=r;k++)
+      {
+        samples.emplace_back(i,j,k);
+      }
+    }
+  }
+  Eigen::MatrixXd P(samples.size(),3);
+  for(size_t s = 0;s<samples.size();s++)
+  {
+    P.row(s) = h*samples[s].cast<double>();
+  }
+  Eigen::VectorXd S,I;
+  Eigen::MatrixXd C,N;
+  igl::signed_distance(
+    P,V,F,igl::SIGNED_DISTANCE_TYPE_WINDING_NUMBER,S,I,C,N);
+  int num_in_band = 0;
+  for(size_t s = 0;s<samples.size();s++)
+  {
+    double value;
+    const bool found = sdf.value(samples[s],value);
+    if(std::abs(S(s)) < band-1e-6)
+    {
+      // Values are stored in single precision
+      IGL_TEST_CHECK(found && std::abs(value-S(s)) < 1e-6);
+      num_in_band++;
+    }else if(found)
+    {
+      IGL_TEST_CHECK(std::abs(value) < band+1e-6);
+    }
+  }
+  IGL_TEST_CHECK(num_in_band > 0);
+  double value;
+  IGL_TEST_CHECK(!sdf.value(Eigen::RowVector3i(0,0,0),value));
+}
@@ -0,0 +1,63 @@
+#include <test_common.h>
+#include <igl/Subdivision.h>
+#include <igl/loop.h>
+#include <igl/upsample.h>
+
+IGL_TEST_CASE("matches_loop_and_upsample")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(8,5,V,F);
+  V.col(0) *= 1.5;
+  for(const auto scheme : {
+    igl::Subdivision::SUBDIVISION_LOOP,
+    igl::Subdivision::SUBDIVISION_UPSAMPLE})
+  {
+    for(int levels = 1;levels<=3;levels++)
+    {
+      Eigen::MatrixXd NV_expected;
+      Eigen::MatrixXi NF_expected;
+      if(scheme == igl::Subdivision::SUBDIVISION_LOOP)
+      {
+        igl::loop(V,F,NV_expected,NF_expected,levels);
+      }else
+      {
+        igl::upsample(V,F,NV_expected,NF_expected,levels);
+      }
+      igl::Subdivision subdivision;
+      subdivision.precompute(V.rows(),F,levels,scheme);
+      IGL_TEST_CHECK(subdivision.rows() == NV_expected.rows());
+      IGL_TEST_CHECK(subdivision.num_faces() == NF_expected.rows());
+      Eigen::MatrixXd NV;
+      Eigen::MatrixXi NF;
+      subdivision.apply(V,NV);
+      subdivision.faces(NF);
+      IGL_TEST_CHECK_CLOSE(NV,NV_expected,1e-12);
+      IGL_TEST_CHECK_CLOSE(NF,NF_expected,0);
+    }
+  }
+}
+
+IGL_TEST_CASE("new_poses")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(8,5,V,F);
+  igl::Subdivision subdivision;
+  subdivision.precompute(V.rows(),F,2);
+  srand(0);
+  for(int frame = 0;frame<3;frame++)
+  {
+    const Eigen::MatrixXd C = V+0.1*Eigen::MatrixXd::Random(V.rows(),3);
+    Eigen::MatrixXd NV_expected;
+    Eigen::MatrixXi NF_expected;
+    igl::loop(C,F,NV_expected,NF_expected,2);
+    // Straight into single precision buffers, as MeshGL uses
+    Eigen::Matrix<float,Eigen::Dynamic,3,Eigen::RowMajor> NV;
+    Eigen::Matrix<unsigned,Eigen::Dynamic,3,Eigen::RowMajor> NF;
+    subdivision.apply(C,NV);
+    subdivision.faces(NF);
+    IGL_TEST_CHECK_CLOSE(NV,NV_expected,1e-6);
+    IGL_TEST_CHECK_CLOSE(NF,NF_expected,0);
+  }
+}
@@ -0,0 +1,114 @@
+#include <test_common.h>
+#include <igl/arap.h>
+
+namespace
+{
+  void arap_test_setup(
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F,
+    Eigen::VectorXi & b)
+  {
+    test_common::sphere(16,9,V,F);
+    // Both poles and a point on the equator
+    b.resize(3);
+    b << V.rows()-2, V.rows()-1, 4*16;
+  }
+}
+
+IGL_TEST_CASE("rigid_motion")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  Eigen::VectorXi b;
+  arap_test_setup(V,F,b);
+  igl::ARAPData data;
+  data.max_iter = 20;
+  IGL_TEST_CHECK(igl::arap_precomputation(V,F,3,b,data));
+  // Rotate by 90 degrees about z and translate
+  Eigen::Matrix3d Q;
+  Q <<
+    0,-1,0,
+    1,0,0,
+    0,0,1;
+  const Eigen::RowVector3d t(0.5,-1,2);
+  const Eigen::MatrixXd V_rigid = (V*Q.transpose()).rowwise()+t;
+  Eigen::MatrixXd bc(b.size(),3);
+  for(int i = 0;i<b.size();i++)
+  {
+    bc.row(i) = V_rigid.row(b(i));
+  }
+  // A rigid motion of the rest pose is a fixed point of the iterations, up to
+  // the single precision rotation fits
+  Eigen::MatrixXd U = V_rigid;
+  IGL_TEST_CHECK(igl::arap_solve(bc,data,U));
+  IGL_TEST_CHECK_CLOSE(U,V_rigid,1e-4);
+}
+
+IGL_TEST_CASE("warm_start_and_tol")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  Eigen::VectorXi b;
+  arap_test_setup(V,F,b);
+  Eigen::MatrixXd bc(b.size(),3);
+  for(int i = 0;i<b.size();i++)
+  {
+    bc.row(i) = V.row(b(i));
+  }
+  // Squash the poles together
+  bc(0,2) = 0.6;
+  bc(1,2) = -0.6;
+
+  igl::ARAPData data;
+  data.max_iter = 500;
+  IGL_TEST_CHECK(igl::arap_precomputation(V,F,3,b,data));
+  Eigen::MatrixXd U_converged = V;
+  IGL_TEST_CHECK(igl::arap_solve(bc,data,U_converged));
+
+  // With a tolerance the same solve stops early near the fixed point
+  data.tol = 1e-10;
+  Eigen::MatrixXd U = V;
+  IGL_TEST_CHECK(igl::arap_solve(bc,data,U));
+  IGL_TEST_CHECK_CLOSE(U,U_converged,1e-6);
+
+  // Warm started from the converged solution a single iteration keeps it
+  data.max_iter = 1;
+  U = U_converged;
+  IGL_TEST_CHECK(igl::arap_solve(bc,data,U));
+  IGL_TEST_CHECK_CLOSE(U,U_converged,1e-6);
+}
+
+IGL_TEST_CASE("new_rest_pose")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  Eigen::VectorXi b;
+  arap_test_setup(V,F,b);
+  // A stretched rest pose with the same connectivity
+  Eigen::MatrixXd V2 = V;
+  V2.col(2) *= 1.5;
+  V2.col(0) += 0.2*V2.col(1).array().square().matrix();
+  Eigen::MatrixXd bc(b.size(),3);
+  for(int i = 0;i<b.size();i++)
+  {
+    bc.row(i) = V2.row(b(i));
+  }
+  bc(0,2) -= 0.3;
+  for(const bool with_dynamics : {false,true})
+  {
+    // Precomputed again for V2, which only refactors the system of V
+    igl::ARAPData data;
+    data.with_dynamics = with_dynamics;
+    IGL_TEST_CHECK(igl::arap_precomputation(V,F,3,b,data));
+    IGL_TEST_CHECK(igl::arap_precomputation(V2,F,3,b,data));
+    Eigen::MatrixXd U = V2;
+    IGL_TEST_CHECK(igl::arap_solve(bc,data,U));
+
+    igl::ARAPData fresh;
+    fresh.with_dynamics = with_dynamics;
+    IGL_TEST_CHECK(igl::arap_precomputation(V2,F,3,b,fresh));
+    Eigen::MatrixXd U_fresh = V2;
+    IGL_TEST_CHECK(igl::arap_solve(bc,fresh,U_fresh));
+    IGL_TEST_CHECK_CLOSE(U,U_fresh,1e-9);
+  }
+}
@@ -0,0 +1,117 @@
+#include <test_common.h>
+#include <igl/copyleft/marching_cubes.h>
+#include <igl/SparseSignedDistance.h>
+#include <igl/is_edge_manifold.h>
+#include <igl/doublearea.h>
+#include <map>
+#include <vector>
+
+namespace
+{
+  // The band cubes of all blocks of sdf as one sparse lattice, so that the
+  // sparse overload of marching_cubes welds vertices by lattice edge
+  void sparse_signed_distance_cubes(
+    const igl::SparseSignedDistance & sdf,
+    Eigen::VectorXd & S,
+    Eigen::MatrixXd & GV,
+    Eigen::MatrixXi & GI)
+  {
+    std::map<std::vector<int>,int> sample_index;
+    std::vector<double> values;
+    std::vector<Eigen::RowVector3d> positions;
+    std::vector<Eigen::Matrix<int,1,8> > cubes;
+    const int n = sdf.block_width()+1;
+    for(int b = 0;b<sdf.num_blocks();b++)
+    {
+      Eigen::VectorXd BS;
+      Eigen::MatrixXd BV;
+      Eigen::MatrixXi BI;
+      sdf.block_cubes(b,BS,BV,BI);
+      const Eigen::RowVector3i origin = sdf.block_origin(b);
+      for(int c = 0;c<BI.rows();c++)
+      {
+        Eigen::Matrix<int,1,8> cube;
+        for(int k = 0;k<8;k++)
+        {
+          const int s = BI(c,k);
+          const std::vector<int> ijk =
+            {origin(0)+s%n,origin(1)+(s/n)%n,origin(2)+s/(n*n)};
+          const auto it = sample_index.emplace(ijk,int(values.size()));
+          if(it.second)
+          {
+            values.push_back(BS(s));
+            positions.push_back(BV.row(s));
+          }
+          cube(k) = it.first->second;
+        }
+        cubes.push_back(cube);
+      }
+    }
+    S.resize(values.size());
+    GV.resize(values.size(),3);
+    for(size_t s = 0;s<values.size();s++)
+    {
+      S(s) = values[s];
+      GV.row(s) = positions[s];
+    }
+    GI.resize(cubes.size(),8);
+    for(size_t c = 0;c<cubes.size();c++)
+    {
+      GI.row(c) = cubes[c];
+    }
+  }
+}
+
+IGL_TEST_CASE("sparse_signed_distance_matches_lattice")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(40,20,V,F);
+  // Samples such as (1,0,0) lie exactly on the surface, where edges of
+  // different cubes meet at the same point
+  const double h = 0.05;
+  igl::SparseSignedDistance sdf(4);
+  sdf.build(V,F,h,3*h);
+  for(const double isovalue : {0.,0.02})
+  {
+    Eigen::MatrixXd SV;
+    Eigen::MatrixXi SF;
+    igl::copyleft::marching_cubes(sdf,isovalue,SV,SF);
+    IGL_TEST_CHECK(SF.rows() > 0);
+    IGL_TEST_CHECK(igl::is_edge_manifold(SF));
+
+    Eigen::VectorXd S;
+    Eigen::MatrixXd GV,LV;
+    Eigen::MatrixXi GI,LF;
+    sparse_signed_distance_cubes(sdf,S,GV,GI);
+    igl::copyleft::marching_cubes(S,GV,GI,isovalue,LV,LF);
+    IGL_TEST_CHECK(SV.rows() == LV.rows() && SF.rows() == LF.rows());
+    // The same surface up to the order of vertices and faces
+    Eigen::VectorXd A,LA;
+    igl::doublearea(SV,SF,A);
+    igl::doublearea(LV,LF,LA);
+    IGL_TEST_CHECK(std::abs(A.sum()-LA.sum()) < 1e-10*LA.sum());
+    IGL_TEST_CHECK(igl::is_edge_manifold(LF));
+  }
+}
+
+IGL_TEST_CASE("emits_blocks")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(20,10,V,F);
+  igl::SparseSignedDistance sdf(4);
+  sdf.build(V,F,0.1,0.3);
+  int num_faces = 0;
+  igl::copyleft::marching_cubes(sdf,0.,
+    [&](const Eigen::MatrixXd & BV, const Eigen::MatrixXi & BF)
+    {
+      IGL_TEST_CHECK(BF.rows() > 0 && BV.cols() == 3);
+      IGL_TEST_CHECK(BF.minCoeff() >= 0 && BF.maxCoeff() < BV.rows());
+      num_faces += BF.rows();
+    });
+  Eigen::MatrixXd SV;
+  Eigen::MatrixXi SF;
+  igl::copyleft::marching_cubes(sdf,0.,SV,SF);
+  IGL_TEST_CHECK(num_faces == SF.rows());
+}
@@ -0,0 +1,41 @@
+#include <test_common.h>
+#include <igl/cotmatrix_cached.h>
+#include <igl/cotmatrix.h>
+
+namespace
+{
+  void check_cotmatrix_cached(Eigen::MatrixXd V, const Eigen::MatrixXi & F)
+  {
+    Eigen::VectorXi data;
+    Eigen::SparseMatrix<double> L,L_expected;
+    igl::cotmatrix_cached_precompute(V,F,data,L);
+    igl::cotmatrix(V,F,L_expected);
+    IGL_TEST_CHECK_CLOSE(Eigen::MatrixXd(L),Eigen::MatrixXd(L_expected),1e-12);
+
+    // New positions only rewrite the values, in place
+    srand(0);
+    V += 0.05*Eigen::MatrixXd::Random(V.rows(),V.cols());
+    const double * values = L.valuePtr();
+    const int nnz = L.nonZeros();
+    igl::cotmatrix_cached(V,F,data,L);
+    IGL_TEST_CHECK(L.valuePtr() == values && L.nonZeros() == nnz);
+    igl::cotmatrix(V,F,L_expected);
+    IGL_TEST_CHECK_CLOSE(Eigen::MatrixXd(L),Eigen::MatrixXd(L_expected),1e-12);
+  }
+}
+
+IGL_TEST_CASE("triangles")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(12,7,V,F);
+  check_cotmatrix_cached(V,F);
+}
+
+IGL_TEST_CASE("tetrahedra")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi T;
+  test_common::tet_grid(4,V,T);
+  check_cotmatrix_cached(V,T);
+}
@@ -0,0 +1,142 @@
+#include <test_common.h>
+#include <igl/decimate.h>
+#include <igl/qslim.h>
+#include <igl/progressive_mesh_refine.h>
+#include <igl/sortrows.h>
+
+namespace
+{
+  // Faces with their corners rotated so that the smallest index comes first,
+  // sorted, so that meshes can be compared up to a reordering of faces and
+  // corners that preserves orientation
+  Eigen::MatrixXi decimate_canonical_faces(const Eigen::MatrixXi & F)
+  {
+    Eigen::MatrixXi R(F.rows(),3);
+    for(int f = 0;f<F.rows();f++)
+    {
+      int c = 0;
+      F.row(f).minCoeff(&c);
+      R.row(f) << F(f,c),F(f,(c+1)%3),F(f,(c+2)%3);
+    }
+    Eigen::MatrixXi S;
+    Eigen::VectorXi I;
+    igl::sortrows(R,true,S,I);
+    return S;
+  }
+
+  // Refine the output of decimate all the way and compare it with the input
+  void check_decimate_splits(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const size_t max_m,
+    Eigen::MatrixXd U,
+    Eigen::MatrixXi G,
+    const Eigen::VectorXi & I,
+    const std::vector<igl::VertexSplit> & splits)
+  {
+    IGL_TEST_CHECK(G.rows() <= (int)max_m);
+    IGL_TEST_CHECK(U.rows()+(int)splits.size() == V.rows());
+
+    // Refine half way, then the rest
+    int k = 0;
+    const size_t half = (G.rows()+F.rows())/2;
+    const int applied = igl::progressive_mesh_refine(splits,half,U,G,k);
+    IGL_TEST_CHECK(applied == k && G.rows() <= (int)half);
+    IGL_TEST_CHECK(k < (int)splits.size());
+    igl::progressive_mesh_refine(splits,F.rows(),U,G,k);
+    IGL_TEST_CHECK(k == (int)splits.size());
+    IGL_TEST_CHECK(U.rows() == V.rows() && G.rows() == F.rows());
+    if(U.rows() != V.rows() || G.rows() != F.rows())
+    {
+      return;
+    }
+
+    // Map refined vertices back to the input with the birth indices
+    Eigen::VectorXi birth(U.rows());
+    birth.head(I.size()) = I;
+    for(size_t s = 0;s<splits.size();s++)
+    {
+      birth(I.size()+s) = splits[s].t_birth;
+    }
+    Eigen::MatrixXd U_input(V.rows(),V.cols());
+    for(int u = 0;u<U.rows();u++)
+    {
+      U_input.row(birth(u)) = U.row(u);
+    }
+    IGL_TEST_CHECK_CLOSE(U_input,V,0);
+    for(int g = 0;g<G.rows();g++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        G(g,c) = birth(G(g,c));
+      }
+    }
+    IGL_TEST_CHECK_CLOSE(
+      decimate_canonical_faces(G),decimate_canonical_faces(F),0);
+  }
+}
+
+IGL_TEST_CASE("splits_recover_input")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(16,9,V,F);
+  const size_t max_m = 40;
+  Eigen::MatrixXd U;
+  Eigen::MatrixXi G;
+  Eigen::VectorXi J,I;
+  std::vector<igl::VertexSplit> splits;
+  IGL_TEST_CHECK(igl::decimate(V,F,max_m,U,G,J,I,splits));
+  check_decimate_splits(V,F,max_m,U,G,I,splits);
+
+  // Same coarse mesh as without splits
+  Eigen::MatrixXd U_plain;
+  Eigen::MatrixXi G_plain;
+  Eigen::VectorXi J_plain,I_plain;
+  igl::decimate(V,F,max_m,U_plain,G_plain,J_plain,I_plain);
+  IGL_TEST_CHECK_CLOSE(U,U_plain,0);
+  IGL_TEST_CHECK_CLOSE(G,G_plain,0);
+}
+
+IGL_TEST_CASE("qslim_splits_recover_input")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(16,9,V,F);
+  V.col(0) *= 2;
+  const size_t max_m = 60;
+  Eigen::MatrixXd U;
+  Eigen::MatrixXi G;
+  Eigen::VectorXi J,I;
+  std::vector<igl::VertexSplit> splits;
+  IGL_TEST_CHECK(igl::qslim(V,F,max_m,U,G,J,I,splits));
+  check_decimate_splits(V,F,max_m,U,G,I,splits);
+}
+
+IGL_TEST_CASE("open_mesh")
+{
+  // Boundaries are connected to a point at infinity while decimating, whose
+  // faces and splits must then be removed from the progressive mesh
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::grid(8,V,F);
+  V.col(2) = V.col(0).array()*V.col(1).array();
+  for(const bool use_qslim : {false,true})
+  {
+    const size_t max_m = 30;
+    Eigen::MatrixXd U;
+    Eigen::MatrixXi G;
+    Eigen::VectorXi J,I;
+    std::vector<igl::VertexSplit> splits;
+    if(use_qslim)
+    {
+      igl::qslim(V,F,max_m,U,G,J,I,splits);
+    }else
+    {
+      igl::decimate(V,F,max_m,U,G,J,I,splits);
+    }
+    IGL_TEST_CHECK((J.array() < F.rows()).all());
+    IGL_TEST_CHECK((I.array() < V.rows()).all());
+    check_decimate_splits(V,F,max_m,U,G,I,splits);
+  }
+}
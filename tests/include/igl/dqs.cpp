@@ -0,0 +1,43 @@
+#include <test_common.h>
+#include <igl/dqs.h>
+#include <igl/sparse_skinning_weights.h>
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+#include <vector>
+
+IGL_TEST_CASE("sparse_matches_dense")
+{
+  srand(0);
+  const int n = 50, num_handles = 5;
+  typedef std::vector<
+    Eigen::Quaterniond,Eigen::aligned_allocator<Eigen::Quaterniond> >
+    RotationList;
+  RotationList vQ;
+  std::vector<Eigen::Vector3d> vT;
+  for(int c = 0;c<num_handles;c++)
+  {
+    vQ.push_back(Eigen::Quaterniond(Eigen::Vector4d::Random()).normalized());
+    vT.push_back(Eigen::Vector3d::Random());
+  }
+  const Eigen::MatrixXd V = Eigen::MatrixXd::Random(n,3);
+  const Eigen::MatrixXd W =
+    Eigen::MatrixXd::Random(n,num_handles).cwiseAbs();
+  for(const int k : {num_handles,3})
+  {
+    Eigen::MatrixXi I;
+    Eigen::MatrixXd WK;
+    igl::sparse_skinning_weights(W,k,I,WK);
+    Eigen::MatrixXd Wk = Eigen::MatrixXd::Zero(n,num_handles);
+    for(int i = 0;i<n;i++)
+    {
+      for(int j = 0;j<k;j++)
+      {
+        Wk(i,I(i,j)) += WK(i,j);
+      }
+    }
+    Eigen::MatrixXd U,U_dense;
+    igl::dqs(V,I,WK,vQ,vT,U);
+    igl::dqs(V,Wk,vQ,vT,U_dense);
+    IGL_TEST_CHECK_CLOSE(U,U_dense,1e-12);
+  }
+}
@@ -0,0 +1,64 @@
+#include <test_common.h>
+#include <igl/fast_marching.h>
+#include <igl/vertex_triangle_adjacency.h>
+#include <limits>
+
+IGL_TEST_CASE("plane")
+{
+  // On a plane geodesics are straight lines, which fast marching may only
+  // overestimate
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::grid(21,V,F);
+  Eigen::VectorXi gamma(1);
+  gamma << 0;
+  Eigen::VectorXd D;
+  igl::fast_marching(V,F,gamma,D);
+  const Eigen::VectorXd E = (V.rowwise()-V.row(0)).rowwise().norm();
+  IGL_TEST_CHECK(D(0) == 0);
+  IGL_TEST_CHECK((D-E).minCoeff() > -1e-12);
+  IGL_TEST_CHECK(((D-E).array()/E.array().max(1e-12)).maxCoeff() < 0.05);
+  // Straight along an edge direction the marching is exact
+  IGL_TEST_CHECK(std::abs(D(20)-1) < 1e-12);
+}
+
+IGL_TEST_CASE("cached_adjacency")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(20,10,V,F);
+  Eigen::VectorXi gamma(2);
+  gamma << 3, V.rows()-1;
+  Eigen::VectorXd D,D_cached;
+  igl::fast_marching(V,F,gamma,D);
+  Eigen::VectorXi VF,NI;
+  igl::vertex_triangle_adjacency(F,V.rows(),VF,NI);
+  igl::fast_marching(V,F,VF,NI,gamma,D_cached);
+  IGL_TEST_CHECK_CLOSE(D_cached,D,0);
+  IGL_TEST_CHECK(D(3) == 0 && D(V.rows()-1) == 0);
+}
+
+IGL_TEST_CASE("unreachable")
+{
+  Eigen::MatrixXd V(6,3);
+  V <<
+    0,0,0,
+    1,0,0,
+    0,1,0,
+    5,0,0,
+    6,0,0,
+    5,1,0;
+  Eigen::MatrixXi F(2,3);
+  F <<
+    0,1,2,
+    3,4,5;
+  Eigen::VectorXi gamma(1);
+  gamma << 0;
+  Eigen::VectorXd D;
+  igl::fast_marching(V,F,gamma,D);
+  IGL_TEST_CHECK(std::abs(D(1)-1) < 1e-12 && std::abs(D(2)-1) < 1e-12);
+  for(int v = 3;v<6;v++)
+  {
+    IGL_TEST_CHECK(D(v) == std::numeric_limits<double>::infinity());
+  }
+}
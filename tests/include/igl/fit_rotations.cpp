@@ -0,0 +1,84 @@
+#include <test_common.h>
+#include <igl/fit_rotations.h>
+#include <igl/polar_svd.h>
+
+namespace
+{
+  // nr*3 by 3 stack of random covariance matrices, ordered as fit_rotations
+  // expects them: row i*nr+r holds row i of matrix r
+  Eigen::MatrixXd random_covariances(const int nr)
+  {
+    srand(0);
+    Eigen::MatrixXd S(3*nr,3);
+    for(int r = 0;r<nr;r++)
+    {
+      const Eigen::Matrix3d Sr = Eigen::Matrix3d::Random();
+      for(int i = 0;i<3;i++)
+      {
+        S.row(i*nr+r) = Sr.row(i);
+      }
+    }
+    return S;
+  }
+
+  // Serial reference: closest rotation to each covariance matrix
+  Eigen::MatrixXd fit_rotations_serial(const Eigen::MatrixXd & S)
+  {
+    const int nr = S.rows()/3;
+    Eigen::MatrixXd R(3,3*nr);
+    for(int r = 0;r<nr;r++)
+    {
+      Eigen::Matrix3d Sr,Rr,T,U,V;
+      Eigen::Vector3d sigma;
+      for(int i = 0;i<3;i++)
+      {
+        Sr.row(i) = S.row(i*nr+r);
+      }
+      igl::polar_svd(Sr,Rr,T,U,sigma,V);
+      R.block(0,3*r,3,3) = Rr.transpose();
+    }
+    return R;
+  }
+}
+
+IGL_TEST_CASE("parallel_matches_serial")
+{
+  // Enough clusters to run in parallel, and not a multiple of the SIMD width
+  const Eigen::MatrixXd S = random_covariances(3001);
+  const Eigen::MatrixXd R_serial = fit_rotations_serial(S);
+  Eigen::MatrixXd R;
+  igl::fit_rotations(S,false,R);
+  IGL_TEST_CHECK_CLOSE(R,R_serial,1e-12);
+}
+
+IGL_TEST_CASE("single_precision")
+{
+  const Eigen::MatrixXd S = random_covariances(1027);
+  const Eigen::MatrixXd R_serial = fit_rotations_serial(S);
+  Eigen::MatrixXd R;
+  igl::fit_rotations(S,true,R);
+  IGL_TEST_CHECK(R.rows() == 3 && R.cols() == R_serial.cols());
+  // Random matrices may be close to singular, where the polar factor is
+  // ill-conditioned: only compare well separated cases, but check that every
+  // output is a rotation
+  int compared = 0;
+  for(int r = 0;r<R.cols()/3;r++)
+  {
+    const Eigen::Matrix3d Rr = R.block(0,3*r,3,3);
+    IGL_TEST_CHECK_CLOSE(
+      Eigen::Matrix3d(Rr*Rr.transpose()),Eigen::Matrix3d::Identity(),1e-4);
+    IGL_TEST_CHECK(std::abs(Rr.determinant()-1) < 1e-4);
+    Eigen::Matrix3d Sr;
+    for(int i = 0;i<3;i++)
+    {
+      Sr.row(i) = S.row(i*(R.cols()/3)+r);
+    }
+    if(std::abs(Sr.determinant()) > 0.05)
+    {
+      IGL_TEST_CHECK_CLOSE(
+        Rr,Eigen::Matrix3d(R_serial.block(0,3*r,3,3)),1e-2);
+      compared++;
+    }
+  }
+  IGL_TEST_CHECK(compared > 500);
+}
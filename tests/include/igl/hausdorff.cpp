@@ -0,0 +1,159 @@
+#include <test_common.h>
+#include <igl/hausdorff.h>
+#include <igl/point_mesh_squared_distance.h>
+#include <igl/AABB.h>
+
+namespace
+{
+  // Largest distance to (VB,FB) over a dense barycentric sampling of the
+  // triangles of (VA,FA), a lower bound on h(A,B)
+  double hausdorff_sampled(
+    const Eigen::MatrixXd & VA,
+    const Eigen::MatrixXi & FA,
+    const Eigen::MatrixXd & VB,
+    const Eigen::MatrixXi & FB)
+  {
+    const int n = 8;
+    Eigen::MatrixXd P(FA.rows()*(n+1)*(n+2)/2,3);
+    int p = 0;
+    for(int f = 0;f<FA.rows();f++)
+    {
+      for(int i = 0;i<=n;i++)
+      {
+        for(int j = 0;i+j<=n;j++)
+        {
+          const double a = double(i)/n;
+          const double b = double(j)/n;
+          P.row(p++) =
+            (1-a-b)*VA.row(FA(f,0))+a*VA.row(FA(f,1))+b*VA.row(FA(f,2));
+        }
+      }
+    }
+    Eigen::VectorXd sqrD;
+    Eigen::VectorXi I;
+    Eigen::MatrixXd C;
+    igl::point_mesh_squared_distance(P,VB,FB,sqrD,I,C);
+    return std::sqrt(sqrD.maxCoeff());
+  }
+
+  // A coarse sphere and a finer, slightly larger and shifted one
+  void hausdorff_test_meshes(
+    Eigen::MatrixXd & VA,
+    Eigen::MatrixXi & FA,
+    Eigen::MatrixXd & VB,
+    Eigen::MatrixXi & FB)
+  {
+    test_common::sphere(6,4,VA,FA);
+    test_common::sphere(24,13,VB,FB);
+    VB *= 1.1;
+    VB.col(0).array() += 0.05;
+  }
+}
+
+IGL_TEST_CASE("one_sided_bounds")
+{
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  hausdorff_test_meshes(VA,FA,VB,FB);
+  igl::AABB<Eigen::MatrixXd,3> treeA,treeB;
+  treeA.init(VA,FA);
+  treeB.init(VB,FB);
+  const double tol = 1e-4;
+  for(int direction = 0;direction<2;direction++)
+  {
+    const Eigen::MatrixXd & V1 = direction == 0 ? VA : VB;
+    const Eigen::MatrixXi & F1 = direction == 0 ? FA : FB;
+    const Eigen::MatrixXd & V2 = direction == 0 ? VB : VA;
+    const Eigen::MatrixXi & F2 = direction == 0 ? FB : FA;
+    const igl::AABB<Eigen::MatrixXd,3> & tree2 = direction == 0 ? treeB : treeA;
+    double l,u;
+    igl::hausdorff(V1,F1,tree2,V2,F2,tol,l,u);
+    IGL_TEST_CHECK(l <= u && u-l <= tol);
+    // h(A,B) lies between the sampled maximum and u, so l is within tol of
+    // the sampled maximum or above it
+    const double sampled = hausdorff_sampled(V1,F1,V2,F2);
+    IGL_TEST_CHECK(sampled <= u+1e-12);
+    IGL_TEST_CHECK(l >= sampled-tol);
+  }
+}
+
+IGL_TEST_CASE("two_sided")
+{
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  hausdorff_test_meshes(VA,FA,VB,FB);
+  igl::AABB<Eigen::MatrixXd,3> treeA,treeB;
+  treeA.init(VA,FA);
+  treeB.init(VB,FB);
+  const double tol = 1e-4;
+  double lAB,uAB,lBA,uBA,l,u;
+  igl::hausdorff(VA,FA,treeB,VB,FB,tol,lAB,uAB);
+  igl::hausdorff(VB,FB,treeA,VA,FA,tol,lBA,uBA);
+  igl::hausdorff(treeA,VA,FA,treeB,VB,FB,tol,l,u);
+  IGL_TEST_CHECK(l <= u && u-l <= tol);
+  IGL_TEST_CHECK(u >= std::max(lAB,lBA));
+  IGL_TEST_CHECK(l <= std::max(uAB,uBA));
+
+  // The vertex-only distance never exceeds the surface distance
+  double d;
+  igl::hausdorff(VA,FA,VB,FB,d);
+  IGL_TEST_CHECK(d <= u+1e-12);
+}
+
+IGL_TEST_CASE("nonpositive_tolerance")
+{
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  hausdorff_test_meshes(VA,FA,VB,FB);
+  igl::AABB<Eigen::MatrixXd,3> treeA,treeB;
+  treeA.init(VA,FA);
+  treeB.init(VB,FB);
+  // Raised to sqrt(eps) times the bounding box diagonal, so the refinement
+  // still stops
+  const double diagonal = 2.*std::sqrt(3.)*1.15;
+  const double floor = std::sqrt(std::numeric_limits<double>::epsilon())*diagonal;
+  for(const double tol : {0.,-1.,std::numeric_limits<double>::quiet_NaN()})
+  {
+    double l,u;
+    igl::hausdorff(treeA,VA,FA,treeB,VB,FB,tol,l,u);
+    IGL_TEST_CHECK(l <= u && u-l <= floor);
+  }
+}
+
+IGL_TEST_CASE("triangle_bounds")
+{
+  Eigen::MatrixXd V(3,3);
+  V <<
+    0,0,0,
+    1,0,0,
+    0,1,0;
+  // Distance to the point (0,0,0.5)
+  const std::function<double(const double &,const double &,const double &)>
+    dist_to_B = [](const double & x,const double & y,const double & z)
+    {
+      return std::sqrt(x*x+y*y+(z-0.5)*(z-0.5));
+    };
+  double l,u;
+  igl::hausdorff(V,dist_to_B,l,u);
+  IGL_TEST_CHECK(std::abs(l-std::sqrt(1.25)) < 1e-12);
+  IGL_TEST_CHECK(u >= l);
+}
+
+IGL_TEST_CASE("point_mesh_squared_distance_tree")
+{
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  hausdorff_test_meshes(VA,FA,VB,FB);
+  srand(0);
+  // Enough queries to run in parallel
+  const Eigen::MatrixXd P = 1.5*Eigen::MatrixXd::Random(3000,3);
+  Eigen::VectorXd sqrD,sqrD_tree;
+  Eigen::VectorXi I,I_tree;
+  Eigen::MatrixXd C,C_tree;
+  igl::point_mesh_squared_distance(P,VB,FB,sqrD,I,C);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(VB,FB);
+  igl::point_mesh_squared_distance(P,tree,VB,FB,sqrD_tree,I_tree,C_tree);
+  IGL_TEST_CHECK_CLOSE(sqrD_tree,sqrD,1e-12);
+  IGL_TEST_CHECK_CLOSE(C_tree,C,1e-12);
+}
@@ -0,0 +1,31 @@
+#include <test_common.h>
+#include <igl/heat_geodesics.h>
+#include <vector>
+
+IGL_TEST_CASE("multi_source_matches_single")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(24,12,V,F);
+  igl::HeatGeodesicsData<double> data;
+  IGL_TEST_CHECK(igl::heat_geodesics_precompute(V,F,data));
+  std::vector<Eigen::VectorXi> gammas(3);
+  gammas[0] = Eigen::VectorXi::Constant(1,V.rows()-2);
+  gammas[1] = Eigen::VectorXi::Constant(1,7);
+  gammas[2].resize(2);
+  gammas[2] << 10, 100;
+  Eigen::MatrixXd D;
+  igl::heat_geodesics_solve(data,gammas,D);
+  IGL_TEST_CHECK(D.rows() == V.rows() && D.cols() == 3);
+  for(int s = 0;s<3;s++)
+  {
+    Eigen::VectorXd Ds;
+    igl::heat_geodesics_solve(data,gammas[s],Ds);
+    IGL_TEST_CHECK_CLOSE(D.col(s),Ds,1e-10);
+  }
+  // The opposite pole is the farthest vertex from a pole
+  Eigen::Index farthest;
+  D.col(0).maxCoeff(&farthest);
+  IGL_TEST_CHECK(farthest == V.rows()-1);
+  IGL_TEST_CHECK(std::abs(D(V.rows()-2,0)) < 1e-12);
+}
@@ -0,0 +1,48 @@
+#include <test_common.h>
+#include <igl/lbs.h>
+#include <igl/lbs_matrix.h>
+#include <igl/sparse_skinning_weights.h>
+
+namespace
+{
+  // #C*4 by 3 stack of transposed random affine transformations
+  Eigen::MatrixXd random_transformations(const int num_handles)
+  {
+    Eigen::MatrixXd T(num_handles*4,3);
+    for(int c = 0;c<num_handles;c++)
+    {
+      T.block(c*4,0,3,3) =
+        Eigen::Matrix3d::Identity()+0.3*Eigen::Matrix3d::Random();
+      T.row(c*4+3) = Eigen::RowVector3d::Random();
+    }
+    return T;
+  }
+}
+
+IGL_TEST_CASE("matches_lbs_matrix")
+{
+  srand(0);
+  const int n = 50, num_handles = 6;
+  const Eigen::MatrixXd V = Eigen::MatrixXd::Random(n,3);
+  const Eigen::MatrixXd T = random_transformations(num_handles);
+  Eigen::MatrixXd W = Eigen::MatrixXd::Random(n,num_handles).cwiseAbs();
+  for(const int k : {num_handles,2})
+  {
+    Eigen::MatrixXi I;
+    Eigen::MatrixXd WK;
+    igl::sparse_skinning_weights(W,k,I,WK);
+    // The same truncated weights as a dense matrix
+    Eigen::MatrixXd Wk = Eigen::MatrixXd::Zero(n,num_handles);
+    for(int i = 0;i<n;i++)
+    {
+      for(int j = 0;j<k;j++)
+      {
+        Wk(i,I(i,j)) += WK(i,j);
+      }
+    }
+    Eigen::MatrixXd M,U;
+    igl::lbs_matrix(V,Wk,M);
+    igl::lbs(V,I,WK,T,U);
+    IGL_TEST_CHECK_CLOSE(U,M*T,1e-12);
+  }
+}
@@ -0,0 +1,53 @@
+#include <test_common.h>
+#include <igl/massmatrix_cached.h>
+#include <igl/massmatrix.h>
+
+namespace
+{
+  void check_massmatrix_cached(
+    Eigen::MatrixXd V,
+    const Eigen::MatrixXi & F,
+    const igl::MassMatrixType type)
+  {
+    Eigen::VectorXi data;
+    Eigen::SparseMatrix<double> M,M_expected;
+    igl::massmatrix_cached_precompute(V,F,type,data,M);
+    igl::massmatrix(V,F,type,M_expected);
+    IGL_TEST_CHECK_CLOSE(Eigen::MatrixXd(M),Eigen::MatrixXd(M_expected),1e-14);
+
+    srand(0);
+    V += 0.05*Eigen::MatrixXd::Random(V.rows(),V.cols());
+    const double * values = M.valuePtr();
+    igl::massmatrix_cached(V,F,type,data,M);
+    IGL_TEST_CHECK(M.valuePtr() == values);
+    igl::massmatrix(V,F,type,M_expected);
+    IGL_TEST_CHECK_CLOSE(Eigen::MatrixXd(M),Eigen::MatrixXd(M_expected),1e-14);
+  }
+}
+
+IGL_TEST_CASE("triangles")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(12,7,V,F);
+  for(const auto type : {
+    igl::MASSMATRIX_TYPE_DEFAULT,
+    igl::MASSMATRIX_TYPE_BARYCENTRIC,
+    igl::MASSMATRIX_TYPE_VORONOI})
+  {
+    check_massmatrix_cached(V,F,type);
+  }
+}
+
+IGL_TEST_CASE("tetrahedra")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi T;
+  test_common::tet_grid(4,V,T);
+  for(const auto type : {
+    igl::MASSMATRIX_TYPE_DEFAULT,
+    igl::MASSMATRIX_TYPE_BARYCENTRIC})
+  {
+    check_massmatrix_cached(V,T,type);
+  }
+}
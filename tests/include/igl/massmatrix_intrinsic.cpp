@@ -0,0 +1,32 @@
+#include <test_common.h>
+#include <igl/massmatrix_intrinsic.h>
+#include <igl/edge_lengths.h>
+
+IGL_TEST_CASE("corner_masses")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(12,7,V,F);
+  V.col(0) *= 1.5;
+  Eigen::MatrixXd l;
+  igl::edge_lengths(V,F,l);
+  for(const auto type : {
+    igl::MASSMATRIX_TYPE_BARYCENTRIC,
+    igl::MASSMATRIX_TYPE_VORONOI})
+  {
+    Eigen::MatrixXd C;
+    igl::massmatrix_intrinsic(l,F,type,C);
+    IGL_TEST_CHECK(C.rows() == F.rows() && C.cols() == 3);
+    Eigen::VectorXd M_sum = Eigen::VectorXd::Zero(V.rows());
+    for(int f = 0;f<F.rows();f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        M_sum(F(f,c)) += C(f,c);
+      }
+    }
+    Eigen::SparseMatrix<double> M;
+    igl::massmatrix_intrinsic(l,F,type,M);
+    IGL_TEST_CHECK_CLOSE(Eigen::VectorXd(M.diagonal()),M_sum,1e-15);
+  }
+}
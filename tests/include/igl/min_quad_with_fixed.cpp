@@ -0,0 +1,60 @@
+#include <test_common.h>
+#include <igl/min_quad_with_fixed.h>
+#include <igl/cotmatrix_cached.h>
+#include <igl/cotmatrix.h>
+
+IGL_TEST_CASE("refactorize_matches_precompute")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::grid(8,V,F);
+  Eigen::VectorXi known(3);
+  known << 0, 7, V.rows()-1;
+  Eigen::MatrixXd Y(3,2);
+  Y <<
+    0,1,
+    1,0,
+    0.5,0.5;
+  srand(0);
+  const Eigen::MatrixXd B = Eigen::MatrixXd::Random(V.rows(),2);
+  // One linear constraint tying two free vertices together
+  Eigen::SparseMatrix<double> Aeq(1,V.rows()),Aeq_none;
+  Aeq.insert(0,10) = 1;
+  Aeq.insert(0,20) = -1;
+  const Eigen::MatrixXd Beq = Eigen::MatrixXd::Zero(1,2);
+  for(const bool pd : {true,false})
+  {
+    for(const bool with_Aeq : {false,true})
+    {
+      const Eigen::SparseMatrix<double> & E = with_Aeq ? Aeq : Aeq_none;
+      const Eigen::MatrixXd Eb = with_Aeq ? Beq : Eigen::MatrixXd(0,2);
+      Eigen::VectorXi L_data;
+      Eigen::SparseMatrix<double> L;
+      igl::cotmatrix_cached_precompute(V,F,L_data,L);
+      // -L is positive semi-definite, L is not
+      const double sign = pd ? -1 : 1;
+      Eigen::SparseMatrix<double> A = sign*L;
+      igl::min_quad_with_fixed_data<double> data;
+      IGL_TEST_CHECK(igl::min_quad_with_fixed_precompute(A,known,E,pd,data));
+
+      Eigen::MatrixXd U = V;
+      U.col(0) += 0.2*U.col(1).array().square().matrix();
+      igl::cotmatrix_cached(U,F,L_data,L);
+      A = sign*L;
+      IGL_TEST_CHECK(igl::min_quad_with_fixed_refactorize(A,E,data));
+      Eigen::MatrixXd Z;
+      IGL_TEST_CHECK(igl::min_quad_with_fixed_solve(data,B,Y,Eb,Z));
+
+      igl::min_quad_with_fixed_data<double> fresh;
+      Eigen::SparseMatrix<double> L_fresh;
+      igl::cotmatrix(U,F,L_fresh);
+      const Eigen::SparseMatrix<double> A_fresh = sign*L_fresh;
+      IGL_TEST_CHECK(
+        igl::min_quad_with_fixed_precompute(A_fresh,known,E,pd,fresh));
+      Eigen::MatrixXd Z_fresh;
+      IGL_TEST_CHECK(igl::min_quad_with_fixed_solve(fresh,B,Y,Eb,Z_fresh));
+      IGL_TEST_CHECK_CLOSE(Z,Z_fresh,1e-9);
+      IGL_TEST_CHECK(data.solver_type == fresh.solver_type);
+    }
+  }
+}
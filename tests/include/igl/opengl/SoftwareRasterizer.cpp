@@ -0,0 +1,128 @@
+#include <test_common.h>
+#include <igl/opengl/SoftwareRasterizer.h>
+#include <igl/opengl/ViewerCore.h>
+#include <igl/opengl/ViewerData.h>
+#include <cmath>
+
+namespace
+{
+  // Square [-1,1]^2 in the plane z, split into 2*(n-1)^2 triangles
+  void software_rasterizer_square(
+    const int n,
+    const double z,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F)
+  {
+    test_common::grid(n,V,F);
+    V.leftCols(2) = (2*V.leftCols(2)).array()-1;
+    V.col(2).setConstant(z);
+  }
+}
+
+IGL_TEST_CASE("coverage")
+{
+  // Larger than a tile, so that triangles are binned into several tiles
+  const int width = 200;
+  const int height = 150;
+  igl::opengl::ViewerCore core;
+  core.orthographic = true;
+  core.depth_test = false;
+  igl::opengl::ViewerData data;
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  software_rasterizer_square(7,0,V,F);
+  data.set_mesh(V,F);
+  data.show_lines = 0;
+  // Translucent, so that pixels drawn twice come out darker
+  data.set_colors(Eigen::RowVector4d(1,0,0,0.5));
+
+  igl::opengl::SoftwareRasterizer rasterizer;
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>
+    R(width,height),G(width,height),B(width,height),A(width,height);
+  rasterizer.draw_buffer(
+    core,Eigen::Matrix4f::Identity(),data,true,R,G,B,A);
+  IGL_TEST_CHECK(rasterizer.width() == width);
+  IGL_TEST_CHECK(rasterizer.height() == height);
+
+  // Half extents of the orthographic view volume at the default camera
+  const double h = std::tan(45.0/360.0*3.14159265358979323846)*5.0;
+  const double w = h*width/height;
+  const int cx = width/2;
+  const int cy = height/2;
+  int covered = 0;
+  int mismatches = 0;
+  int uneven = 0;
+  for(int x = 0;x<width;x++)
+  {
+    for(int y = 0;y<height;y++)
+    {
+      const double px = (2.0*(x+0.5)/width-1)*w;
+      const double py = (2.0*(y+0.5)/height-1)*h;
+      const double margin = 1-std::max(std::abs(px),std::abs(py));
+      const bool drawn = A(x,y) != 0;
+      if(std::abs(margin) > 1e-3 && drawn != (margin > 0))
+      {
+        mismatches++;
+      }
+      if(drawn)
+      {
+        covered++;
+        // Shared edges inside the square are drawn exactly once
+        if(R(x,y) != R(cx,cy) || A(x,y) != A(cx,cy))
+        {
+          uneven++;
+        }
+      }
+    }
+  }
+  IGL_TEST_CHECK(covered > 0);
+  IGL_TEST_CHECK(mismatches == 0);
+  IGL_TEST_CHECK(uneven == 0);
+}
+
+IGL_TEST_CASE("depth_test")
+{
+  const int width = 96;
+  const int height = 80;
+  igl::opengl::ViewerCore core;
+  igl::opengl::ViewerData data;
+  // A small square in front of a large one
+  Eigen::MatrixXd V1,V2;
+  Eigen::MatrixXi F1,F2;
+  software_rasterizer_square(2,0,V1,F1);
+  software_rasterizer_square(2,0.5,V2,F2);
+  V2.leftCols(2) *= 0.3;
+  Eigen::MatrixXd V(8,3);
+  V << V1, V2;
+  Eigen::MatrixXi F(4,3);
+  F << F1, F2.array()+4;
+  data.set_mesh(V,F);
+  data.show_lines = 0;
+  Eigen::MatrixXd C(4,3);
+  C <<
+    1,0,0,
+    1,0,0,
+    0,0,1,
+    0,0,1;
+  data.set_colors(C);
+
+  igl::opengl::SoftwareRasterizer rasterizer;
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>
+    R(width,height),G(width,height),B(width,height),A(width,height);
+  // Draw the squares in both orders
+  for(int pass = 0;pass<2;pass++)
+  {
+    rasterizer.draw_buffer(
+      core,Eigen::Matrix4f::Identity(),data,true,R,G,B,A);
+    const int center = (height/2)*width+width/2;
+    const int side = (height/2)*width+width/2+width/8;
+    IGL_TEST_CHECK(B(width/2,height/2) > R(width/2,height/2));
+    IGL_TEST_CHECK(R(width/2+width/8,height/2) > B(width/2+width/8,height/2));
+    IGL_TEST_CHECK(rasterizer.depth()[center] < rasterizer.depth()[side]);
+    IGL_TEST_CHECK(rasterizer.depth()[0] == 1);
+    F << F2.array()+4, F1;
+    C.topRows(2).swap(C.bottomRows(2));
+    data.set_mesh(V,F);
+    data.set_colors(C);
+  }
+}
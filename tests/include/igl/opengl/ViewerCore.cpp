@@ -0,0 +1,120 @@
+#include <test_common.h>
+#include <igl/opengl/ViewerCore.h>
+#include <igl/opengl/ViewerData.h>
+
+namespace
+{
+  // Default camera at (0,0,5) looking at the origin, 45 degree field of view
+  // and depth range [1,100]
+  igl::opengl::ViewerCore viewer_core_test_core(const bool orthographic)
+  {
+    igl::opengl::ViewerCore core;
+    core.viewport << 0,0,800,600;
+    core.orthographic = orthographic;
+    core.update_camera(Eigen::Matrix4f::Identity());
+    return core;
+  }
+
+  Eigen::AlignedBox3f viewer_core_test_box(
+    const float x,
+    const float y,
+    const float z,
+    const float r)
+  {
+    return Eigen::AlignedBox3f(
+      Eigen::Vector3f(x-r,y-r,z-r),Eigen::Vector3f(x+r,y+r,z+r));
+  }
+}
+
+IGL_TEST_CASE("in_frustum")
+{
+  for(const bool orthographic : {false,true})
+  {
+    const igl::opengl::ViewerCore core = viewer_core_test_core(orthographic);
+    const Eigen::Matrix4f I = Eigen::Matrix4f::Identity();
+    IGL_TEST_CHECK(core.in_frustum(I,viewer_core_test_box(0,0,0,0.5f)));
+    // Far to the side, behind the camera and beyond the far plane
+    IGL_TEST_CHECK(!core.in_frustum(I,viewer_core_test_box(50,0,0,0.5f)));
+    IGL_TEST_CHECK(!core.in_frustum(I,viewer_core_test_box(0,-50,0,0.5f)));
+    IGL_TEST_CHECK(!core.in_frustum(I,viewer_core_test_box(0,0,10,0.5f)));
+    IGL_TEST_CHECK(!core.in_frustum(I,viewer_core_test_box(0,0,-200,0.5f)));
+    // Straddling a plane counts as visible
+    IGL_TEST_CHECK(core.in_frustum(I,viewer_core_test_box(0,0,-95,10)));
+    IGL_TEST_CHECK(!core.in_frustum(I,Eigen::AlignedBox3f()));
+
+    // The mesh transformation moves the box into and out of view
+    Eigen::Matrix4f model = I;
+    model.block<3,1>(0,3) << 50,0,0;
+    IGL_TEST_CHECK(!core.in_frustum(model,viewer_core_test_box(0,0,0,0.5f)));
+    IGL_TEST_CHECK(core.in_frustum(model,viewer_core_test_box(-50,0,0,0.5f)));
+  }
+}
+
+IGL_TEST_CASE("in_frustum_moved_world")
+{
+  // The scene transformation is part of camera_view, in_frustum only gets the
+  // mesh's own transformation, just like draw
+  Eigen::Affine3f world = Eigen::Affine3f::Identity();
+  world.translate(Eigen::Vector3f(2,0,-3));
+  world.rotate(Eigen::AngleAxisf(0.5f,Eigen::Vector3f::UnitY()));
+  for(const bool orthographic : {false,true})
+  {
+    igl::opengl::ViewerCore core;
+    core.viewport << 0,0,800,600;
+    core.orthographic = orthographic;
+    core.update_camera(world.matrix());
+    igl::opengl::ViewerData data;
+    data.MyTranslate(Eigen::Vector3f(-1.5f,0.5f,0),Movable::OBJECT_AXIS);
+    const Eigen::Matrix4f model = data.MakeTrans();
+    // Where draw puts each point: proj * view * p with view = camera_view *
+    // MakeTrans(). Points clearly inside or outside the clip volume must be
+    // kept or culled accordingly.
+    const Eigen::Matrix4f clip_from_mesh = core.proj * core.camera_view * model;
+    int inside = 0, outside = 0;
+    for(float x = -20;x<=20;x += 2.5f)
+    for(float y = -10;y<=10;y += 2.5f)
+    for(float z = -60;z<=10;z += 5)
+    {
+      const Eigen::Vector4f c = clip_from_mesh * Eigen::Vector4f(x,y,z,1);
+      const float m = c.head<3>().cwiseAbs().maxCoeff();
+      const bool in = c(3) > 0 && m < 0.9f*c(3);
+      const bool out = c(3) <= 0 || m > 1.1f*c(3);
+      if(!in && !out)
+      {
+        continue;
+      }
+      (in ? inside : outside)++;
+      IGL_TEST_CHECK(
+        core.in_frustum(model,viewer_core_test_box(x,y,z,1e-3f)) == in);
+    }
+    IGL_TEST_CHECK(inside > 0 && outside > 0);
+  }
+}
+
+IGL_TEST_CASE("mesh_bounds")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(8,5,V,F);
+  igl::opengl::ViewerData data;
+  data.set_mesh(V,F);
+  const Eigen::Vector3f lo = V.colwise().minCoeff().transpose().cast<float>();
+  const Eigen::Vector3f hi = V.colwise().maxCoeff().transpose().cast<float>();
+  Eigen::AlignedBox3f box = data.mesh_bounds();
+  IGL_TEST_CHECK_CLOSE(box.min(),lo,0);
+  IGL_TEST_CHECK_CLOSE(box.max(),hi,0);
+
+  // Moving the vertices refreshes the cached box
+  data.set_vertices(Eigen::MatrixXd(2*V));
+  box = data.mesh_bounds();
+  IGL_TEST_CHECK_CLOSE(box.min(),Eigen::Vector3f(2*lo),0);
+  IGL_TEST_CHECK_CLOSE(box.max(),Eigen::Vector3f(2*hi),0);
+
+  // 2D meshes lie in z = 0
+  igl::opengl::ViewerData flat;
+  test_common::grid(3,V,F);
+  flat.set_mesh(Eigen::MatrixXd(V.leftCols(2)),F);
+  box = flat.mesh_bounds();
+  IGL_TEST_CHECK_CLOSE(box.min(),Eigen::Vector3f(0,0,0),0);
+  IGL_TEST_CHECK_CLOSE(box.max(),Eigen::Vector3f(1,1,0),0);
+}
@@ -0,0 +1,44 @@
+#include <test_common.h>
+#include <igl/opengl/ViewerCore.h>
+#include <igl/opengl/ViewerData.h>
+
+IGL_TEST_CASE("set_mesh_own_uninitialized")
+{
+  // A 2D mesh assigned directly and then plotted through set_mesh must be
+  // padded and set up like any new mesh
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::grid(4,V,F);
+  igl::opengl::ViewerData data;
+  data.V = V.leftCols(2);
+  data.F = F;
+  data.set_mesh(data.V,data.F);
+  IGL_TEST_CHECK_CLOSE(data.V,V,0);
+  IGL_TEST_CHECK(data.F == F);
+  IGL_TEST_CHECK(data.V_normals.rows() == V.rows());
+  IGL_TEST_CHECK(data.F_normals.rows() == F.rows());
+  IGL_TEST_CHECK(data.V_material_diffuse.rows() == V.rows());
+  IGL_TEST_CHECK(data.F_material_diffuse.rows() == F.rows());
+  IGL_TEST_CHECK(data.texture_R.size() > 0);
+}
+
+IGL_TEST_CASE("set_mesh_own_initialized")
+{
+  // Editing the plotted mesh in place keeps its colors and refreshes normals
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(12,7,V,F);
+  igl::opengl::ViewerData data;
+  data.set_mesh(V,F);
+  data.set_colors(Eigen::MatrixXd(Eigen::RowVector3d(0.1,0.2,0.3)));
+  const Eigen::MatrixXd C = data.F_material_diffuse;
+  data.V *= 2;
+  data.V.col(0) *= 1.5;
+  data.set_mesh(data.V,data.F);
+  IGL_TEST_CHECK_CLOSE(data.F_material_diffuse,C,0);
+  data.compute_normals();
+  igl::opengl::ViewerData fresh;
+  fresh.set_mesh(data.V,data.F);
+  IGL_TEST_CHECK_CLOSE(data.V_normals,fresh.V_normals,1e-12);
+  IGL_TEST_CHECK_CLOSE(data.F_normals,fresh.F_normals,1e-12);
+}
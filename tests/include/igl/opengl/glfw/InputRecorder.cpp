@@ -0,0 +1,116 @@
+#include <test_common.h>
+#include <igl/opengl/glfw/InputRecorder.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+IGL_TEST_CASE("save_and_replay")
+{
+  const std::string filename = "InputRecorder_save_and_replay.txt";
+  InputRecorder recorder;
+  recorder.start_recording(1234);
+  const int r0 = rand();
+  const double dts[] = {0.016,0.017,1./60.};
+  std::vector<InputRecorder::Event> frame_events;
+  double dt = dts[0];
+  recorder.next_frame(dt,frame_events);
+  recorder.record(InputRecorder::Event(InputRecorder::RESIZE,1000,800));
+  recorder.record(
+    InputRecorder::Event(InputRecorder::MOUSE_BUTTON,0,1,0,512.25,300.5));
+  recorder.record(InputRecorder::Event(InputRecorder::PICK,11,1));
+  dt = dts[1];
+  recorder.next_frame(dt,frame_events);
+  dt = dts[2];
+  recorder.next_frame(dt,frame_events);
+  recorder.record(InputRecorder::Event(InputRecorder::KEY,'1',1,0));
+  IGL_TEST_CHECK(recorder.save(filename));
+
+  InputRecorder replay;
+  IGL_TEST_CHECK(replay.start_replay(filename));
+  std::remove(filename.c_str());
+  IGL_TEST_CHECK(replay.is_replaying());
+  IGL_TEST_CHECK(replay.seed == 1234);
+  // The seed is applied again
+  IGL_TEST_CHECK(rand() == r0);
+
+  // Events recorded after frame i started are applied before frame i+1
+  std::vector<size_t> num_events;
+  for(int f = 0;f<3;f++)
+  {
+    dt = -1;
+    replay.next_frame(dt,frame_events);
+    IGL_TEST_CHECK(dt == dts[f]);
+    num_events.push_back(frame_events.size());
+    if(f == 1 && frame_events.size() == 3)
+    {
+      const InputRecorder::Event & press = frame_events[1];
+      IGL_TEST_CHECK(press.type == InputRecorder::MOUSE_BUTTON);
+      IGL_TEST_CHECK(press.x == 512.25 && press.y == 300.5);
+      IGL_TEST_CHECK(frame_events[2].type == InputRecorder::PICK);
+      IGL_TEST_CHECK(replay.check_pick(frame_events[2],11,true));
+      IGL_TEST_CHECK(!replay.check_pick(frame_events[2],12,true));
+      IGL_TEST_CHECK(!replay.check_pick(frame_events[2],11,false));
+    }
+  }
+  IGL_TEST_CHECK(num_events == std::vector<size_t>({0,3,0}));
+  IGL_TEST_CHECK(replay.pick_mismatches == 2);
+  // The key pressed during the last frame has no frame to be applied before
+  dt = -1;
+  replay.next_frame(dt,frame_events);
+  IGL_TEST_CHECK(!replay.is_replaying());
+  IGL_TEST_CHECK(dt == -1 && frame_events.empty());
+}
+
+IGL_TEST_CASE("level_check")
+{
+  const std::string filename = "InputRecorder_level_check.txt";
+  InputRecorder recorder;
+  recorder.start_recording(7);
+  std::vector<InputRecorder::Event> frame_events;
+  // Frame 0 finishes level 1 and loads level 2, frame 1 keeps playing it
+  double dt = 16;
+  recorder.next_frame(dt,frame_events);
+  recorder.record(InputRecorder::Event(InputRecorder::KEY,' ',1,0));
+  recorder.record(InputRecorder::Event(InputRecorder::LEVEL,2,120,0,0.025f));
+  dt = 0;
+  recorder.next_frame(dt,frame_events);
+  IGL_TEST_CHECK(recorder.save(filename));
+
+  InputRecorder replay;
+  IGL_TEST_CHECK(replay.start_replay(filename));
+  std::remove(filename.c_str());
+  dt = -1;
+  replay.next_frame(dt,frame_events);
+  IGL_TEST_CHECK(dt == 16 && frame_events.empty());
+  replay.next_frame(dt,frame_events);
+  // The time step of the frame after the load is the reset one
+  IGL_TEST_CHECK(dt == 0);
+  IGL_TEST_CHECK(frame_events.size() == 2);
+  if(frame_events.size() == 2)
+  {
+    const InputRecorder::Event & level = frame_events[1];
+    IGL_TEST_CHECK(level.type == InputRecorder::LEVEL);
+    // The scale round-trips exactly through the file
+    IGL_TEST_CHECK(replay.check_level(level,2,120,0.025f));
+    // A replay that kept the zoom of the previous level
+    IGL_TEST_CHECK(!replay.check_level(level,2,120,0.05f));
+    IGL_TEST_CHECK(!replay.check_level(level,1,120,0.025f));
+    IGL_TEST_CHECK(!replay.check_level(level,2,100,0.025f));
+  }
+  IGL_TEST_CHECK(replay.level_mismatches == 3);
+  IGL_TEST_CHECK(replay.pick_mismatches == 0);
+}
+
+IGL_TEST_CASE("rejects_other_files")
+{
+  const std::string filename = "InputRecorder_rejects_other_files.txt";
+  FILE * f = fopen(filename.c_str(),"w");
+  fputs("OFF\n3 1 0\n",f);
+  fclose(f);
+  InputRecorder replay;
+  IGL_TEST_CHECK(!replay.start_replay(filename));
+  IGL_TEST_CHECK(!replay.is_replaying());
+  std::remove(filename.c_str());
+  IGL_TEST_CHECK(!replay.start_replay(filename));
+}
@@ -0,0 +1,135 @@
+#include <test_common.h>
+#include <igl/per_vertex_normals.h>
+#include <igl/per_face_normals.h>
+#include <igl/doublearea.h>
+#include <igl/internal_angles.h>
+#include <igl/vertex_triangle_adjacency.h>
+
+namespace
+{
+  // Serial scatter of weighted face normals, as per_vertex_normals did before
+  // gathering over the vertex-triangle adjacency
+  void per_vertex_normals_scatter(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const igl::PerVertexNormalsWeightingType weighting,
+    Eigen::MatrixXd & N)
+  {
+    Eigen::MatrixXd FN,W(F.rows(),3);
+    igl::per_face_normals(V,F,FN);
+    if(weighting == igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM)
+    {
+      W.setConstant(1);
+    }else if(weighting == igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE)
+    {
+      igl::internal_angles(V,F,W);
+    }else
+    {
+      Eigen::VectorXd A;
+      igl::doublearea(V,F,A);
+      W = A.replicate(1,3);
+    }
+    N.setZero(V.rows(),3);
+    for(int f = 0;f<F.rows();f++)
+    {
+      for(int j = 0;j<3;j++)
+      {
+        N.row(F(f,j)) += W(f,j)*FN.row(f);
+      }
+    }
+    N.rowwise().normalize();
+  }
+}
+
+IGL_TEST_CASE("gather_matches_scatter")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(40,20,V,F);
+  // Break the symmetry so that the weightings differ
+  V.col(0) *= 1.7;
+  V.col(2) += 0.3*V.col(0).cwiseAbs2();
+  for(const auto weighting : {
+    igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM,
+    igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA,
+    igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE})
+  {
+    Eigen::MatrixXd N,N_scatter;
+    igl::per_vertex_normals(V,F,weighting,N);
+    per_vertex_normals_scatter(V,F,weighting,N_scatter);
+    IGL_TEST_CHECK_CLOSE(N,N_scatter,1e-12);
+  }
+}
+
+IGL_TEST_CASE("cached_adjacency")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(16,9,V,F);
+  Eigen::MatrixXd FN,N,N_cached;
+  igl::per_face_normals(V,F,FN);
+  igl::per_vertex_normals(
+    V,F,igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA,FN,N);
+  Eigen::VectorXi VF,NI;
+  igl::vertex_triangle_adjacency(F,V.rows(),VF,NI);
+  igl::per_vertex_normals(
+    V,F,igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA,FN,VF,NI,N_cached);
+  IGL_TEST_CHECK_CLOSE(N_cached,N,0);
+}
+
+IGL_TEST_CASE("incremental_matches_full")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(24,12,V,F);
+  Eigen::VectorXi VF,NI;
+  igl::vertex_triangle_adjacency(F,V.rows(),VF,NI);
+  for(const auto weighting : {
+    igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM,
+    igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA,
+    igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE})
+  {
+    Eigen::MatrixXd FN,N;
+    igl::per_face_normals(V,F,FN);
+    igl::per_vertex_normals(V,F,weighting,FN,N);
+
+    // Move a few vertices, including a pole with a large one-ring
+    Eigen::VectorXi I(3);
+    I << 5, 100, V.rows()-1;
+    Eigen::MatrixXd U = V;
+    for(int i = 0;i<I.size();i++)
+    {
+      U.row(I(i)) *= 1.3;
+      U(I(i),0) += 0.1;
+    }
+    igl::per_vertex_normals(U,F,weighting,VF,NI,I,FN,N);
+
+    Eigen::MatrixXd FN_full,N_full;
+    igl::per_face_normals(U,F,FN_full);
+    igl::per_vertex_normals(U,F,weighting,FN_full,N_full);
+    IGL_TEST_CHECK_CLOSE(FN,FN_full,1e-12);
+    IGL_TEST_CHECK_CLOSE(N,N_full,1e-12);
+  }
+}
+
+IGL_TEST_CASE("repeated_corner")
+{
+  // Face 1 repeats vertex 0, which must still count once per corner
+  Eigen::MatrixXd V(4,3);
+  V <<
+    0,0,0,
+    1,0,0,
+    0,1,0,
+    0,0,1;
+  Eigen::MatrixXi F(3,3);
+  F <<
+    0,1,2,
+    0,0,3,
+    0,3,1;
+  Eigen::MatrixXd N,N_scatter;
+  igl::per_vertex_normals(
+    V,F,igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM,N);
+  per_vertex_normals_scatter(
+    V,F,igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM,N_scatter);
+  IGL_TEST_CHECK_CLOSE(N,N_scatter,1e-12);
+}
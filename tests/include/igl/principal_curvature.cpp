@@ -0,0 +1,104 @@
+#include <test_common.h>
+#include <igl/principal_curvature.h>
+#include <vector>
+
+IGL_TEST_CASE("sphere")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(60,30,V,F);
+  const double r = 2.5;
+  V *= r;
+  Eigen::MatrixXd PD1,PD2;
+  Eigen::VectorXd PV1,PV2;
+  std::vector<int> bad;
+  igl::principal_curvature(V,F,PD1,PD2,PV1,PV2,bad);
+  IGL_TEST_CHECK(bad.empty());
+  // Away from the poles, where the tessellation is the least regular
+  for(int i = 0;i<V.rows()-2;i++)
+  {
+    if(std::abs(V(i,2)) > 0.8*r)
+    {
+      continue;
+    }
+    IGL_TEST_CHECK(std::abs(std::abs(PV1(i))*r-1) < 0.15);
+    IGL_TEST_CHECK(std::abs(std::abs(PV2(i))*r-1) < 0.15);
+  }
+}
+
+IGL_TEST_CASE("cylinder")
+{
+  // Open cylinder of radius r around the z axis
+  const int nu = 48, nz = 30;
+  const double r = 1.5, pi = 3.14159265358979323846;
+  Eigen::MatrixXd V(nu*nz,3);
+  Eigen::MatrixXi F(2*nu*(nz-1),3);
+  for(int z = 0;z<nz;z++)
+  {
+    for(int u = 0;u<nu;u++)
+    {
+      const double phi = 2.*pi*u/nu;
+      V.row(z*nu+u) << r*std::cos(phi),r*std::sin(phi),0.1*z;
+    }
+  }
+  int f = 0;
+  for(int z = 0;z+1<nz;z++)
+  {
+    for(int u = 0;u<nu;u++)
+    {
+      const int a = z*nu+u, b = z*nu+(u+1)%nu;
+      F.row(f++) << a,b,b+nu;
+      F.row(f++) << a,b+nu,a+nu;
+    }
+  }
+  Eigen::MatrixXd PD1,PD2;
+  Eigen::VectorXd PV1,PV2;
+  igl::principal_curvature(V,F,PD1,PD2,PV1,PV2);
+  for(int i = 10*nu;i<(nz-10)*nu;i++)
+  {
+    // Maximal curvature around the axis, none along it
+    const double k1 = std::max(std::abs(PV1(i)),std::abs(PV2(i)));
+    const double k2 = std::min(std::abs(PV1(i)),std::abs(PV2(i)));
+    IGL_TEST_CHECK(std::abs(k1*r-1) < 0.15);
+    IGL_TEST_CHECK(k2*r < 0.1);
+    const Eigen::RowVector3d & d =
+      std::abs(PV1(i)) > std::abs(PV2(i)) ? PD1.row(i) : PD2.row(i);
+    IGL_TEST_CHECK(std::abs(d(2)) < 0.05);
+  }
+}
+
+IGL_TEST_CASE("precomputed_matches_direct")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(30,15,V,F);
+  // Break the symmetry so that the principal directions are well defined
+  V.col(0) *= 1.5;
+  V.col(1) *= 0.8;
+  for(const bool use_kring : {true,false})
+  {
+    for(const unsigned radius : {2u,5u})
+    {
+      Eigen::MatrixXd PD1,PD2;
+      Eigen::VectorXd PV1,PV2;
+      std::vector<int> bad;
+      igl::principal_curvature(V,F,PD1,PD2,PV1,PV2,bad,radius,use_kring);
+      // Cached rings cover radius 2 but not 5, which searches per vertex
+      for(const int max_ring : {0,3})
+      {
+        igl::PrincipalCurvatureData data;
+        igl::principal_curvature_precompute(V,F,max_ring,data);
+        Eigen::MatrixXd PD1_data,PD2_data;
+        Eigen::VectorXd PV1_data,PV2_data;
+        std::vector<int> bad_data;
+        igl::principal_curvature(
+          data,PD1_data,PD2_data,PV1_data,PV2_data,bad_data,radius,use_kring);
+        IGL_TEST_CHECK(bad_data == bad);
+        IGL_TEST_CHECK_CLOSE(PV1_data,PV1,1e-10);
+        IGL_TEST_CHECK_CLOSE(PV2_data,PV2,1e-10);
+        IGL_TEST_CHECK_CLOSE(PD1_data,PD1,1e-10);
+        IGL_TEST_CHECK_CLOSE(PD2_data,PD2,1e-10);
+      }
+    }
+  }
+}
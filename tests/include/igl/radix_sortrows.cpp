@@ -0,0 +1,87 @@
+#include <test_common.h>
+#include <igl/radix_sortrows.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+  // Stable lexicographic reference, -0 equal to 0
+  template <typename DerivedX>
+  Eigen::VectorXi radix_sortrows_reference(
+    const Eigen::MatrixBase<DerivedX> & X,
+    const bool ascending)
+  {
+    std::vector<int> I(X.rows());
+    std::iota(I.begin(),I.end(),0);
+    std::stable_sort(I.begin(),I.end(),[&](const int a,const int b)
+    {
+      for(int c = 0;c<X.cols();c++)
+      {
+        if(X(a,c) != X(b,c))
+        {
+          return ascending == (X(a,c) < X(b,c));
+        }
+      }
+      return false;
+    });
+    return Eigen::Map<Eigen::VectorXi>(I.data(),I.size());
+  }
+
+  template <typename DerivedX>
+  void check_radix_sortrows(const Eigen::MatrixBase<DerivedX> & X)
+  {
+    for(const bool ascending : {true,false})
+    {
+      Eigen::VectorXi I;
+      IGL_TEST_CHECK(igl::radix_sortrows(X,ascending,I));
+      IGL_TEST_CHECK_CLOSE(I,radix_sortrows_reference(X,ascending),0);
+    }
+  }
+}
+
+IGL_TEST_CASE("integers")
+{
+  srand(0);
+  // Few distinct values so that rows tie on leading columns
+  Eigen::MatrixXi X(5000,3);
+  for(int i = 0;i<X.size();i++)
+  {
+    X(i) = rand()%7-3;
+  }
+  // Bytes beyond the first
+  X.col(2) *= 100000;
+  check_radix_sortrows(X);
+  const Eigen::Matrix<unsigned,Eigen::Dynamic,2> U =
+    (X.leftCols(2).array()+3).cast<unsigned>()*4000000000u/7;
+  check_radix_sortrows(U);
+  const Eigen::Matrix<long long,Eigen::Dynamic,1> L =
+    X.col(2).cast<long long>()*(1ll<<32);
+  check_radix_sortrows(L);
+}
+
+IGL_TEST_CASE("floating_point")
+{
+  srand(0);
+  Eigen::MatrixXd X = Eigen::MatrixXd::Random(3000,2);
+  X.col(0) = (X.col(0)*4).array().round()/4;
+  X(0,0) = -0.0;
+  X(1,0) = 0.0;
+  X(2,0) = std::numeric_limits<double>::infinity();
+  X(3,0) = -std::numeric_limits<double>::infinity();
+  X(4,0) = std::numeric_limits<double>::denorm_min();
+  X(5,0) = -std::numeric_limits<double>::max();
+  check_radix_sortrows(X);
+  check_radix_sortrows(Eigen::MatrixXf(X.cast<float>()));
+}
+
+IGL_TEST_CASE("unsupported_scalar")
+{
+  Eigen::Matrix<bool,Eigen::Dynamic,1> X(3);
+  X << true,false,true;
+  Eigen::VectorXi I(1);
+  I << 42;
+  IGL_TEST_CHECK(!igl::radix_sortrows(X,true,I));
+  IGL_TEST_CHECK(I.size() == 1 && I(0) == 42);
+}
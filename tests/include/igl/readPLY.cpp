@@ -0,0 +1,57 @@
+#include <test_common.h>
+#include <igl/readPLY.h>
+#include <igl/writePLY.h>
+#include <igl/list_to_matrix.h>
+#include <cstdio>
+
+namespace
+{
+  void check_readPLY_round_trip(const bool ascii)
+  {
+    Eigen::MatrixXd V,N,UV;
+    Eigen::MatrixXi F;
+    test_common::sphere(40,21,V,F);
+    N = V;
+    UV = V.leftCols(2);
+    const std::string filename = ascii ?
+      "readPLY_round_trip_ascii.ply" : "readPLY_round_trip_binary.ply";
+    IGL_TEST_CHECK(igl::writePLY(filename,V,F,N,UV,ascii));
+
+    Eigen::MatrixXd rV,rN,rUV;
+    Eigen::MatrixXi rF;
+    IGL_TEST_CHECK(igl::readPLY(filename,rV,rF,rN,rUV));
+    IGL_TEST_CHECK_CLOSE(rV,V,1e-6);
+    IGL_TEST_CHECK_CLOSE(rF,F,0);
+    IGL_TEST_CHECK_CLOSE(rN,N,1e-6);
+    IGL_TEST_CHECK_CLOSE(rUV,UV,1e-6);
+
+    // The list reader must agree with the streaming reader
+    std::vector<std::vector<double> > lV,lN,lUV;
+    std::vector<std::vector<int> > lF;
+    IGL_TEST_CHECK(igl::readPLY(filename,lV,lF,lN,lUV));
+    Eigen::MatrixXd mV;
+    Eigen::MatrixXi mF;
+    igl::list_to_matrix(lV,mV);
+    igl::list_to_matrix(lF,mF);
+    IGL_TEST_CHECK_CLOSE(rV,mV,0);
+    IGL_TEST_CHECK_CLOSE(rF,mF,0);
+    std::remove(filename.c_str());
+  }
+}
+
+IGL_TEST_CASE("binary")
+{
+  check_readPLY_round_trip(false);
+}
+
+IGL_TEST_CASE("ascii")
+{
+  check_readPLY_round_trip(true);
+}
+
+IGL_TEST_CASE("missing_file")
+{
+  Eigen::MatrixXd V,N,UV;
+  Eigen::MatrixXi F;
+  IGL_TEST_CHECK(!igl::readPLY("readPLY_missing_file.ply",V,F,N,UV));
+}
@@ -0,0 +1,57 @@
+#include <test_common.h>
+#include <igl/readSTL.h>
+#include <igl/writeSTL.h>
+#include <igl/per_face_normals.h>
+#include <cstdio>
+
+namespace
+{
+  void check_readSTL_round_trip(const bool ascii)
+  {
+    Eigen::MatrixXd V,N;
+    Eigen::MatrixXi F;
+    // More triangles than a binary read chunk
+    test_common::sphere(120,21,V,F);
+    igl::per_face_normals(V,F,N);
+    const std::string filename = ascii ?
+      "readSTL_round_trip_ascii.stl" : "readSTL_round_trip_binary.stl";
+    IGL_TEST_CHECK(igl::writeSTL(filename,V,F,N,ascii));
+
+    // Without merging every corner gets its own vertex
+    Eigen::MatrixXd sV,sN;
+    Eigen::MatrixXi sF;
+    IGL_TEST_CHECK(igl::readSTL(filename,sV,sF,sN));
+    IGL_TEST_CHECK(sV.rows() == 3*F.rows() && sF.rows() == F.rows());
+    IGL_TEST_CHECK_CLOSE(sN,N,1e-6);
+
+    // Merging recovers the shared vertices, numbered by first appearance
+    Eigen::MatrixXd mV,mN;
+    Eigen::MatrixXi mF;
+    IGL_TEST_CHECK(igl::readSTL(filename,mV,mF,mN,true));
+    IGL_TEST_CHECK(mV.rows() == V.rows() && mF.rows() == F.rows());
+    IGL_TEST_CHECK_CLOSE(mN,N,1e-6);
+    if(mF.rows() != F.rows() || sF.rows() != F.rows())
+    {
+      return;
+    }
+    for(int f = 0;f<F.rows();f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        IGL_TEST_CHECK_CLOSE(mV.row(mF(f,c)),V.row(F(f,c)),1e-6);
+        IGL_TEST_CHECK_CLOSE(sV.row(sF(f,c)),V.row(F(f,c)),1e-6);
+      }
+    }
+    std::remove(filename.c_str());
+  }
+}
+
+IGL_TEST_CASE("binary")
+{
+  check_readSTL_round_trip(false);
+}
+
+IGL_TEST_CASE("ascii")
+{
+  check_readSTL_round_trip(true);
+}
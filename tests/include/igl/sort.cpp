@@ -0,0 +1,41 @@
+#include <test_common.h>
+#include <igl/sort.h>
+#include <algorithm>
+
+IGL_TEST_CASE("large")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(40,21,V,F);
+  // Columns of large matrices
+  for(const bool ascending : {true,false})
+  {
+    Eigen::MatrixXd Y;
+    Eigen::MatrixXi I;
+    igl::sort(V,1,ascending,Y,I);
+    bool sorted = true;
+    for(int c = 0;c<V.cols();c++)
+    {
+      for(int i = 0;i<V.rows();i++)
+      {
+        sorted = sorted && Y(i,c) == V(I(i,c),c) &&
+          (i == 0 || (ascending ? Y(i-1,c) <= Y(i,c) : Y(i-1,c) >= Y(i,c)));
+      }
+    }
+    IGL_TEST_CHECK(sorted);
+  }
+  // Vectors
+  const std::vector<int> unsorted(F.data(),F.data()+F.size());
+  std::vector<int> sorted;
+  std::vector<size_t> index_map;
+  igl::sort(unsorted,true,sorted,index_map);
+  std::vector<int> expected = unsorted;
+  std::sort(expected.begin(),expected.end());
+  IGL_TEST_CHECK(sorted == expected);
+  bool mapped = index_map.size() == unsorted.size();
+  for(size_t i = 0;mapped && i<index_map.size();i++)
+  {
+    mapped = unsorted[index_map[i]] == sorted[i];
+  }
+  IGL_TEST_CHECK(mapped);
+}
@@ -0,0 +1,58 @@
+#include <test_common.h>
+#include <igl/sortrows.h>
+
+namespace
+{
+  // Rows of Y are X(I,:) in order, equal rows keeping their input order
+  template <typename DerivedX>
+  bool sortrows_is_sorted(
+    const DerivedX & X,
+    const DerivedX & Y,
+    const Eigen::VectorXi & I,
+    const bool ascending)
+  {
+    if(Y.rows() != X.rows() || I.size() != X.rows())
+    {
+      return false;
+    }
+    for(int i = 0;i<X.rows();i++)
+    {
+      if(Y.row(i) != X.row(I(i)))
+      {
+        return false;
+      }
+      if(i == 0)
+      {
+        continue;
+      }
+      int c = 0;
+      while(c<X.cols() && Y(i-1,c) == Y(i,c))
+      {
+        c++;
+      }
+      if(c == X.cols() ? I(i-1) > I(i) :
+        ascending != (Y(i-1,c) < Y(i,c)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+IGL_TEST_CASE("rows")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(40,21,V,F);
+  for(const bool ascending : {true,false})
+  {
+    Eigen::MatrixXi Y;
+    Eigen::VectorXi I;
+    igl::sortrows(F,ascending,Y,I);
+    IGL_TEST_CHECK(sortrows_is_sorted(F,Y,I,ascending));
+    Eigen::MatrixXd W;
+    igl::sortrows(V,ascending,W,I);
+    IGL_TEST_CHECK(sortrows_is_sorted(V,W,I,ascending));
+  }
+}
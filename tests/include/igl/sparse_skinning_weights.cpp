@@ -0,0 +1,45 @@
+#include <test_common.h>
+#include <igl/sparse_skinning_weights.h>
+
+IGL_TEST_CASE("keeps_largest")
+{
+  Eigen::MatrixXd W(3,4);
+  W <<
+    0.1,0.4,0.2,0.3,
+    0.5,0.0,0.5,0.0,
+    0.0,0.0,0.0,1.0;
+  Eigen::MatrixXi I;
+  Eigen::MatrixXd WK;
+  igl::sparse_skinning_weights(W,2,I,WK);
+  Eigen::MatrixXi I_expected(3,2);
+  I_expected <<
+    1,3,
+    // Ties keep the lower handle index first
+    0,2,
+    // Missing influences are padded with handle 0 and weight 0
+    3,0;
+  Eigen::MatrixXd WK_expected(3,2);
+  WK_expected <<
+    0.4/0.7,0.3/0.7,
+    0.5,0.5,
+    1.0,0.0;
+  IGL_TEST_CHECK(I == I_expected);
+  IGL_TEST_CHECK_CLOSE(WK,WK_expected,1e-15);
+}
+
+IGL_TEST_CASE("clamps_k")
+{
+  Eigen::MatrixXd W = Eigen::MatrixXd::Random(20,3).cwiseAbs();
+  Eigen::MatrixXi I;
+  Eigen::MatrixXd WK;
+  igl::sparse_skinning_weights(W,5,I,WK);
+  IGL_TEST_CHECK(I.rows() == 20 && I.cols() == 3);
+  IGL_TEST_CHECK_CLOSE(WK.rowwise().sum(),Eigen::VectorXd::Ones(20),1e-14);
+  for(int i = 0;i<I.rows();i++)
+  {
+    for(int j = 0;j<I.cols();j++)
+    {
+      IGL_TEST_CHECK(WK(i,j)*W.row(i).sum() - W(i,I(i,j)) < 1e-14);
+    }
+  }
+}
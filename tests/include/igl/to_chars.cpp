@@ -0,0 +1,80 @@
+#include <test_common.h>
+#include <igl/to_chars.h>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace
+{
+  template <typename T>
+  std::string to_chars_string(const T x)
+  {
+    char buffer[igl::TO_CHARS_MAX_LENGTH];
+    return std::string(buffer,igl::to_chars(buffer,x));
+  }
+}
+
+IGL_TEST_CASE("shortest")
+{
+  IGL_TEST_CHECK(to_chars_string(0.1) == "0.1");
+  IGL_TEST_CHECK(to_chars_string(0.1f) == "0.1");
+  IGL_TEST_CHECK(to_chars_string(1.0) == "1");
+  IGL_TEST_CHECK(to_chars_string(-2.5) == "-2.5");
+  IGL_TEST_CHECK(to_chars_string(0.0) == "0");
+  IGL_TEST_CHECK(to_chars_string(1e-5) == "1e-05");
+  IGL_TEST_CHECK(to_chars_string(1.5e20) == "1.5e+20");
+  IGL_TEST_CHECK(to_chars_string(std::numeric_limits<double>::quiet_NaN()) == "nan");
+  IGL_TEST_CHECK(to_chars_string(std::numeric_limits<double>::infinity()) == "inf");
+  IGL_TEST_CHECK(to_chars_string(-std::numeric_limits<double>::infinity()) == "-inf");
+}
+
+IGL_TEST_CASE("round_trip")
+{
+  srand(0);
+  bool exact = true;
+  bool exact_float = true;
+  const double special[] = {
+    std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::min(),
+    std::numeric_limits<double>::denorm_min(),
+    std::numeric_limits<double>::epsilon(),
+    1./3.,
+    123456789012345678.};
+  for(const double x : special)
+  {
+    exact = exact && std::strtod(to_chars_string(x).c_str(),nullptr) == x;
+    exact = exact && std::strtod(to_chars_string(-x).c_str(),nullptr) == -x;
+  }
+  for(int i = 0;i<20000;i++)
+  {
+    // Random mantissas over a wide range of exponents
+    const double x =
+      (double(rand())/RAND_MAX-0.5)*std::pow(10.0,rand()%80-40);
+    const std::string s = to_chars_string(x);
+    exact = exact &&
+      s.size() <= (size_t)igl::TO_CHARS_MAX_LENGTH &&
+      std::strtod(s.c_str(),nullptr) == x;
+    const float f = float(x);
+    exact_float = exact_float &&
+      std::strtof(to_chars_string(f).c_str(),nullptr) == f;
+  }
+  IGL_TEST_CHECK(exact);
+  IGL_TEST_CHECK(exact_float);
+}
+
+IGL_TEST_CASE("integers")
+{
+  IGL_TEST_CHECK(to_chars_string(0) == "0");
+  IGL_TEST_CHECK(to_chars_string(-17) == "-17");
+  IGL_TEST_CHECK(
+    to_chars_string(std::numeric_limits<int>::min()) == "-2147483648");
+  IGL_TEST_CHECK(
+    to_chars_string(std::numeric_limits<unsigned int>::max()) == "4294967295");
+  IGL_TEST_CHECK(
+    to_chars_string(std::numeric_limits<long long>::min()) ==
+    "-9223372036854775808");
+  IGL_TEST_CHECK(
+    to_chars_string(std::numeric_limits<unsigned long long>::max()) ==
+    "18446744073709551615");
+}
@@ -0,0 +1,87 @@
+#include <test_common.h>
+#include <igl/unique_edge_map.h>
+#include <igl/oriented_facets.h>
+
+namespace
+{
+  void check_unique_edge_map(const Eigen::MatrixXi & F)
+  {
+    Eigen::MatrixXi E,uE,uE_lists,E_lists;
+    Eigen::VectorXi EMAP,uEC,uEE,EMAP_lists;
+    std::vector<std::vector<int> > uE2E;
+    igl::unique_edge_map(F,E,uE,EMAP,uEC,uEE);
+    igl::unique_edge_map(F,E_lists,uE_lists,EMAP_lists,uE2E);
+    Eigen::MatrixXi E_expected;
+    igl::oriented_facets(F,E_expected);
+    IGL_TEST_CHECK_CLOSE(E,E_expected,0);
+    IGL_TEST_CHECK_CLOSE(E_lists,E,0);
+    IGL_TEST_CHECK_CLOSE(uE_lists,uE,0);
+    IGL_TEST_CHECK_CLOSE(EMAP_lists,EMAP,0);
+    IGL_TEST_CHECK(uEC.size() == uE.rows()+1 && uEC(uE.rows()) == E.rows());
+    IGL_TEST_CHECK(uE2E.size() == (size_t)uE.rows());
+    if(uEC.size() != uE.rows()+1 || uE2E.size() != (size_t)uE.rows())
+    {
+      return;
+    }
+    bool valid = true;
+    for(int u = 0;u<uE.rows();u++)
+    {
+      // Lexicographic order of the sorted vertices
+      const int lo = uE.row(u).minCoeff();
+      const int hi = uE.row(u).maxCoeff();
+      if(u > 0)
+      {
+        const int prev_lo = uE.row(u-1).minCoeff();
+        const int prev_hi = uE.row(u-1).maxCoeff();
+        valid = valid &&
+          (prev_lo < lo || (prev_lo == lo && prev_hi < hi));
+      }
+      // Directed edges in increasing order, oriented like the first
+      valid = valid && uEC(u) < uEC(u+1) &&
+        (int)uE2E[u].size() == uEC(u+1)-uEC(u) &&
+        E(uEE(uEC(u)),0) == uE(u,0) && E(uEE(uEC(u)),1) == uE(u,1);
+      for(int k = uEC(u);k<uEC(u+1);k++)
+      {
+        const int e = uEE(k);
+        valid = valid && EMAP(e) == u && uE2E[u][k-uEC(u)] == e &&
+          (k == uEC(u) || uEE(k-1) < e) &&
+          std::min(E(e,0),E(e,1)) == lo && std::max(E(e,0),E(e,1)) == hi;
+      }
+    }
+    IGL_TEST_CHECK(valid);
+  }
+}
+
+IGL_TEST_CASE("closed")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(12,7,V,F);
+  // Vary the orientation in which each edge is met first
+  for(int f = 0;f<F.rows();f += 3)
+  {
+    F.row(f) = F.row(f).reverse().eval();
+  }
+  check_unique_edge_map(F);
+}
+
+IGL_TEST_CASE("non_manifold")
+{
+  // Three triangles sharing edge (0,1), one of them twice
+  Eigen::MatrixXi F(4,3);
+  F <<
+    0,1,2,
+    1,0,3,
+    0,1,4,
+    0,1,4;
+  check_unique_edge_map(F);
+}
+
+IGL_TEST_CASE("large")
+{
+  // Enough edges to split the sort among threads
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::grid(120,V,F);
+  check_unique_edge_map(F);
+}
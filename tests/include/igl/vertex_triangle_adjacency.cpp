@@ -0,0 +1,52 @@
+#include <test_common.h>
+#include <igl/vertex_triangle_adjacency.h>
+
+namespace
+{
+  void check_vertex_triangle_adjacency(
+    const Eigen::MatrixXi & F,
+    const int n)
+  {
+    std::vector<std::vector<int> > VF_list,VFi_list;
+    igl::vertex_triangle_adjacency(n,F,VF_list,VFi_list);
+    Eigen::VectorXi VF,VFi,NI,VF_only,NI_only;
+    igl::vertex_triangle_adjacency(F,n,VF,VFi,NI);
+    igl::vertex_triangle_adjacency(F,n,VF_only,NI_only);
+    IGL_TEST_CHECK(NI.size() == n+1 && NI(0) == 0 && NI(n) == F.size());
+    IGL_TEST_CHECK_CLOSE(VF_only,VF,0);
+    IGL_TEST_CHECK_CLOSE(NI_only,NI,0);
+    bool same = NI.size() == n+1;
+    for(int i = 0;same && i<n;i++)
+    {
+      same =
+        NI(i+1)-NI(i) == (int)VF_list[i].size() &&
+        std::equal(VF_list[i].begin(),VF_list[i].end(),VF.data()+NI(i)) &&
+        std::equal(VFi_list[i].begin(),VFi_list[i].end(),VFi.data()+NI(i));
+    }
+    IGL_TEST_CHECK(same);
+  }
+}
+
+IGL_TEST_CASE("csr_matches_lists")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(12,7,V,F);
+  check_vertex_triangle_adjacency(F,V.rows());
+  // Unreferenced vertices and repeated corners
+  Eigen::MatrixXi G(3,3);
+  G <<
+    0,1,2,
+    0,0,3,
+    4,3,1;
+  check_vertex_triangle_adjacency(G,7);
+}
+
+IGL_TEST_CASE("large")
+{
+  // Enough faces to split the sort among threads
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::grid(120,V,F);
+  check_vertex_triangle_adjacency(F,V.rows());
+}
@@ -0,0 +1,29 @@
+#include <test_common.h>
+#include <igl/writeOBJ.h>
+#include <igl/readOBJ.h>
+#include <cstdio>
+
+IGL_TEST_CASE("round_trip")
+{
+  Eigen::MatrixXd V,TC,CN;
+  Eigen::MatrixXi F;
+  // Enough vertices to format in several blocks
+  test_common::sphere(200,101,V,F);
+  srand(0);
+  V += 1e-3*Eigen::MatrixXd::Random(V.rows(),3);
+  TC = V.leftCols(2);
+  CN = V.rowwise().normalized();
+  const std::string filename = "writeOBJ_round_trip.obj";
+  IGL_TEST_CHECK(igl::writeOBJ(filename,V,F,CN,F,TC,F));
+  Eigen::MatrixXd rV,rTC,rCN;
+  Eigen::MatrixXi rF,rFTC,rFN;
+  IGL_TEST_CHECK(igl::readOBJ(filename,rV,rTC,rCN,rF,rFTC,rFN));
+  std::remove(filename.c_str());
+  // Shortest round trip formatting reads back exactly
+  IGL_TEST_CHECK_CLOSE(rV,V,0);
+  IGL_TEST_CHECK_CLOSE(rTC,TC,0);
+  IGL_TEST_CHECK_CLOSE(rCN,CN,0);
+  IGL_TEST_CHECK_CLOSE(rF,F,0);
+  IGL_TEST_CHECK_CLOSE(rFTC,F,0);
+  IGL_TEST_CHECK_CLOSE(rFN,F,0);
+}
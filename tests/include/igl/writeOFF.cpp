@@ -0,0 +1,21 @@
+#include <test_common.h>
+#include <igl/writeOFF.h>
+#include <igl/readOFF.h>
+#include <cstdio>
+
+IGL_TEST_CASE("round_trip")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(200,101,V,F);
+  srand(0);
+  V += 1e-3*Eigen::MatrixXd::Random(V.rows(),3);
+  const std::string filename = "writeOFF_round_trip.off";
+  IGL_TEST_CHECK(igl::writeOFF(filename,V,F));
+  Eigen::MatrixXd rV;
+  Eigen::MatrixXi rF;
+  IGL_TEST_CHECK(igl::readOFF(filename,rV,rF));
+  std::remove(filename.c_str());
+  IGL_TEST_CHECK_CLOSE(rV,V,0);
+  IGL_TEST_CHECK_CLOSE(rF,F,0);
+}
@@ -0,0 +1,39 @@
+#include <test_common.h>
+#include <igl/writePLY.h>
+#include <igl/readPLY.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+IGL_TEST_CASE("header_types")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(8,5,V,F);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  const Eigen::Matrix<unsigned,Eigen::Dynamic,Eigen::Dynamic> Fu =
+    F.cast<unsigned>();
+  const std::string filename = "writePLY_header_types.ply";
+  for(const bool ascii : {true,false})
+  {
+    IGL_TEST_CHECK(igl::writePLY(filename,Vf,Fu,ascii));
+    std::ifstream in(filename);
+    std::string header,line;
+    while(std::getline(in,line) && line != "end_header")
+    {
+      header += line+"\n";
+    }
+    in.close();
+    IGL_TEST_CHECK(header.find("property float x\n") != std::string::npos);
+    IGL_TEST_CHECK(
+      header.find("property list uchar uint vertex_indices\n") !=
+      std::string::npos);
+    Eigen::MatrixXd rV,rN,rUV;
+    Eigen::MatrixXi rF;
+    IGL_TEST_CHECK(igl::readPLY(filename,rV,rF,rN,rUV));
+    // Floats are written to round trip as floats
+    IGL_TEST_CHECK_CLOSE(Eigen::MatrixXf(rV.cast<float>()),Vf,0);
+    IGL_TEST_CHECK_CLOSE(rF,F,0);
+  }
+  std::remove(filename.c_str());
+}
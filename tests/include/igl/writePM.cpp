@@ -0,0 +1,118 @@
+#include <test_common.h>
+#include <igl/writePM.h>
+#include <igl/readPM.h>
+#include <igl/ProgressiveMeshReader.h>
+#include <igl/decimate.h>
+#include <igl/progressive_mesh_refine.h>
+#include <cstdio>
+#include <sstream>
+
+namespace
+{
+  void write_pm_test_mesh(
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    std::vector<igl::VertexSplit> & splits,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F)
+  {
+    test_common::sphere(16,9,V,F);
+    Eigen::VectorXi J,I;
+    igl::decimate(V,F,40,U,G,J,I,splits);
+  }
+
+  // Refine all the way, with the corners of every face rotated to start at
+  // its smallest index: .pm files only keep the orientation of new faces
+  void write_pm_test_refine(
+    const std::vector<igl::VertexSplit> & splits,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G)
+  {
+    int k = 0;
+    igl::progressive_mesh_refine(splits,1<<30,U,G,k);
+    for(int g = 0;g<G.rows();g++)
+    {
+      int c = 0;
+      G.row(g).minCoeff(&c);
+      const Eigen::RowVector3i f = G.row(g);
+      G.row(g) << f(c),f((c+1)%3),f((c+2)%3);
+    }
+  }
+}
+
+IGL_TEST_CASE("round_trip")
+{
+  Eigen::MatrixXd U,V;
+  Eigen::MatrixXi G,F;
+  std::vector<igl::VertexSplit> splits;
+  write_pm_test_mesh(U,G,splits,V,F);
+  const std::string filename = "writePM_round_trip.pm";
+  IGL_TEST_CHECK(igl::writePM(filename,U,G,splits));
+  Eigen::MatrixXd rU;
+  Eigen::MatrixXi rG;
+  std::vector<igl::VertexSplit> r_splits;
+  IGL_TEST_CHECK(igl::readPM(filename,rU,rG,r_splits));
+  std::remove(filename.c_str());
+  IGL_TEST_CHECK_CLOSE(rU,U,1e-6);
+  IGL_TEST_CHECK_CLOSE(rG,G,0);
+  IGL_TEST_CHECK(r_splits.size() == splits.size());
+
+  // Both refine to the same mesh, up to single precision positions
+  write_pm_test_refine(splits,U,G);
+  write_pm_test_refine(r_splits,rU,rG);
+  IGL_TEST_CHECK_CLOSE(rU,U,1e-6);
+  IGL_TEST_CHECK_CLOSE(rG,G,0);
+}
+
+IGL_TEST_CASE("reader_chunks")
+{
+  Eigen::MatrixXd U,V;
+  Eigen::MatrixXi G,F;
+  std::vector<igl::VertexSplit> splits;
+  write_pm_test_mesh(U,G,splits,V,F);
+  std::stringstream stream;
+  IGL_TEST_CHECK(igl::writePM(stream,U,G,splits));
+  const std::string bytes = stream.str();
+
+  // One byte at a time: the base mesh and the splits show up as soon as
+  // they are complete
+  igl::ProgressiveMeshReader reader;
+  IGL_TEST_CHECK(reader.num_splits() == -1);
+  size_t base_end = 0;
+  bool monotone = true;
+  size_t num_splits = 0;
+  for(size_t b = 0;b<bytes.size();b++)
+  {
+    IGL_TEST_CHECK(!reader.done());
+    IGL_TEST_CHECK(reader.push(bytes.data()+b,1));
+    if(base_end == 0 && reader.has_base())
+    {
+      base_end = b+1;
+    }
+    monotone = monotone && reader.splits().size() >= num_splits;
+    num_splits = reader.splits().size();
+  }
+  IGL_TEST_CHECK(monotone);
+  IGL_TEST_CHECK(reader.done() && !reader.failed());
+  IGL_TEST_CHECK(base_end > 0 && base_end < bytes.size());
+  IGL_TEST_CHECK(reader.num_splits() == (int)splits.size());
+  IGL_TEST_CHECK_CLOSE(reader.base_vertices(),U,1e-6);
+  IGL_TEST_CHECK_CLOSE(reader.base_faces(),G,0);
+
+  Eigen::MatrixXd rU = reader.base_vertices();
+  Eigen::MatrixXi rG = reader.base_faces();
+  write_pm_test_refine(reader.splits(),rU,rG);
+  write_pm_test_refine(splits,U,G);
+  IGL_TEST_CHECK_CLOSE(rU,U,1e-6);
+  IGL_TEST_CHECK_CLOSE(rG,G,0);
+}
+
+IGL_TEST_CASE("reader_rejects_malformed")
+{
+  igl::ProgressiveMeshReader reader;
+  const std::string bytes = "NOTPM1";
+  IGL_TEST_CHECK(!reader.push(bytes.data(),bytes.size()));
+  IGL_TEST_CHECK(reader.failed() && !reader.has_base());
+  reader.clear();
+  IGL_TEST_CHECK(!reader.failed());
+}
@@ -0,0 +1,51 @@
+#include <test_common.h>
+#include <igl/write_formatted_rows.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+IGL_TEST_CASE("rows_in_order")
+{
+  // Rows of varying length, several megabytes in total, so that blocks are
+  // formatted in parallel
+  const size_t num_rows = 200000;
+  const auto row = [](const size_t i)
+  {
+    return "row " + std::to_string(i) + std::string(i%37,'x') + "\n";
+  };
+  const std::string filename = "write_formatted_rows.txt";
+  FILE * fp = fopen(filename.c_str(),"wb");
+  IGL_TEST_CHECK(fp != nullptr);
+  if(fp == nullptr)
+  {
+    return;
+  }
+  const bool ok = igl::write_formatted_rows(fp,num_rows,64,
+    [&row](const size_t i,char * p)
+    {
+      const std::string r = row(i);
+      std::memcpy(p,r.data(),r.size());
+      return p+r.size();
+    });
+  fclose(fp);
+  IGL_TEST_CHECK(ok);
+
+  std::string expected;
+  for(size_t i = 0;i<num_rows;i++)
+  {
+    expected += row(i);
+  }
+  fp = fopen(filename.c_str(),"rb");
+  std::string contents(expected.size()+1,'\0');
+  const size_t read = fread(&contents[0],1,contents.size(),fp);
+  fclose(fp);
+  std::remove(filename.c_str());
+  contents.resize(read);
+  IGL_TEST_CHECK(contents == expected);
+}
+
+IGL_TEST_CASE("no_rows")
+{
+  IGL_TEST_CHECK(igl::write_formatted_rows(nullptr,0,16,
+    [](const size_t,char * p){ return p; }));
+}
@@ -0,0 +1,41 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "test_common.h"
+#include <cstdio>
+#include <string>
+
+// Usage: libigl_tests [prefix]
+//
+// Runs every registered case whose name starts with prefix (all cases
+// without one). Fails if a check fails or if no case matches.
+int main(int argc, char * argv[])
+{
+  const std::string prefix = argc > 1 ? argv[1] : "";
+  int num_run = 0;
+  for(const test_common::TestCase & test : test_common::test_cases())
+  {
+    if(test.name.compare(0,prefix.size(),prefix) != 0)
+    {
+      continue;
+    }
+    const int before = test_common::num_failures();
+    test.run();
+    printf("%s %s\n",
+      test_common::num_failures() == before ? "passed" : "FAILED",
+      test.name.c_str());
+    num_run++;
+  }
+  if(num_run == 0)
+  {
+    fprintf(stderr,"no test case matches \"%s\"\n",prefix.c_str());
+    return 1;
+  }
+  printf("%d case(s), %d failed check(s)\n",
+    num_run,test_common::num_failures());
+  return test_common::num_failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 The libigl contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_TESTS_TEST_COMMON_H
+#define IGL_TESTS_TEST_COMMON_H
+#include <Eigen/Core>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Minimal test registry: every file under tests/include registers its cases
+// with IGL_TEST_CASE and checks them with IGL_TEST_CHECK*. A case is named
+// after its file, e.g. "igl/sort/rows" for case "rows" in
+// include/igl/sort.cpp, and main.cpp runs the cases matching a name prefix.
+namespace test_common
+{
+  typedef void (*TestFunction)();
+  struct TestCase
+  {
+    std::string name;
+    TestFunction run;
+  };
+
+  inline std::vector<TestCase> & test_cases()
+  {
+    static std::vector<TestCase> cases;
+    return cases;
+  }
+
+  inline int & num_failures()
+  {
+    static int n = 0;
+    return n;
+  }
+
+  // "igl/sort" from ".../tests/include/igl/sort.cpp"
+  inline std::string file_to_name(const std::string & file)
+  {
+    std::string name = file;
+    for(char & c : name)
+    {
+      if(c == '\\')
+      {
+        c = '/';
+      }
+    }
+    const std::string include = "include/";
+    const size_t begin = name.rfind(include);
+    if(begin != std::string::npos)
+    {
+      name = name.substr(begin+include.size());
+    }
+    const size_t dot = name.rfind('.');
+    return dot == std::string::npos ? name : name.substr(0,dot);
+  }
+
+  struct Registrar
+  {
+    Registrar(const char * file, const char * name, const TestFunction run)
+    {
+      test_cases().push_back({file_to_name(file)+"/"+name,run});
+    }
+  };
+
+  inline bool check(
+    const bool ok,
+    const char * expr,
+    const char * file,
+    const int line)
+  {
+    if(!ok)
+    {
+      fprintf(stderr,"%s:%d: check failed: %s\n",file,line,expr);
+      num_failures()++;
+    }
+    return ok;
+  }
+
+  template <typename DerivedA, typename DerivedB>
+  inline bool check_close(
+    const Eigen::MatrixBase<DerivedA> & A,
+    const Eigen::MatrixBase<DerivedB> & B,
+    const double eps,
+    const char * expr,
+    const char * file,
+    const int line)
+  {
+    bool ok = A.rows() == B.rows() && A.cols() == B.cols();
+    double err = 0;
+    if(ok)
+    {
+      err = (A.template cast<double>()-B.template cast<double>()).
+        cwiseAbs().maxCoeff();
+      // NaN compares false
+      ok = A.size() == 0 || err <= eps;
+    }
+    if(!ok)
+    {
+      fprintf(stderr,"%s:%d: check failed: %s (%dx%d vs %dx%d, error %g)\n",
+        file,line,expr,(int)A.rows(),(int)A.cols(),(int)B.rows(),
+        (int)B.cols(),err);
+      num_failures()++;
+    }
+    return ok;
+  }
+
+  // Closed, manifold triangle mesh of the unit sphere: nu vertices around
+  // each of the nv-1 rings between the two poles.
+  inline void sphere(
+    const int nu,
+    const int nv,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F)
+  {
+    const double pi = 3.14159265358979323846;
+    V.resize(nu*(nv-1)+2,3);
+    F.resize(2*nu*(nv-1),3);
+    for(int j = 1;j<nv;j++)
+    {
+      const double theta = pi*j/nv;
+      for(int i = 0;i<nu;i++)
+      {
+        const double phi = 2.*pi*i/nu;
+        V.row((j-1)*nu+i) <<
+          std::sin(theta)*std::cos(phi),
+          std::sin(theta)*std::sin(phi),
+          std::cos(theta);
+      }
+    }
+    const int north = nu*(nv-1);
+    const int south = north+1;
+    V.row(north) << 0,0,1;
+    V.row(south) << 0,0,-1;
+    int f = 0;
+    for(int i = 0;i<nu;i++)
+    {
+      const int i1 = (i+1)%nu;
+      F.row(f++) << north,i,i1;
+      for(int j = 1;j<nv-1;j++)
+      {
+        const int a = (j-1)*nu+i;
+        const int b = (j-1)*nu+i1;
+        const int c = j*nu+i;
+        const int d = j*nu+i1;
+        F.row(f++) << a,c,d;
+        F.row(f++) << a,d,b;
+      }
+      F.row(f++) << (nv-2)*nu+i,south,(nv-2)*nu+i1;
+    }
+  }
+
+  // Triangulated regular grid of the unit square in the z=0 plane with n by n
+  // vertices
+  inline void grid(const int n, Eigen::MatrixXd & V, Eigen::MatrixXi & F)
+  {
+    V.resize(n*n,3);
+    F.resize(2*(n-1)*(n-1),3);
+    for(int y = 0;y<n;y++)
+    {
+      for(int x = 0;x<n;x++)
+      {
+        V.row(y*n+x) << double(x)/(n-1),double(y)/(n-1),0;
+      }
+    }
+    int f = 0;
+    for(int y = 0;y<n-1;y++)
+    {
+      for(int x = 0;x<n-1;x++)
+      {
+        const int a = y*n+x;
+        F.row(f++) << a,a+1,a+n+1;
+        F.row(f++) << a,a+n+1,a+n;
+      }
+    }
+  }
+
+  // Tetrahedral mesh of the unit cube with n by n by n vertices, every cell
+  // split into 6 positively oriented tetrahedra around its diagonal
+  inline void tet_grid(const int n, Eigen::MatrixXd & V, Eigen::MatrixXi & T)
+  {
+    V.resize(n*n*n,3);
+    for(int z = 0;z<n;z++)
+    {
+      for(int y = 0;y<n;y++)
+      {
+        for(int x = 0;x<n;x++)
+        {
+          V.row(x+n*(y+n*z)) <<
+            double(x)/(n-1),double(y)/(n-1),double(z)/(n-1);
+        }
+      }
+    }
+    const int axes[6][3] =
+      {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+    const int step[3] = {1,n,n*n};
+    T.resize(6*(n-1)*(n-1)*(n-1),4);
+    int t = 0;
+    for(int z = 0;z+1<n;z++)
+    {
+      for(int y = 0;y+1<n;y++)
+      {
+        for(int x = 0;x+1<n;x++)
+        {
+          const int a = x+n*(y+n*z);
+          for(const auto & p : axes)
+          {
+            const int b = a+step[p[0]];
+            const int c = b+step[p[1]];
+            const int d = c+step[p[2]];
+            const Eigen::RowVector3d e1 = V.row(b)-V.row(a);
+            const Eigen::RowVector3d e2 = V.row(c)-V.row(a);
+            const Eigen::RowVector3d e3 = V.row(d)-V.row(a);
+            if(e1.cross(e2).dot(e3) > 0)
+            {
+              T.row(t++) << a,b,c,d;
+            }else
+            {
+              T.row(t++) << a,c,b,d;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+#define IGL_TEST_CONCAT_IMPL(a,b) a##b
+#define IGL_TEST_CONCAT(a,b) IGL_TEST_CONCAT_IMPL(a,b)
+#define IGL_TEST_CASE(name) \
+  static void IGL_TEST_CONCAT(igl_test_case_,__LINE__)(); \
+  static const test_common::Registrar \
+    IGL_TEST_CONCAT(igl_test_registrar_,__LINE__)( \
+      __FILE__,name,&IGL_TEST_CONCAT(igl_test_case_,__LINE__)); \
+  static void IGL_TEST_CONCAT(igl_test_case_,__LINE__)()
+#define IGL_TEST_CHECK(cond) \
+  test_common::check((cond),#cond,__FILE__,__LINE__)
+#define IGL_TEST_CHECK_CLOSE(A,B,eps) \
+  test_common::check_close((A),(B),(eps),#A " == " #B,__FILE__,__LINE__)
+
+#endif
@@ -0,0 +1,417 @@
+// Headless simulation driver: runs the snake game loop (Renderer::UpdateScene)
+// without a window or GL context and reports the timings of its igl::Profiler
+// scopes, the heap allocations per tick and the peak heap size.
+//
+// Usage:
+//   headless_bin [balls] [links] [ticks] [seed] [ball rings]
+//
+// The level is built by Viewer::sys_init like in the game, from generated
+// stand-ins for the asset files (no configuration.txt), so that runs are
+// reproducible on any machine. The
+// snake always chases the first remaining ball and, once the objective is
+// reached, the pyramid, so a run is fully determined by its arguments.
+#include "igl/opengl/glfw/renderer.h"
+#include <igl/cylinder.h>
+#include <igl/get_seconds.h>
+#include <igl/PI.h>
+#include <igl/Profiler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <string>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(_MSC_VER) && defined(_DEBUG)
+#include <crtdbg.h>
+#endif
+
+// Heap allocation counters. Eigen matrices allocate with malloc, and so does
+// operator new, so malloc is what gets counted: by interposing it on glibc,
+// or through the CRT allocation hook in MSVC debug builds. Elsewhere the
+// allocation columns are not reported.
+static std::atomic<long long> alloc_count(0);
+static std::atomic<long long> alloc_bytes(0);
+// Bytes in use (as sized by the allocator) and their maximum since
+// reset_peak_heap()
+static std::atomic<long long> live_bytes(0);
+static std::atomic<long long> peak_bytes(0);
+
+static void count_allocation(std::size_t size)
+{
+	alloc_count.fetch_add(1, std::memory_order_relaxed);
+	alloc_bytes.fetch_add((long long)size, std::memory_order_relaxed);
+}
+
+static void count_live_bytes(long long delta)
+{
+	const long long live = live_bytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+	long long peak = peak_bytes.load(std::memory_order_relaxed);
+	while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+		;
+}
+
+static void reset_peak_heap()
+{
+	peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+#if defined(__GLIBC__)
+static const bool counts_allocations = true;
+extern "C"
+{
+	void* __libc_malloc(std::size_t size);
+	void* __libc_calloc(std::size_t n, std::size_t size);
+	void* __libc_realloc(void* p, std::size_t size);
+	void* __libc_memalign(std::size_t alignment, std::size_t size);
+	void __libc_free(void* p);
+
+	static void* count_block(void* p)
+	{
+		if (p)
+			count_live_bytes((long long)malloc_usable_size(p));
+		return p;
+	}
+
+	void* malloc(std::size_t size) __THROW
+	{
+		count_allocation(size);
+		return count_block(__libc_malloc(size));
+	}
+
+	void* calloc(std::size_t n, std::size_t size) __THROW
+	{
+		count_allocation(n * size);
+		return count_block(__libc_calloc(n, size));
+	}
+
+	void* realloc(void* p, std::size_t size) __THROW
+	{
+		count_allocation(size);
+		const long long old_size = p ? (long long)malloc_usable_size(p) : 0;
+		void* q = __libc_realloc(p, size);
+		// p is freed unless the reallocation failed
+		if (q || size == 0)
+			count_live_bytes(-old_size);
+		return count_block(q);
+	}
+
+	void* memalign(std::size_t alignment, std::size_t size) __THROW
+	{
+		count_allocation(size);
+		return count_block(__libc_memalign(alignment, size));
+	}
+
+	void* aligned_alloc(std::size_t alignment, std::size_t size) __THROW
+	{
+		count_allocation(size);
+		return count_block(__libc_memalign(alignment, size));
+	}
+
+	int posix_memalign(void** p, std::size_t alignment, std::size_t size) __THROW
+	{
+		count_allocation(size);
+		*p = count_block(__libc_memalign(alignment, size));
+		return *p ? 0 : ENOMEM;
+	}
+
+	void free(void* p) __THROW
+	{
+		if (p)
+			count_live_bytes(-(long long)malloc_usable_size(p));
+		__libc_free(p);
+	}
+}
+static void install_allocation_counter() {}
+#elif defined(_MSC_VER) && defined(_DEBUG)
+static const bool counts_allocations = true;
+static int count_crt_allocation(int type, void* p, std::size_t size, int block_use, long, const unsigned char*, int)
+{
+	if (type == _HOOK_ALLOC || type == _HOOK_REALLOC)
+		count_allocation(size);
+	// The hook runs before the CRT (re)allocates or frees the block
+	if (type == _HOOK_ALLOC)
+		count_live_bytes((long long)size);
+	else if (type == _HOOK_REALLOC)
+		count_live_bytes((long long)size - (p ? (long long)_msize_dbg(p, block_use) : 0));
+	else if (type == _HOOK_FREE && p)
+		count_live_bytes(-(long long)_msize_dbg(p, block_use));
+	return TRUE;
+}
+static void install_allocation_counter()
+{
+	_CrtSetAllocHook(count_crt_allocation);
+}
+#else
+static const bool counts_allocations = false;
+static void install_allocation_counter() {}
+#endif
+
+struct Stats
+{
+	double total = 0;
+	double max = 0;
+	long long calls = 0;
+	long long allocs = 0;
+	long long bytes = 0;
+};
+
+static void accumulate(Stats& s, double t)
+{
+	s.total += t;
+	if (t > s.max)
+		s.max = t;
+	s.calls++;
+}
+
+// Per-subsystem timings, read from the igl::Profiler scopes of
+// Renderer::UpdateScene in the order they first appear
+struct ScopeStats
+{
+	std::string name;
+	int depth;
+	Stats stats;
+};
+
+// Adds the profiler events that ended after *last_end and advances it. The
+// ring buffer must not have wrapped since the previous call.
+static void collect_scopes(double* last_end, std::vector<igl::Profiler::Event>& events, std::vector<ScopeStats>& scopes)
+{
+	igl::profiler().events(events);
+	for (const auto& e : events)
+	{
+		if (e.end <= *last_end)
+			continue;
+		// Depth 0 are the ticks, timed with their allocations in main
+		if (e.depth > 0)
+		{
+			auto it = std::find_if(scopes.begin(), scopes.end(),
+				[&e](const ScopeStats& s) { return s.name == e.name && s.depth == e.depth; });
+			if (it == scopes.end())
+			{
+				ScopeStats scope;
+				scope.name = e.name;
+				scope.depth = e.depth;
+				scopes.push_back(scope);
+				it = scopes.end() - 1;
+			}
+			accumulate(it->stats, e.end - e.begin);
+		}
+	}
+	if (!events.empty())
+		*last_end = std::max(*last_end, events.back().end);
+}
+
+static void make_sphere(int n, double r, Eigen::MatrixXd& V, Eigen::MatrixXi& F)
+{
+	// Latitude/longitude sphere with n rings and 2n segments
+	const int m = 2 * n;
+	V.resize((n + 1) * m, 3);
+	F.resize(2 * n * m, 3);
+	for (int i = 0; i <= n; i++)
+	{
+		double th = igl::PI * i / n;
+		for (int j = 0; j < m; j++)
+		{
+			double ph = 2.0 * igl::PI * j / m;
+			V.row(i * m + j) << r * sin(th) * cos(ph), r * sin(th) * sin(ph), r * cos(th);
+		}
+	}
+	int f = 0;
+	for (int i = 0; i < n; i++)
+	{
+		for (int j = 0; j < m; j++)
+		{
+			int a = i * m + j, b = i * m + (j + 1) % m;
+			F.row(f++) << a, a + m, b;
+			F.row(f++) << b, a + m, b + m;
+		}
+	}
+}
+
+static void make_box(const Eigen::RowVector3d& m, const Eigen::RowVector3d& M, Eigen::MatrixXd& V, Eigen::MatrixXi& F)
+{
+	V.resize(8, 3);
+	V <<
+		m(0), m(1), m(2),
+		M(0), m(1), m(2),
+		M(0), M(1), m(2),
+		m(0), M(1), m(2),
+		m(0), m(1), M(2),
+		M(0), m(1), M(2),
+		M(0), M(1), M(2),
+		m(0), M(1), M(2);
+	F.resize(12, 3);
+	F <<
+		0, 2, 1, 0, 3, 2,
+		4, 5, 6, 4, 6, 7,
+		0, 1, 5, 0, 5, 4,
+		1, 2, 6, 1, 6, 5,
+		2, 3, 7, 2, 7, 6,
+		3, 0, 4, 3, 4, 7;
+}
+
+static void make_link(Eigen::MatrixXd& V, Eigen::MatrixXi& F)
+{
+	// Same extents as ycylinder.obj: radius 0.2, y in [-0.8, 0.8]
+	Eigen::MatrixXd C;
+	igl::cylinder(16, 2, C, F);
+	V.resize(C.rows(), 3);
+	V.col(0) = 0.2 * C.col(0);
+	V.col(1) = 1.6 * C.col(2).array() - 0.8;
+	V.col(2) = 0.2 * C.col(1);
+}
+
+// Stand-ins for the scene's asset files, so that Viewer::sys_init builds the
+// game's level without reading any file
+static bool load_generated_scene_mesh(igl::opengl::glfw::Viewer& viewer, igl::opengl::glfw::Viewer::SceneMesh mesh, int ball_rings)
+{
+	using namespace Eigen;
+	typedef igl::opengl::glfw::Viewer Viewer;
+	MatrixXd V;
+	MatrixXi F;
+	switch (mesh)
+	{
+	case Viewer::SCENE_MESH_LINK:
+		make_link(V, F);
+		break;
+	case Viewer::SCENE_MESH_BALL:
+		make_sphere(ball_rings, 0.5, V, F);
+		break;
+	case Viewer::SCENE_MESH_GROUND:
+		make_box(RowVector3d(-55, -55, -0.5), RowVector3d(55, 55, 0), V, F);
+		break;
+	case Viewer::SCENE_MESH_WALL:
+		make_box(RowVector3d(-57, -1, 0), RowVector3d(57, 1, 5), V, F);
+		break;
+	case Viewer::SCENE_MESH_WALL_SIDES:
+		make_box(RowVector3d(-1, -57, 0), RowVector3d(1, 57, 5), V, F);
+		break;
+	case Viewer::SCENE_MESH_PYRAMID:
+		make_box(RowVector3d(-2, -2, 0), RowVector3d(2, 2, 4), V, F);
+		break;
+	case Viewer::SCENE_MESH_ARROW_RIGHT:
+	case Viewer::SCENE_MESH_ARROW_LEFT:
+		make_box(RowVector3d(-2, -1, 0), RowVector3d(2, 1, 1), V, F);
+		break;
+	default:
+		return false;
+	}
+	viewer.load_mesh(std::move(V), std::move(F));
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	int balls = argc > 1 ? atoi(argv[1]) : 10;
+	int links = argc > 2 ? atoi(argv[2]) : 10;
+	int ticks = argc > 3 ? atoi(argv[3]) : 10000;
+	unsigned seed = argc > 4 ? (unsigned)atoi(argv[4]) : 1;
+	// More rings make the geometry weigh more in the heap peak
+	int ball_rings = argc > 5 ? atoi(argv[5]) : 8;
+	const double delta_time = 16.0;
+
+	// The IK data of the links is kept in arrays of 26
+	if (links < 1 || links > 26 || balls < 0 || ball_rings < 2)
+	{
+		std::cerr << "links must be in [1, 26], balls at least 0 and ball rings at least 2" << std::endl;
+		return 1;
+	}
+	install_allocation_counter();
+	srand(seed);
+
+	igl::opengl::glfw::Viewer viewer;
+	igl::opengl::ViewerCore left, right;
+	left.id = 1;
+	right.id = 2;
+	viewer.left_view = &left;
+	viewer.right_view = &right;
+	viewer.arm_length = links;
+	viewer.scene_mesh_loader = [&viewer, ball_rings](igl::opengl::glfw::Viewer::SceneMesh mesh)
+	{
+		return load_generated_scene_mesh(viewer, mesh, ball_rings);
+	};
+
+	Renderer renderer;
+	renderer.SetScene(&viewer);
+
+	reset_peak_heap();
+	double t_0 = igl::get_seconds();
+	viewer.sys_init(balls);
+	viewer.save_snake();
+	double init_time = igl::get_seconds() - t_0;
+	const long long init_peak = peak_bytes.load();
+	reset_peak_heap();
+
+	// The ring buffer of the profiler holds 1<<16 events, a tick records
+	// about ten
+	const int collect_interval = 1024;
+	std::vector<igl::Profiler::Event> events;
+	std::vector<ScopeStats> scopes;
+	double last_end = igl::profiler().now();
+	Stats tick_stats;
+	int completed_tick = -1;
+
+	for (int tick = 0; tick < ticks && completed_tick < 0; tick++)
+	{
+		// Scripted player: chase the first remaining ball, then the pyramid
+		if (viewer.selected_data_index == igl::opengl::glfw::Viewer::SNAKE_SKIN)
+		{
+			if (viewer.num_balls() > 0)
+				viewer.selected_data_index = igl::opengl::glfw::Viewer::FIRST_BALL;
+			else if (viewer.finished_objective)
+				viewer.selected_data_index = viewer.environment_index(igl::opengl::glfw::Viewer::ENVIRONMENT_PYRAMID);
+			viewer.found_obj = viewer.selected_data_index != igl::opengl::glfw::Viewer::SNAKE_SKIN;
+		}
+
+		// The game's own update, so that the harness cannot drift from it
+		long long count_0 = alloc_count;
+		long long bytes_0 = alloc_bytes;
+		double tick_0 = igl::get_seconds();
+		igl::profiler().begin_frame();
+		renderer.deltaTime = delta_time;
+		renderer.UpdateScene();
+		renderer.EndFrame();
+		igl::profiler().end_frame();
+		accumulate(tick_stats, igl::get_seconds() - tick_0);
+		tick_stats.allocs += alloc_count - count_0;
+		tick_stats.bytes += alloc_bytes - bytes_0;
+
+		if (tick % collect_interval == collect_interval - 1)
+			collect_scopes(&last_end, events, scopes);
+		if (viewer.level_state != igl::opengl::glfw::Viewer::LEVEL_PLAYING)
+			completed_tick = tick;
+	}
+	collect_scopes(&last_end, events, scopes);
+
+	printf("\nballs %d, links %d, ticks %lld, seed %u\n", balls, links, tick_stats.calls, seed);
+	printf("scene init %.3f ms\n", 1000.0 * init_time);
+	if (completed_tick >= 0)
+		printf("level completed at tick %d (score %d)\n", completed_tick, viewer.score);
+	else
+		printf("level not completed (score %d / %d)\n", viewer.score, viewer.cur_level_max_score);
+
+	// Nested scopes (depth > 1) are also part of the time of their parent
+	printf("%-20s %5s %8s %12s %12s %12s\n", "scope", "depth", "calls", "total ms", "mean us", "max us");
+	auto print_row = [](const std::string& name, int depth, const Stats& s)
+	{
+		long long calls = s.calls > 0 ? s.calls : 1;
+		printf("%-20s %5d %8lld %12.3f %12.3f %12.3f\n", name.c_str(), depth, s.calls,
+			1000.0 * s.total, 1e6 * s.total / calls, 1e6 * s.max);
+	};
+	for (const auto& scope : scopes)
+		print_row(scope.name, scope.depth, scope.stats);
+	print_row("tick", 0, tick_stats);
+	if (counts_allocations)
+	{
+		printf("allocated %lld bytes in %lld allocations during ticks (%.2f per tick)\n", tick_stats.bytes, tick_stats.allocs,
+			(double)tick_stats.allocs / (tick_stats.calls > 0 ? tick_stats.calls : 1));
+		printf("heap peak %.1f KiB during scene init, %.1f KiB during ticks\n", init_peak / 1024.0, peak_bytes.load() / 1024.0);
+	}
+	else
+		printf("allocations are only counted with glibc or in MSVC debug builds\n");
+	return 0;
+}
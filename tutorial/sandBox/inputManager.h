@@ -1,35 +1,45 @@
 #pragma once
 #include "igl/opengl/glfw/Display.h"
+#include "igl/Profiler.h"
 #include <windows.h>
-static void glfw_mouse_press(GLFWwindow* window, int button, int action, int modifier)
+// The handle_* functions apply input to the renderer/scene without touching
+// the window, so that recorded input can be replayed headless. The glfw_*
+// callbacks at the bottom turn window events into InputRecorder events.
+
+// While the level menu or shop is open the game is paused: the mouse only
+// moves the camera and the keys only pick menu options
+static bool is_game_paused(Renderer* rndr)
+{
+	return rndr->GetScene()->level_state != igl::opengl::glfw::Viewer::LEVEL_PLAYING;
+}
+
+static void handle_mouse_press(Renderer* rndr, int button, int action, double x2, double y2)
 {
-  Renderer* rndr = (Renderer*) glfwGetWindowUserPointer(window);
-  if (action == GLFW_PRESS)
+  if (action == GLFW_PRESS && !is_game_paused(rndr))
   {
-	  double x2, y2;
-	  glfwGetCursorPos(window, &x2, &y2);
 	  igl::opengl::glfw::Viewer* scn = rndr->GetScene();
 	  bool found = false;
 	  int i = 0, savedIndx = scn->selected_data_index;
 
 	  // Distances range is (-infinity, -1)
 	  float min_distance = INT_MIN, distance;
-	  int min_distance_index = -1;
+	  int min_distance_index = -1, fid, min_distance_fid = -1;
 
 	  for (; i < scn->data_list.size(); i++)
 	  { 
 		  scn->selected_data_index = i;
-		  distance = rndr->Picking(x2, y2);
+		  distance = rndr->Picking(x2, y2, &fid);
 
 		  if (distance > min_distance)
 		  {
 			  min_distance = distance;
 			  min_distance_index = i;
+			  min_distance_fid = fid;
 			  found = true;
 		  }
 	  }
 
-	  if (scn->finished_objective && min_distance_index == scn->data_list.size() - 6)
+	  if (scn->finished_objective && min_distance_index == scn->environment_index(igl::opengl::glfw::Viewer::ENVIRONMENT_PYRAMID))
 	  {
 		  SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 2);
 		  //std::cout << "Found " << (min_distance_index == 0? "Sphere" : min_distance_index == 1 ? "Bunny" : "Cube") << ", Distance: " << min_distance << std::endl;
@@ -39,7 +49,7 @@ static void glfw_mouse_press(GLFWwindow* window, int button, int action, int mod
 		  scn->found_obj = true;
 		  SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
 	  }
-	  else if(!found || min_distance_index >= scn->data_list.size() - 8)
+	  else if(!found || min_distance_index >= igl::opengl::glfw::Viewer::FIRST_BALL + scn->num_balls())
 	  {
 		  std::cout << "not found " << std::endl;
 		  scn->selected_data_index = savedIndx;
@@ -51,6 +61,9 @@ static void glfw_mouse_press(GLFWwindow* window, int button, int action, int mod
 		  //std::cout << "Found " << (min_distance_index == 0? "Sphere" : min_distance_index == 1 ? "Bunny" : "Cube") << ", Distance: " << min_distance << std::endl;
 		  std::cout << "Found " << min_distance_index << ", Distance: " << min_distance << ".\n";
 		  scn->selected_data_index = min_distance_index;
+		  // Links are picked on the skin, through the bone of the face hit
+		  if (min_distance_index == igl::opengl::glfw::Viewer::SNAKE_SKIN)
+			  scn->selected_bone = scn->snake_skin_bones(scn->data().F(min_distance_fid, 0), 0);
 		  
 		  scn->found_obj = true;
 		  SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
@@ -61,11 +74,11 @@ static void glfw_mouse_press(GLFWwindow* window, int button, int action, int mod
 	  {
 		  scn->data().uniform_colors_index(2);
 		  if(savedIndx != scn->selected_data_index)
-			  savedIndx >= scn->arm_length ? scn->data_list[savedIndx].uniform_colors_index(0) : scn->data_list[savedIndx].uniform_colors_index(1);
+			  savedIndx != igl::opengl::glfw::Viewer::SNAKE_SKIN ? scn->data_list[savedIndx].uniform_colors_index(0) : scn->data_list[savedIndx].uniform_colors_index(1);
 	  }
 	  else
 	  {
-		  scn->selected_data_index >= scn->arm_length ? scn->data_list[savedIndx].uniform_colors_index(0) : scn->data_list[savedIndx].uniform_colors_index(1);
+		  scn->selected_data_index != igl::opengl::glfw::Viewer::SNAKE_SKIN ? scn->data_list[savedIndx].uniform_colors_index(0) : scn->data_list[savedIndx].uniform_colors_index(1);
 	  }
 	  
   }
@@ -77,11 +90,8 @@ static void glfw_mouse_press(GLFWwindow* window, int button, int action, int mod
 //}
 
 
-IGL_INLINE void select_hovered_core(GLFWwindow* window, double current_mouse_x, double current_mouse_y)
+IGL_INLINE void select_hovered_core(Renderer* rndr, int height_window, double current_mouse_x, double current_mouse_y)
 	{
-		int width_window, height_window = 800;
-	   glfwGetFramebufferSize(window, &width_window, &height_window);
-	   Renderer* rndr = (Renderer*)glfwGetWindowUserPointer(window);
 		for (int i = 0; i < rndr->core_list.size(); i++)
 		{
 			Eigen::Vector4f viewport = rndr->core_list[i].viewport;
@@ -97,17 +107,17 @@ IGL_INLINE void select_hovered_core(GLFWwindow* window, double current_mouse_x,
 		}
 	}
 
- void glfw_mouse_move(GLFWwindow* window, double x, double y)
+ // buttons: bit i is set if mouse button i is pressed
+ void handle_mouse_move(Renderer* rndr, double x, double y, int buttons, int height_window)
 {
-	 
-	 Renderer* rndr = (Renderer*)glfwGetWindowUserPointer(window);
 	 rndr->UpdatePosition(x, y);
 	 //std::cout << rndr->selected_core_index << std::endl;
 	 //std::cout << "size " << rndr->core_list.size() << std::endl;
-	 select_hovered_core(window, x, y);
-	 if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS)
+	 select_hovered_core(rndr, height_window, x, y);
+	 const bool move_obj = rndr->GetScene()->found_obj && !is_game_paused(rndr);
+	 if ((buttons & (1 << GLFW_MOUSE_BUTTON_RIGHT)))
 	 {
-		 if (rndr->GetScene()->found_obj)
+		 if (move_obj)
 		 {
 			 rndr->MouseProcessing(GLFW_MOUSE_BUTTON_RIGHT);
 		 }
@@ -116,9 +126,9 @@ IGL_INLINE void select_hovered_core(GLFWwindow* window, double current_mouse_x,
 			 rndr->TranslateCamera();
 		 }
 	 }
-	 else if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
+	 else if ((buttons & (1 << GLFW_MOUSE_BUTTON_LEFT)))
 	 {
-		 if (rndr->GetScene()->found_obj)
+		 if (move_obj)
 		 {
 			 rndr->MouseProcessing(GLFW_MOUSE_BUTTON_LEFT);
 		 }
@@ -127,16 +137,15 @@ IGL_INLINE void select_hovered_core(GLFWwindow* window, double current_mouse_x,
 			 rndr->RotateCamera();
 		 }
 	 }
-	 else if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_MIDDLE) == GLFW_PRESS)
+	 else if ((buttons & (1 << GLFW_MOUSE_BUTTON_MIDDLE)) && !is_game_paused(rndr))
 	 {
 		 rndr->MouseProcessing(GLFW_MOUSE_BUTTON_MIDDLE);
 	 }
 }
 
-static void glfw_mouse_scroll(GLFWwindow* window, double x, double y)
+static void handle_mouse_scroll(Renderer* rndr, double y)
 {
-	Renderer* rndr = (Renderer*)glfwGetWindowUserPointer(window);
-	if (rndr->GetScene()->found_obj)
+	if (rndr->GetScene()->found_obj && !is_game_paused(rndr))
 	{
 		if (rndr->isArm())
 		{
@@ -153,15 +162,6 @@ static void glfw_mouse_scroll(GLFWwindow* window, double x, double y)
 	}
 }
 
-void glfw_window_size(GLFWwindow* window, int width, int height)
-{
-	Renderer* rndr = (Renderer*)glfwGetWindowUserPointer(window);
-	//igl::opengl::glfw::Viewer* scn = rndr->GetScene();
-
-    rndr->post_resize(window,width, height);
-
-}
-
 //static void glfw_drop_callback(GLFWwindow *window,int count,const char **filenames)
 //{
 //
@@ -172,13 +172,17 @@ void glfw_window_size(GLFWwindow* window, int width, int height)
 //	fputs(description, stderr);
 //}
 
-static void glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, int modifier)
+static void handle_key(Renderer* rndr, int key, int action, int modifier)
 {
-	Renderer* rndr = (Renderer*) glfwGetWindowUserPointer(window);
 	igl::opengl::glfw::Viewer* scn = rndr->GetScene();
-	if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
-		glfwSetWindowShouldClose(window, GL_TRUE);
 
+	// Digits 1-4 pick menu/shop options while the game is paused, and go back
+	// to cycling the selected mesh (1/2) once the next level is loaded
+	if (is_game_paused(rndr))
+	{
+		if (action == GLFW_PRESS && key >= '1' && key <= '4')
+			scn->push_menu_input(key - '0');
+	}
 	else if(action == GLFW_PRESS || action == GLFW_REPEAT)
 		switch (key)
 		{
@@ -265,23 +269,126 @@ static void glfw_key_callback(GLFWwindow* window, int key, int scancode, int act
 			rndr->InvertSnake();
 			break;
 		case GLFW_KEY_DELETE:
-			rndr->GetScene()->erase_mesh(rndr->GetScene()->selected_data_index);
-			rndr->GetScene()->movement_data.erase(rndr->GetScene()->movement_data.begin() + (rndr->GetScene()->selected_data_index - rndr->GetScene()->arm_length + 1));
+		{
+			// Only balls can be deleted
+			const int ball = (int)scn->selected_data_index - igl::opengl::glfw::Viewer::FIRST_BALL;
+			if (ball < 0 || ball >= scn->num_balls())
+				break;
+			scn->erase_mesh(scn->selected_data_index);
+			scn->movement_data.erase(scn->movement_data.begin() + ball);
 			break;
+		}
 		case GLFW_KEY_B:
 			rndr->GetScene()->draw_bounding_boxes();
 			rndr->GetScene()->bounding_boxes_visible = !rndr->GetScene()->bounding_boxes_visible;
 			break;
+		case GLFW_KEY_K:
+			// Cycle the kd-tree levels drawn with the bounding boxes
+			rndr->GetScene()->bounding_boxes_depth = (rndr->GetScene()->bounding_boxes_depth + 1) % 9;
+			break;
 		case GLFW_KEY_Z:
 			rndr->GetScene()->load_next_level();
 			break;
 		case GLFW_KEY_F1:
 			rndr->GetScene()->load_snake();
 			break;
+		case GLFW_KEY_P:
+			if (igl::profiler().write_chrome_trace("trace.json"))
+				std::cout << "Wrote trace.json (frame p99 " << 1000.0 * igl::profiler().frame_percentile(99) << " ms)" << std::endl;
+			break;
 		default: break;//do nothing
 		}
 }
 
+static void dispatch_input_event(Renderer* rndr, const InputRecorder::Event& e)
+{
+	// Without a window nothing else computes the projection picking uses
+	rndr->UpdateCameras();
+	switch (e.type)
+	{
+	case InputRecorder::KEY:
+		handle_key(rndr, e.a, e.b, e.c);
+		break;
+	case InputRecorder::MOUSE_BUTTON:
+		handle_mouse_press(rndr, e.a, e.b, e.x, e.y);
+		break;
+	case InputRecorder::MOUSE_MOVE:
+		handle_mouse_move(rndr, e.x, e.y, e.a, e.c);
+		break;
+	case InputRecorder::MOUSE_SCROLL:
+		handle_mouse_scroll(rndr, e.y);
+		break;
+	case InputRecorder::RESIZE:
+		rndr->post_resize(nullptr, e.a, e.b);
+		break;
+	case InputRecorder::PICK:
+		rndr->recorder.check_pick(e, rndr->GetScene()->selected_data_index, rndr->GetScene()->found_obj);
+		break;
+	case InputRecorder::LEVEL:
+		rndr->recorder.check_level(e, rndr->GetScene()->cur_level, rndr->GetScene()->score,
+			rndr->GetScene()->getTrans().matrix()(0, 0));
+		break;
+	default: break;
+	}
+}
+
+static void submit_input_event(GLFWwindow* window, const InputRecorder::Event& e)
+{
+	Renderer* rndr = (Renderer*)glfwGetWindowUserPointer(window);
+	// Live input would desynchronize a replay
+	if (rndr->recorder.is_replaying())
+		return;
+	rndr->recorder.record(e);
+	dispatch_input_event(rndr, e);
+	// The outcome of a pick lets a replay check that it selects the same mesh
+	if (e.type == InputRecorder::MOUSE_BUTTON && e.b == GLFW_PRESS)
+	{
+		igl::opengl::glfw::Viewer* scn = rndr->GetScene();
+		rndr->recorder.record(InputRecorder::Event(InputRecorder::PICK, (int)scn->selected_data_index, scn->found_obj ? 1 : 0));
+	}
+}
+
+static void glfw_mouse_press(GLFWwindow* window, int button, int action, int modifier)
+{
+	double x2, y2;
+	glfwGetCursorPos(window, &x2, &y2);
+	submit_input_event(window, InputRecorder::Event(InputRecorder::MOUSE_BUTTON, button, action, modifier, x2, y2));
+}
+
+void glfw_mouse_move(GLFWwindow* window, double x, double y)
+{
+	int buttons = 0;
+	for (int button : {GLFW_MOUSE_BUTTON_LEFT, GLFW_MOUSE_BUTTON_RIGHT, GLFW_MOUSE_BUTTON_MIDDLE})
+	{
+		if (glfwGetMouseButton(window, button) == GLFW_PRESS)
+			buttons |= 1 << button;
+	}
+	int width_window, height_window = 800;
+	glfwGetFramebufferSize(window, &width_window, &height_window);
+	submit_input_event(window, InputRecorder::Event(InputRecorder::MOUSE_MOVE, buttons, 0, height_window, x, y));
+}
+
+static void glfw_mouse_scroll(GLFWwindow* window, double x, double y)
+{
+	submit_input_event(window, InputRecorder::Event(InputRecorder::MOUSE_SCROLL, 0, 0, 0, x, y));
+}
+
+void glfw_window_size(GLFWwindow* window, int width, int height)
+{
+	Renderer* rndr = (Renderer*)glfwGetWindowUserPointer(window);
+	//igl::opengl::glfw::Viewer* scn = rndr->GetScene();
+
+    rndr->post_resize(window,width, height);
+
+}
+
+static void glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, int modifier)
+{
+	if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+		glfwSetWindowShouldClose(window, GL_TRUE);
+	else
+		submit_input_event(window, InputRecorder::Event(InputRecorder::KEY, key, action, modifier));
+}
 
 void Init(Display& display)
 {
@@ -1,19 +1,85 @@
 #include "igl/opengl/glfw/renderer.h"
 #include "tutorial/sandBox/inputManager.h"
+#include <cstring>
+#include <ctime>
 
+// Usage:
+//   sandBox_bin                         play
+//   sandBox_bin --record <file>         play and record the session to file
+//   sandBox_bin --replay <file>         replay a recorded session
+//   sandBox_bin --replay <file> --headless
+//                                       replay without a window, print
+//                                       frame time percentiles and fail if a
+//                                       pick selects a different mesh
 int main(int argc, char* argv[])
 {
-	Display* disp = new Display(1000, 800, "Wellcome");
+	const char* record_file = nullptr;
+	const char* replay_file = nullptr;
+	bool headless = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+			record_file = argv[++i];
+		else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+			replay_file = argv[++i];
+		else if (strcmp(argv[i], "--headless") == 0)
+			headless = true;
+	}
+
 	Renderer renderer;
 	igl::opengl::glfw::Viewer viewer;
+	// Seeds rand() before the scene is built
+	if (replay_file)
+	{
+		if (!renderer.recorder.start_replay(replay_file))
+			return 1;
+	}
+	else if (record_file)
+		renderer.recorder.start_recording((unsigned int)time(NULL));
+	renderer.callback_replay_input = [&](const InputRecorder::Event& e) { dispatch_input_event(&renderer, e); };
+
+	int arm_length = 10;
+	viewer.arm_length = arm_length;
+
+	if (replay_file && headless)
+	{
+		renderer.SetScene(&viewer);
+		viewer.sys_init(1);
+		viewer.save_snake();
+		renderer.MultipleViews();
+		renderer.GetScene()->getTrans().matrix() << 0.025f, 0, 0, 0,
+			0, 0.025f, 0, 0,
+			0, 0, 0.025f, 0,
+			0, 0, 0, 1;
+
+		while (true)
+		{
+			igl::profiler().begin_frame();
+			renderer.BeginFrame();
+			if (!renderer.recorder.is_replaying())
+			{
+				igl::profiler().end_frame();
+				break;
+			}
+			renderer.UpdateScene();
+			renderer.EndFrame();
+			igl::profiler().end_frame();
+		}
+		printf("frame time p50 %.3f ms, p99 %.3f ms, score %d, pick mismatches %d, level mismatches %d\n",
+			1000.0 * igl::profiler().frame_percentile(50),
+			1000.0 * igl::profiler().frame_percentile(99),
+			viewer.score, renderer.recorder.pick_mismatches, renderer.recorder.level_mismatches);
+		igl::profiler().write_chrome_trace("replay_trace.json");
+		return renderer.recorder.pick_mismatches == 0 && renderer.recorder.level_mismatches == 0 ? 0 : 1;
+	}
+
+	Display* disp = new Display(1000, 800, "Wellcome");
 	Init(*disp);
 	renderer.init(&viewer);
 
 
 	disp->SetRenderer(&renderer);
 
-	int arm_length = 10;
-	viewer.arm_length = arm_length;
 	viewer.sys_init(1);
 	viewer.save_snake();
 
@@ -24,5 +90,8 @@ int main(int argc, char* argv[])
 		0, 0, 0, 1;
 	disp->launch_rendering(true);
 
+	if (record_file)
+		renderer.recorder.save(record_file);
+
 	delete disp;
 }